@@ -132,3 +132,40 @@ CbmDigiEvent DigiEvent::ToStorable() const
     .fSelectionTriggers = fSelectionTriggers,
   };
 }
+
+size_t DigiEventRange::Size(ECbmModuleId system) const
+{
+  auto size = [](const Range& range) { return range.second - range.first; };
+  switch (system) {
+    case ECbmModuleId::kSts: return size(fSts);
+    case ECbmModuleId::kMuch: return size(fMuch);
+    case ECbmModuleId::kTof: return size(fTof);
+    case ECbmModuleId::kBmon: return size(fBmon);
+    case ECbmModuleId::kTrd: return size(fTrd);
+    case ECbmModuleId::kTrd2d: return size(fTrd2d);
+    case ECbmModuleId::kRich: return size(fRich);
+    case ECbmModuleId::kPsd: return size(fPsd);
+    case ECbmModuleId::kFsd: return size(fFsd);
+    default: throw std::runtime_error("DigiEventRange: Invalid system Id " + ::ToString(system));
+  }
+}
+
+DigiEvent DigiEventRange::Materialize(const DigiData& ts) const
+{
+  auto copy = [](auto& target, const auto& source, const Range& range) {
+    target.assign(source.begin() + range.first, source.begin() + range.second);
+  };
+
+  DigiEvent event;
+  event.fTime = fTime;
+  copy(event.fSts, ts.fSts, fSts);
+  copy(event.fMuch, ts.fMuch, fMuch);
+  copy(event.fTof, ts.fTof, fTof);
+  copy(event.fBmon, ts.fBmon, fBmon);
+  copy(event.fTrd, ts.fTrd, fTrd);
+  copy(event.fTrd2d, ts.fTrd2d, fTrd2d);
+  copy(event.fRich, ts.fRich, fRich);
+  copy(event.fPsd, ts.fPsd, fPsd);
+  copy(event.fFsd, ts.fFsd, fFsd);
+  return event;
+}
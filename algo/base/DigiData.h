@@ -17,6 +17,9 @@
 #include "CbmTrdDigi.h"
 #include "PODVector.h"
 
+#include <gsl/span>
+#include <utility>
+
 namespace cbm::algo
 {
   /**
@@ -98,6 +101,51 @@ namespace cbm::algo
     CbmDigiEvent ToStorable() const;
   };
 
+  /**
+   * @brief Event as [begin, end) index ranges into the digis of a timeslice
+   *
+   * Unlike DigiEvent, overlapping events share the timeslice digis instead of holding their own copies.
+   * Copies are only made on demand with Materialize().
+   *
+   * @note The ranges are only valid as long as the DigiData they were built from is unchanged.
+   */
+  struct DigiEventRange {
+    using Range = std::pair<size_t, size_t>;  ///< [begin, end) digi indices
+
+    double fTime = 0;  ///< Event trigger time [ns]
+    Range fSts;        ///< STS digis
+    Range fMuch;       ///< MUCH digis
+    Range fTof;        ///< TOF digis
+    Range fBmon;       ///< Bmon digis
+    Range fTrd;        ///< TRD digis
+    Range fTrd2d;      ///< TRD2D digis
+    Range fRich;       ///< RICH digis
+    Range fPsd;        ///< PSD digis
+    Range fFsd;        ///< FSD digis
+
+    /**
+     * @brief Get the number of digis for a given subsystem
+     */
+    size_t Size(ECbmModuleId system) const;
+
+    /**
+     * @brief Get the digis of a range
+     * @param digis Digis of the timeslice this event was built from
+     * @param range One of the ranges of this event
+     */
+    template<class Digi>
+    static gsl::span<const Digi> Span(const PODVector<Digi>& digis, Range range)
+    {
+      return gsl::span<const Digi>(digis.data() + range.first, range.second - range.first);
+    }
+
+    /**
+     * @brief Copy the digis of the event
+     * @param ts Timeslice this event was built from
+     */
+    DigiEvent Materialize(const DigiData& ts) const;
+  };
+
 }  // namespace cbm::algo
 
 #endif  // CBM_ALGO_BASE_DIGI_DATA_H
@@ -15,6 +15,8 @@
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/vector.hpp>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <zmq.hpp>
@@ -38,20 +40,22 @@ namespace cbm::algo
     /** @brief Serialize object and send it to the histogram server
        ** @param obj: object to be serialized in the message, e.g. config pairs of strings or QaData
        ** @param flags: or'ed values from zmq::send_flags, typ. zmq::send_flags::sndmore to indicate multi-parts message
+       ** @return true if the message was queued, false if it was dropped (e.g. high-water mark reached)
+       **
+       ** The message takes ownership of the serialized buffer, so it is handed to ZMQ without copying.
        **/
     template<typename Object>
-    void PrepareAndSendMsg(const Object& obj, zmq::send_flags flags)
+    bool PrepareAndSendMsg(const Object& obj, zmq::send_flags flags)
     {
       /// Needed ressources (serializd string, boost inserter, boost stream, boost binary output archive)
       namespace b_io = boost::iostreams;
       namespace b_ar = boost::archive;
 
-      std::string serial_str;
-      b_io::back_insert_device<std::string> inserter(serial_str);
+      auto serial_str = std::make_unique<std::string>();
+      serial_str->reserve(fLastMsgSize);
+      b_io::back_insert_device<std::string> inserter(*serial_str);
       b_io::stream<b_io::back_insert_device<std::string>> bstream(inserter);
 
-      serial_str.clear();
-
       if (fbCompression) {
 #ifdef BOOST_IOS_HAS_ZSTD
         std::unique_ptr<b_io::filtering_ostream> out_ = std::make_unique<b_io::filtering_ostream>();
@@ -69,17 +73,22 @@ namespace cbm::algo
         oa << obj;
       }
       bstream.flush();
+      fLastMsgSize = std::max(fLastMsgSize, serial_str->size());
 
-      zmq::message_t msg(serial_str.size());
-      std::copy_n(static_cast<const char*>(serial_str.data()), msg.size(), static_cast<char*>(msg.data()));
-      /// FIXME: read return value to catch EAGAIN indicating a failed emission, use it outside to skip histo reset
-      fZmqSocket.send(msg, flags | zmq::send_flags::dontwait);
+      /// The string is deleted by ZMQ once the message was sent (or by the message destructor, if sending failed)
+      std::string* buffer = serial_str.release();
+      zmq::message_t msg(buffer->data(), buffer->size(), &HistogramSender::FreeBuffer, buffer);
+      return fZmqSocket.send(msg, flags | zmq::send_flags::dontwait).has_value();
     }
 
    private:
+    /** @brief Deallocates a serialized message buffer, called by ZMQ **/
+    static void FreeBuffer(void* /*data*/, void* hint) { delete static_cast<std::string*>(hint); }
+
     std::string fHistComChan   = "tcp://127.0.0.1:56800";
     int32_t fHistHighWaterMark = 1;
     bool fbCompression         = false;
+    size_t fLastMsgSize        = 0;  ///< Size of the largest message so far, used to preallocate the buffer
     zmq::context_t fZmqContext;  ///< ZMQ context FIXME: should be only one context per binary!
     zmq::socket_t fZmqSocket;    ///< ZMQ socket to histogram server
   };
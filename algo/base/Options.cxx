@@ -91,9 +91,15 @@ Options::Options(int argc, char** argv)
     ("output-types,O", po::value(&fOutputTypes)->multitoken()->value_name("<types>"),
       "space separated list of reconstruction output types (Hit, Tracks, DigiTimeslice, DigiEvent, ...)")
     ("compress-archive", po::bool_switch(&fCompressArchive)->default_value(false), "Enable compression for output archives")
+    ("columnar-archive", po::bool_switch(&fColumnarArchive)->default_value(false),
+      "Write the output archive in the columnar format, which allows reading single collections (e.g. only tracks) of a timeslice")
     ("steps", po::value(&fRecoSteps)->multitoken()->default_value({Step::Unpack, Step::DigiTrigger, Step::LocalReco, Step::Tracking})->value_name("<steps>"),
       "space separated list of reconstruction steps (unpack, digitrigger, localreco, ...)")
-    ("event-reco", po::bool_switch(&fReconstructDigiEvents)->default_value(false), "runs digi event reconstruction (local reco, tracking, trigger)")
+    ("event-reco", po::bool_switch(&fReconstructDigiEvents)->default_value(false), "runs digi event reconstruction (local reco, tracking, trigger)"
+      " in parallel on the OpenMP threads; each thread keeps its own hit finder, tracking and V0 finder buffers,"
+      " so memory grows with the number of threads (serial if a QA of the event reconstruction is active)")
+    ("tracking-snapshot", po::value(&fTrackingSnapshot)->value_name("<file>"),
+      "snapshot of the initialized tracking parameters: used at startup if the parameter files didn't change, rewritten otherwise")
     ("systems,s", po::value(&fDetectors)->multitoken()->default_value({Subsystem::STS, Subsystem::TOF, Subsystem::BMON, Subsystem::MUCH, Subsystem::RICH, Subsystem::TRD, Subsystem::TRD2D})->value_name("<detectors>"),
       "space separated list of detectors to process (sts, mvd, ...)")
     ("child-id,c", po::value(&fChildId)->default_value("00")->value_name("<id>"), "online process id on node")
@@ -113,6 +119,12 @@ Options::Options(int argc, char** argv)
       "Dump archive content to stdout and exit. Provide archive with '-i'. (This is a hack to quick check archive content until we have proper tooling.)")
     ("release-mode,R",po::value<bool>(&fReleaseMode)->implicit_value(true),
       "Copy and release each timeslice immediately after receiving it")
+    ("pipeline-depth", po::value(&fPipelineDepth)->default_value(0)->value_name("<num>"),
+      "Fetch timeslices and write results on separate threads, with up to <num> timeslices queued between the stages (0 = process serially)")
+    ("pipeline-memory", po::value(&fPipelineMemoryMB)->default_value(0)->value_name("<MB>"),
+      "Limit the size of the timeslices / results queued between pipeline stages (0 = no limit)")
+    ("concurrent-stages", po::bool_switch(&fConcurrentStages)->default_value(false),
+      "Run independent reconstruction stages (unpacking and local reco of different detectors) concurrently")
     ("help,h",
       "produce help message")
   ;
@@ -52,6 +52,9 @@ namespace cbm::algo
     uint64_t RunStart() const { return fRunStartTime; }
     bool DumpArchive() const { return fDumpArchive; }
     bool ReleaseMode() const { return fReleaseMode; }
+    int PipelineDepth() const { return fPipelineDepth; }
+    size_t PipelineMemoryMB() const { return fPipelineMemoryMB; }
+    bool ConcurrentStages() const { return fConcurrentStages; }
 
     const std::vector<Step>& Steps() const { return fRecoSteps; }
 
@@ -59,6 +62,7 @@ namespace cbm::algo
     bool HasOutput(RecoData recoData) const;
 
     bool CompressArchive() const { return fCompressArchive; }
+    bool ColumnarArchive() const { return fColumnarArchive; }
 
     const std::vector<fles::Subsystem>& Detectors() const { return fDetectors; }
 
@@ -70,6 +74,8 @@ namespace cbm::algo
 
     bool ReconstructDigiEvents() const { return fReconstructDigiEvents; }
 
+    fs::path TrackingSnapshot() const { return fTrackingSnapshot; }
+
    private:                  // members
     std::string fParamsDir;  // TODO: can we make this a std::path?
     std::string fInputLocator;
@@ -86,6 +92,9 @@ namespace cbm::algo
     std::vector<QaStep> fQaSteps;
     bool fDumpArchive              = false;
     bool fReleaseMode              = false;
+    int fPipelineDepth             = 0;
+    size_t fPipelineMemoryMB       = 0;
+    bool fConcurrentStages         = false;
     ProfilingLevel fProfilingLevel = ProfilingNone;
     std::string fTimingsFile;
     int fNumTimeslices  = -1;
@@ -94,12 +103,14 @@ namespace cbm::algo
     std::vector<Step> fRecoSteps;
     std::vector<RecoData> fOutputTypes;
     bool fCompressArchive = false;
+    bool fColumnarArchive = false;
     std::vector<fles::Subsystem> fDetectors;
     std::string fChildId   = "00";
     uint64_t fRunId        = 2391;
     uint64_t fRunStartTime = 0;
     bool fCollectAuxData   = false;
     bool fReconstructDigiEvents = false;
+    std::string fTrackingSnapshot;
   };
 
 }  // namespace cbm::algo
@@ -44,3 +44,15 @@ size_t cbm::algo::GetPeakRSS()
   return size_t(rusage.ru_maxrss * 1024L);
 #endif
 }
+
+size_t cbm::algo::GetPageFaults()
+{
+#ifndef __linux__
+  return 0;
+#else
+  struct rusage rusage;
+  getrusage(RUSAGE_SELF, &rusage);
+
+  return size_t(rusage.ru_minflt + rusage.ru_majflt);
+#endif
+}
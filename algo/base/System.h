@@ -28,4 +28,10 @@ namespace cbm::algo
   **/
   size_t GetPeakRSS();
 
+  /**
+   * @brief Get the number of page faults (minor and major) of the process since it started
+   * @note Returns zero if the value cannot be determined
+  **/
+  size_t GetPageFaults();
+
 }  // namespace cbm::algo
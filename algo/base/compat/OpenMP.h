@@ -47,11 +47,13 @@ namespace cbm::algo::openmp
   inline int GetThreadNum() { return 0; }
   inline int GetNumThreads() { return 1; }
   inline void SetNumThreads(int) {}
+  inline bool InParallel() { return false; }
 #else
   inline int GetMaxThreads() { return omp_get_max_threads(); }
   inline int GetThreadNum() { return omp_get_thread_num(); }
   inline int GetNumThreads() { return omp_get_num_threads(); }
   inline void SetNumThreads(int n) { omp_set_num_threads(n); }
+  inline bool InParallel() { return omp_in_parallel(); }
 #endif
 
 }  // namespace cbm::algo::openmp
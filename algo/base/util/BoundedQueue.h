@@ -0,0 +1,162 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @file BoundedQueue.h
+ * @brief Blocking queue with a limit on the number of items and their size, used between pipeline stages
+**/
+
+namespace cbm::algo
+{
+
+  /**
+   * @brief Occupancy statistics of a BoundedQueue
+  **/
+  struct QueueOccupancy {
+    size_t nPushed      = 0;   ///< Number of items pushed
+    size_t maxItems     = 0;   ///< Maximum number of queued items
+    size_t maxBytes     = 0;   ///< Maximum number of queued bytes
+    double sumItems     = 0.;  ///< Sum of the queue size seen by each push (after the push)
+    double timePushWait = 0.;  ///< Time producers waited for free space [ms]
+    double timePopWait  = 0.;  ///< Time consumers waited for items [ms]
+
+    double MeanItems() const { return nPushed > 0 ? sumItems / nPushed : 0.; }
+  };
+
+  /**
+   * @brief Blocking FIFO queue with a limit on the number of items and on their total size in bytes
+   *
+   * An item is always accepted by an empty queue, even if it exceeds the byte limit on its own. Otherwise a single
+   * large timeslice would block the pipeline forever.
+  **/
+  template<typename T>
+  class BoundedQueue {
+
+   public:
+    /**
+     * @brief Constructor
+     * @param maxItems Maximum number of queued items (at least 1)
+     * @param maxBytes Maximum size of the queued items in bytes (0 = no limit)
+    **/
+    explicit BoundedQueue(size_t maxItems, size_t maxBytes = 0)
+      : fMaxItems(std::max<size_t>(maxItems, 1))
+      , fMaxBytes(maxBytes)
+    {
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Add an item, waiting until there is space
+     * @param bytes Size of the item, counted against the byte limit
+     * @return false if the queue was closed and the item was dropped
+    **/
+    bool Push(T item, size_t bytes = 0)
+    {
+      std::unique_lock lock{fMutex};
+      auto start = std::chrono::steady_clock::now();
+      fNotFull.wait(lock, [&] { return fClosed || HasSpace(bytes); });
+      fStats.timePushWait += ElapsedMs(start);
+      if (fClosed) return false;
+
+      fItems.emplace_back(std::move(item), bytes);
+      fBytes += bytes;
+      fStats.nPushed++;
+      fStats.sumItems += fItems.size();
+      fStats.maxItems = std::max(fStats.maxItems, fItems.size());
+      fStats.maxBytes = std::max(fStats.maxBytes, fBytes);
+      lock.unlock();
+      fNotEmpty.notify_one();
+      return true;
+    }
+
+    /**
+     * @brief Remove the oldest item, waiting until one is available
+     * @return std::nullopt once the queue is closed and drained
+    **/
+    std::optional<T> Pop()
+    {
+      std::unique_lock lock{fMutex};
+      auto start = std::chrono::steady_clock::now();
+      fNotEmpty.wait(lock, [&] { return fClosed || !fItems.empty(); });
+      fStats.timePopWait += ElapsedMs(start);
+      if (fItems.empty()) return std::nullopt;
+
+      auto [item, bytes] = std::move(fItems.front());
+      fItems.pop_front();
+      fBytes -= bytes;
+      lock.unlock();
+      fNotFull.notify_one();
+      return std::move(item);
+    }
+
+    /**
+     * @brief Stop accepting items. Queued items can still be popped.
+    **/
+    void Close()
+    {
+      {
+        std::lock_guard lock{fMutex};
+        fClosed = true;
+      }
+      fNotFull.notify_all();
+      fNotEmpty.notify_all();
+    }
+
+    /**
+     * @brief Number of queued items
+    **/
+    size_t Size() const
+    {
+      std::lock_guard lock{fMutex};
+      return fItems.size();
+    }
+
+    /**
+     * @brief Occupancy statistics since construction
+    **/
+    QueueOccupancy Stats() const
+    {
+      std::lock_guard lock{fMutex};
+      return fStats;
+    }
+
+   private:
+    size_t fMaxItems;
+    size_t fMaxBytes;
+    size_t fBytes = 0;
+    bool fClosed  = false;
+    std::deque<std::pair<T, size_t>> fItems;
+    QueueOccupancy fStats;
+
+    mutable std::mutex fMutex;
+    std::condition_variable fNotFull;
+    std::condition_variable fNotEmpty;
+
+    bool HasSpace(size_t bytes) const
+    {
+      if (fItems.empty()) return true;
+      if (fItems.size() >= fMaxItems) return false;
+      return fMaxBytes == 0 || fBytes + bytes <= fMaxBytes;
+    }
+
+    static double ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+  };
+
+}  // namespace cbm::algo
@@ -19,13 +19,16 @@ void MemoryLogger::Log()
 {
   size_t currentRSS = GetCurrentRSS();
   size_t peakRSS    = GetPeakRSS();
+  size_t pageFaults = GetPageFaults();
 
   ptrdiff_t deltaRSS = currentRSS - mLastRSS;
   float deltaPercent = 100.0f * deltaRSS / currentRSS;
 
   L_(debug) << "Current memory usage: " << BytesToMB(currentRSS) << "MB (delta  " << BytesToMB(deltaRSS) << "MB / "
             << deltaPercent << "%)"
-            << ", peak: " << BytesToMB(peakRSS) << "MB";
+            << ", peak: " << BytesToMB(peakRSS) << "MB"
+            << ", page faults since last log: " << pageFaults - mLastPageFaults;
 
-  mLastRSS = currentRSS;
+  mLastRSS        = currentRSS;
+  mLastPageFaults = pageFaults;
 }
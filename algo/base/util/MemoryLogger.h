@@ -36,7 +36,8 @@ namespace cbm::algo
     void Log();
 
    private:
-    size_t mLastRSS = 0;
+    size_t mLastRSS        = 0;
+    size_t mLastPageFaults = 0;
 
     // Convert bytes to MB
     // Template to allow for different integer types
@@ -0,0 +1,85 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#pragma once
+
+#include "PODVector.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file RecyclingBuffer.h
+ * @brief Buffer that keeps its memory between timeslices
+**/
+
+namespace cbm::algo
+{
+
+  /**
+   * @brief Holds a PODVector between uses, so its memory is reused by the next timeslice instead of reallocated
+   *
+   * Take() hands out the buffer (empty, but with the capacity of previous timeslices), Give() returns it. If the
+   * capacity grows beyond TrimFactor times the largest size of the last NHistory uses, the buffer is shrunk to that
+   * high-water mark, so a single huge timeslice doesn't pin its memory forever.
+   *
+   * Not thread-safe: each buffer is meant to be used by a single processing stage.
+  **/
+  template<typename T>
+  class RecyclingBuffer {
+
+   public:
+    static constexpr size_t NHistory   = 16;  //< Number of uses considered for the high-water mark
+    static constexpr size_t TrimFactor = 2;   //< Shrink if capacity exceeds this factor times the high-water mark
+
+    /**
+     * @brief Take the buffer. It's empty, but keeps the capacity of previous uses.
+    **/
+    PODVector<T> Take()
+    {
+      PODVector<T> buffer = std::move(fBuffer);
+      fBuffer             = PODVector<T>{};
+      buffer.clear();
+      return buffer;
+    }
+
+    /**
+     * @brief Return a buffer after use, its current size counts towards the high-water mark
+     * @note Buffers without memory (e.g. moved-from) are ignored
+    **/
+    void Give(PODVector<T>&& buffer)
+    {
+      if (buffer.capacity() == 0) return;
+
+      fSizes[fNUses++ % NHistory] = buffer.size();
+      const size_t highWaterMark  = *std::max_element(fSizes.begin(), fSizes.end());
+      if (buffer.capacity() > TrimFactor * highWaterMark) {
+        PODVector<T> trimmed;
+        trimmed.reserve(highWaterMark);
+        buffer = std::move(trimmed);
+        fNTrims++;
+      }
+      if (buffer.capacity() >= fBuffer.capacity()) fBuffer = std::move(buffer);
+    }
+
+    /**
+     * @brief Capacity of the buffer currently held
+    **/
+    size_t Capacity() const { return fBuffer.capacity(); }
+
+    /**
+     * @brief Number of times the buffer was shrunk
+    **/
+    size_t NTrims() const { return fNTrims; }
+
+   private:
+    PODVector<T> fBuffer;
+    std::array<size_t, NHistory> fSizes{};  //< Sizes of the last uses
+    size_t fNUses  = 0;
+    size_t fNTrims = 0;
+  };
+
+}  // namespace cbm::algo
@@ -0,0 +1,290 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "TaskGraph.h"
+
+#include "Exceptions.h"
+#include "compat/Algorithm.h"
+#include "compat/OpenMP.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <sstream>
+
+#include <fmt/format.h>
+
+using namespace cbm::algo;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  /// Set while a task runs on a thread of the pool
+  thread_local bool gOnWorkerThread = false;
+
+  /// xpu timers are only used outside of TaskGraph tasks and OpenMP parallel regions
+  bool TimersEnabled() { return !TaskGraph::OnWorkerThread() && !openmp::InParallel(); }
+
+  double MsSince(Clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+}  // namespace
+
+TaskGraph::TaskId TaskGraph::Add(std::string name, std::function<void()> fn, std::vector<TaskId> deps,
+                                 bool onCallingThread)
+{
+  TaskId id = fTasks.size();
+  for (TaskId dep : deps) {
+    if (dep >= id) {
+      throw FatalError("TaskGraph: Task '{}' depends on task {}, which wasn't added before", name, dep);
+    }
+    fTasks[dep].dependents.push_back(id);
+  }
+  fTasks.push_back({std::move(name), std::move(fn), std::move(deps), {}, onCallingThread, {}});
+  return id;
+}
+
+void TaskGraph::Run()
+{
+  // One thread of the pool stays free for the parallel STL algorithms called by the tasks, see RunConcurrent
+  if (fConcurrent && openmp::GetMaxThreads() > 1 && GetGlobalSTLThreadPool().get_num_threads() > 1) {
+    RunConcurrent();
+  }
+  else {
+    RunSerial();
+  }
+}
+
+void TaskGraph::RunSerial()
+{
+  auto start = Clock::now();
+  for (auto& task : fTasks) {
+    task.timing.start = MsSince(start);
+    task.fn();
+    task.timing.end = MsSince(start);
+  }
+  fWallTime = MsSince(start);
+}
+
+void TaskGraph::RunConcurrent()
+{
+  auto& pool           = GetGlobalSTLThreadPool();
+  const int maxThreads = openmp::GetMaxThreads();
+  const size_t nTasks  = fTasks.size();
+
+  // The tasks may call the parallel STL algorithms, which run on the same pool and wait for their chunks. Leaving one
+  // pool thread free guarantees that these chunks are processed, even if all other pool threads are busy with tasks.
+  const size_t maxWorkers = pool.get_num_threads() - 1;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::vector<size_t> nPendingDeps(nTasks);
+  std::vector<int> nTaskThreads(nTasks, 0);
+  std::deque<TaskId> ready;
+  std::vector<std::future<void>> workers;
+  std::exception_ptr error;
+  size_t nDone      = 0;
+  size_t nRunning   = 0;
+  size_t nOnWorkers = 0;
+  int nThreadsInUse = 0;
+
+  for (TaskId id = 0; id < nTasks; id++) {
+    nPendingDeps[id] = fTasks[id].deps.size();
+    if (nPendingDeps[id] == 0) ready.push_back(id);
+  }
+
+  auto start = Clock::now();
+
+  // Number of OpenMP threads for one of nNew tasks that start now. The threads are shared evenly between all tasks
+  // that run or wait, and never exceed the threads that are not yet used by running tasks. Called while holding the
+  // lock.
+  auto threadsPerTask = [&](size_t nNew) {
+    const int nConcurrent = static_cast<int>(nRunning + nNew + ready.size());
+    const int fairShare   = maxThreads / nConcurrent;
+    const int free        = (maxThreads - nThreadsInUse) / static_cast<int>(nNew);
+    return std::max(1, std::min(fairShare, free));
+  };
+
+  std::function<void(TaskId, bool)> execute;
+
+  // Starts ready tasks that may run on a worker thread, as long as pool threads are available. Tasks for the calling
+  // thread stay in the ready queue. Called while holding the lock.
+  auto schedule = [&] {
+    if (error) return;
+    std::vector<TaskId> launch;
+    std::deque<TaskId> waiting;
+    for (TaskId id : ready) {
+      if (!fTasks[id].onCallingThread && nOnWorkers + launch.size() < maxWorkers) {
+        launch.push_back(id);
+      }
+      else {
+        waiting.push_back(id);
+      }
+    }
+    ready = std::move(waiting);
+    if (launch.empty()) return;
+
+    const int nThreads = threadsPerTask(launch.size());
+    for (TaskId id : launch) {
+      nRunning++;
+      nOnWorkers++;
+      nThreadsInUse += nThreads;
+      nTaskThreads[id] = nThreads;
+      workers.push_back(pool.submit([&execute, id] { execute(id, true); }));
+    }
+  };
+
+  // Runs a task and schedules its dependents. Called without holding the lock.
+  execute = [&](TaskId id, bool onWorker) {
+    auto& task = fTasks[id];
+    std::exception_ptr taskError;
+    gOnWorkerThread   = onWorker;
+    task.timing.start = MsSince(start);
+    try {
+      openmp::SetNumThreads(nTaskThreads[id]);
+      task.fn();
+    }
+    catch (...) {
+      taskError = std::current_exception();
+    }
+    task.timing.end = MsSince(start);
+    gOnWorkerThread = false;
+
+    std::lock_guard lock{mutex};
+    nDone++;
+    nRunning--;
+    if (onWorker) nOnWorkers--;
+    nThreadsInUse -= nTaskThreads[id];
+    if (taskError && !error) error = taskError;
+    for (TaskId dep : task.dependents) {
+      if (--nPendingDeps[dep] == 0) ready.push_back(dep);
+    }
+    schedule();
+    finished.notify_all();
+  };
+
+  std::unique_lock lock{mutex};
+  schedule();
+  while (nDone < nTasks && !(error && nRunning == 0)) {
+    // Tasks left in the ready queue either belong to the calling thread, or wait for a free pool thread
+    auto onCaller = std::find_if(ready.begin(), ready.end(), [&](TaskId id) { return fTasks[id].onCallingThread; });
+    if (error || onCaller == ready.end()) {
+      finished.wait(lock);
+      continue;
+    }
+
+    TaskId id = *onCaller;
+    ready.erase(onCaller);
+    nTaskThreads[id] = threadsPerTask(1);
+    nRunning++;
+    nThreadsInUse += nTaskThreads[id];
+    lock.unlock();
+    execute(id, false);
+    lock.lock();
+  }
+  lock.unlock();
+
+  // Tasks have finished their work at this point, wait until they have also left the pool threads
+  for (auto& worker : workers) {
+    worker.wait();
+  }
+  openmp::SetNumThreads(maxThreads);
+  fWallTime = MsSince(start);
+
+  if (error) std::rethrow_exception(error);
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::CriticalPath() const
+{
+  // Tasks are stored in a valid execution order, so a single forward pass finds the longest chain ending in each task
+  const size_t nTasks = fTasks.size();
+  std::vector<double> length(nTasks);
+  std::vector<TaskId> prev(nTasks, nTasks);
+  for (TaskId id = 0; id < nTasks; id++) {
+    double longestDep = 0.;
+    for (TaskId dep : fTasks[id].deps) {
+      if (length[dep] > longestDep) {
+        longestDep = length[dep];
+        prev[id]   = dep;
+      }
+    }
+    length[id] = longestDep + fTasks[id].timing.Duration();
+  }
+
+  std::vector<TaskId> path;
+  if (nTasks == 0) return path;
+  for (TaskId id = std::max_element(length.begin(), length.end()) - length.begin(); id < nTasks; id = prev[id]) {
+    path.push_back(id);
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+double TaskGraph::CriticalPathTime() const
+{
+  double time = 0.;
+  for (TaskId id : CriticalPath()) {
+    time += fTasks[id].timing.Duration();
+  }
+  return time;
+}
+
+std::string TaskGraph::Report() const
+{
+  std::stringstream ss;
+  double sumTasks = 0.;
+  ss << "Task graph timings:\n";
+  for (const auto& task : fTasks) {
+    sumTasks += task.timing.Duration();
+    ss << fmt::format("  {:<20} {:>10.3f} ms  (start {:>10.3f} ms)\n", task.name, task.timing.Duration(),
+                      task.timing.start);
+  }
+
+  const auto path = CriticalPath();
+  ss << "  Critical path:";
+  for (size_t i = 0; i < path.size(); i++) {
+    ss << (i == 0 ? " " : " -> ") << fTasks[path[i]].name;
+  }
+  ss << fmt::format("\n  Critical path: {:.3f} ms, sum of tasks: {:.3f} ms, wall: {:.3f} ms", CriticalPathTime(),
+                    sumTasks, fWallTime);
+  return ss.str();
+}
+
+bool TaskGraph::OnWorkerThread() { return gOnWorkerThread; }
+
+TaskTimer::TaskTimer(std::string_view name, xpu::timings* timings)
+  : fTimings(timings)
+  , fActive(TimersEnabled())
+{
+  if (fActive) xpu::push_timer(name);
+}
+
+TaskTimer::~TaskTimer()
+{
+  if (!fActive) return;
+  xpu::timings timings = xpu::pop_timer();
+  if (fTimings != nullptr) *fTimings = std::move(timings);
+}
+
+void TaskTimer::Push(std::string_view name)
+{
+  if (TimersEnabled()) xpu::push_timer(name);
+}
+
+xpu::timings TaskTimer::Pop()
+{
+  if (!TimersEnabled()) return {};
+  return xpu::pop_timer();
+}
+
+void TaskTimer::AddBytes(size_t bytes)
+{
+  if (TimersEnabled()) xpu::t_add_bytes(bytes);
+}
@@ -0,0 +1,170 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <xpu/host.h>
+
+/**
+ * @file TaskGraph.h
+ * @brief Dependency-aware execution of the stages of a processing chain
+**/
+
+namespace cbm::algo
+{
+
+  /**
+   * @brief Set of tasks with dependencies, executed once all dependencies of a task have finished
+   *
+   * Tasks without pending dependencies run concurrently on the threads of the global STL thread pool. One pool thread
+   * is kept free for the parallel STL algorithms called by the tasks. The OpenMP threads are shared between the
+   * running tasks, and the threads assigned to all running tasks never exceed the OpenMP maximum, so stages that
+   * parallelize internally don't oversubscribe the machine. Tasks that have to stay on the calling thread (e.g.
+   * because they use the GPU) can be marked as such.
+   *
+   * xpu timers may only be used on the main thread. Code that can run in a task on a worker thread uses TaskTimer
+   * instead, and the timings of such tasks are taken from Timing().
+   *
+   * Tasks must be added in a valid execution order, i.e. dependencies are added before their dependents. In serial
+   * mode the tasks are run in this order on the calling thread.
+   *
+   * After Run() the wall time of each task is available, together with the critical path through the graph.
+  **/
+  class TaskGraph {
+
+   public:
+    using TaskId = size_t;
+
+    /**
+     * @brief Timing of a task from the last call to Run()
+    **/
+    struct TaskTiming {
+      double start = 0.;  ///< Start time relative to the start of Run() [ms]
+      double end   = 0.;  ///< End time relative to the start of Run() [ms]
+
+      double Duration() const { return end - start; }
+    };
+
+    /**
+     * @brief Constructor
+     * @param concurrent Run independent tasks concurrently. If false, run all tasks serially on the calling thread.
+    **/
+    explicit TaskGraph(bool concurrent = true) : fConcurrent(concurrent) {}
+
+    /**
+     * @brief Add a task
+     * @param name Name of the task, used in the critical path report
+     * @param fn Work of the task
+     * @param deps Tasks that have to finish before this task starts
+     * @param onCallingThread Run the task on the thread that calls Run()
+     * @return Id of the task, used to declare dependencies
+    **/
+    TaskId Add(std::string name, std::function<void()> fn, std::vector<TaskId> deps = {},
+               bool onCallingThread = false);
+
+    /**
+     * @brief Execute all tasks
+     *
+     * If a task throws, no further tasks are started. Run() waits for the running tasks and rethrows the first
+     * exception.
+    **/
+    void Run();
+
+    /**
+     * @brief Timing of a task from the last call to Run()
+    **/
+    const TaskTiming& Timing(TaskId id) const { return fTasks.at(id).timing; }
+
+    /**
+     * @brief Wall time of the last call to Run() [ms]
+    **/
+    double WallTime() const { return fWallTime; }
+
+    /**
+     * @brief Tasks on the longest dependency chain of the last call to Run(), ordered from first to last
+    **/
+    std::vector<TaskId> CriticalPath() const;
+
+    /**
+     * @brief Summed durations of the tasks on the critical path [ms]
+    **/
+    double CriticalPathTime() const;
+
+    /**
+     * @brief Human-readable report of the last call to Run(): task timings and the critical path
+    **/
+    std::string Report() const;
+
+    /**
+     * @brief Whether the calling thread executes a task on a worker thread
+    **/
+    static bool OnWorkerThread();
+
+   private:
+    struct Task {
+      std::string name;
+      std::function<void()> fn;
+      std::vector<TaskId> deps;
+      std::vector<TaskId> dependents;
+      bool onCallingThread = false;
+      TaskTiming timing;
+    };
+
+    bool fConcurrent;
+    double fWallTime = 0.;
+    std::vector<Task> fTasks;
+
+    void RunSerial();
+    void RunConcurrent();
+  };
+
+  /**
+   * @brief xpu timer for code that may run in a TaskGraph task or an OpenMP parallel region
+   *
+   * Same as xpu::scoped_timer, xpu::push_timer, xpu::pop_timer and xpu::t_add_bytes on the main thread. On a worker
+   * thread of a TaskGraph and inside an active OpenMP parallel region (e.g. the parallel event reconstruction), the
+   * timer does nothing and Pop() returns empty timings.
+  **/
+  class TaskTimer {
+
+   public:
+    /**
+     * @brief Start a scoped timer
+     * @param name Name of the timer
+     * @param timings If not null, receives the timings when the timer is stopped
+    **/
+    explicit TaskTimer(std::string_view name, xpu::timings* timings = nullptr);
+
+    ~TaskTimer();
+
+    TaskTimer(const TaskTimer&)            = delete;
+    TaskTimer& operator=(const TaskTimer&) = delete;
+
+    /**
+     * @brief Start a timer, stopped by Pop()
+    **/
+    static void Push(std::string_view name);
+
+    /**
+     * @brief Stop the last timer started by Push()
+    **/
+    static xpu::timings Pop();
+
+    /**
+     * @brief Add processed bytes to the current timer
+    **/
+    static void AddBytes(size_t bytes);
+
+   private:
+    xpu::timings* fTimings;
+    bool fActive;
+  };
+
+}  // namespace cbm::algo
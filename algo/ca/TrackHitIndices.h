@@ -0,0 +1,95 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   TrackHitIndices.h
+/// \brief  Hit indices of reconstructed tracks in a single detector, stored in CSR format
+
+#pragma once
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
+namespace cbm::algo::ca
+{
+  /// \class TrackHitIndices
+  /// \brief Track to hit association of one detector as flat CSR: per-track offsets and packed hit indices
+  ///
+  /// Indexing: [trackID][localHit], value: (partitionID, hitIDinPartition).
+  /// Tracks are filled in order: hits are added with AddHit() and each track is finished with CloseTrack().
+  class TrackHitIndices {
+   public:
+    using HitId_t = std::pair<uint32_t, uint32_t>;
+
+    /// \brief Default constructor, creates a container without tracks
+    TrackHitIndices() : fOffsets{0} {}
+
+    /// \brief Constructor from the CSR arrays
+    /// \param offsets  Index of the first hit of each track, followed by the total number of hits
+    /// \param hits     Hit indices of all tracks
+    TrackHitIndices(std::vector<size_t>&& offsets, std::vector<HitId_t>&& hits)
+      : fOffsets(std::move(offsets))
+      , fHits(std::move(hits))
+    {
+      if (fOffsets.empty()) fOffsets.push_back(0);
+    }
+
+    /// \brief Removes all tracks and preallocates memory
+    /// \param nTracks  Expected number of tracks
+    /// \param nHits    Expected number of hits of all tracks
+    void Reset(size_t nTracks, size_t nHits)
+    {
+      fOffsets.clear();
+      fOffsets.reserve(nTracks + 1);
+      fOffsets.push_back(0);
+      fHits.clear();
+      fHits.reserve(nHits);
+    }
+
+    /// \brief Adds a hit to the track that is currently filled
+    void AddHit(uint32_t iPartition, uint32_t iPartHit) { fHits.emplace_back(iPartition, iPartHit); }
+
+    /// \brief Finishes the track that is currently filled
+    void CloseTrack() { fOffsets.push_back(fHits.size()); }
+
+    /// \brief Number of tracks
+    size_t NTracks() const { return fOffsets.size() - 1; }
+
+    /// \brief Number of hits of all tracks
+    size_t NHits() const { return fHits.size(); }
+
+    /// \brief Number of hits of a track
+    size_t Size(size_t iTrk) const { return fOffsets[iTrk + 1] - fOffsets[iTrk]; }
+
+    /// \brief Hit indices of a track
+    gsl::span<const HitId_t> operator[](size_t iTrk) const
+    {
+      return gsl::span<const HitId_t>(fHits.data() + fOffsets[iTrk], Size(iTrk));
+    }
+
+    /// \brief Hit indices of all tracks
+    gsl::span<const HitId_t> Data() const { return fHits; }
+
+    /// \brief Offsets of the tracks in Data(), NTracks() + 1 entries
+    gsl::span<const size_t> Offsets() const { return fOffsets; }
+
+   private:
+    std::vector<size_t> fOffsets;  ///< Index of the first hit of each track, followed by the total number of hits
+    std::vector<HitId_t> fHits;    ///< Hit indices of all tracks
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int /*version*/)
+    {
+      ar& fOffsets;
+      ar& fHits;
+    }
+  };
+}  // namespace cbm::algo::ca
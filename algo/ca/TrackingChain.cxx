@@ -15,19 +15,25 @@
 #include "CaParameters.h"
 #include "KfSetupBuilder.h"
 #include "ParFiles.h"
+#include "TrackingSnapshot.h"
 #include "compat/OpenMP.h"
+#include "util/TaskGraph.h"
 #include "yaml/Yaml.h"
 
 #include <boost/archive/binary_oarchive.hpp>
 
+#include <array>
 #include <fstream>
+#include <optional>
 #include <set>
 #include <unordered_map>
 
 #include <fmt/format.h>
 #include <xpu/host.h>
 
+using cbm::algo::TaskTimer;
 using cbm::algo::TrackingChain;
+using cbm::algo::TrackingSnapshot;
 using cbm::algo::ca::EDetectorID;
 using cbm::algo::ca::Framework;
 using cbm::algo::ca::HitTypes_t;
@@ -66,49 +72,93 @@ void TrackingChain::Init()
   auto mainCfgFile  = (Opts().ParamsDir() / fConfig.fsMainConfig).string();
   auto userCfgFile  = fConfig.fsUserConfig;
 
-  L_(info) << "Tracking Chain: reading geometry from CA parameters file " << GNb << geomCfgFile << CL << '\n';
-  L_(info) << "Tracking Chain: reading geometry setup file " << GNb << setupCfgFile << CL << '\n';
-  L_(info) << "Tracking Chain: reading parameters from CA main config " << GNb << mainCfgFile << CL << '\n';
-
-  //* InitManager instantiation
-  auto manager = InitManager{};
-  manager.SetDetectorNames(ca::kDetName);
-  manager.SetConfigMain(mainCfgFile);
-  if (!userCfgFile.empty()) {
-    L_(info) << "Tracking Chain: applying user configuration from " << GNb << userCfgFile << CL << '\n';
-    manager.SetConfigUser(userCfgFile);
+  // ------ Use the snapshot of the parameters, if it was built from the same parameter files
+  auto snapshotFile = Opts().TrackingSnapshot().string();
+  u64 snapshotKey   = 0;
+  std::optional<Parameters<ca::fvec>> snapshot;
+  if (!snapshotFile.empty()) {
+    snapshotKey = TrackingSnapshot::MakeKey({geomCfgFile, setupCfgFile, mainCfgFile, userCfgFile});
+    snapshot    = TrackingSnapshot::Read(snapshotFile, snapshotKey);
   }
 
-  //* Read parameters object from the geomCfgFile to intialize tracking stations
-  {
-    manager.ReadParametersObject(geomCfgFile);  // geometry setup
-    auto paramIn = manager.TakeParameters();
-    manager.ClearSetupInfo();
-
-    //* Read setup
-    auto geoSetup = kf::SetupBuilder::Load<ca::fvec>(setupCfgFile);
-    kf::Target<double> target(geoSetup.GetTarget());
-
-    //* Initialize tracking parameters
-    manager.SetFieldFunction([](const double(&)[3], double(&outB)[3]) {
-      outB[0] = 0.;
-      outB[1] = 0.;
-      outB[2] = 0.;
-    });
-    manager.SetTargetPosition(target.GetX(), target.GetY(), target.GetZ());
-    manager.InitTargetField(2.5 /*cm*/);
-    manager.AddStations(paramIn);  // Initialize stations
-    manager.InitStationLayout();
-    manager.ReadInputConfigs();
-    manager.SetGeometrySetup(geoSetup);
-    manager.DevSetIsParSearchWUsed(false);
-    if (!manager.FormParametersContainer()) {
-      throw std::runtime_error("Initialization of CA parameters failed");
+  Parameters<ca::fvec> parameters;
+  if (snapshot.has_value()) {
+    L_(info) << "Tracking Chain: reading parameters from snapshot " << GNb << snapshotFile << CL << '\n';
+    parameters = std::move(*snapshot);
+  }
+  else {
+    L_(info) << "Tracking Chain: reading geometry from CA parameters file " << GNb << geomCfgFile << CL << '\n';
+    L_(info) << "Tracking Chain: reading geometry setup file " << GNb << setupCfgFile << CL << '\n';
+    L_(info) << "Tracking Chain: reading parameters from CA main config " << GNb << mainCfgFile << CL << '\n';
+
+    //* InitManager instantiation
+    auto manager = InitManager{};
+    manager.SetDetectorNames(ca::kDetName);
+    manager.SetConfigMain(mainCfgFile);
+    if (!userCfgFile.empty()) {
+      L_(info) << "Tracking Chain: applying user configuration from " << GNb << userCfgFile << CL << '\n';
+      manager.SetConfigUser(userCfgFile);
+    }
+
+    //* Read parameters object from the geomCfgFile to intialize tracking stations
+    {
+      manager.ReadParametersObject(geomCfgFile);  // geometry setup
+      auto paramIn = manager.TakeParameters();
+      manager.ClearSetupInfo();
+
+      //* Read setup
+      auto geoSetup = kf::SetupBuilder::Load<ca::fvec>(setupCfgFile);
+      kf::Target<double> target(geoSetup.GetTarget());
+
+      //* Initialize tracking parameters
+      manager.SetFieldFunction([](const double(&)[3], double(&outB)[3]) {
+        outB[0] = 0.;
+        outB[1] = 0.;
+        outB[2] = 0.;
+      });
+      manager.SetTargetPosition(target.GetX(), target.GetY(), target.GetZ());
+      manager.InitTargetField(2.5 /*cm*/);
+      manager.AddStations(paramIn);  // Initialize stations
+      manager.InitStationLayout();
+      manager.ReadInputConfigs();
+      manager.SetGeometrySetup(geoSetup);
+      manager.DevSetIsParSearchWUsed(false);
+      if (!manager.FormParametersContainer()) {
+        throw std::runtime_error("Initialization of CA parameters failed");
+      }
+    }
+    parameters = manager.TakeParameters();
+
+    if (!snapshotFile.empty()) {
+      try {
+        TrackingSnapshot::Write(snapshotFile, snapshotKey, parameters);
+      }
+      catch (const std::exception& err) {
+        L_(warning) << "Tracking Chain: the snapshot of the parameters was not stored: " << err.what();
+      }
     }
   }
-  auto parameters = manager.TakeParameters();
 
   L_(info) << "Tracking Chain: parameters object: \n" << parameters.ToString(1) << '\n';
+  InitFramework(std::make_shared<const Parameters<ca::fvec>>(std::move(parameters)));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void TrackingChain::Init(const TrackingChain& other)
+{
+  if (fpSetup.get() == nullptr) {
+    throw std::runtime_error("Tracking Chain: TrackingSetup object was not registered");
+  }
+  fConfig = other.fConfig;
+  InitFramework(other.fCaFramework.GetSharedParameters());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void TrackingChain::InitFramework(std::shared_ptr<const Parameters<ca::fvec>> pParameters)
+{
+  const auto& parameters = *pParameters;
 
   // ------ Used detector subsystem flags
   fbDetUsed.fill(false);
@@ -125,7 +175,7 @@ void TrackingChain::Init()
   else {
     fCaFramework.SetNofThreads(1);
   }
-  fCaFramework.ReceiveParameters(std::move(parameters));
+  fCaFramework.ShareParameters(std::move(pParameters));
   fCaFramework.Init(ca::TrackingMode::kMcbm);
 
   // ------ Initialize QA modules
@@ -140,7 +190,7 @@ void TrackingChain::Init()
 //
 TrackingChain::Output_t TrackingChain::Run(Input_t recoResults)
 {
-  xpu::scoped_timer t_("CA");  // TODO: pass timings to monitoring for throughput?
+  TaskTimer t_("CA");  // TODO: pass timings to monitoring for throughput?
   fCaMonitorData.Reset();
   fCaMonitorData.StartTimer(ca::ETimer::TrackingChain);
 
@@ -212,33 +262,46 @@ TrackingChain::Output_t TrackingChain::PrepareOutput()
   output.tracks = std::move(fCaFramework.fRecoTracks);
   int nTracks   = output.tracks.size();
 
-  output.stsHitIndices.reset(nTracks);
-  output.tofHitIndices.reset(nTracks);
-  output.trdHitIndices.reset(nTracks);
+  // Count the hits per detector first, so that each CSR container is allocated only once
+  const auto& recoHits = fCaFramework.fRecoHits;
+  auto ExternalIndex   = [&](int iRecoHit) {
+    return faHitExternalIndices[fCaFramework.GetInputData().GetHit(recoHits[iRecoHit]).Id()];
+  };
+  std::array<size_t, 3> nDetHits = {0, 0, 0};  // STS, TOF, TRD
+  for (int iHit = 0; iHit < static_cast<int>(recoHits.size()); ++iHit) {
+    switch (std::get<0>(ExternalIndex(iHit))) {
+      case ca::EDetectorID::kSts: ++nDetHits[0]; break;
+      case ca::EDetectorID::kTof: ++nDetHits[1]; break;
+      case ca::EDetectorID::kTrd: ++nDetHits[2]; break;
+      default: break;
+    }
+  }
+  output.stsHitIndices.Reset(nTracks, nDetHits[0]);
+  output.tofHitIndices.Reset(nTracks, nDetHits[1]);
+  output.trdHitIndices.Reset(nTracks, nDetHits[2]);
 
   int trackFirstHit = 0;
   for (int iTrk = 0; iTrk < nTracks; ++iTrk) {
-    output.stsHitIndices[iTrk].clear();
-    output.tofHitIndices[iTrk].clear();
-    output.trdHitIndices[iTrk].clear();
     int nHits = output.tracks[iTrk].fNofHits;
     for (int iHit = 0; iHit < nHits; ++iHit) {
-      int iHitInternal = fCaFramework.GetInputData().GetHit(fCaFramework.fRecoHits[trackFirstHit + iHit]).Id();
-      const auto [detID, iPartition, iPartHit] = faHitExternalIndices[iHitInternal];
+      const auto [detID, iPartition, iPartHit] = ExternalIndex(trackFirstHit + iHit);
       switch (detID) {
         // FIXME: store a global hit index instead of (partition, hit)
-        case ca::EDetectorID::kSts: output.stsHitIndices[iTrk].push_back(std::make_pair(iPartition, iPartHit)); break;
-        case ca::EDetectorID::kTof: output.tofHitIndices[iTrk].push_back(std::make_pair(iPartition, iPartHit)); break;
-        case ca::EDetectorID::kTrd: output.trdHitIndices[iTrk].push_back(std::make_pair(iPartition, iPartHit)); break;
+        case ca::EDetectorID::kSts: output.stsHitIndices.AddHit(iPartition, iPartHit); break;
+        case ca::EDetectorID::kTof: output.tofHitIndices.AddHit(iPartition, iPartHit); break;
+        case ca::EDetectorID::kTrd: output.trdHitIndices.AddHit(iPartition, iPartHit); break;
         default: break;
       }
     }
-    fCaMonitorData.IncrementCounter(ca::ECounter::RecoStsHit, output.stsHitIndices[iTrk].size());
-    fCaMonitorData.IncrementCounter(ca::ECounter::RecoTofHit, output.tofHitIndices[iTrk].size());
-    fCaMonitorData.IncrementCounter(ca::ECounter::RecoTrdHit, output.trdHitIndices[iTrk].size());
+    output.stsHitIndices.CloseTrack();
+    output.tofHitIndices.CloseTrack();
+    output.trdHitIndices.CloseTrack();
 
     trackFirstHit += nHits;
   }
+  fCaMonitorData.IncrementCounter(ca::ECounter::RecoStsHit, nDetHits[0]);
+  fCaMonitorData.IncrementCounter(ca::ECounter::RecoTofHit, nDetHits[1]);
+  fCaMonitorData.IncrementCounter(ca::ECounter::RecoTrdHit, nDetHits[2]);
 
   if (ECbmRecoMode::Timeslice == fRecoMode) {
     L_(info) << "TrackingChain: Timeslice contains " << fCaMonitorData.GetCounterValue(ca::ECounter::RecoTrack)
@@ -292,7 +355,7 @@ void TrackingChain::ReadHits(PartitionedSpan<const ca::HitTypes_t::at<DetID>> hi
   constexpr bool IsTrd  = (DetID == EDetectorID::kTrd);
   constexpr bool IsTof  = (DetID == EDetectorID::kTof);
 
-  xpu::t_add_bytes(hits.NElements() * sizeof(Hit_t));  // Assumes call from Run, for existence of timer!
+  TaskTimer::AddBytes(hits.NElements() * sizeof(Hit_t));  // Assumes call from Run, for existence of timer!
 
   int64_t dataStreamDet = static_cast<int64_t>(DetID) << 60;  // detector part of the data stream
   int64_t dataStream    = 0;
@@ -18,6 +18,7 @@
 #include "PartitionedSpan.h"
 #include "RecoResults.h"
 #include "SubChain.h"
+#include "TrackHitIndices.h"
 #include "TrackingChainConfig.h"
 #include "TrackingDefs.h"
 #include "TrackingSetup.h"
@@ -63,15 +64,15 @@ namespace cbm::algo
 
       /// \brief STS hit indices
       /// \note  Indexing: [trackID][localHit], value: (partitionID, hitIDinPartition)
-      ca::Vector<std::vector<std::pair<uint32_t, uint32_t>>> stsHitIndices;
+      ca::TrackHitIndices stsHitIndices;
 
       /// \brief TOF hit indices
       /// \note  Indexing: [trackID][localHit], value: (partitionID, hitIDinPartition)
-      ca::Vector<std::vector<std::pair<uint32_t, uint32_t>>> tofHitIndices;
+      ca::TrackHitIndices tofHitIndices;
 
       /// \brief TRD hit indices
       /// \note  Indexing: [trackID][localHit], value: (partitionID, hitIDinPartition)
-      ca::Vector<std::vector<std::pair<uint32_t, uint32_t>>> trdHitIndices;
+      ca::TrackHitIndices trdHitIndices;
 
       /// \brief Monitor data
       ca::TrackingMonitorData monitorData;
@@ -83,6 +84,13 @@ namespace cbm::algo
     /// \brief  Provides action in the initialization of the run
     void Init();
 
+    /// \brief  Initializes the chain with the config and the tracking parameters of another, initialized instance
+    /// \param  other  Tracking chain, which was initialized with Init()
+    ///
+    /// The tracking parameters are shared with the other instance and not copied, so that the instances of the
+    /// event threads do not keep the stations and the field of the setup each.
+    void Init(const TrackingChain& other);
+
     /// \brief  Registers tracking setup
     void RegisterSetup(std::shared_ptr<TrackingSetup> pSetup) { fpSetup = pSetup; }
 
@@ -94,11 +102,19 @@ namespace cbm::algo
     /// \brief  Provides action in the end of the run
     void Finalize();
 
+    /// \brief  Adds the run monitor of another instance (e.g. of another thread) to the run monitor
+    /// \param  other  Other tracking chain
+    void MergeMonitor(const TrackingChain& other) { fCaMonitor.AddMonitorData(other.fCaMonitor.GetMonitorData()); }
+
 
    private:
     // *********************
     // **  Utility functions
 
+    /// \brief  Initializes the CA framework and the QA with the tracking parameters
+    /// \param  pParameters  Tracking parameters
+    void InitFramework(std::shared_ptr<const ca::Parameters<ca::fvec>> pParameters);
+
     /// \brief  Prepares input data
     /// \param  recoResults  Structure of reconstruction results
     void PrepareInput(Input_t recoResults);
@@ -0,0 +1,193 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   TrackingSnapshot.cxx
+/// \brief  Binary snapshot of the initialized tracking parameters (source)
+
+#include "TrackingSnapshot.h"
+
+#include "AlgoFairloggerCompat.h"
+
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using cbm::algo::TrackingSnapshot;
+
+namespace b_io = boost::iostreams;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+cbm::algo::u64 TrackingSnapshot::Hash(const char* data, size_t size, u64 hash)
+{
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+cbm::algo::u64 TrackingSnapshot::MakeKey(const std::vector<std::string>& files)
+{
+  const u64 layout = LayoutFingerprint();
+  u64 key          = Hash(Magic, sizeof(Magic));
+  key              = Hash(reinterpret_cast<const char*>(&layout), sizeof(layout), key);
+  for (const auto& file : files) {
+    if (file.empty()) {
+      continue;
+    }
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs) {
+      throw std::runtime_error("TrackingSnapshot: parameter file \"" + file + "\" was not found");
+    }
+    std::string content{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    u64 size = content.size();
+    key      = Hash(reinterpret_cast<const char*>(&size), sizeof(size), key);
+    key      = Hash(content.data(), content.size(), key);
+  }
+  return key;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+cbm::algo::u64 TrackingSnapshot::LayoutFingerprint()
+{
+  const u64 layout[] = {sizeof(ca::Parameters<ca::fvec>),
+                        sizeof(ca::Station<ca::fvec>),
+                        sizeof(ca::Iteration),
+                        sizeof(ca::SearchWindow),
+                        sizeof(kf::Setup<ca::fvec>),
+                        sizeof(kf::FieldRegion<ca::fvec>),
+                        sizeof(kf::FieldValue<ca::fvec>),
+                        boost::archive::BOOST_ARCHIVE_VERSION()};
+  return Hash(reinterpret_cast<const char*>(layout), sizeof(layout));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+std::optional<cbm::algo::ca::Parameters<cbm::algo::ca::fvec>> TrackingSnapshot::Read(const std::string& path, u64 key)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    L_(info) << "TrackingSnapshot: no snapshot found in " << path;
+    return std::nullopt;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    L_(warning) << "TrackingSnapshot: " << path << " is not a snapshot, ignored";
+    return std::nullopt;
+  }
+  const size_t fileSize = st.st_size;
+  void* pFile           = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (pFile == MAP_FAILED) {
+    L_(warning) << "TrackingSnapshot: failed to map " << path << ", ignored";
+    return std::nullopt;
+  }
+  const char* data = static_cast<const char*>(pFile);
+
+  auto Reject = [&](const char* reason) {
+    munmap(pFile, fileSize);
+    L_(info) << "TrackingSnapshot: " << path << " is not used: " << reason;
+    return std::nullopt;
+  };
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  if (!std::equal(std::begin(Magic), std::end(Magic), header.magic)) {
+    return Reject("not a snapshot");
+  }
+  if (header.version != kVersion || header.simdWidth != ca::fvec::size()) {
+    return Reject("written by an incompatible version");
+  }
+  if (header.key != key) {
+    return Reject("parameter files changed");
+  }
+  if (header.payloadSize != fileSize - sizeof(Header)) {
+    return Reject("file is truncated");
+  }
+  const char* payload = data + sizeof(Header);
+  if (Hash(payload, header.payloadSize) != header.checksum) {
+    return Reject("checksum mismatch");
+  }
+
+  auto parameters = std::make_optional<ca::Parameters<ca::fvec>>();
+  try {
+    b_io::array_source device(payload, header.payloadSize);
+    b_io::stream<b_io::array_source> stream(device);
+    boost::archive::binary_iarchive ia(stream);
+    parameters->LoadWithSetups(ia);
+  }
+  catch (const std::exception& err) {
+    munmap(pFile, fileSize);
+    L_(warning) << "TrackingSnapshot: failed to read " << path << ": " << err.what();
+    return std::nullopt;
+  }
+  munmap(pFile, fileSize);
+  return parameters;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void TrackingSnapshot::Write(const std::string& path, u64 key, const ca::Parameters<ca::fvec>& parameters)
+{
+  std::string payload;
+  {
+    b_io::back_insert_device<std::string> inserter(payload);
+    b_io::stream<b_io::back_insert_device<std::string>> stream(inserter);
+    boost::archive::binary_oarchive oa(stream);
+    parameters.SaveWithSetups(oa);
+  }  // Archive and stream are flushed on destruction
+
+  Header header;
+  std::copy(std::begin(Magic), std::end(Magic), header.magic);
+  header.version     = kVersion;
+  header.simdWidth   = ca::fvec::size();
+  header.key         = key;
+  header.payloadSize = payload.size();
+  header.checksum    = Hash(payload.data(), payload.size());
+
+  // Write to a temporary file first, so a concurrently starting process never sees a partial snapshot. The name is
+  // unique, so that concurrent writers do not write into the same temporary file.
+  std::string tmpPath = path + ".XXXXXX";
+  int fd              = mkstemp(tmpPath.data());
+  if (fd < 0) {
+    throw std::runtime_error("TrackingSnapshot: failed to create a temporary file for " + path);
+  }
+  fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);  // mkstemp creates the file readable for the owner only
+  close(fd);
+  {
+    std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    ofs.write(payload.data(), payload.size());
+    if (!ofs) {
+      std::remove(tmpPath.c_str());
+      throw std::runtime_error("TrackingSnapshot: failed to write " + tmpPath);
+    }
+  }
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    throw std::runtime_error("TrackingSnapshot: failed to replace " + path);
+  }
+  L_(info) << "TrackingSnapshot: parameters stored in " << path << " (" << payload.size() << " bytes)";
+}
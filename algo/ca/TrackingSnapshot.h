@@ -0,0 +1,79 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   TrackingSnapshot.h
+/// \brief  Binary snapshot of the initialized tracking parameters (header)
+
+#pragma once
+
+#include "CaParameters.h"
+#include "Definitions.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cbm::algo
+{
+  /// \class TrackingSnapshot
+  /// \brief Binary snapshot of the fully initialized CA parameters, including the KF-setups
+  ///
+  /// Building the parameters from the parameter files involves reading the configurations and completing the
+  /// KF-setups. The snapshot stores the result, so the next start of the process only has to map a file and
+  /// deserialize it.
+  ///
+  /// File layout: a fixed-size Header, followed by the boost binary archive of the parameters. The header contains
+  /// a format version, a key of the inputs and a checksum of the archive. A snapshot is only used, if all three match,
+  /// otherwise the parameters are built from scratch.
+  class TrackingSnapshot {
+   public:
+    static constexpr char Magic[8] = {'C', 'B', 'M', 'C', 'A', 'S', 'N', 'P'};
+    /// Format version, increment on any change of the stored classes. Changes of their size are also caught by the
+    /// layout fingerprint in the key.
+    static constexpr u32 kVersion = 3;
+
+    /// \struct Header
+    /// \brief  Header of the snapshot file
+    struct Header {
+      char magic[8];    ///< Magic
+      u32 version;      ///< Format version
+      u32 simdWidth;    ///< Number of entries in ca::fvec
+      u64 key;          ///< Key of the inputs, from which the parameters were built
+      u64 payloadSize;  ///< Size of the archive [bytes]
+      u64 checksum;     ///< Checksum of the archive
+    };
+
+    /// \brief  Calculates the key of the inputs
+    /// \param  files  Parameter files, from which the parameters are built (empty names are skipped)
+    /// \return Hash of the file contents (geometry, setup including the field, and configurations) and of the layout
+    ///         fingerprint
+    static u64 MakeKey(const std::vector<std::string>& files);
+
+    /// \brief  Fingerprint of the memory layout of the stored classes
+    /// \return Hash of the sizes of the stored classes and of the boost archive version
+    ///
+    /// A snapshot written by a build, in which one of the stored classes has a different layout, is not used, even
+    /// if kVersion was not incremented.
+    static u64 LayoutFingerprint();
+
+    /// \brief  Reads the parameters from a snapshot
+    /// \param  path  Snapshot file
+    /// \param  key   Key of the current inputs
+    /// \return Parameters, or std::nullopt if the file is missing, outdated or corrupt
+    static std::optional<ca::Parameters<ca::fvec>> Read(const std::string& path, u64 key);
+
+    /// \brief Writes a snapshot of the parameters
+    /// \param path        Snapshot file, replaced atomically
+    /// \param key         Key of the inputs, from which the parameters were built
+    /// \param parameters  Initialized parameters
+    static void Write(const std::string& path, u64 key, const ca::Parameters<ca::fvec>& parameters);
+
+   private:
+    /// \brief 64-bit FNV-1a hash
+    /// \param data  Data to hash
+    /// \param size  Size of the data [bytes]
+    /// \param hash  Hash of the preceding data
+    static u64 Hash(const char* data, size_t size, u64 hash = 0xcbf29ce484222325ULL);
+  };
+}  // namespace cbm::algo
@@ -10,6 +10,10 @@
 
 #include <xpu/host.h>
 
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
 namespace cbm::algo::ca
 {
 
@@ -42,8 +46,11 @@ namespace cbm::algo::ca
     xpu::timings ConstructCandidates_time[4];
     xpu::timings Additional_time[4];
     xpu::timings Competition_time[4];
+    xpu::timings CompetitionKernel_time[4];  ///< Competition kernel only (GNN GPU profiling)
+    xpu::timings StationPipeline_time[4];  ///< kNN + triplet kernels of all station groups (pipelined mode)
 
     int nIterations;
+    int nStationGroups = 0;  ///< Number of station groups in the pipelined mode, 0 if run serially
 
     void PrintTimings(int iteration) const
     {
@@ -80,6 +87,20 @@ namespace cbm::algo::ca
       print_timing("Competition_time", Competition_time[iteration]);
       print_timing("Additional_time", Additional_time[iteration]);
       print_timing("Total_time", Total_time[iteration]);
+
+      if (nStationGroups > 0) {
+        // Kernels of different station groups run concurrently, so the summed kernel time exceeds the wall time
+        // of the pipeline by the amount of overlap
+        const auto& t      = StationPipeline_time[iteration];
+        const double kern  = t.kernel_time();
+        const double wall  = t.wall();
+        const double ratio = wall > 0. ? kern / wall : 0.;
+        print_timing("StationPipeline_time", t);
+        std::cout << std::left << std::setw(25) << "StationPipeline_overlap"
+                  << "Groups: " << std::setw(10) << nStationGroups << " Sum kernels: " << std::setw(10) << kern
+                  << " Overlapped: " << std::setw(10) << std::max(0., kern - wall) << " Concurrency: " << std::setw(10)
+                  << ratio << std::endl;
+      }
     }
   };
 
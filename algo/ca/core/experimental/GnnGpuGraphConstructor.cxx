@@ -20,42 +20,45 @@ XPU_EXPORT(strGnnGpuGraphConstructor);
 //XPU_D void TestFunc::operator()(context& ctx) { ctx.cmem<strGpuTripletConstructor>().TestFunc(ctx); }
 
 XPU_EXPORT(EmbedHits);
-XPU_D void EmbedHits::operator()(context& ctx) { ctx.cmem<strGnnGpuGraphConstructor>().EmbedHits(ctx); }
+XPU_D void EmbedHits::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
+{
+  ctx.cmem<strGnnGpuGraphConstructor>().EmbedHits(ctx, iHitBegin, iHitEnd);
+}
 
 XPU_EXPORT(NearestNeighbours_FastPrim);
-XPU_D void NearestNeighbours_FastPrim::operator()(context& ctx)
+XPU_D void NearestNeighbours_FastPrim::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().NearestNeighbours_FastPrim(ctx);
+  ctx.cmem<strGnnGpuGraphConstructor>().NearestNeighbours_FastPrim(ctx, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(NearestNeighbours_Other);
-XPU_D void NearestNeighbours_Other::operator()(context& ctx)
+XPU_D void NearestNeighbours_Other::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().NearestNeighbours_Other(ctx);
+  ctx.cmem<strGnnGpuGraphConstructor>().NearestNeighbours_Other(ctx, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(MakeTripletsOT_FastPrim);
-XPU_D void MakeTripletsOT_FastPrim::operator()(context& ctx)
+XPU_D void MakeTripletsOT_FastPrim::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().MakeTripletsOT_FastPrim(ctx);
+  ctx.cmem<strGnnGpuGraphConstructor>().MakeTripletsOT_FastPrim(ctx, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(MakeTripletsOT_Other);
-XPU_D void MakeTripletsOT_Other::operator()(context& ctx, const int iteration)
+XPU_D void MakeTripletsOT_Other::operator()(context& ctx, const int iteration, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().MakeTripletsOT_Other(ctx, iteration);
+  ctx.cmem<strGnnGpuGraphConstructor>().MakeTripletsOT_Other(ctx, iteration, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(FitTripletsOT_FastPrim);
-XPU_D void FitTripletsOT_FastPrim::operator()(context& ctx)
+XPU_D void FitTripletsOT_FastPrim::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().FitTripletsOT_FastPrim(ctx);
+  ctx.cmem<strGnnGpuGraphConstructor>().FitTripletsOT_FastPrim(ctx, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(FitTripletsOT_Other);
-XPU_D void FitTripletsOT_Other::operator()(context& ctx)
+XPU_D void FitTripletsOT_Other::operator()(context& ctx, const int iHitBegin, const int iHitEnd)
 {
-  ctx.cmem<strGnnGpuGraphConstructor>().FitTripletsOT_Other(ctx);
+  ctx.cmem<strGnnGpuGraphConstructor>().FitTripletsOT_Other(ctx, iHitBegin, iHitEnd);
 }
 
 XPU_EXPORT(ConstructCandidates);
@@ -85,10 +88,10 @@ XPU_D void CompressAllTripletsOrdered::operator()(context& ctx)
 XPU_EXPORT(Competition);
 XPU_D void Competition::operator()(context& ctx) { ctx.cmem<strGnnGpuGraphConstructor>().Competition(ctx); }
 
-XPU_D void GnnGpuGraphConstructor::EmbedHits(EmbedHits::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::EmbedHits(EmbedHits::context& ctx, const int iHitBegin, const int iHitEnd) const
 {
-  const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
-  if (iGThread >= fNHits) return;
+  const int iGThread = iHitBegin + ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();  // hit index
+  if (iGThread >= iHitEnd || iGThread >= fNHits) return;
 
   const auto& hitl = fvHits[iGThread];
 
@@ -99,10 +102,12 @@ XPU_D void GnnGpuGraphConstructor::EmbedHits(EmbedHits::context& ctx) const
   fEmbedCoord[iGThread] = result;
 }
 
-XPU_D void GnnGpuGraphConstructor::NearestNeighbours_FastPrim(NearestNeighbours_FastPrim::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::NearestNeighbours_FastPrim(NearestNeighbours_FastPrim::context& ctx,
+                                                              const int iHitBegin, const int iHitEnd) const
 {
-  const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
-  if (iGThread >= fNHits) return;
+  const int iGThread = iHitBegin + ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();  // hit index
+  if (iGThread >= iHitEnd || iGThread >= fNHits) return;
+  const unsigned int* firstHitStation = &fIndexFirstHitStation[fvHitWindow[iGThread] * (fNStations + 1)];
 
   const float margin = 2.0f;  // FastPrim
   auto& neighbours   = fDoublets_FastPrim[iGThread];
@@ -121,8 +126,8 @@ XPU_D void GnnGpuGraphConstructor::NearestNeighbours_FastPrim(NearestNeighbours_
   const int iStaM = iStaL + 1;
 
   // Find closest hits (upto kNNOrder) which satisfy slope condition
-  const ca::HitIndex_t iHitStart = fIndexFirstHitStation[iStaM];      // start index
-  const ca::HitIndex_t iHitEnd   = fIndexFirstHitStation[iStaM + 1];  // end index
+  const ca::HitIndex_t iHitStart = firstHitStation[iStaM];      // start index
+  const ca::HitIndex_t iHitEnd   = firstHitStation[iStaM + 1];  // end index
   for (std::size_t ihitm = iHitStart; ihitm < iHitEnd; ihitm++) {
     const auto& hitm = fvHits[ihitm];
     // margin
@@ -155,10 +160,12 @@ XPU_D void GnnGpuGraphConstructor::NearestNeighbours_FastPrim(NearestNeighbours_
   fNNeighbours[iGThread] = neighCount;
 }
 
-XPU_D void GnnGpuGraphConstructor::NearestNeighbours_Other(NearestNeighbours_Other::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::NearestNeighbours_Other(NearestNeighbours_Other::context& ctx, const int iHitBegin,
+                                                           const int iHitEnd) const
 {
-  const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
-  if (iGThread >= fNHits) return;
+  const int iGThread = iHitBegin + ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();  // hit index
+  if (iGThread >= iHitEnd || iGThread >= fNHits) return;
+  const unsigned int* firstHitStation = &fIndexFirstHitStation[fvHitWindow[iGThread] * (fNStations + 1)];
 
   float margin = 5.0f;
   if (fIteration == 1)
@@ -182,8 +189,8 @@ XPU_D void GnnGpuGraphConstructor::NearestNeighbours_Other(NearestNeighbours_Oth
 
   int iStaM = iStaL + 1;
   // Find closest hits (upto kNNOrder) which satisfy slope condition
-  ca::HitIndex_t iHitStart = fIndexFirstHitStation[iStaM];      // start index
-  ca::HitIndex_t iHitEnd   = fIndexFirstHitStation[iStaM + 1];  // end index
+  ca::HitIndex_t iHitStart = firstHitStation[iStaM];      // start index
+  ca::HitIndex_t iHitEnd   = firstHitStation[iStaM + 1];  // end index
   for (std::size_t ihitm = iHitStart; ihitm < iHitEnd; ihitm++) {
     const auto& hitm = fvHits[ihitm];
     // margin
@@ -221,8 +228,8 @@ XPU_D void GnnGpuGraphConstructor::NearestNeighbours_Other(NearestNeighbours_Oth
   maxDistIndex = 25;
   iStaM        = iStaL + 2;
   // Find closest hits (upto kNNOrder_Jump) which satisfy slope condition
-  iHitStart = fIndexFirstHitStation[iStaM];      // start index
-  iHitEnd   = fIndexFirstHitStation[iStaM + 1];  // end index
+  iHitStart = firstHitStation[iStaM];      // start index
+  iHitEnd   = firstHitStation[iStaM + 1];  // end index
   for (std::size_t ihitm = iHitStart; ihitm < iHitEnd; ihitm++) {
     const auto& hitm  = fvHits[ihitm];
     const float y_m   = hitm.Y();
@@ -258,10 +265,12 @@ XPU_D void GnnGpuGraphConstructor::NearestNeighbours_Other(NearestNeighbours_Oth
 
 }  // NearestNeighbours_Other
 
-XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_FastPrim(MakeTripletsOT_FastPrim::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_FastPrim(MakeTripletsOT_FastPrim::context& ctx, const int iHitBegin,
+                                                           const int iHitEnd) const
 {
-  const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
-  if (iGThread >= fNHits) return;
+  const int iGThread = iHitBegin + ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();  // hit index
+  if (iGThread >= iHitEnd || iGThread >= fNHits) return;
+  const unsigned int* firstHitStation = &fIndexFirstHitStation[fvHitWindow[iGThread] * (fNStations + 1)];
 
   unsigned int tripletCount = 0;
   const float YZCut         = 0.1;  // (radians) def - 0.1 from distributions
@@ -281,8 +290,8 @@ XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_FastPrim(MakeTripletsOT_FastPr
   }
   const int iStaM = iStaL + 1;
 
-  const ca::HitIndex_t iHitStartM = fIndexFirstHitStation[iStaM];      // start index middle station
-  const ca::HitIndex_t iHitEndM   = fIndexFirstHitStation[iStaM + 1];  // end index
+  const ca::HitIndex_t iHitStartM = firstHitStation[iStaM];      // start index middle station
+  const ca::HitIndex_t iHitEndM   = firstHitStation[iStaM + 1];  // end index
   for (int iDoubletL = 0; iDoubletL < nLHitDoublets; iDoubletL++) {
     const unsigned int iHitM = doubletsLHit[iDoubletL];
     for (auto iM = iHitStartM; iM < iHitEndM; iM++) {  // hits on next station
@@ -323,10 +332,12 @@ XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_FastPrim(MakeTripletsOT_FastPr
   // printf ("iGThread: %d, fNTriplets: %d", iGThread, fNTriplets[iGThread]);
 }
 
-XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_Other(MakeTripletsOT_Other::context& ctx, const int iteration) const
+XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_Other(MakeTripletsOT_Other::context& ctx, const int iteration,
+                                                        const int iHitBegin, const int iHitEnd) const
 {
-  const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
-  if (iGThread >= fNHits) return;
+  const int iGThread = iHitBegin + ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();  // hit index
+  if (iGThread >= iHitEnd || iGThread >= fNHits) return;
+  const unsigned int* firstHitStation = &fIndexFirstHitStation[fvHitWindow[iGThread] * (fNStations + 1)];
 
   // printf ("iGThread: %d \t", iGThread);
 
@@ -362,9 +373,9 @@ XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_Other(MakeTripletsOT_Other::co
     const unsigned int iHitM = doubletsLHit[iDoubletL];
     const int sta2           = fvHits[iHitM].Station();
     if (sta2 > 10) continue;
-    const ca::HitIndex_t iHitStartM = fIndexFirstHitStation[sta2];      // start index middle station
-    const ca::HitIndex_t iHitEndM   = fIndexFirstHitStation[sta2 + 1];  // end index
-    if ((sta2 - sta1) == 1) {                                           // triplet type : [1 2 3/4]
+    const ca::HitIndex_t iHitStartM = firstHitStation[sta2];      // start index middle station
+    const ca::HitIndex_t iHitEndM   = firstHitStation[sta2 + 1];  // end index
+    if ((sta2 - sta1) == 1) {                                     // triplet type : [1 2 3/4]
       for (auto iM = iHitStartM; iM < iHitEndM; iM++) {
         if (iHitM == iM) {
           const auto& hitm        = fvHits[iHitM];
@@ -475,13 +486,14 @@ XPU_D void GnnGpuGraphConstructor::MakeTripletsOT_Other(MakeTripletsOT_Other::co
   // printf("iGThread: %d, fNTriplets: %d \n", iGThread, fNTriplets[iGThread]);
 }
 
-XPU_D void GnnGpuGraphConstructor::FitTripletsOT_FastPrim(FitTripletsOT_FastPrim::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::FitTripletsOT_FastPrim(FitTripletsOT_FastPrim::context& ctx, const int iHitBegin,
+                                                          const int iHitEnd) const
 {
   const int iGThread       = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
   const int NMaxTripletHit = kNN_FastPrim * kNN_FastPrim;
-  if (iGThread >= fNHits * NMaxTripletHit) return;
+  if (iGThread >= (iHitEnd - iHitBegin) * NMaxTripletHit) return;
 
-  const unsigned int iHitL = iGThread / NMaxTripletHit;
+  const unsigned int iHitL = iHitBegin + iGThread / NMaxTripletHit;
   if (iHitL >= fNHits) return;
   const int lSta = fvHits[iHitL].Station();
   if (lSta > 9) return;
@@ -757,15 +769,16 @@ XPU_D void GnnGpuGraphConstructor::FitTripletsOT_FastPrim(FitTripletsOT_FastPrim
   fTripletsSelected_FastPrim[iHitL][iTriplet] = !killTrack;
 }  // FitTripletsOT_FastPrim
 
-XPU_D void GnnGpuGraphConstructor::FitTripletsOT_Other(FitTripletsOT_Other::context& ctx) const
+XPU_D void GnnGpuGraphConstructor::FitTripletsOT_Other(FitTripletsOT_Other::context& ctx, const int iHitBegin,
+                                                       const int iHitEnd) const
 {
   const int iGThread = ctx.block_dim_x() * ctx.block_idx_x() + ctx.thread_idx_x();
   // printf("iGThread: %d\n", iGThread);
 
   const int NMaxTripletHit = kNN_Other * kNN_Other;
-  if (iGThread >= fNHits * NMaxTripletHit) return;
+  if (iGThread >= (iHitEnd - iHitBegin) * NMaxTripletHit) return;
 
-  const unsigned int iHitL = iGThread / NMaxTripletHit;
+  const unsigned int iHitL = iHitBegin + iGThread / NMaxTripletHit;
   if (iHitL >= fNHits) return;
   const int lSta = fvHits[iHitL].Station();
   if (lSta > 9) return;
@@ -51,49 +51,49 @@ namespace cbm::algo::ca
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct NearestNeighbours_FastPrim : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct NearestNeighbours_Other : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct MakeTripletsOT_FastPrim : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct MakeTripletsOT_Other : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx, int);
+    XPU_D void operator()(context& ctx, int iteration, int iHitBegin, int iHitEnd);
   };
 
   struct FitTripletsOT_FastPrim : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct FitTripletsOT_Other : xpu::kernel<GPUReco> {
     using block_size = xpu::block_size<kEmbedHitsBlockSize>;
     using constants  = xpu::cmem<strGnnGpuGraphConstructor>;
     using context    = xpu::kernel_context<xpu::no_smem, constants>;  // shared memory argument required
-    XPU_D void operator()(context& ctx);
+    XPU_D void operator()(context& ctx, int iHitBegin, int iHitEnd);
   };
 
   struct ConstructCandidates : xpu::kernel<GPUReco> {
@@ -154,19 +154,20 @@ namespace cbm::algo::ca
   class GnnGpuGraphConstructor {
    public:
     ///                             ------  FUNCTIONAL PART ------
-    XPU_D void EmbedHits(EmbedHits::context&) const;
+    XPU_D void EmbedHits(EmbedHits::context&, int iHitBegin, int iHitEnd) const;
 
-    XPU_D void NearestNeighbours_FastPrim(NearestNeighbours_FastPrim::context&) const;
+    XPU_D void NearestNeighbours_FastPrim(NearestNeighbours_FastPrim::context&, int iHitBegin, int iHitEnd) const;
 
-    XPU_D void NearestNeighbours_Other(NearestNeighbours_Other::context&) const;
+    XPU_D void NearestNeighbours_Other(NearestNeighbours_Other::context&, int iHitBegin, int iHitEnd) const;
 
-    XPU_D void MakeTripletsOT_FastPrim(MakeTripletsOT_FastPrim::context&) const;
+    XPU_D void MakeTripletsOT_FastPrim(MakeTripletsOT_FastPrim::context&, int iHitBegin, int iHitEnd) const;
 
-    XPU_D void MakeTripletsOT_Other(MakeTripletsOT_Other::context&, const int iteration) const;
+    XPU_D void MakeTripletsOT_Other(MakeTripletsOT_Other::context&, const int iteration, int iHitBegin,
+                                    int iHitEnd) const;
 
-    XPU_D void FitTripletsOT_FastPrim(FitTripletsOT_FastPrim::context&) const;
+    XPU_D void FitTripletsOT_FastPrim(FitTripletsOT_FastPrim::context&, int iHitBegin, int iHitEnd) const;
 
-    XPU_D void FitTripletsOT_Other(FitTripletsOT_Other::context&) const;
+    XPU_D void FitTripletsOT_Other(FitTripletsOT_Other::context&, int iHitBegin, int iHitEnd) const;
 
     XPU_D void ConstructCandidates(ConstructCandidates::context&) const;
 
@@ -223,12 +224,15 @@ namespace cbm::algo::ca
 
     int fNHits;
 
+    int fNStations;  ///< Number of active stations
+
     GpuParameters fParams_const[4];
 
     ca::GpuStation fStations_const[constants::gpu::MaxNofStations];
 
     // General
-    xpu::buffer<unsigned int> fIndexFirstHitStation;  // index (in fvHits) of first hit on station
+    xpu::buffer<unsigned int> fIndexFirstHitStation;  // index (in fvHits) of first hit on station, per batch window
+    xpu::buffer<int> fvHitWindow;                     // batch window of each hit in fvHits
 
     // Metric learning
     xpu::buffer<std::array<float, 6>> fEmbedCoord;
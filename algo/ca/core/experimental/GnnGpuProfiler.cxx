@@ -0,0 +1,82 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file GnnGpuProfiler.cxx
+/// \brief Roofline-style per-kernel profile of the GNN GPU chain (bytes moved, estimated FLOPs, element counts)
+
+#include "GnnGpuProfiler.h"
+
+#include <fstream>
+#include <map>
+
+#include <fmt/format.h>
+
+using namespace cbm::algo::ca;
+
+int GnnGpuProfiler::NextWindow()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNofWindows++;
+}
+
+void GnnGpuProfiler::Add(GnnGpuKernelProfile profile)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fvProfiles.push_back(std::move(profile));
+}
+
+void GnnGpuProfiler::Flush(uint64_t iTs)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  const std::string base = fmt::format("{}_ts{}", fOutputPrefix, iTs);
+  WriteJson(base + ".json", iTs);
+  WriteCsv(base + ".csv");
+  fvProfiles.clear();
+  fNofWindows = 0;
+}
+
+void GnnGpuProfiler::WriteJson(const std::string& fileName, uint64_t iTs) const
+{
+  auto entry = [](const GnnGpuKernelProfile& p) {
+    return fmt::format("\"elements\": {}, \"bytes\": {:.6g}, \"flops\": {:.6g}, \"time_ms\": {:.6g}, "
+                       "\"intensity\": {:.6g}, \"bandwidth_GBps\": {:.6g}, \"performance_GFLOPps\": {:.6g}",
+                       p.nElements, p.bytes, p.flops, p.time, p.Intensity(), p.Bandwidth(), p.Performance());
+  };
+
+  // Sum over all windows and iterations of the timeslice
+  std::map<std::string, GnnGpuKernelProfile> summary;
+  for (const auto& p : fvProfiles) {
+    auto& s  = summary[p.kernel];
+    s.kernel = p.kernel;
+    s.nElements += p.nElements;
+    s.bytes += p.bytes;
+    s.flops += p.flops;
+    s.time += p.time;
+  }
+
+  std::ofstream out(fileName);
+  out << "{\n  \"timeslice\": " << iTs << ",\n  \"windows\": " << fNofWindows << ",\n  \"summary\": [\n";
+  for (auto it = summary.begin(); it != summary.end(); ++it) {
+    out << fmt::format("    {{\"kernel\": \"{}\", {}}}", it->first, entry(it->second))
+        << (std::next(it) == summary.end() ? "\n" : ",\n");
+  }
+  out << "  ],\n  \"launches\": [\n";
+  for (size_t i = 0; i < fvProfiles.size(); ++i) {
+    const auto& p = fvProfiles[i];
+    out << fmt::format("    {{\"kernel\": \"{}\", \"window\": {}, \"iteration\": {}, {}}}", p.kernel, p.window,
+                       p.iteration, entry(p))
+        << (i + 1 == fvProfiles.size() ? "\n" : ",\n");
+  }
+  out << "  ]\n}\n";
+}
+
+void GnnGpuProfiler::WriteCsv(const std::string& fileName) const
+{
+  std::ofstream out(fileName);
+  out << "kernel,window,iteration,elements,bytes,flops,time_ms,intensity,bandwidth_GBps,performance_GFLOPps\n";
+  for (const auto& p : fvProfiles) {
+    out << fmt::format("{},{},{},{},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g}\n", p.kernel, p.window, p.iteration,
+                       p.nElements, p.bytes, p.flops, p.time, p.Intensity(), p.Bandwidth(), p.Performance());
+  }
+}
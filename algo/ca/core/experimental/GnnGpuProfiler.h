@@ -0,0 +1,68 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file GnnGpuProfiler.h
+/// \brief Roofline-style per-kernel profile of the GNN GPU chain (bytes moved, estimated FLOPs, element counts)
+
+#pragma once  // include this header only once per compilation unit
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cbm::algo::ca
+{
+  /// \brief Profile of a single kernel launch in the GNN GPU chain
+  ///
+  /// Bytes and FLOPs are estimates from a cost model of the kernel bodies, evaluated on the element counts which
+  /// are read back together with the kernel output.
+  struct GnnGpuKernelProfile {
+    std::string kernel;      ///< Kernel name
+    int window         = 0;  ///< Index of the time window within the timeslice
+    int iteration      = 0;  ///< CA iteration
+    uint64_t nElements = 0;  ///< Processed elements (hits, kNN candidates, doublet pairs, triplets or tracks)
+    double bytes       = 0.;  ///< Estimated global memory traffic [bytes]
+    double flops       = 0.;  ///< Estimated floating point operations
+    double time        = 0.;  ///< Kernel time [ms]
+
+    /// \brief Arithmetic intensity [FLOP/byte]
+    double Intensity() const { return bytes > 0. ? flops / bytes : 0.; }
+
+    /// \brief Achieved bandwidth [GB/s]
+    double Bandwidth() const { return time > 0. ? bytes / time * 1.e-6 : 0.; }
+
+    /// \brief Achieved performance [GFLOP/s]
+    double Performance() const { return time > 0. ? flops / time * 1.e-6 : 0.; }
+  };
+
+  /// \brief Collects kernel profiles of all time windows of a timeslice and writes them as JSON and CSV
+  ///
+  /// Enabled with constants::gpu::GnnGpuProfiling. Windows may be processed by several threads, so adding
+  /// profiles is thread-safe.
+  class GnnGpuProfiler {
+   public:
+    /// \brief Sets the prefix of the report files
+    void SetOutputPrefix(const std::string& prefix) { fOutputPrefix = prefix; }
+
+    /// \brief Registers a new time window
+    /// \return Index of the window within the current timeslice
+    int NextWindow();
+
+    /// \brief Adds a kernel profile
+    void Add(GnnGpuKernelProfile profile);
+
+    /// \brief Writes <prefix>_ts<iTs>.json and <prefix>_ts<iTs>.csv and clears the collected profiles
+    void Flush(uint64_t iTs);
+
+   private:
+    void WriteJson(const std::string& fileName, uint64_t iTs) const;
+    void WriteCsv(const std::string& fileName) const;
+
+    std::mutex fMutex;
+    std::vector<GnnGpuKernelProfile> fvProfiles;
+    int fNofWindows           = 0;
+    std::string fOutputPrefix = "GnnGpuProfile";
+  };
+}  // namespace cbm::algo::ca
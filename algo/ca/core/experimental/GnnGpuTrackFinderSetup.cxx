@@ -9,10 +9,13 @@
 
 using namespace cbm::algo::ca;
 
+static_assert(!constants::gpu::GnnGpuProfiling || constants::gpu::GpuTimeMonitoring,
+              "GNN GPU profiling takes the kernel times from the GPU time monitor");
+
 GnnGpuTrackFinderSetup::GnnGpuTrackFinderSetup(WindowData& wData, const ca::Parameters<fvec>& pars,
                                                const ca::InputData& input, TrackFitter& trackFitter)
   : fParameters(pars)
-  , frWData(wData)
+  , fpWData(&wData)
   , fIteration(0)
   , frInput(input)
   , frTrackFitter(trackFitter)
@@ -83,6 +86,7 @@ void GnnGpuTrackFinderSetup::SetupParameters()
   for (int ista = 0; ista < nStations; ista++) {
     fGraphConstructor.fStations_const[ista] = fParameters.GetStation(ista);
   }
+  fGraphConstructor.fNStations = nStations;
 
   xpu::set<strGnnGpuGraphConstructor>(fGraphConstructor);
 }  // SetupParameters
@@ -97,9 +101,9 @@ void GnnGpuTrackFinderSetup::SetupGrid()
   xpu::h_view vfvGpuGrid{fGraphConstructor.fvGpuGrid};
 
   for (unsigned int ista = 0; ista < nStations; ista++) {
-    vfvGpuGrid[ista] = GpuGrid(frWData.Grid(ista), bin_start, entries_start);
-    bin_start += frWData.Grid(ista).GetFirstBinEntryIndex().size();
-    entries_start += frWData.Grid(ista).GetEntries().size();
+    vfvGpuGrid[ista] = GpuGrid(fpWData->Grid(ista), bin_start, entries_start);
+    bin_start += fpWData->Grid(ista).GetFirstBinEntryIndex().size();
+    entries_start += fpWData->Grid(ista).GetEntries().size();
   }
 
   fQueue.copy(fGraphConstructor.fvGpuGrid, xpu::h2d);
@@ -113,13 +117,13 @@ void GnnGpuTrackFinderSetup::SetupGrid()
   bin_start = entries_start = 0;
 
   for (unsigned int ista = 0; ista < nStations; ista++) {
-    std::copy_n(frWData.Grid(ista).GetFirstBinEntryIndex().begin(), frWData.Grid(ista).GetFirstBinEntryIndex().size(),
-                &vfgridFirstBinEntryIndex[bin_start]);
-    for (unsigned int i = 0; i < frWData.Grid(ista).GetEntries().size(); i++) {
-      vfgridEntries[entries_start + i] = frWData.Grid(ista).GetEntries()[i].GetObjectId();
+    std::copy_n(fpWData->Grid(ista).GetFirstBinEntryIndex().begin(),
+                fpWData->Grid(ista).GetFirstBinEntryIndex().size(), &vfgridFirstBinEntryIndex[bin_start]);
+    for (unsigned int i = 0; i < fpWData->Grid(ista).GetEntries().size(); i++) {
+      vfgridEntries[entries_start + i] = fpWData->Grid(ista).GetEntries()[i].GetObjectId();
     }
-    bin_start += frWData.Grid(ista).GetFirstBinEntryIndex().size();
-    entries_start += frWData.Grid(ista).GetEntries().size();
+    bin_start += fpWData->Grid(ista).GetFirstBinEntryIndex().size();
+    entries_start += fpWData->Grid(ista).GetEntries().size();
   }
   fNHits = entries_start;
 
@@ -162,10 +166,10 @@ void GnnGpuTrackFinderSetup::SetupMaterialMap()
 
 void GnnGpuTrackFinderSetup::SetInputData()
 {
-  fGraphConstructor.fvHits.reset(frWData.Hits().size(), xpu::buf_io);
+  fGraphConstructor.fvHits.reset(fpWData->Hits().size(), xpu::buf_io);
   xpu::h_view vfvHits{fGraphConstructor.fvHits};
 
-  std::copy_n(frWData.Hits().begin(), frWData.Hits().size(), &vfvHits[0]);
+  std::copy_n(fpWData->Hits().begin(), fpWData->Hits().size(), &vfvHits[0]);
 
   fQueue.copy(fGraphConstructor.fvHits, xpu::h2d);
 }  // SetInputData
@@ -196,9 +200,8 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
   }
   LOG(info) << "Num hits in event: " << fNHits;
 
-  bool isCpu            = xpu::device::active().backend() == xpu::cpu;
-  float embedHitsBlocks = std::ceil((float) activeHits.size() / GnnGpuConstants::kEmbedHitsBlockSize);
-  
+  bool isCpu = xpu::device::active().backend() == xpu::cpu;
+
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     fEventTimeMonitor.nIterations = fIteration;
     xpu::push_timer("Full_time");
@@ -208,10 +211,90 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
   fGraphConstructor.fNHits     = fNHits;
   xpu::set<strGnnGpuGraphConstructor>(fGraphConstructor);
   
+  // Profiling needs a separate timer per kernel, so it runs the kernels serially. A batch of several windows fills
+  // the device on its own, and its station groups are not contiguous in fvHits.
+  if (fParameters.GetGnnGpuNofStreams() > 1 && !constants::gpu::GnnGpuProfiling && fvBatchWindows.size() == 1) {
+    RunKernelsPipelined();
+  }
+  else {
+    if constexpr (constants::gpu::GpuTimeMonitoring) {
+      fEventTimeMonitor.nStationGroups = 0;
+    }
+    RunKernelsSerial();
+  }
+
+  if constexpr (constants::gpu::GpuTimeMonitoring) {
+    xpu::push_timer("Additional_time");
+  }
+
+  fGraphConstructor.fIterationData.reset(0, xpu::buf_device);
+  fGraphConstructor.fvGpuGrid.reset(0, xpu::buf_io);
+  fGraphConstructor.fgridFirstBinEntryIndex.reset(0, xpu::buf_io);
+  fGraphConstructor.fgridEntries.reset(0, xpu::buf_io);
+  xpu::set<strGnnGpuGraphConstructor>(fGraphConstructor);  //TODO: check if we need to reset all the buffers here
+
+  fQueue.copy(fGraphConstructor.fNNeighbours, xpu::d2h);
+  fQueue.copy(fGraphConstructor.fNTriplets, xpu::d2h);
+  if (fIteration == 0) {
+    fQueue.copy(fGraphConstructor.fTriplets_FastPrim, xpu::d2h);
+    fQueue.copy(fGraphConstructor.fTripletsSelected_FastPrim, xpu::d2h);
+    fQueue.copy(fGraphConstructor.fvTripletParams_FastPrim, xpu::d2h);
+  }
+  else {
+    // fQueue.copy(fGraphConstructor.fDoublets_Other, xpu::d2h);  // save doublets as tracks
+    fQueue.copy(fGraphConstructor.fTriplets_Other, xpu::d2h);
+    fQueue.copy(fGraphConstructor.fTripletsSelected_Other, xpu::d2h);
+    fQueue.copy(fGraphConstructor.fvTripletParams_Other, xpu::d2h);
+  }
+
+  if constexpr (constants::gpu::GpuTimeMonitoring) {
+    xpu::timings step_time                        = xpu::pop_timer();
+    fEventTimeMonitor.Additional_time[fIteration] = step_time;
+    xpu::push_timer("Competition_time");
+  }
+  // Scatter the tracks back to the windows of the batch
+  for (const auto& window : fvBatchWindows) {
+    SetWindow(*window.fpWData);
+    FindTracks(fIteration, true, window.fFirstHit, window.fFirstHit + window.fNHits);
+  }
+  if constexpr (constants::gpu::GpuTimeMonitoring) {
+    xpu::timings step_time                         = xpu::pop_timer();
+    fEventTimeMonitor.Competition_time[fIteration] = step_time;
+  }
+  if constexpr (constants::gpu::GnnGpuProfiling) {
+    ProfileKernels();
+  }
+
+  // Debugging
+  // SaveDoubletsAsTracks();
+  // SaveTripletsAsTracks();
+  // SaveFittedTripletsAsTracks();
+  // if (fIteration == 0) {
+  //   FindTracks(fIteration, true);
+  // }
+  // else if (fIteration == 1) {
+  //   FindTracks(fIteration, true);
+  // }
+  // else if (fIteration == 3) {
+  //   FindTracks(fIteration, true);
+  // }
+
+  if constexpr (constants::gpu::GpuTimeMonitoring) {
+    xpu::timings t                           = xpu::pop_timer();
+    fEventTimeMonitor.Total_time[fIteration] = t;
+    fEventTimeMonitor.PrintTimings(fIteration);
+  }
+}
+
+void GnnGpuTrackFinderSetup::RunKernelsSerial()
+{
+  const int nHits             = activeHits.size();
+  const float embedHitsBlocks = std::ceil((float) nHits / GnnGpuConstants::kEmbedHitsBlockSize);
+
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::push_timer("EmbedHits_time");
   }
-  fQueue.launch<EmbedHits>(xpu::n_blocks(embedHitsBlocks));
+  fQueue.launch<EmbedHits>(xpu::n_blocks(embedHitsBlocks), 0, nHits);
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::timings step_time                       = xpu::pop_timer();
     fEventTimeMonitor.EmbedHits_time[fIteration] = step_time;
@@ -219,34 +302,24 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
   }
 
   if (fIteration == 0) {
-    fQueue.launch<NearestNeighbours_FastPrim>(xpu::n_blocks(embedHitsBlocks));
+    fQueue.launch<NearestNeighbours_FastPrim>(xpu::n_blocks(embedHitsBlocks), 0, nHits);
   }
   else {
-    fQueue.launch<NearestNeighbours_Other>(xpu::n_blocks(embedHitsBlocks));
+    fQueue.launch<NearestNeighbours_Other>(xpu::n_blocks(embedHitsBlocks), 0, nHits);
   }
 
-  // fQueue.copy(fGraphConstructor.fNNeighbours, xpu::d2h);
-  // xpu::h_view vfNNeighbours(fGraphConstructor.fNNeighbours);
-  // const int nDoublets = std::accumulate(vfNNeighbours.begin(), vfNNeighbours.end(), 0);
-  // LOG(info) << "GPU Tracking: Num doublets found: " << nDoublets;
-
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::timings step_time                               = xpu::pop_timer();
     fEventTimeMonitor.NearestNeighbours_time[fIteration] = step_time;
     xpu::push_timer("MakeTripletsOT_time");
   }
   if (fIteration == 0) {
-    fQueue.launch<MakeTripletsOT_FastPrim>(xpu::n_blocks(embedHitsBlocks));
+    fQueue.launch<MakeTripletsOT_FastPrim>(xpu::n_blocks(embedHitsBlocks), 0, nHits);
   }
   else {
-    fQueue.launch<MakeTripletsOT_Other>(xpu::n_blocks(embedHitsBlocks), fIteration);
+    fQueue.launch<MakeTripletsOT_Other>(xpu::n_blocks(embedHitsBlocks), fIteration, 0, nHits);
   }
 
-  // fQueue.copy(fGraphConstructor.fNTriplets, xpu::d2h);
-  // xpu::h_view vfNTriplets(fGraphConstructor.fNTriplets);
-  // const int nTriplets = std::accumulate(vfNTriplets.begin(), vfNTriplets.end(), 0);
-  // LOG(info) << "GPU Tracking: Num Triplets constructed: " << nTriplets;
-
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::timings step_time                            = xpu::pop_timer();
     fEventTimeMonitor.MakeTripletsOT_time[fIteration] = step_time;
@@ -257,18 +330,13 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
   // const int NBlocks = std::ceil((float)nTriplets / GnnGpuConstants::kScanBlockSize);
   // fQueue.launch<ExclusiveScan>(xpu::n_blocks(NBlocks));
   // LOG(info) << "Exclusive Scan.";
-  // const int NBlockGroups = std::ceil((float)frWData.Hits().size() / GnnGpuConstants::kScanBlockSize);
+  // const int NBlockGroups = std::ceil((float)fpWData->Hits().size() / GnnGpuConstants::kScanBlockSize);
   // fQueue.launch<AddBlockSums>(xpu::n_blocks(fitTripletsBlocks), NBlockGroups);
   // LOG(info) << "AddBlockSums";
   // fQueue.launch<AddOffsets>(xpu::n_blocks(fitTripletsBlocks));
   // LOG(info) << "AddOffsets";
   // fQueue.launch<CompressAllTripletsOrdered>(xpu::n_blocks(fitTripletsBlocks));
 
-  // fQueue.copy(fGraphConstructor.fTripletsFlat, xpu::d2h);
-  // xpu::h_view vfTripletsFlat(fGraphConstructor.fTripletsFlat);
-  // const auto nTripletsFlat = vfTripletsFlat.size();
-  // LOG(info) << "GPU Tracking: Triplets Compressed: " << nTripletsFlat;
-
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::timings step_time                              = xpu::pop_timer();
     fEventTimeMonitor.CompressTriplets_time[fIteration] = step_time;
@@ -278,41 +346,14 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
   if (fIteration == 0) {
     constexpr float numTriplets   = fGraphConstructor.kNN_FastPrim * fGraphConstructor.kNN_FastPrim;
     const float fitTripletsBlocks = std::ceil((activeHits.size() * numTriplets) / GnnGpuConstants::kEmbedHitsBlockSize);
-    fQueue.launch<FitTripletsOT_FastPrim>(xpu::n_blocks(fitTripletsBlocks));
+    fQueue.launch<FitTripletsOT_FastPrim>(xpu::n_blocks(fitTripletsBlocks), 0, nHits);
   }
   else {
     constexpr float numTriplets   = fGraphConstructor.kNN_Other * fGraphConstructor.kNN_Other;
     const float fitTripletsBlocks = std::ceil((activeHits.size() * numTriplets) / GnnGpuConstants::kEmbedHitsBlockSize);
-    fQueue.launch<FitTripletsOT_Other>(xpu::n_blocks(fitTripletsBlocks));
+    fQueue.launch<FitTripletsOT_Other>(xpu::n_blocks(fitTripletsBlocks), 0, nHits);
   }
 
-  // if (fIteration == 0) {
-  //   fQueue.copy(fGraphConstructor.fTripletsSelected_FastPrim, xpu::d2h);
-  //   xpu::h_view vfNTripletsSelected(fGraphConstructor.fTripletsSelected_FastPrim);
-  //   size_t nTripletsSelected = 0;
-  //   for (auto iHit = 0; iHit < vfNTripletsSelected.size(); iHit++) {
-  //     const auto& tripsHit = vfNTripletsSelected[iHit];
-  //     const int nTripHit   = vfNTriplets[iHit];  // uninitialized after nTripHit
-  //     for (auto iTrip = 0; iTrip < nTripHit; iTrip++) {
-  //       nTripletsSelected += tripsHit[iTrip];  // implicit cast to int
-  //     }
-  //   }
-  //   LOG(info) << "GPU Tracking: Num Triplets after fitting: " << nTripletsSelected;
-  // }
-  // else {
-  //   fQueue.copy(fGraphConstructor.fTripletsSelected_Other, xpu::d2h);
-  //   xpu::h_view vfNTripletsSelected(fGraphConstructor.fTripletsSelected_Other);
-  //   size_t nTripletsSelected = 0;
-  //   for (auto iHit = 0; iHit < vfNTripletsSelected.size(); iHit++) {
-  //     const auto& tripsHit = vfNTripletsSelected[iHit];
-  //     const int nTripHit   = vfNTriplets[iHit];  // uninitialized after nTripHit
-  //     for (auto iTrip = 0; iTrip < nTripHit; iTrip++) {
-  //       nTripletsSelected += tripsHit[iTrip];  // implicit cast to int
-  //     }
-  //   }
-  //   LOG(info) << "GPU Tracking: Num Triplets after fitting: " << nTripletsSelected;
-  // }
-
   if constexpr (constants::gpu::GpuTimeMonitoring) {
     xpu::timings step_time                           = xpu::pop_timer();
     fEventTimeMonitor.FitTripletsOT_time[fIteration] = step_time;
@@ -323,58 +364,194 @@ void GnnGpuTrackFinderSetup::RunGpuTracking()
     xpu::timings step_time                                 = xpu::pop_timer();
     fEventTimeMonitor.ConstructCandidates_time[fIteration] = step_time;
     // LOG(info) << "ConstructCandidates_time: " << step_time.wall();
-    xpu::push_timer("Additional_time");
   }
+}
 
-  fGraphConstructor.fIterationData.reset(0, xpu::buf_device);
-  fGraphConstructor.fvGpuGrid.reset(0, xpu::buf_io);
-  fGraphConstructor.fgridFirstBinEntryIndex.reset(0, xpu::buf_io);
-  fGraphConstructor.fgridEntries.reset(0, xpu::buf_io);
-  xpu::set<strGnnGpuGraphConstructor>(fGraphConstructor);  //TODO: check if we need to reset all the buffers here
+void GnnGpuTrackFinderSetup::RunKernelsPipelined()
+{
+  const int nHits     = activeHits.size();
+  const int nStations = fParameters.GetNstationsActive();
 
-  fQueue.copy(fGraphConstructor.fNNeighbours, xpu::d2h);
-  fQueue.copy(fGraphConstructor.fNTriplets, xpu::d2h);
-  if (fIteration == 0) {
-    fQueue.copy(fGraphConstructor.fTriplets_FastPrim, xpu::d2h);
-    fQueue.copy(fGraphConstructor.fTripletsSelected_FastPrim, xpu::d2h);
-    fQueue.copy(fGraphConstructor.fvTripletParams_FastPrim, xpu::d2h);
-  }
-  else {
-    // fQueue.copy(fGraphConstructor.fDoublets_Other, xpu::d2h);  // save doublets as tracks
-    fQueue.copy(fGraphConstructor.fTriplets_Other, xpu::d2h);
-    fQueue.copy(fGraphConstructor.fTripletsSelected_Other, xpu::d2h);
-    fQueue.copy(fGraphConstructor.fvTripletParams_Other, xpu::d2h);
+  // Triplet building for a hit on station L reads the kNN of the hits on stations L + 1 and L + 2. A group has at
+  // least two stations, so the triplets of a group depend on the kNN of the group itself, which precede them on the
+  // same queue, and on the kNN of the next group. The queues have no events, so the host waits for the queue of the
+  // next group, which holds only its kNN at that point, before launching the triplets. The triplets of a group thus
+  // overlap with the kNN of the groups after the next one.
+  const int nGroups      = std::max(1, std::min(fParameters.GetGnnGpuNofStreams(), nStations / 2));
+  const int nStaPerGroup = (nStations + nGroups - 1) / nGroups;
+  auto& queues           = StreamQueues();
+
+  xpu::h_view vIndexFirstHitStation{fGraphConstructor.fIndexFirstHitStation};
+  std::array<int, constants::gpu::GnnMaxNofStreams + 1> groupFirstHit;
+  for (int iGroup = 0; iGroup <= nGroups; ++iGroup) {
+    groupFirstHit[iGroup] = vIndexFirstHitStation[std::min(iGroup * nStaPerGroup, nStations)];
   }
 
+  auto nBlocks = [](int nThreads) { return std::ceil((float) nThreads / GnnGpuConstants::kEmbedHitsBlockSize); };
+
   if constexpr (constants::gpu::GpuTimeMonitoring) {
-    xpu::timings step_time                        = xpu::pop_timer();
-    fEventTimeMonitor.Additional_time[fIteration] = step_time;
-    xpu::push_timer("Competition_time");
+    xpu::push_timer("EmbedHits_time");
   }
-  FindTracks(fIteration, true);
+  // The embedding is cheap and needed by every group, so it runs once over all hits. Waiting here also makes sure
+  // the input copies issued on fQueue have finished before the stream queues start.
+  fQueue.launch<EmbedHits>(xpu::n_blocks(nBlocks(nHits)), 0, nHits);
+  fQueue.wait();
   if constexpr (constants::gpu::GpuTimeMonitoring) {
-    xpu::timings step_time                         = xpu::pop_timer();
-    fEventTimeMonitor.Competition_time[fIteration] = step_time;
+    xpu::timings step_time                       = xpu::pop_timer();
+    fEventTimeMonitor.EmbedHits_time[fIteration] = step_time;
+    xpu::push_timer("StationPipeline_time");
   }
 
-  // Debugging
-  // SaveDoubletsAsTracks();
-  // SaveTripletsAsTracks();
-  // SaveFittedTripletsAsTracks();
-  // if (fIteration == 0) {
-  //   FindTracks(fIteration, true);
-  // }
-  // else if (fIteration == 1) {
-  //   FindTracks(fIteration, true);
-  // }
-  // else if (fIteration == 3) {
-  //   FindTracks(fIteration, true);
-  // }
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    const int iFirst = groupFirstHit[iGroup];
+    const int iLast  = groupFirstHit[iGroup + 1];
+    if (iFirst == iLast) continue;
+    auto& queue = queues[iGroup];
+    if (fIteration == 0) {
+      queue.launch<NearestNeighbours_FastPrim>(xpu::n_blocks(nBlocks(iLast - iFirst)), iFirst, iLast);
+    }
+    else {
+      queue.launch<NearestNeighbours_Other>(xpu::n_blocks(nBlocks(iLast - iFirst)), iFirst, iLast);
+    }
+  }
+
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    if (iGroup + 1 < nGroups) {
+      queues[iGroup + 1].wait();
+    }
+    const int iFirst = groupFirstHit[iGroup];
+    const int iLast  = groupFirstHit[iGroup + 1];
+    if (iFirst == iLast) continue;
+    auto& queue = queues[iGroup];
+    if (fIteration == 0) {
+      constexpr int numTriplets = GnnGpuGraphConstructor::kNN_FastPrim * GnnGpuGraphConstructor::kNN_FastPrim;
+      queue.launch<MakeTripletsOT_FastPrim>(xpu::n_blocks(nBlocks(iLast - iFirst)), iFirst, iLast);
+      queue.launch<FitTripletsOT_FastPrim>(xpu::n_blocks(nBlocks((iLast - iFirst) * numTriplets)), iFirst, iLast);
+    }
+    else {
+      constexpr int numTriplets = GnnGpuGraphConstructor::kNN_Other * GnnGpuGraphConstructor::kNN_Other;
+      queue.launch<MakeTripletsOT_Other>(xpu::n_blocks(nBlocks(iLast - iFirst)), fIteration, iFirst, iLast);
+      queue.launch<FitTripletsOT_Other>(xpu::n_blocks(nBlocks((iLast - iFirst) * numTriplets)), iFirst, iLast);
+    }
+  }
+
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    queues[iGroup].wait();
+  }
 
   if constexpr (constants::gpu::GpuTimeMonitoring) {
-    xpu::timings t                           = xpu::pop_timer();
-    fEventTimeMonitor.Total_time[fIteration] = t;
-    fEventTimeMonitor.PrintTimings(fIteration);
+    xpu::timings step_time                             = xpu::pop_timer();
+    fEventTimeMonitor.StationPipeline_time[fIteration] = step_time;
+    fEventTimeMonitor.nStationGroups                   = nGroups;
+  }
+}
+
+std::array<xpu::queue, constants::gpu::GnnMaxNofStreams>& GnnGpuTrackFinderSetup::StreamQueues()
+{
+  thread_local std::array<xpu::queue, constants::gpu::GnnMaxNofStreams> queues;
+  return queues;
+}
+
+void GnnGpuTrackFinderSetup::SetProfiler(GnnGpuProfiler* profiler)
+{
+  fpProfiler = profiler;
+  if (fpProfiler) {
+    fProfilerWindow = fpProfiler->NextWindow();
+  }
+}
+
+void GnnGpuTrackFinderSetup::ProfileKernels()
+{
+  if (!fpProfiler) return;
+
+  // Cost model of the kernel bodies in GnnGpuGraphConstructor.cxx. Only global memory traffic is counted; the
+  // parameters in constant memory are ignored. A transcendental function counts as kTranscFlops operations.
+  constexpr double kTranscFlops      = 20.;
+  constexpr double kHitBytes         = sizeof(ca::Hit);
+  constexpr double kEmbedBytes       = sizeof(std::array<float, 6>);
+  constexpr double kEmbedFlops       = 2. * (3 * 16 + 16 * 16 + 16 * 6) + (16 + 16 + 6) * (kTranscFlops + 3.);
+  constexpr double kKnnFlops         = 7. + 3. * 6;              // slope margin + distance in the embedding space
+  constexpr double kMakeTripletFlops = 4. * kTranscFlops + 10.;  // four atan2 + angle cuts
+  constexpr double kFitTripletFlops  = 3000.;                    // 1.5 iterations of the KF fit over three hits
+  constexpr double kTripletBytes     = sizeof(std::array<unsigned int, 2>);
+  constexpr double kParamBytes       = sizeof(std::array<float, 7>) + sizeof(bool);
+  const int kNN = (fIteration == 0) ? GnnGpuGraphConstructor::kNN_FastPrim : GnnGpuGraphConstructor::kNN_Other;
+
+  const int nStations  = fParameters.GetNstationsActive();
+  const uint64_t nHits = activeHits.size();
+  xpu::h_view vIndexFirstHitStation{fGraphConstructor.fIndexFirstHitStation};
+  xpu::h_view vNNeighbours{fGraphConstructor.fNNeighbours};
+  xpu::h_view vNTriplets{fGraphConstructor.fNTriplets};
+
+  // Kernels only connect hits of the same window, so the counts are summed over the windows of the batch
+  uint64_t nCandidates = 0;
+  uint64_t nDoublets   = 0;
+  uint64_t nTriplets   = 0;
+  double nPairs        = 0.;
+  for (size_t iWindow = 0; iWindow < fvBatchWindows.size(); ++iWindow) {
+    const unsigned int* indexFirstHitStation = &vIndexFirstHitStation[iWindow * (nStations + 1)];
+
+    auto nHitsStation = [&](int iSta) -> uint64_t {
+      return (iSta < nStations) ? indexFirstHitStation[iSta + 1] - indexFirstHitStation[iSta] : 0;
+    };
+
+    // kNN: a hit on station L <= 10 scans station L+1, and also L+2 for L <= 9 outside of the FastPrim iteration
+    for (int iSta = 0; iSta < nStations && iSta <= 10; ++iSta) {
+      uint64_t nScanned = nHitsStation(iSta + 1);
+      if (fIteration != 0 && iSta <= 9) nScanned += nHitsStation(iSta + 2);
+      nCandidates += nHitsStation(iSta) * nScanned;
+    }
+
+    // Triplet building visits the doublets of each middle hit. The middle hits are not read back, so the number of
+    // doublet pairs is estimated with the mean number of doublets on the next station.
+    std::vector<double> meanDoublets(nStations + 1, 0.);
+    for (int iSta = 0; iSta < nStations; ++iSta) {
+      uint64_t nStaDoublets = 0;
+      for (auto iHit = indexFirstHitStation[iSta]; iHit < indexFirstHitStation[iSta + 1]; ++iHit) {
+        nStaDoublets += vNNeighbours[iHit];
+      }
+      nDoublets += nStaDoublets;
+      meanDoublets[iSta] = nHitsStation(iSta) > 0 ? double(nStaDoublets) / nHitsStation(iSta) : 0.;
+    }
+    for (int iSta = 0; iSta < nStations; ++iSta) {
+      for (auto iHit = indexFirstHitStation[iSta]; iHit < indexFirstHitStation[iSta + 1]; ++iHit) {
+        nPairs += vNNeighbours[iHit] * meanDoublets[iSta + 1];
+        nTriplets += vNTriplets[iHit];
+      }
+    }
+  }
+
+  auto add = [&](const char* name, uint64_t nElements, double bytes, double flops, const xpu::timings& t) {
+    GnnGpuKernelProfile profile;
+    profile.kernel    = name;
+    profile.window    = fProfilerWindow;
+    profile.iteration = fIteration;
+    profile.nElements = nElements;
+    profile.bytes     = bytes;
+    profile.flops     = flops;
+    profile.time      = t.kernel_time();
+    fpProfiler->Add(std::move(profile));
+  };
+
+  const auto& tm = fEventTimeMonitor;
+  add("EmbedHits", nHits, nHits * (kHitBytes + kEmbedBytes) + sizeof(GnnGpuEmbedNet), nHits * kEmbedFlops,
+      tm.EmbedHits_time[fIteration]);
+  add("NearestNeighbours", nCandidates,
+      nCandidates * (kHitBytes + kEmbedBytes) + nHits * (kHitBytes + kEmbedBytes + (kNN + 1) * sizeof(int)),
+      nCandidates * kKnnFlops, tm.NearestNeighbours_time[fIteration]);
+  add("MakeTripletsOT", uint64_t(nPairs),
+      nPairs * (kHitBytes + sizeof(int)) + nDoublets * (kHitBytes + 2 * sizeof(int)) + nTriplets * kTripletBytes
+        + nHits * (kHitBytes + 2 * sizeof(int)),
+      nPairs * kMakeTripletFlops, tm.MakeTripletsOT_time[fIteration]);
+  add("FitTripletsOT", nTriplets,
+      nTriplets * (3 * kHitBytes + kTripletBytes + 2 * sizeof(float) + kParamBytes) + nHits * sizeof(int),
+      nTriplets * kFitTripletFlops, tm.FitTripletsOT_time[fIteration]);
+  if (fNCompetitionTracks > 0) {
+    constexpr double kTrackBytes = sizeof(std::array<int, 12>) + sizeof(float) + 2 * sizeof(int);
+    add("Competition", fNCompetitionTracks,
+        2. * fNCompetitionTracks * kTrackBytes + fpWData->HitKeyFlags().size() * sizeof(unsigned char), 0.,
+        tm.CompetitionKernel_time[fIteration]);
+    fNCompetitionTracks = 0;
   }
 }
 
@@ -382,8 +559,8 @@ void GnnGpuTrackFinderSetup::SaveDoubletsAsTracks()
 {
   LOG(info) << "Saving doublets as tracks.";
   if (fIteration == 0) {
-    frWData.RecoHitIndices().reserve(200000);
-    frWData.RecoTracks().reserve(100000);
+    fpWData->RecoHitIndices().reserve(200000);
+    fpWData->RecoTracks().reserve(100000);
   }
 
   const auto nHits = activeHits.size();
@@ -395,12 +572,12 @@ void GnnGpuTrackFinderSetup::SaveDoubletsAsTracks()
     for (auto iHitM = 0; iHitM < fGraphConstructor.fNNeighbours[iHitL]; iHitM++) {
       const auto& hitM = fGraphConstructor.fvHits[fGraphConstructor.fDoublets_Other[iHitL][iHitM]];
       // LOG(info) << "iHitL: " << iHitL << " ID: " << activeToWDataMapping[iHitL];
-      frWData.RecoHitIndices().push_back(frWData.Hit(activeToWDataMapping[iHitL]).Id());
+      fpWData->RecoHitIndices().push_back(fpWData->Hit(activeToWDataMapping[iHitL]).Id());
       // LOG(info) << "iHitM: " << iHitM << " ID: " << activeToWDataMapping[iHitM];
-      frWData.RecoHitIndices().push_back(frWData.Hit(activeToWDataMapping[iHitM]).Id());
+      fpWData->RecoHitIndices().push_back(fpWData->Hit(activeToWDataMapping[iHitM]).Id());
       Track t;
       t.fNofHits = 2;
-      frWData.RecoTracks().push_back(t);
+      fpWData->RecoTracks().push_back(t);
       nDoublets++;
     }
   }
@@ -411,8 +588,8 @@ void GnnGpuTrackFinderSetup::SaveTripletsAsTracks()
 {
   LOG(info) << "Saving triplets as tracks.";
   if (fIteration == 0) {
-    frWData.RecoHitIndices().reserve(200000);
-    frWData.RecoTracks().reserve(100000);
+    fpWData->RecoHitIndices().reserve(200000);
+    fpWData->RecoTracks().reserve(100000);
   }
 
   const auto nHits = activeHits.size();
@@ -428,12 +605,12 @@ void GnnGpuTrackFinderSetup::SaveTripletsAsTracks()
       const auto& hitR            = fGraphConstructor.fvHits[tripletsIndexes[1]];
       // LOG(info) << "iHitM: " << iHitM << " ID: " << hitM.Id();
       // LOG(info) << "iHitR: " << iHitR << " ID: " << hitR.Id();
-      frWData.RecoHitIndices().push_back(hitL.Id());
-      frWData.RecoHitIndices().push_back(hitM.Id());
-      frWData.RecoHitIndices().push_back(hitR.Id());
+      fpWData->RecoHitIndices().push_back(hitL.Id());
+      fpWData->RecoHitIndices().push_back(hitM.Id());
+      fpWData->RecoHitIndices().push_back(hitR.Id());
       Track t;
       t.fNofHits = 3;
-      frWData.RecoTracks().push_back(t);
+      fpWData->RecoTracks().push_back(t);
       nTriplets++;
     }
   }
@@ -444,8 +621,8 @@ void GnnGpuTrackFinderSetup::SaveFittedTripletsAsTracks()
 {
   LOG(info) << "Saving triplets as tracks.";
   if (fIteration == 0) {
-    frWData.RecoHitIndices().reserve(200000);
-    frWData.RecoTracks().reserve(100000);
+    fpWData->RecoHitIndices().reserve(200000);
+    fpWData->RecoTracks().reserve(100000);
   }
 
   const auto nHits = activeHits.size();
@@ -464,19 +641,19 @@ void GnnGpuTrackFinderSetup::SaveFittedTripletsAsTracks()
       const auto& hitR            = fGraphConstructor.fvHits[tripletsIndexes[1]];
       // LOG(info) << "iHitM: " << iHitM << " ID: " << hitM.Id();
       // LOG(info) << "iHitR: " << iHitR << " ID: " << hitR.Id();
-      frWData.RecoHitIndices().push_back(hitL.Id());
-      frWData.RecoHitIndices().push_back(hitM.Id());
-      frWData.RecoHitIndices().push_back(hitR.Id());
+      fpWData->RecoHitIndices().push_back(hitL.Id());
+      fpWData->RecoHitIndices().push_back(hitM.Id());
+      fpWData->RecoHitIndices().push_back(hitR.Id());
       Track t;
       t.fNofHits = 3;
-      frWData.RecoTracks().push_back(t);
+      fpWData->RecoTracks().push_back(t);
       nTriplets++;
     }
   }
   LOG(info) << "Num triplets as tracks (after fitting): " << nTriplets;
 }
 
-void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompetition)
+void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompetition, int iHitBegin, int iHitEnd)
 {
   std::vector<std::vector<int>> tracklets;
   tracklets.reserve(10000000);
@@ -485,9 +662,8 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
   std::vector<std::array<float, 7>> trackletFitParams;  // store fit params of last triplet added to tracklet
   trackletFitParams.reserve(10000000);
 
-  const unsigned int nHits = activeHits.size();
-  int nTriplets            = 0;
-  for (unsigned int iHitL = 0; iHitL < nHits; iHitL++) {
+  int nTriplets = 0;
+  for (int iHitL = iHitBegin; iHitL < iHitEnd; iHitL++) {
     const auto& hitL = fGraphConstructor.fvHits[iHitL];
     if (fGraphConstructor.fNNeighbours[iHitL] == 0 || hitL.Station() > 9 || fGraphConstructor.fNTriplets[iHitL] == 0)
       continue;
@@ -523,12 +699,12 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
   // LOG(info) << "FindTracksCpu(): Num triplets used for making tracks: " << nTriplets;
 
   /// organize triplets by station
-  const int NStations = 12;
+  const int NStations = fParameters.GetNstationsActive();
   std::vector<std::vector<std::vector<int>>> tripletsByStation(NStations);
   std::vector<std::vector<float>> tripletsScore(NStations);
   std::vector<std::vector<std::array<float, 7>>> tripletsFitParams(NStations);
   for (int i = 0; i < nTriplets; i++) {
-    const int sta = frWData.Hit(tracklets[i][0]).Station();
+    const int sta = fpWData->Hit(tracklets[i][0]).Station();
     tripletsByStation[sta].push_back(tracklets[i]);
     tripletsScore[sta].push_back(0.);
     tripletsFitParams[sta].push_back(trackletFitParams[i]);
@@ -590,9 +766,9 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
   for (int iTracklet = 0; iTracklet < (int) tracklets.size(); ++iTracklet) {
     const auto& tracklet = tracklets[iTracklet];
     int length           = tracklet.size();
-    int middleSta        = frWData.Hit(tracklet[length - 2]).Station();
+    int middleSta        = fpWData->Hit(tracklet[length - 2]).Station();
     const bool isJumpTripletLast =
-      (frWData.Hit(tracklet[length - 1]).Station() - frWData.Hit(tracklet[length - 3]).Station()) == 3;
+      (fpWData->Hit(tracklet[length - 1]).Station() - fpWData->Hit(tracklet[length - 3]).Station()) == 3;
 
     for (int iTriplet = 0; iTriplet < (int) tripletsByStation[middleSta].size(); ++iTriplet) {
       // check overlapping triplet
@@ -600,10 +776,10 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
       if (tracklet[length - 1] != tripletsByStation[middleSta][iTriplet][1]) continue;
 
       /// check difference of angle difference between triplets in XZ and YZ
-      const auto& h1 = frWData.Hit(tracklet[length - 3]);
-      const auto& h2 = frWData.Hit(tracklet[length - 2]);
-      const auto& h3 = frWData.Hit(tracklet[length - 1]);
-      const auto& h4 = frWData.Hit(tripletsByStation[middleSta][iTriplet][2]);
+      const auto& h1 = fpWData->Hit(tracklet[length - 3]);
+      const auto& h2 = fpWData->Hit(tracklet[length - 2]);
+      const auto& h3 = fpWData->Hit(tracklet[length - 1]);
+      const auto& h4 = fpWData->Hit(tripletsByStation[middleSta][iTriplet][2]);
 
       // YZ angle 1
       angle1YZ     = std::atan2(h2.Y() - h1.Y(), h2.Z() - h1.Z());
@@ -792,8 +968,8 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
   }
 
   if (iteration == 0) {
-    frWData.RecoHitIndices().reserve(200000);
-    frWData.RecoTracks().reserve(100000);
+    fpWData->RecoHitIndices().reserve(200000);
+    fpWData->RecoTracks().reserve(100000);
   }
 
   // prepare final tracks
@@ -804,18 +980,18 @@ void GnnGpuTrackFinderSetup::FindTracks(const int iteration, const bool doCompet
 
   for (const auto& [track, _] : trackAndScores) {
     for (const auto& iHit : track) {
-      const ca::Hit& hit                   = frWData.Hit(iHit);
-      frWData.IsHitKeyUsed(hit.FrontKey()) = 1;
-      frWData.IsHitKeyUsed(hit.BackKey())  = 1;
-      frWData.RecoHitIndices().push_back(hit.Id());
+      const ca::Hit& hit                   = fpWData->Hit(iHit);
+      fpWData->IsHitKeyUsed(hit.FrontKey()) = 1;
+      fpWData->IsHitKeyUsed(hit.BackKey())  = 1;
+      fpWData->RecoHitIndices().push_back(hit.Id());
     }
     Track t;
     t.fNofHits = track.size();
-    frWData.RecoTracks().push_back(t);
+    fpWData->RecoTracks().push_back(t);
   }
 
   LOG(info) << "FindTracks(): Num tracks after competition: " << trackAndScores.size();
-  LOG(info) << "Total tracks found in event: " << frWData.RecoTracks().size();
+  LOG(info) << "Total tracks found in event: " << fpWData->RecoTracks().size();
 }
 
 void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std::vector<int>, float>>& trackAndScores)
@@ -838,8 +1014,8 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std
     std::vector<int> usedHitIDs;
     std::vector<int> usedHitIndexesInTrack;
     for (std::size_t iHit = 0; iHit < track.size(); iHit++) {
-      const ca::Hit& hit = frWData.Hit(track[iHit]);
-      if (frWData.IsHitKeyUsed(hit.FrontKey()) || frWData.IsHitKeyUsed(hit.BackKey())) {
+      const ca::Hit& hit = fpWData->Hit(track[iHit]);
+      if (fpWData->IsHitKeyUsed(hit.FrontKey()) || fpWData->IsHitKeyUsed(hit.BackKey())) {
         nUsedHits++;
         usedHitIDs.push_back(track[iHit]);
         usedHitIndexesInTrack.push_back(iHit);
@@ -848,8 +1024,8 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std
     if (nUsedHits == 0) {  // clean tracks
       /// mark all hits as used
       for (const auto& hit : track) {
-        frWData.IsHitKeyUsed(frWData.Hit(hit).FrontKey()) = 1;
-        frWData.IsHitKeyUsed(frWData.Hit(hit).BackKey())  = 1;
+        fpWData->IsHitKeyUsed(fpWData->Hit(hit).FrontKey()) = 1;
+        fpWData->IsHitKeyUsed(fpWData->Hit(hit).BackKey())  = 1;
       }
       continue;
     }
@@ -863,8 +1039,8 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std
         }
         // mark remaining hits as used
         for (const auto& hit : track) {
-          frWData.IsHitKeyUsed(frWData.Hit(hit).FrontKey()) = 1;
-          frWData.IsHitKeyUsed(frWData.Hit(hit).BackKey())  = 1;
+          fpWData->IsHitKeyUsed(fpWData->Hit(hit).FrontKey()) = 1;
+          fpWData->IsHitKeyUsed(fpWData->Hit(hit).BackKey())  = 1;
         }
         continue;
       }
@@ -885,13 +1061,13 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std
         for (std::size_t iBegHit = 0; iBegHit < begTrack.size(); iBegHit++) {
           const auto begHit = begTrack[iBegHit];
           if (begHit == usedHitIDs[0]) continue;  // dont let exact hit be borrowed.
-          if (frWData.Hit(begHit).FrontKey() == frWData.Hit(usedHitIDs[0]).FrontKey()
-              || frWData.Hit(begHit).BackKey() == frWData.Hit(usedHitIDs[0]).BackKey()) {  // only one track will match
+          if (fpWData->Hit(begHit).FrontKey() == fpWData->Hit(usedHitIDs[0]).FrontKey()  // only one track will match
+              || fpWData->Hit(begHit).BackKey() == fpWData->Hit(usedHitIDs[0]).BackKey()) {
             // remove iBegHit from begTrack
             begTrack.erase(begTrack.begin() + iBegHit);
             // reset hit flags. Will be reset by beggar
-            frWData.IsHitKeyUsed(frWData.Hit(begHit).FrontKey()) = 0;
-            frWData.IsHitKeyUsed(frWData.Hit(begHit).BackKey())  = 0;
+            fpWData->IsHitKeyUsed(fpWData->Hit(begHit).FrontKey()) = 0;
+            fpWData->IsHitKeyUsed(fpWData->Hit(begHit).BackKey())  = 0;
 
             remove = false;
             break;
@@ -907,8 +1083,8 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionCPU(std::vector<std::pair<std
     }
     // mark all hits as used
     for (const auto& hit : track) {
-      frWData.IsHitKeyUsed(frWData.Hit(hit).FrontKey()) = 1;
-      frWData.IsHitKeyUsed(frWData.Hit(hit).BackKey())  = 1;
+      fpWData->IsHitKeyUsed(fpWData->Hit(hit).FrontKey()) = 1;
+      fpWData->IsHitKeyUsed(fpWData->Hit(hit).BackKey())  = 1;
     }
   }
 }
@@ -955,17 +1131,24 @@ void GnnGpuTrackFinderSetup::CooperativeCompetitionGPU(std::vector<std::pair<std
     fQueue.copy(fGraphConstructor.fTrackNumHits, xpu::h2d);
     fQueue.copy(fGraphConstructor.fSelectedTrackIndexes, xpu::h2d);
 
-    const int numKeyFlags = frWData.HitKeyFlags().size();
+    const int numKeyFlags = fpWData->HitKeyFlags().size();
     fGraphConstructor.fHitKeyFlags.reset(numKeyFlags, xpu::buf_io);
     xpu::h_view vfHitKeyFlags{fGraphConstructor.fHitKeyFlags};
-    std::copy_n(frWData.HitKeyFlags().begin(), numKeyFlags, &vfHitKeyFlags[0]);
+    std::copy_n(fpWData->HitKeyFlags().begin(), numKeyFlags, &vfHitKeyFlags[0]);
     fQueue.copy(fGraphConstructor.fHitKeyFlags, xpu::h2d);
   }
 
   xpu::set<strGnnGpuGraphConstructor>(fGraphConstructor);  // set memory on gpu
   // LOG(info) << "Data prepared for GPU.";
 
+  if constexpr (constants::gpu::GnnGpuProfiling) {
+    xpu::push_timer("CompetitionKernel_time");
+  }
   fQueue.launch<Competition>(xpu::n_blocks(1));
+  if constexpr (constants::gpu::GnnGpuProfiling) {
+    fEventTimeMonitor.CompetitionKernel_time[fIteration] = xpu::pop_timer();
+    fNCompetitionTracks                                  = numTracks;
+  }
   // LOG(info) << "GPU competition done.";
 
   // copy trackAndScores back to CPU
@@ -1018,7 +1201,7 @@ void GnnGpuTrackFinderSetup::FitTracklets(std::vector<std::vector<int>>& trackle
 
   for (const auto& trackCand : tracklets) {
     for (const auto& hit : trackCand) {
-      const int hitID = frWData.Hit(hit).Id();  // get hit id in fInputData
+      const int hitID = fpWData->Hit(hit).Id();  // get hit id in fInputData
       GNNTrackHits.push_back(hitID);
     }
     Track t;
@@ -1026,7 +1209,7 @@ void GnnGpuTrackFinderSetup::FitTracklets(std::vector<std::vector<int>>& trackle
     GNNTrackCandidates.push_back(t);
   }
 
-  frTrackFitter.FitGNNTracklets(frInput, frWData, GNNTrackCandidates, GNNTrackHits, selectedTrackIndexes,
+  frTrackFitter.FitGNNTracklets(frInput, *fpWData, GNNTrackCandidates, GNNTrackHits, selectedTrackIndexes,
                                 selectedTrackScores, selectedTrackFitParams, 3);
   // LOG(info) << "Candidate tracks fitted with KF.";
 
@@ -1053,23 +1236,49 @@ void GnnGpuTrackFinderSetup::FitTracklets(std::vector<std::vector<int>>& trackle
   LOG(info) << "Tracks after fitting: " << trackletScores.size();
 }  // FitTracklets
 
-void GnnGpuTrackFinderSetup::SetupGNN(const int iteration)
+void GnnGpuTrackFinderSetup::ClearBatch()
 {
-  const int nStations = fParameters.GetNstationsActive();
-
-  // get active hits from all hits
   activeHits.clear();
   activeHits.reserve(10000);
   activeToWDataMapping.clear();
   activeToWDataMapping.reserve(10000);
-  for (auto i = 0; i < frWData.Hits().size(); i++) {
-    if (!(frWData.IsHitKeyUsed(frWData.Hit(i).FrontKey())
-          || frWData.IsHitKeyUsed(frWData.Hit(i).BackKey()))) {  // true when hit active
-      activeHits.push_back(frWData.Hit(i));
+  fvBatchWindows.clear();
+}
+
+void GnnGpuTrackFinderSetup::AddBatchWindow(WindowData& wData)
+{
+  SetWindow(wData);
+
+  // get active hits from all hits
+  BatchWindow window{&wData, static_cast<int>(activeHits.size()), 0};
+  for (auto i = 0; i < fpWData->Hits().size(); i++) {
+    if (!(fpWData->IsHitKeyUsed(fpWData->Hit(i).FrontKey())
+          || fpWData->IsHitKeyUsed(fpWData->Hit(i).BackKey()))) {  // true when hit active
+      activeHits.push_back(fpWData->Hit(i));
       activeToWDataMapping.push_back(i);
     }
   }
-  const int NHits = activeHits.size();
+  window.fNHits = activeHits.size() - window.fFirstHit;
+  fvBatchWindows.push_back(window);
+
+  // A single window keeps the number of hits of its grid, set in SetupGrid
+  if (fvBatchWindows.size() > 1) {
+    fNHits = activeHits.size();
+  }
+}
+
+void GnnGpuTrackFinderSetup::SetWindow(WindowData& wData)
+{
+  if (&wData == fpWData) return;
+  fpWData->HitKeyFlags().swap(wData.HitKeyFlags());
+  fpWData = &wData;
+}
+
+void GnnGpuTrackFinderSetup::SetupGNN(const int iteration)
+{
+  const int nStations = fParameters.GetNstationsActive();
+  const int nWindows  = fvBatchWindows.size();
+  const int NHits     = activeHits.size();
 
   if (iteration == 0) {
     fGraphConstructor.fvHitsAll.reset(NHits, xpu::buf_io);
@@ -1183,25 +1392,32 @@ void GnnGpuTrackFinderSetup::SetupGNN(const int iteration)
     fGraphConstructor.fTripletsSelected_Other.reset(NHits, xpu::buf_io);
   }
 
-  // Set starting index of hits for each station
-  fGraphConstructor.fIndexFirstHitStation.reset(nStations + 1, xpu::buf_io);
+  // Set starting index of hits for each station, (nStations + 1) entries per window of the batch
+  fGraphConstructor.fIndexFirstHitStation.reset(nWindows * (nStations + 1), xpu::buf_io);
+  fGraphConstructor.fvHitWindow.reset(NHits, xpu::buf_io);
   xpu::h_view fvIndexFirstHitStation{fGraphConstructor.fIndexFirstHitStation};
-  int iHit                        = 0;
-  int lastSta                     = 0;
-  fvIndexFirstHitStation[lastSta] = 0;
-  for (const auto& hit : activeHits) {
-    // LOG(info) << "Hit: " << iHit << " , Station: " << hit.Station(); // hits ordered by Station
-    const int curSta = hit.Station();
-    if (curSta > lastSta) {
-      for (int iSta = lastSta + 1; iSta <= curSta; iSta++)
-        fvIndexFirstHitStation[iSta] = iHit;
-      lastSta = curSta;
+  xpu::h_view vfvHitWindow{fGraphConstructor.fvHitWindow};
+  for (int iWindow = 0; iWindow < nWindows; iWindow++) {
+    const auto& window                 = fvBatchWindows[iWindow];
+    unsigned int* indexFirstHitStation = &fvIndexFirstHitStation[iWindow * (nStations + 1)];
+    int iHit                           = window.fFirstHit;
+    int lastSta                        = 0;
+    indexFirstHitStation[lastSta]      = iHit;
+    for (; iHit < window.fFirstHit + window.fNHits; iHit++) {
+      // LOG(info) << "Hit: " << iHit << " , Station: " << activeHits[iHit].Station(); // hits ordered by Station
+      const int curSta = activeHits[iHit].Station();
+      if (curSta > lastSta) {
+        for (int iSta = lastSta + 1; iSta <= curSta; iSta++)
+          indexFirstHitStation[iSta] = iHit;
+        lastSta = curSta;
+      }
+      vfvHitWindow[iHit] = iWindow;
     }
-    iHit++;
+    for (int iSta = lastSta + 1; iSta <= nStations; iSta++)
+      indexFirstHitStation[iSta] = iHit;
   }
-  for (int iSta = lastSta + 1; iSta <= nStations; iSta++)
-    fvIndexFirstHitStation[iSta] = iHit;
   fQueue.copy(fGraphConstructor.fIndexFirstHitStation, xpu::h2d);
+  fQueue.copy(fGraphConstructor.fvHitWindow, xpu::h2d);
 
   // for (int iSta = 0; iSta <= nStations; iSta++) {
   //   LOG(info) << "First hit index on station " << iSta << ": " << fvIndexFirstHitStation[iSta];
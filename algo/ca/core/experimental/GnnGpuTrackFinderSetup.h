@@ -16,11 +16,14 @@
 #include "CandClassifier.h"
 #include "EmbedNet.h"
 #include "GnnGpuGraphConstructor.h"
+#include "GnnGpuProfiler.h"
 #include "KfTrackParam.h"
 #include "MLPutil.h"
 
 #include <xpu/host.h>
 
+#include <array>
+
 namespace cbm::algo::ca
 {
   class GnnGpuTrackFinderSetup {
@@ -67,7 +70,23 @@ namespace cbm::algo::ca
     /// Run the track finding algorithm chain
     void RunGpuTracking();
 
-    /// Load embed weights and set up for embedding hits
+    /// Start a new batch of time windows
+    void ClearBatch();
+
+    /// Add the active hits of a time window to the batch
+    /// \param wData  Window data, becomes the current window
+    ///
+    /// For a batch of several windows, the number of hits of the kernel chain is set to the number of active hits of
+    /// the batch. A single window keeps the number of hits of its grid.
+    void AddBatchWindow(WindowData& wData);
+
+    /// Make a window of the batch the current one
+    ///
+    /// The windows of a batch share one set of hit key flags. They are handed over (swapped, not copied) to the
+    /// current window, so that the flags always reflect the tracks stored by the previous windows.
+    void SetWindow(WindowData& wData);
+
+    /// Load embed weights and set up for embedding hits of all windows of the batch
     void SetupGNN(const int iteration);
 
     /// Save doublets as tracks for debugging
@@ -86,7 +105,8 @@ namespace cbm::algo::ca
     void FitTracklets(std::vector<std::vector<int>>& tracklets, std::vector<float>& trackletScores,
                       std::vector<std::vector<float>>& trackletFitParams);
 
-    void FindTracks(const int iteration, const bool doCompetition);
+    /// Build tracks from the fitted triplets of the active hits [iHitBegin, iHitEnd) of the current window
+    void FindTracks(const int iteration, const bool doCompetition, int iHitBegin, int iHitEnd);
 
     /// Get the number of triplets
     unsigned int GetNofTriplets() const { return fNTriplets; }
@@ -94,18 +114,46 @@ namespace cbm::algo::ca
     /// Get timings
     XpuTimings& GetTimings() { return fEventTimeMonitor; }
 
+    /// Set the profiler collecting per-kernel bytes and FLOPs (constants::gpu::GnnGpuProfiling)
+    void SetProfiler(GnnGpuProfiler* profiler);
+
    private:
+    /// Launch the graph construction kernels over all hits one after another on fQueue
+    void RunKernelsSerial();
+
+    /// Launch the graph construction kernels per station group on separate queues (Parameters::GetGnnGpuNofStreams),
+    /// so that the groups run concurrently
+    void RunKernelsPipelined();
+
+    /// Queues of the station groups
+    ///
+    /// Creating a queue is expensive, so the queues are created on the first use of the pipeline and reused by all
+    /// later windows processed by the same thread.
+    static std::array<xpu::queue, constants::gpu::GnnMaxNofStreams>& StreamQueues();
+
+    /// \brief Time window processed within a batch
+    struct BatchWindow {
+      WindowData* fpWData;  ///< Window data
+      int fFirstHit;        ///< Index of the first active hit of the window in fvHits
+      int fNHits;           ///< Number of active hits of the window
+    };
+
+    /// Estimate bytes and FLOPs of the kernels of the current iteration from the element counts read back with the
+    /// kernel output and add them to the profiler
+    void ProfileKernels();
+
     const Parameters<fvec>& fParameters;           ///< Object of Framework parameters class
-    WindowData& frWData;                           ///< Reference to the window data
+    WindowData* fpWData;                           ///< Current window data
     xpu::queue fQueue;                             ///< GPU queue TODO: initialization is ~220 ms. Why and how to avoid?
     ca::GnnGpuGraphConstructor fGraphConstructor;  ///< GPU graph constructor
     TrackFitter& frTrackFitter;
     const ca::InputData& frInput;
     unsigned int fIteration;  ///< Iteration number
 
-    int fNHits;                             ///< Number of active hits
-    std::vector<ca::Hit> activeHits;        ///< active hits in this iteration
-    std::vector<int> activeToWDataMapping;  ///< index of activeHit in window data
+    int fNHits;                               ///< Number of active hits
+    std::vector<ca::Hit> activeHits;          ///< active hits in this iteration
+    std::vector<int> activeToWDataMapping;    ///< index of activeHit in window data
+    std::vector<BatchWindow> fvBatchWindows;  ///< windows whose active hits are packed into activeHits
 
     int fNTriplets;  ///< Number of triplets
 
@@ -113,5 +161,9 @@ namespace cbm::algo::ca
     const float CandClassifierThreshold_ = 0.5;
 
     XpuTimings fEventTimeMonitor;
+
+    GnnGpuProfiler* fpProfiler = nullptr;  ///< Kernel profiler, nullptr if profiling is disabled
+    int fProfilerWindow        = 0;        ///< Index of the time window in the profiler
+    int fNCompetitionTracks    = 0;        ///< Number of tracks passed to the Competition kernel
   };
 }  // namespace cbm::algo::ca
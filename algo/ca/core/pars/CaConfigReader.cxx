@@ -126,6 +126,12 @@ void ConfigReader::Read()
     GetNode([](YAML::Node n) { return n["core"]["track_finder"]["max_doublets_per_singlet"]; }).as<unsigned int>());
   fpInitManager->SetMaxTripletPerDoublets(
     GetNode([](YAML::Node n) { return n["core"]["track_finder"]["max_triplets_per_doublet"]; }).as<unsigned int>());
+  if (auto node = GetNode([](YAML::Node n) { return n["core"]["track_finder"]["gnn_gpu_nof_streams"]; }, true)) {
+    fpInitManager->SetGnnGpuNofStreams(node.as<int>());
+  }
+  if (auto node = GetNode([](YAML::Node n) { return n["core"]["track_finder"]["gnn_gpu_batch_size"]; }, true)) {
+    fpInitManager->SetGnnGpuBatchSize(node.as<int>());
+  }
 
   ReadMisalignmentTolerance();
 
@@ -117,6 +117,9 @@ namespace cbm::algo::ca::constants
     constexpr bool CpuSortTriplets       = true;   ///< Flag: use CPU for sorting triplets
     constexpr bool GnnTracking           = true;   ///< Flag: use GNN for tracking
     constexpr bool GnnGpuTracking        = false;  ///< Flag: use GPU GNN for tracking
+    constexpr int GnnMaxNofStreams       = 4;      ///< Max number of XPU queues for the GNN station groups
+    constexpr bool GnnGpuProfiling       = false;  ///< Flag: write per-kernel bytes/FLOPs report of GNN GPU tracking
+    constexpr int GnnMaxBatchSize        = 16;     ///< Max number of time windows per GNN GPU kernel chain
   }  // namespace gpu
 
   /// \brief Undefined values
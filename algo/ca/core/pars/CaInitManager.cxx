@@ -87,6 +87,8 @@ namespace cbm::algo::ca
     // Clear other flags
     fParameters.fRandomSeed       = 1;
     fParameters.fGhostSuppression = 0;
+    fParameters.fGnnGpuNofStreams = 1;
+    fParameters.fGnnGpuBatchSize  = 1;
     fInitController.SetFlag(EInitKey::kRandomSeed, false);
     fInitController.SetFlag(EInitKey::kGhostSuppression, false);
 
@@ -473,6 +475,32 @@ namespace cbm::algo::ca
     fInitController.SetFlag(EInitKey::kGhostSuppression);
   }
 
+  // --------------------------------------------------------------------------------------------------------------------
+  //
+  void InitManager::SetGnnGpuNofStreams(int nStreams)
+  {
+    if (nStreams < 1 || nStreams > constants::gpu::GnnMaxNofStreams) {
+      std::stringstream msg;
+      msg << "ca::InitManager::SetGnnGpuNofStreams: number of queues " << nStreams << " is out of range [1, "
+          << constants::gpu::GnnMaxNofStreams << "]";
+      throw std::runtime_error(msg.str());
+    }
+    fParameters.fGnnGpuNofStreams = nStreams;
+  }
+
+  // --------------------------------------------------------------------------------------------------------------------
+  //
+  void InitManager::SetGnnGpuBatchSize(int nWindows)
+  {
+    if (nWindows < 1 || nWindows > constants::gpu::GnnMaxBatchSize) {
+      std::stringstream msg;
+      msg << "ca::InitManager::SetGnnGpuBatchSize: number of time windows " << nWindows << " is out of range [1, "
+          << constants::gpu::GnnMaxBatchSize << "]";
+      throw std::runtime_error(msg.str());
+    }
+    fParameters.fGnnGpuBatchSize = nWindows;
+  }
+
   // --------------------------------------------------------------------------------------------------------------------
   //
   void InitManager::SetRandomSeed(unsigned int seed)
@@ -260,6 +260,15 @@ namespace cbm::algo::ca
     /// \brief Sets upper-bound cut on max number of triplets per one doublet
     void SetMaxTripletPerDoublets(unsigned int value) { fParameters.fMaxTripletPerDoublets = value; }
 
+    /// \brief Sets number of XPU queues for the station groups of the GNN GPU track finder
+    /// \param nStreams  Number of queues, 1 (default) launches the kernels serially on one queue
+    void SetGnnGpuNofStreams(int nStreams);
+
+    /// \brief Sets number of consecutive time windows processed by one GNN GPU kernel chain
+    /// \param nWindows  Number of windows, 1 (default) processes each window separately
+    /// \note  A batch does not reproduce the per-window output exactly, see the CA parameter config for details
+    void SetGnnGpuBatchSize(int nWindows);
+
     /// \brief Sets setup
     /// \tparam  Underlying type of the setup
     template<typename DataT>
@@ -311,6 +311,8 @@ std::string Parameters<DataT>::ToString(int verbosity, int indentLevel) const
   msg << indent << indentCh << "Random seed:                        " << fRandomSeed << '\n';
   msg << indent << indentCh << "Max number of doublets per singlet: " << fMaxDoubletsPerSinglet << '\n';
   msg << indent << indentCh << "Max number of triplets per doublet: " << fMaxTripletPerDoublets << '\n';
+  msg << indent << indentCh << "GNN GPU station group queues:       " << fGnnGpuNofStreams << '\n';
+  msg << indent << indentCh << "GNN GPU time windows per batch:     " << fGnnGpuBatchSize << '\n';
   msg << indent << indentCh << "Ghost suppression:                   " << fGhostSuppression << '\n';
   msg << indent << clrs::CLb << "CA TRACK FINDER ITERATIONS:\n" << clrs::CL;
   msg << Iteration::ToTableFromVector(fCAIterations);
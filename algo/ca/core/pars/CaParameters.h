@@ -76,6 +76,8 @@ namespace cbm::algo::ca
       , fActiveSetup(other.GetActiveSetup())
       , fMaxDoubletsPerSinglet(other.GetMaxDoubletsPerSinglet())
       , fMaxTripletPerDoublets(other.GetMaxTripletPerDoublets())
+      , fGnnGpuNofStreams(other.GetGnnGpuNofStreams())
+      , fGnnGpuBatchSize(other.GetGnnGpuBatchSize())
       , fCAIterations(other.GetCAIterations())
       , fVertexFieldValue(other.GetVertexFieldValue())
       , fVertexFieldRegion(other.GetVertexFieldRegion())
@@ -131,6 +133,12 @@ namespace cbm::algo::ca
     /// \brief Gets upper-bound cut on max number of triplets per one doublet
     unsigned int GetMaxTripletPerDoublets() const { return fMaxTripletPerDoublets; }
 
+    /// \brief Gets number of XPU queues for the station groups of the GNN GPU track finder (1: serial launch)
+    int GetGnnGpuNofStreams() const { return fGnnGpuNofStreams; }
+
+    /// \brief Gets number of time windows per GNN GPU kernel chain (1: no batching)
+    int GetGnnGpuBatchSize() const { return fGnnGpuBatchSize; }
+
     /// \brief Gets total number of active stations
     int GetNstationsActive() const { return fNstationsActiveTotal; }
 
@@ -315,6 +323,26 @@ namespace cbm::algo::ca
 
     bool DevIsParSearchWUsed() const { return fDevIsParSearchWUsed; }
 
+    /// \brief Stores the parameters together with the KF-setups
+    /// \note  The KF-setups are not a part of the regular serialization, because they are provided by a separate file
+    ///        and completed by the InitManager. This pair of methods stores the fully initialized parameters.
+    template<class Archive>
+    void SaveWithSetups(Archive& ar) const
+    {
+      ar << *this;
+      ar << fGeometrySetup;
+      ar << fActiveSetup;
+    }
+
+    /// \brief Loads the parameters together with the KF-setups, stored with SaveWithSetups
+    template<class Archive>
+    void LoadWithSetups(Archive& ar)
+    {
+      ar >> *this;
+      ar >> fGeometrySetup;
+      ar >> fActiveSetup;
+    }
+
    private:
     /// \brief Geometrical KF-setup (including inactive stations)
     kf::Setup<DataT> fGeometrySetup{kf::EFieldMode::Intrpl};
@@ -324,6 +352,8 @@ namespace cbm::algo::ca
 
     unsigned int fMaxDoubletsPerSinglet{150};  ///< Upper-bound cut on max number of doublets per one singlet
     unsigned int fMaxTripletPerDoublets{15};   ///< Upper-bound cut on max number of triplets per one doublet
+    int fGnnGpuNofStreams{1};                  ///< Number of XPU queues for the GNN GPU station groups
+    int fGnnGpuBatchSize{1};                   ///< Number of time windows per GNN GPU kernel chain
 
     alignas(constants::misc::Alignment) IterationsContainer_t fCAIterations{
       "ca::Parameters::fCAIterations"};  ///< L1 tracking iterations vector
@@ -448,6 +478,9 @@ namespace cbm::algo::ca
       ar& fDevIsMatchTripletsViaMc;
       ar& fDevIsExtendTracksViaMc;
       ar& fDevIsSuppressOverlapHitsViaMc;
+
+      ar& fGnnGpuNofStreams;
+      ar& fGnnGpuBatchSize;
     }
   };
 }  // namespace cbm::algo::ca
@@ -15,7 +15,9 @@
 #include "CaVector.h"
 #include "KfTrackKalmanFilter.h"
 
+#include <algorithm>
 #include <iostream>
+#include <tuple>
 
 namespace cbm::algo::ca
 {
@@ -36,14 +38,34 @@ namespace cbm::algo::ca
     Vector<Track>& extTracks            = wData.RecoTracks();
     Vector<ca::HitIndex_t>& extRecoHits = wData.RecoHitIndices();
 
-    Vector<unsigned short>& firstStation = fTrackFirstStation;
-    Vector<unsigned short>& lastStation  = fTrackLastStation;
-    Vector<ca::HitIndex_t>& firstHit     = fTrackFirstHit;
-    Vector<ca::HitIndex_t>& lastHit      = fTrackLastHit;
-    Vector<unsigned short>& neighbour    = fTrackNeighbour;
-    Vector<fscal>& trackChi2             = fTrackChi2;
-    Vector<char>& isStored               = fTrackIsStored;
-    Vector<char>& isDownstreamNeighbour  = fTrackIsDownstreamNeighbour;
+    const int nTracks = extTracks.size();
+    fTrackFirstStation.reset(nTracks);
+    fTrackLastStation.reset(nTracks);
+
+    ca::HitIndex_t start_hit = 0;
+
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      fTrackFirstStation[iTr] = input.GetHit(extRecoHits[start_hit]).Station();
+      start_hit += extTracks[iTr].fNofHits;
+      fTrackLastStation[iTr] = input.GetHit(extRecoHits[start_hit - 1]).Station();
+    }
+
+    MergeTracks(extTracks, extRecoHits, fTrackFirstStation, fTrackLastStation, fParameters.GetStations(),
+                fParameters.GetNstationsActive());
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void CloneMerger::MergeTracks(Vector<Track>& extTracks, Vector<ca::HitIndex_t>& extRecoHits,
+                                const Vector<unsigned short>& firstStation, const Vector<unsigned short>& lastStation,
+                                const StationsContainer_t<fvec>& stations, int nStations)
+  {
+    Vector<ca::HitIndex_t>& firstHit    = fTrackFirstHit;
+    Vector<ca::HitIndex_t>& lastHit     = fTrackLastHit;
+    Vector<unsigned short>& neighbour   = fTrackNeighbour;
+    Vector<fscal>& trackChi2            = fTrackChi2;
+    Vector<char>& isStored              = fTrackIsStored;
+    Vector<char>& isDownstreamNeighbour = fTrackIsDownstreamNeighbour;
 
     int nTracks = extTracks.size();
 
@@ -56,8 +78,6 @@ namespace cbm::algo::ca
     fRecoHitsNew.clear();
     fRecoHitsNew.reserve(extRecoHits.size());
 
-    firstStation.reset(nTracks);
-    lastStation.reset(nTracks);
     firstHit.reset(nTracks);
     lastHit.reset(nTracks);
     isStored.reset(nTracks);
@@ -68,11 +88,9 @@ namespace cbm::algo::ca
     ca::HitIndex_t start_hit = 0;
 
     for (int iTr = 0; iTr < nTracks; iTr++) {
-      firstHit[iTr]     = start_hit;
-      firstStation[iTr] = input.GetHit(extRecoHits[start_hit]).Station();
+      firstHit[iTr] = start_hit;
       start_hit += extTracks[iTr].fNofHits - 1;
-      lastHit[iTr]     = start_hit;
-      lastStation[iTr] = input.GetHit(extRecoHits[start_hit]).Station();
+      lastHit[iTr] = start_hit;
       start_hit++;
 
       isStored[iTr]              = false;
@@ -81,91 +99,38 @@ namespace cbm::algo::ca
       isDownstreamNeighbour[iTr] = false;
     }
 
-    kf::TrackKalmanFilter<fvec> fitB;
-    fitB.SetParticleMass(fDefaultMass);
-    fitB.SetMask(fmask::One());
-    fitB.SetQp0(fvec(0.));
-
-    kf::TrackKalmanFilter<fvec> fitF;
-    fitF.SetParticleMass(fDefaultMass);
-    fitF.SetMask(fmask::One());
-    fitF.SetQp0(fvec(0.));
-
-    TrackParamV& Tb = fitB.Tr();
-    TrackParamV& Tf = fitF.Tr();
-    kf::FieldValue<fvec> fBm, fBb, fBf _fvecalignment;
-    kf::FieldRegion<fvec> fld _fvecalignment;
-
     // Max length for merging
-    unsigned char maxLengthForMerge = static_cast<unsigned char>(fParameters.GetNstationsActive() - 3);
+    unsigned char maxLengthForMerge = static_cast<unsigned char>(nStations - 3);
 
-    for (int iTr = 0; iTr < nTracks; iTr++) {
-      if (extTracks[iTr].fNofHits > maxLengthForMerge) continue;
-      for (int jTr = 0; jTr < nTracks; jTr++) {
-        if (extTracks[jTr].fNofHits > maxLengthForMerge) continue;
-        if (iTr == jTr) continue;
-        if (firstStation[iTr] <= lastStation[jTr]) continue;
-
-        unsigned short stab = firstStation[iTr];
-
-        Tb.Set(extTracks[iTr].fParFirst);
+    // Collect the pairs of a downstream track iTr and an upstream track jTr, which can be merged
+    CollectCandidates(extTracks, firstStation, lastStation, nStations, maxLengthForMerge);
 
-        fitB.SetQp0(fitB.Tr().GetQp());
+    // Calculate chi2 of the candidate pairs
+    CalculateCandidateChi2(extTracks, firstStation, lastStation, stations, nStations);
 
-        unsigned short staf = lastStation[jTr];
+    // Select the best neighbours. The candidates are ordered by (iTr, jTr), as the selection depends on the order
+    for (const auto& candidate : fCandidates) {
+      if (candidate.chi2 > 50) continue;
 
-        Tf.Set(extTracks[jTr].fParLast);
-        fitF.SetQp0(fitF.Tr().GetQp());
-
-        if (Tf.NdfTime()[0] >= 0. && Tb.NdfTime()[0] >= 0.) {
-          if (fabs(Tf.GetTime()[0] - Tb.GetTime()[0]) > 3 * sqrt(Tf.C55()[0] + Tb.C55()[0])) continue;
+      const int iTr = candidate.iTr;
+      const int jTr = candidate.jTr;
+      if (candidate.chi2 < trackChi2[iTr] || candidate.chi2 < trackChi2[jTr]) {
+        if (neighbour[iTr] < kNoNeighbour) {
+          neighbour[neighbour[iTr]]             = kNoNeighbour;
+          trackChi2[neighbour[iTr]]             = 100000.;
+          isDownstreamNeighbour[neighbour[iTr]] = false;
         }
-
-        unsigned short stam;
-
-        fBf = fParameters.GetStation(staf).fieldSlice.GetFieldValue(Tf.X(), Tf.Y());
-        fBb = fParameters.GetStation(stab).fieldSlice.GetFieldValue(Tb.X(), Tb.Y());
-
-        unsigned short dist = firstStation[iTr] - lastStation[jTr];
-
-        if (dist > 1)
-          stam = staf + 1;
-        else
-          stam = staf - 1;
-
-        fvec zm = fParameters.GetStation(stam).fZ;
-        fvec xm = fvec(0.5) * (Tf.GetX() + Tf.Tx() * (zm - Tf.Z()) + Tb.GetX() + Tb.Tx() * (zm - Tb.Z()));
-        fvec ym = fvec(0.5) * (Tf.Y() + Tf.Ty() * (zm - Tf.Z()) + Tb.Y() + Tb.Ty() * (zm - Tb.Z()));
-        fBm     = fParameters.GetStation(stam).fieldSlice.GetFieldValue(xm, ym);
-        fld.Set(fBb, Tb.Z(), fBm, zm, fBf, Tf.Z());
-
-        fvec zMiddle = fvec(0.5) * (Tb.Z() + Tf.Z());
-
-        fitF.Extrapolate(zMiddle, fld);
-        fitB.Extrapolate(zMiddle, fld);
-
-        fvec Chi2Tracks(0.);
-        FilterTracks(&(Tf.X()), &(Tf.C00()), &(Tb.X()), &(Tb.C00()), nullptr, nullptr, &Chi2Tracks);
-        if (Chi2Tracks[0] > 50) continue;
-
-        if (Chi2Tracks[0] < trackChi2[iTr] || Chi2Tracks[0] < trackChi2[jTr]) {
-          if (neighbour[iTr] < kNoNeighbour) {
-            neighbour[neighbour[iTr]]             = kNoNeighbour;
-            trackChi2[neighbour[iTr]]             = 100000.;
-            isDownstreamNeighbour[neighbour[iTr]] = false;
-          }
-          if (neighbour[jTr] < kNoNeighbour) {
-            neighbour[neighbour[jTr]]             = kNoNeighbour;
-            trackChi2[neighbour[jTr]]             = 100000.;
-            isDownstreamNeighbour[neighbour[jTr]] = false;
-          }
-          neighbour[iTr]             = jTr;
-          neighbour[jTr]             = iTr;
-          trackChi2[iTr]             = Chi2Tracks[0];
-          trackChi2[jTr]             = Chi2Tracks[0];
-          isDownstreamNeighbour[iTr] = true;
-          isDownstreamNeighbour[jTr] = false;
+        if (neighbour[jTr] < kNoNeighbour) {
+          neighbour[neighbour[jTr]]             = kNoNeighbour;
+          trackChi2[neighbour[jTr]]             = 100000.;
+          isDownstreamNeighbour[neighbour[jTr]] = false;
         }
+        neighbour[iTr]             = jTr;
+        neighbour[jTr]             = iTr;
+        trackChi2[iTr]             = candidate.chi2;
+        trackChi2[jTr]             = candidate.chi2;
+        isDownstreamNeighbour[iTr] = true;
+        isDownstreamNeighbour[jTr] = false;
       }
     }
 
@@ -198,6 +163,181 @@ namespace cbm::algo::ca
     extRecoHits = std::move(fRecoHitsNew);
   }
 
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void CloneMerger::CollectCandidates(const Vector<Track>& extTracks, const Vector<unsigned short>& firstStation,
+                                      const Vector<unsigned short>& lastStation, int nStations,
+                                      unsigned char maxLengthForMerge)
+  {
+    const int nTracks = extTracks.size();
+
+    auto isTimed = [](const Track::TrackParam_t& par) { return par.NdfTime() >= 0.; };
+
+    // Sort the short tracks by the last station, and within a station the tracks without time first, then the tracks
+    // with time ordered by time
+    fTracksByLastStation.clear();
+    fTracksByLastStation.reserve(nTracks);
+    for (int jTr = 0; jTr < nTracks; jTr++) {
+      if (extTracks[jTr].fNofHits > maxLengthForMerge) continue;
+      fTracksByLastStation.push_back_no_warning(jTr);
+    }
+    auto byStationAndTime = [&](int a, int b) {
+      const auto& parA = extTracks[a].fParLast;
+      const auto& parB = extTracks[b].fParLast;
+      if (lastStation[a] != lastStation[b]) return lastStation[a] < lastStation[b];
+      if (isTimed(parA) != isTimed(parB)) return !isTimed(parA);
+      return isTimed(parA) && parA.GetTime() < parB.GetTime();
+    };
+    std::sort(fTracksByLastStation.begin(), fTracksByLastStation.end(), byStationAndTime);
+
+    fLastStationOffset.reset(nStations + 1, 0);
+    fLastStationTimedBegin.reset(nStations, 0);
+    fLastStationMaxC55.reset(nStations, 0.);
+    for (int jTr : fTracksByLastStation) {
+      const int iSta = lastStation[jTr];
+      fLastStationOffset[iSta + 1]++;
+      if (!isTimed(extTracks[jTr].fParLast)) {
+        fLastStationTimedBegin[iSta]++;
+      }
+      else {
+        fLastStationMaxC55[iSta] = std::max(fLastStationMaxC55[iSta], extTracks[jTr].fParLast.C55());
+      }
+    }
+    for (int iSta = 0; iSta < nStations; iSta++) {
+      fLastStationOffset[iSta + 1] += fLastStationOffset[iSta];
+      fLastStationTimedBegin[iSta] += fLastStationOffset[iSta];
+    }
+
+    // Find the upstream partners of each downstream track only among the tracks ending before its first station
+    // and, if both tracks have time, within the time window
+    fCandidates.clear();
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      if (extTracks[iTr].fNofHits > maxLengthForMerge) continue;
+
+      const auto& parB     = extTracks[iTr].fParFirst;
+      const bool iTimed    = isTimed(parB);
+      const int iFirstCand = fCandidates.size();
+      for (int iSta = 0; iSta < firstStation[iTr]; iSta++) {
+        const auto untimedBegin = fTracksByLastStation.cbegin() + fLastStationOffset[iSta];
+        const auto timedBegin   = fTracksByLastStation.cbegin() + fLastStationTimedBegin[iSta];
+        const auto timedEnd     = fTracksByLastStation.cbegin() + fLastStationOffset[iSta + 1];
+
+        for (auto jTr = untimedBegin; jTr != timedBegin; jTr++) {
+          fCandidates.push_back_no_warning(Candidate{iTr, *jTr, 0.});
+        }
+        if (!iTimed) {
+          for (auto jTr = timedBegin; jTr != timedEnd; jTr++) {
+            fCandidates.push_back_no_warning(Candidate{iTr, *jTr, 0.});
+          }
+          continue;
+        }
+
+        // The window is an upper bound of the exact cut below, enlarged against rounding
+        const fscal time   = parB.GetTime();
+        const fscal window = 1.001f * 3 * sqrt(parB.C55() + fLastStationMaxC55[iSta]) + 1.e-6f * std::fabs(time);
+        auto jTr           = std::lower_bound(timedBegin, timedEnd, time - window, [&](int j, fscal t) {
+          return extTracks[j].fParLast.GetTime() < t;
+        });
+        for (; jTr != timedEnd && extTracks[*jTr].fParLast.GetTime() <= time + window; jTr++) {
+          const auto& parF = extTracks[*jTr].fParLast;
+          if (fabs(parF.GetTime() - parB.GetTime()) > 3 * sqrt(parF.C55() + parB.C55())) continue;
+          fCandidates.push_back_no_warning(Candidate{iTr, *jTr, 0.});
+        }
+      }
+      std::sort(fCandidates.begin() + iFirstCand, fCandidates.end(),
+                [](const Candidate& a, const Candidate& b) { return a.jTr < b.jTr; });
+    }
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void CloneMerger::CalculateCandidateChi2(const Vector<Track>& extTracks, const Vector<unsigned short>& firstStation,
+                                           const Vector<unsigned short>& lastStation,
+                                           const StationsContainer_t<fvec>& stations, int nStations)
+  {
+    // Group the candidates by the station pair, so that all the entries of a SIMD vector share the field slices, and
+    // by the z of the track parameters, so that all the entries take the same extrapolation steps
+    auto groupKey = [&](int iCand) {
+      const Candidate& candidate = fCandidates[iCand];
+      return std::make_tuple(firstStation[candidate.iTr] * nStations + lastStation[candidate.jTr],
+                             extTracks[candidate.iTr].fParFirst.Z(), extTracks[candidate.jTr].fParLast.Z());
+    };
+    fCandidateOrder.reset(fCandidates.size());
+    for (size_t iCand = 0; iCand < fCandidates.size(); iCand++) {
+      fCandidateOrder[iCand] = iCand;
+    }
+    std::stable_sort(fCandidateOrder.begin(), fCandidateOrder.end(),
+                     [&](int a, int b) { return groupKey(a) < groupKey(b); });
+
+    kf::TrackKalmanFilter<fvec> fitB;
+    fitB.SetParticleMass(fDefaultMass);
+    fitB.SetMask(fmask::One());
+    fitB.SetQp0(fvec(0.));
+
+    kf::TrackKalmanFilter<fvec> fitF;
+    fitF.SetParticleMass(fDefaultMass);
+    fitF.SetMask(fmask::One());
+    fitF.SetQp0(fvec(0.));
+
+    TrackParamV& Tb = fitB.Tr();
+    TrackParamV& Tf = fitF.Tr();
+    kf::FieldValue<fvec> fBm, fBb, fBf _fvecalignment;
+    kf::FieldRegion<fvec> fld _fvecalignment;
+
+    const int nCandidates = fCandidates.size();
+    for (int iBegin = 0; iBegin < nCandidates;) {
+      const auto key = groupKey(fCandidateOrder[iBegin]);
+      int iEnd       = iBegin + 1;
+      while (iEnd < nCandidates && iEnd - iBegin < static_cast<int>(fvec::size())
+             && groupKey(fCandidateOrder[iEnd]) == key) {
+        iEnd++;
+      }
+
+      // fill the rest of the SIMD vectors with the last candidate
+      for (int iV = 0; iV < static_cast<int>(fvec::size()); iV++) {
+        const Candidate& candidate = fCandidates[fCandidateOrder[std::min(iBegin + iV, iEnd - 1)]];
+        Tb.SetOneEntry(iV, extTracks[candidate.iTr].fParFirst);
+        Tf.SetOneEntry(iV, extTracks[candidate.jTr].fParLast);
+      }
+      fitB.SetQp0(fitB.Tr().GetQp());
+      fitF.SetQp0(fitF.Tr().GetQp());
+
+      const Candidate& first = fCandidates[fCandidateOrder[iBegin]];
+      unsigned short stab    = firstStation[first.iTr];
+      unsigned short staf    = lastStation[first.jTr];
+      unsigned short stam;
+
+      fBf = stations[staf].fieldSlice.GetFieldValue(Tf.X(), Tf.Y());
+      fBb = stations[stab].fieldSlice.GetFieldValue(Tb.X(), Tb.Y());
+
+      unsigned short dist = stab - staf;
+
+      if (dist > 1)
+        stam = staf + 1;
+      else
+        stam = staf - 1;
+
+      fvec zm = stations[stam].fZ;
+      fvec xm = fvec(0.5) * (Tf.GetX() + Tf.Tx() * (zm - Tf.Z()) + Tb.GetX() + Tb.Tx() * (zm - Tb.Z()));
+      fvec ym = fvec(0.5) * (Tf.Y() + Tf.Ty() * (zm - Tf.Z()) + Tb.Y() + Tb.Ty() * (zm - Tb.Z()));
+      fBm     = stations[stam].fieldSlice.GetFieldValue(xm, ym);
+      fld.Set(fBb, Tb.Z(), fBm, zm, fBf, Tf.Z());
+
+      fvec zMiddle = fvec(0.5) * (Tb.Z() + Tf.Z());
+
+      fitF.Extrapolate(zMiddle, fld);
+      fitB.Extrapolate(zMiddle, fld);
+
+      fvec Chi2Tracks(0.);
+      FilterTracks(&(Tf.X()), &(Tf.C00()), &(Tb.X()), &(Tb.C00()), nullptr, nullptr, &Chi2Tracks);
+
+      for (int iCand = iBegin; iCand < iEnd; iCand++) {
+        fCandidates[fCandidateOrder[iCand]].chi2 = Chi2Tracks[iCand - iBegin];
+      }
+      iBegin = iEnd;
+    }
+  }
+
   // -------------------------------------------------------------------------------------------------------------------
   //
   void CloneMerger::FilterTracks(fvec const r[5], fvec const C[15], fvec const m[5], fvec const V[15], fvec R[5],
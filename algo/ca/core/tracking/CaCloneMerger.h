@@ -53,10 +53,57 @@ namespace cbm::algo::ca
     void Exec(const ca::InputData& input, WindowData& wData);
 
    private:
+    friend class CloneMergerTest;  ///< Unit test of the merging steps
+
+    /// \brief Pair of tracks, which can be merged
+    struct Candidate {
+      int iTr;     ///< Index of the downstream track
+      int jTr;     ///< Index of the upstream track, ending before the first station of the downstream track
+      fscal chi2;  ///< Chi2 of the track merging
+    };
+
     // ***************
     // ** Functions **
     // ***************
 
+    /// \brief Merges the clones among the tracks and updates the containers
+    /// \param  extTracks     Reconstructed tracks
+    /// \param  extRecoHits   Hit indices of the reconstructed tracks
+    /// \param  firstStation  First station of each track
+    /// \param  lastStation   Last station of each track
+    /// \param  stations      Active tracking stations
+    /// \param  nStations     Number of active stations
+    void MergeTracks(Vector<Track>& extTracks, Vector<ca::HitIndex_t>& extRecoHits,
+                     const Vector<unsigned short>& firstStation, const Vector<unsigned short>& lastStation,
+                     const StationsContainer_t<fvec>& stations, int nStations);
+
+    /// \brief Collects the pairs of tracks, which pass the station and time cuts, ordered by (iTr, jTr)
+    /// \param  extTracks          Reconstructed tracks
+    /// \param  firstStation       First station of each track
+    /// \param  lastStation        Last station of each track
+    /// \param  nStations          Number of active stations
+    /// \param  maxLengthForMerge  Maximal number of hits of a track to be merged
+    ///
+    /// Instead of testing all the pairs of tracks, the upstream tracks are grouped by the last station and sorted by
+    /// time, so for each downstream track only the tracks ending before its first station and within the time window
+    /// are considered. The result is stored in fCandidates.
+    void CollectCandidates(const Vector<Track>& extTracks, const Vector<unsigned short>& firstStation,
+                           const Vector<unsigned short>& lastStation, int nStations, unsigned char maxLengthForMerge);
+
+    /// \brief Calculates chi2 of the track merging for all the candidates
+    /// \param  extTracks     Reconstructed tracks
+    /// \param  firstStation  First station of each track
+    /// \param  lastStation   Last station of each track
+    /// \param  stations      Active tracking stations
+    /// \param  nStations     Number of active stations
+    ///
+    /// The candidates are processed in SIMD vectors. A vector only holds candidates with the same station pair and the
+    /// same z of the track parameters, because the extrapolation steps all the entries until the last one reaches its
+    /// target. So each entry takes the same steps as a single candidate, and the result doesn't depend on the grouping.
+    void CalculateCandidateChi2(const Vector<Track>& extTracks, const Vector<unsigned short>& firstStation,
+                                const Vector<unsigned short>& lastStation, const StationsContainer_t<fvec>& stations,
+                                int nStations);
+
     ///
     static void InvertCholesky(fvec a[15]);
 
@@ -115,6 +162,24 @@ namespace cbm::algo::ca
     /// Flag: is the track a downstream neighbour of another track
     Vector<char> fTrackIsDownstreamNeighbour{"CloneMerger::fTrackIsDownstreamNeighbour"};
 
+    /// Short tracks sorted by the last station, then by time (tracks without time first)
+    Vector<int> fTracksByLastStation{"CloneMerger::fTracksByLastStation"};
+
+    /// Index of the first track in fTracksByLastStation per last station
+    Vector<int> fLastStationOffset{"CloneMerger::fLastStationOffset"};
+
+    /// Index of the first track with time in fTracksByLastStation per last station
+    Vector<int> fLastStationTimedBegin{"CloneMerger::fLastStationTimedBegin"};
+
+    /// Maximal time variance of the tracks with time per last station
+    Vector<fscal> fLastStationMaxC55{"CloneMerger::fLastStationMaxC55"};
+
+    /// Pairs of tracks, which can be merged, ordered by (iTr, jTr)
+    Vector<Candidate> fCandidates{"CloneMerger::fCandidates"};
+
+    /// Indices of the candidates grouped by the station pair and the z of the track parameters
+    Vector<int> fCandidateOrder{"CloneMerger::fCandidateOrder"};
+
     Vector<Track> fTracksNew{"CaCloneMerger::fTracksNew"};  ///< vector of tracks after the merge
 
     Vector<ca::HitIndex_t> fRecoHitsNew{"CaCloneMerger::fRecoHitsNew"};  ///< vector of track hits after the merge
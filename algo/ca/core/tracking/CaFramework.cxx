@@ -26,7 +26,7 @@ namespace cbm::algo::ca
   void Framework::Init(const TrackingMode mode)
   {
     fpTrackFinder =
-      std::make_unique<ca::TrackFinder>(fParameters, fDefaultMass, mode, fMonitorData, fNofThreads, fCaRecoTime);
+      std::make_unique<ca::TrackFinder>(*fpParameters, fDefaultMass, mode, fMonitorData, fNofThreads, fCaRecoTime);
   }
 
   // -------------------------------------------------------------------------------------------------------------------
@@ -49,10 +49,17 @@ namespace cbm::algo::ca
   //
   void Framework::ReceiveParameters(Parameters<fvec>&& parameters)
   {
-    fParameters          = std::move(parameters);
-    fNstationsBeforePipe = fParameters.GetNstationsActive(static_cast<EDetectorID>(0));
+    ShareParameters(std::make_shared<const Parameters<fvec>>(std::move(parameters)));
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void Framework::ShareParameters(std::shared_ptr<const Parameters<fvec>> pParameters)
+  {
+    fpParameters         = std::move(pParameters);
+    fNstationsBeforePipe = fpParameters->GetNstationsActive(static_cast<EDetectorID>(0));
 
-    kf::GlobalField::ForceUseOfOriginalField(fParameters.DevIsUseOfOriginalField());
+    kf::GlobalField::ForceUseOfOriginalField(fpParameters->DevIsUseOfOriginalField());
   }
 
   // -------------------------------------------------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
 
 namespace cbm::algo::ca
 {
@@ -80,11 +81,17 @@ namespace cbm::algo::ca
 
     /// Sets Framework parameters object
     /// \param other - reference to the Parameters object
-    void SetParameters(const Parameters<fvec>& other) { fParameters = other; }
+    void SetParameters(const Parameters<fvec>& other)
+    {
+      fpParameters = std::make_shared<const Parameters<fvec>>(other);
+    }
     // TODO: remove it (S.Zharko)
 
     /// Gets a pointer to the Framework parameters object
-    const Parameters<fvec>& GetParameters() const { return fParameters; }
+    const Parameters<fvec>& GetParameters() const { return *fpParameters; }
+
+    /// Gets the shared Framework parameters object
+    std::shared_ptr<const Parameters<fvec>> GetSharedParameters() const { return fpParameters; }
 
     /// Receives input data
     void ReceiveInputData(InputData&& inputData);
@@ -92,6 +99,10 @@ namespace cbm::algo::ca
     /// Receives tracking parameters
     void ReceiveParameters(Parameters<fvec>&& parameters);
 
+    /// \brief Shares tracking parameters with other Framework instances
+    /// \param pParameters  Parameters object, which is not modified as long as it is shared
+    void ShareParameters(std::shared_ptr<const Parameters<fvec>> pParameters);
+
     /// Gets pointer to input data object for external access
     const InputData& GetInputData() const { return fInputData; }
 
@@ -175,8 +186,9 @@ namespace cbm::algo::ca
     // ** Member variables list **
     // ***************************
 
-    Parameters<fvec> fParameters;  ///< Object of Framework parameters class
-    InputData fInputData;          ///< Tracking input data
+    /// Object of Framework parameters class, can be shared between the Framework instances of different threads
+    std::shared_ptr<const Parameters<fvec>> fpParameters{std::make_shared<const Parameters<fvec>>()};
+    InputData fInputData;  ///< Tracking input data
 
     Vector<unsigned char> fvHitKeyFlags{
       "Framework::fvHitKeyFlags"};  ///< List of key flags: has been this hit or cluster already used
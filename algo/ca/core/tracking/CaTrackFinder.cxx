@@ -46,6 +46,7 @@ namespace cbm::algo::ca
     , fMonitorData(monitorData)
     , fvMonitorDataThread(nThreads)
     , fvWData(nThreads)
+    , fvBatchWData(nThreads)
     , fNofThreads(nThreads)
     , fCaRecoTime(recoTime)
     , fvRecoTracks(nThreads)
@@ -333,6 +334,16 @@ namespace cbm::algo::ca
 
     fMonitorData.StopTimer(ETimer::Tracking);
 
+    if constexpr (constants::gpu::GnnGpuProfiling) {
+      if (fNofTimeslices == 0 && fParameters.GetGnnGpuNofStreams() > 1) {
+        LOG(warning) << "CA tracker: GNN GPU profiling needs one timer per kernel and launches the kernels serially. "
+                     << "The station group pipeline (gnn_gpu_nof_streams = " << fParameters.GetGnnGpuNofStreams()
+                     << ") used in production is not profiled";
+      }
+      fGnnGpuProfiler.Flush(fNofTimeslices);
+    }
+    ++fNofTimeslices;
+
     LOG(debug) << "CA tracker: time slice finished. Reconstructed " << recoTracks.size() << " tracks with "
                << recoHits.size() << " hits. Processed " << statNhitsProcessedTotal << " hits in " << statNwindowsTotal
                << " time windows. Reco time " << fCaRecoTime / 1.e9 << " s";
@@ -404,149 +415,182 @@ namespace cbm::algo::ca
 
     // Track finder algorithm for the time window
     ca::TrackFinderWindow trackFinderWindow(fParameters, fDefaultMass, fTrackingMode, monitor);
+    if constexpr (constants::gpu::GnnGpuProfiling) {
+      trackFinderWindow.SetGnnGpuProfiler(&fGnnGpuProfiler);
+    }
     trackFinderWindow.InitTimeslice(input.GetNhitKeys());
 
+    // Consecutive windows processed together by the GNN GPU track finder. The first one is wData, which keeps the
+    // hit key flags of the thread. The output of a batch differs from the one of single windows, see the comments
+    // below and the gnn_gpu_batch_size CA parameter.
+    const size_t batchSize = constants::gpu::GnnGpuTracking ? fParameters.GetGnnGpuBatchSize() : 1;
+    auto& vBatchWData    = fvBatchWData[iThread];
+    vBatchWData.resize(batchSize - 1);
+    std::vector<WindowData*> batch;
+    batch.reserve(batchSize);
+
     monitor.StopTimer(ETimer::PrepareThread);
 
     while (true) {
-      monitor.IncrementCounter(ECounter::SubTS);
-      // select the sub-slice hits
-      for (int iS = 0; iS < fParameters.GetNstationsActive(); ++iS) {
-        wData.TsHitIndices(iS).clear();
-      }
+      batch.clear();
       bool areUntouchedDataLeft = false;  // is the whole TS processed
+      fscal windowStart         = windowRange.first;
+      do {
+        WindowData& wWindow = batch.empty() ? wData : vBatchWData[batch.size() - 1];
+        windowStart         = windowRange.first + batch.size() * fWindowLength;
+        batch.push_back(&wWindow);
+
+        monitor.IncrementCounter(ECounter::SubTS);
+        // select the sub-slice hits
+        for (int iS = 0; iS < fParameters.GetNstationsActive(); ++iS) {
+          wWindow.TsHitIndices(iS).clear();
+        }
+        areUntouchedDataLeft = false;
 
-      // TODO: SG: skip empty regions and start the subslice with the earliest hit
+        // TODO: SG: skip empty regions and start the subslice with the earliest hit
 
-      statNwindows++;
-      //out << statNwindows << ' ';
+        statNwindows++;
+        //out << statNwindows << ' ';
 
-      monitor.StartTimer(ETimer::PrepareWindow);
+        monitor.StartTimer(ETimer::PrepareWindow);
 
-      for (auto& range : streamHitRanges) {
-        for (HitIndex_t caHitId = range.first; caHitId < range.second; ++caHitId) {
-          const ca::Hit& h = input.GetHit(caHitId);
-          if (wData.IsHitKeyUsed(h.FrontKey()) || wData.IsHitKeyUsed(h.BackKey())) {
-            // the hit is already reconstructed
-            continue;
-          }
-          const CaHitTimeInfo& info = fHitTimeInfo[caHitId];
-          if (info.fEventTimeMax < windowRange.first) {
-            // the hit belongs to previous sub-slices
-            continue;
-          }
-          if (info.fMinTimeAfterHit > windowRange.first + fWindowLength) {
-            // this hit and all later hits are out of the sub-slice
-            areUntouchedDataLeft = true;
-            break;
-          }
-          if (info.fEventTimeMin > windowRange.first + fWindowLength) {
-            // the hit is too late for the sub slice
-            areUntouchedDataLeft = true;
-            continue;
-          }
+        for (auto& range : streamHitRanges) {
+          for (HitIndex_t caHitId = range.first; caHitId < range.second; ++caHitId) {
+            const ca::Hit& h = input.GetHit(caHitId);
+            if (wData.IsHitKeyUsed(h.FrontKey()) || wData.IsHitKeyUsed(h.BackKey())) {
+              // the hit is already reconstructed
+              continue;
+            }
+            const CaHitTimeInfo& info = fHitTimeInfo[caHitId];
+            if (info.fEventTimeMax < windowStart) {
+              // the hit belongs to previous sub-slices
+              continue;
+            }
+            if (info.fMinTimeAfterHit > windowStart + fWindowLength) {
+              // this hit and all later hits are out of the sub-slice
+              areUntouchedDataLeft = true;
+              break;
+            }
+            if (info.fEventTimeMin > windowStart + fWindowLength) {
+              // the hit is too late for the sub slice
+              areUntouchedDataLeft = true;
+              continue;
+            }
 
-          // the hit belongs to the sub-slice
-          wData.TsHitIndices(h.Station()).push_back(caHitId);
-          if (info.fMaxTimeBeforeHit < windowRange.first + fWindowLength) {
-            range.first = caHitId + 1;  // this hit and all hits before are before the overlap
+            // the hit belongs to the sub-slice
+            wWindow.TsHitIndices(h.Station()).push_back(caHitId);
+            if (info.fMaxTimeBeforeHit < windowStart + fWindowLength) {
+              range.first = caHitId + 1;  // this hit and all hits before are before the overlap
+            }
           }
         }
-      }
-
-      //out << statNwindowHits << ' ';
-      //if (statNwindowHits == 0) {  // Empty window
-      //  monitor.StopTimer(ETimer::PrepareWindow);
-      //  out << 0 << ' ' << 0 << ' ' << 0 << '\n';
-      //  continue;
-      //}
 
-      if (ca::TrackingMode::kMcbm == fTrackingMode) {
-        // cut at 50 hits per station per 1 us.
-        int maxStationHits = (int) (50 * fWindowLength / 1.e3);
-        for (int ista = 0; ista < fParameters.GetNstationsActive(); ++ista) {
-          int nHitsSta = static_cast<int>(wData.TsHitIndices(ista).size());
-          if (nHitsSta > maxStationHits) {
-            wData.TsHitIndices(ista).clear();
+        //out << statNwindowHits << ' ';
+        //if (statNwindowHits == 0) {  // Empty window
+        //  monitor.StopTimer(ETimer::PrepareWindow);
+        //  out << 0 << ' ' << 0 << ' ' << 0 << '\n';
+        //  continue;
+        //}
+
+        if (ca::TrackingMode::kMcbm == fTrackingMode) {
+          // cut at 50 hits per station per 1 us.
+          int maxStationHits = (int) (50 * fWindowLength / 1.e3);
+          for (int ista = 0; ista < fParameters.GetNstationsActive(); ++ista) {
+            int nHitsSta = static_cast<int>(wWindow.TsHitIndices(ista).size());
+            if (nHitsSta > maxStationHits) {
+              wWindow.TsHitIndices(ista).clear();
+            }
           }
         }
-      }
 
-      int statNwindowHits = 0;
-      for (int ista = 0; ista < fParameters.GetNstationsActive(); ++ista) {
-        statNwindowHits += wData.TsHitIndices(ista).size();
-      }
-      statNhitsProcessed += statNwindowHits;
-
-      // print the LOG for every 10 ms of data processed
-      if constexpr (0) {
-        int currentChunk = (int) ((windowRange.first - fStatTsStart) / 10.e6);
-        if (!areUntouchedDataLeft || currentChunk > statLastLogTimeChunk) {
-          statLastLogTimeChunk = currentChunk;
-          double dataRead = 100. * (windowRange.first + fWindowLength - fStatTsStart) / (fStatTsEnd - fStatTsStart);
-          if (dataRead > 100.) {
-            dataRead = 100.;
+        int statNwindowHits = 0;
+        for (int ista = 0; ista < fParameters.GetNstationsActive(); ++ista) {
+          statNwindowHits += wWindow.TsHitIndices(ista).size();
+        }
+        statNhitsProcessed += statNwindowHits;
+
+        // print the LOG for every 10 ms of data processed
+        if constexpr (0) {
+          int currentChunk = (int) ((windowStart - fStatTsStart) / 10.e6);
+          if (!areUntouchedDataLeft || currentChunk > statLastLogTimeChunk) {
+            statLastLogTimeChunk = currentChunk;
+            double dataRead = 100. * (windowStart + fWindowLength - fStatTsStart) / (fStatTsEnd - fStatTsStart);
+            if (dataRead > 100.) {
+              dataRead = 100.;
+            }
+            LOG(debug) << "CA tracker process sliding window N " << statNwindows << ": time " << windowStart / 1.e6
+                       << " ms + " << fWindowLength / 1.e3 << " us) with " << statNwindowHits << " hits. "
+                       << " Processing " << dataRead << " % of the TS time and "
+                       << 100. * statNhitsProcessed / fStatNhitsTotal << " % of TS hits."
+                       << " Already reconstructed " << tracks.size() << " tracks on thread #" << iThread;
           }
-          LOG(debug) << "CA tracker process sliding window N " << statNwindows << ": time " << windowRange.first / 1.e6
-                     << " ms + " << fWindowLength / 1.e3 << " us) with " << statNwindowHits << " hits. "
-                     << " Processing " << dataRead << " % of the TS time and "
-                     << 100. * statNhitsProcessed / fStatNhitsTotal << " % of TS hits."
-                     << " Already reconstructed " << tracks.size() << " tracks on thread #" << iThread;
         }
-      }
 
-      //out << statNwindowHits << ' ';
-      monitor.StopTimer(ETimer::PrepareWindow);
+        //out << statNwindowHits << ' ';
+        monitor.StopTimer(ETimer::PrepareWindow);
+      } while (batch.size() < batchSize && areUntouchedDataLeft && windowStart + fWindowLength <= windowRange.second);
 
       //Timer trackingInWindow;  //DBG
       //trackingInWindow.Start();
       monitor.StartTimer(ETimer::TrackingWindow);
-      trackFinderWindow.CaTrackFinderSlice(input, wData);
+      if (batch.size() == 1) {
+        trackFinderWindow.CaTrackFinderSlice(input, wData);
+      }
+      else {
+        trackFinderWindow.GnnGpuTrackFinderBatch(input, batch);
+      }
       monitor.StopTimer(ETimer::TrackingWindow);
       //trackingInWindow.Stop();
       //out << trackingInWindow.GetTotalMs() << ' ';
 
-      // save reconstructed tracks with no hits in the overlap region
-      //if (windowRange.first > 13.23e6 && windowRange.first < 13.26e6) {
-      windowRange.first += fWindowLength;
-      // we should add hits from reconstructed but not stored tracks to the new sub-timeslice
-      // we do it in a simple way by extending the tsStartNew
-      // TODO: only add those hits from the region before tsStartNew that belong to the not stored tracks
-      //out << fvWData[iThread].RecoHitIndices().size() << ' ';
-      //out << fvWData[iThread].RecoTracks().size() << '\n';
-
-      monitor.StartTimer(ETimer::StoreTracksWindow);
-      auto trackFirstHit = wData.RecoHitIndices().begin();
-
-      for (const auto& track : wData.RecoTracks()) {
-
-        const bool isTrackCompletelyInOverlap =
-          std::all_of(trackFirstHit, trackFirstHit + track.fNofHits, [&](int caHitId) {
-            CaHitTimeInfo& info = fHitTimeInfo[caHitId];
-            return info.fEventTimeMax >= windowRange.first;
-          });
-
-        // Don't save tracks from the overlap region, since they might have additional hits in the next subslice.
-        // Don't reject tracks in the overlap when no more data are left
-        const bool useFlag = !isTrackCompletelyInOverlap || !areUntouchedDataLeft;
-
-        for (int i = 0; i < track.fNofHits; i++) {
-          const int caHitId                = *(trackFirstHit + i);
-          const auto& h                    = input.GetHit(caHitId);
-          wData.IsHitKeyUsed(h.FrontKey()) = static_cast<int>(useFlag);
-          wData.IsHitKeyUsed(h.BackKey())  = static_cast<int>(useFlag);
-
+      for (size_t iWindow = 0; iWindow < batch.size(); ++iWindow) {
+        const WindowData& wWindow = *batch[iWindow];
+        const bool isLastInBatch  = (iWindow + 1 == batch.size());
+
+        // save reconstructed tracks with no hits in the overlap region
+        //if (windowRange.first > 13.23e6 && windowRange.first < 13.26e6) {
+        windowRange.first += fWindowLength;
+        // we should add hits from reconstructed but not stored tracks to the new sub-timeslice
+        // we do it in a simple way by extending the tsStartNew
+        // TODO: only add those hits from the region before tsStartNew that belong to the not stored tracks
+        //out << fvWData[iThread].RecoHitIndices().size() << ' ';
+        //out << fvWData[iThread].RecoTracks().size() << '\n';
+
+        monitor.StartTimer(ETimer::StoreTracksWindow);
+        auto trackFirstHit = wWindow.RecoHitIndices().begin();
+
+        for (const auto& track : wWindow.RecoTracks()) {
+
+          const bool isTrackCompletelyInOverlap =
+            std::all_of(trackFirstHit, trackFirstHit + track.fNofHits, [&](int caHitId) {
+              CaHitTimeInfo& info = fHitTimeInfo[caHitId];
+              return info.fEventTimeMax >= windowRange.first;
+            });
+
+          // Don't save tracks from the overlap region, since they might have additional hits in the next subslice.
+          // Don't reject tracks in the overlap when no more data are left. Within a batch, the hits of the next
+          // window were selected before these tracks were stored, so the tracks are kept there as well. This is
+          // where the batched output differs from the one of single windows.
+          const bool useFlag = !isTrackCompletelyInOverlap || !areUntouchedDataLeft || !isLastInBatch;
+
+          for (int i = 0; i < track.fNofHits; i++) {
+            const int caHitId                = *(trackFirstHit + i);
+            const auto& h                    = input.GetHit(caHitId);
+            wData.IsHitKeyUsed(h.FrontKey()) = static_cast<int>(useFlag);
+            wData.IsHitKeyUsed(h.BackKey())  = static_cast<int>(useFlag);
+
+            if (useFlag) {
+              hitIndices.push_back(caHitId);
+            }
+          }
           if (useFlag) {
-            hitIndices.push_back(caHitId);
+            tracks.push_back(track);
           }
-        }
-        if (useFlag) {
-          tracks.push_back(track);
-        }
 
-        trackFirstHit += track.fNofHits;
-      }  // sub-timeslice tracks
-      monitor.StopTimer(ETimer::StoreTracksWindow);
+          trackFirstHit += track.fNofHits;
+        }  // sub-timeslice tracks
+        monitor.StopTimer(ETimer::StoreTracksWindow);
+      }  // windows of the batch
 
       if (windowRange.first > windowRange.second) {
         break;
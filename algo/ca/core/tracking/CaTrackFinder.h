@@ -73,7 +73,8 @@ namespace cbm::algo::ca
     TrackingMonitorData& fMonitorData;                     ///< Tracking monitor data (statistics per call)
     std::vector<TrackingMonitorData> fvMonitorDataThread;  ///< Tracking monitor data per thread
 
-    std::vector<ca::WindowData> fvWData;  ///< Intrnal data processed in a time-window
+    std::vector<ca::WindowData> fvWData;                    ///< Intrnal data processed in a time-window
+    std::vector<std::vector<ca::WindowData>> fvBatchWData;  ///< Further windows of a GNN GPU batch, per thread
 
     int fNofThreads;      ///< Number of threads to execute the track-finder
     double& fCaRecoTime;  // time of the track finder + fitter
@@ -81,6 +82,9 @@ namespace cbm::algo::ca
     std::vector<Vector<Track>> fvRecoTracks;           ///< reconstructed tracks
     std::vector<Vector<HitIndex_t>> fvRecoHitIndices;  ///< packed hits of reconstructed tracks
 
+    GnnGpuProfiler fGnnGpuProfiler;  ///< Per-kernel profile of the GNN GPU tracking
+    uint64_t fNofTimeslices = 0;     ///< Number of processed timeslices
+
     fscal fWindowLength  = 0.;   ///< Time window length [ns]
     fscal fStatTsStart  = 0.;
     fscal fStatTsEnd    = 0.;
@@ -109,6 +109,37 @@ namespace cbm::algo::ca
   }
 
 
+  // -------------------------------------------------------------------------------------------------------------------
+  void TrackFinderWindow::InitXpu()
+  {
+    // XPU initialization
+    // - temporary solution for tests only
+    // - should not be initialized here
+    setenv("XPU_PROFILE", "1", 1);
+    xpu::settings settings;
+    // settings.device = "cpu0";
+    settings.device = "hip0";  //hip1 - MI100, hip0 - radeon VII
+    //      settings.verbose = true;
+    xpu::initialize(settings);
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  void TrackFinderWindow::InitGnnGpuTrackFinder(std::optional<GnnGpuTrackFinderSetup>& setup,
+                                                const ca::InputData& input, WindowData& wData)
+  {
+    InitXpu();
+
+    // Set up environment for GPU tracking
+    xpu::push_timer("gpuTFinit");
+    setup.emplace(wData, fParameters, input, fTrackFitter);
+    xpu::timings gpuTFinit = xpu::pop_timer();
+    if constexpr (constants::gpu::GpuTimeMonitoring) {
+      LOG(info) << "GPU tracking :: Initialization: " << gpuTFinit.wall() << " ms";
+    }
+    setup->SetProfiler(fpGnnGpuProfiler);
+    SetupGnnGpuTrackFinder(setup.value());
+  }
+
   // **************************************************************************************************
   // *                                                                                                *
   // *                            ------ CATrackFinder procedure ------                               *
@@ -133,36 +164,11 @@ namespace cbm::algo::ca
     size_t iter_num = 0;
 
     if constexpr (constants::gpu::GnnGpuTracking) {  // GNN GPU tracking
-      // XPU initialization
-      // - temporary solution for tests only
-      // - should not be initialized here
-      setenv("XPU_PROFILE", "1", 1);
-      xpu::settings settings;
-      // settings.device = "cpu0";
-      settings.device = "hip0";  //hip1 - MI100, hip0 - radeon VII
-      //      settings.verbose = true;
-      xpu::initialize(settings);
-
-      // Set up environment for GPU tracking
-      xpu::push_timer("gpuTFinit");
-      GnnGpuTrackFinderSetup.emplace(wData, fParameters, input, fTrackFitter);
-      xpu::timings gpuTFinit = xpu::pop_timer();
-      if constexpr (constants::gpu::GpuTimeMonitoring) {
-        LOG(info) << "GPU tracking :: Initialization: " << gpuTFinit.wall() << " ms";
-      }
-      SetupGnnGpuTrackFinder(GnnGpuTrackFinderSetup.value());
+      InitGnnGpuTrackFinder(GnnGpuTrackFinderSetup, input, wData);
     }
     else {  // CA GPU Tracking
       if constexpr (constants::gpu::GpuTracking) {
-        // XPU initialization
-        // - temporary solution for tests only
-        // - should not be initialized here
-        setenv("XPU_PROFILE", "1", 1);
-        xpu::settings settings;
-        //      settings.device = "cpu0";
-        settings.device = "hip0";
-        //      settings.verbose = true;
-        xpu::initialize(settings);
+        InitXpu();
 
         // Set up environment for GPU tracking
         xpu::push_timer("gpuTFinit");
@@ -191,7 +197,7 @@ namespace cbm::algo::ca
 
         frMonitorData.StartTimer(ETimer::GNNTracking);
         if constexpr (constants::gpu::GnnGpuTracking) {
-          ConstructGnnTripletsGpu(wData, GnnGpuTrackFinderSetup.value(), iter_num);
+          ConstructGnnTripletsGpu({&wData}, GnnGpuTrackFinderSetup.value(), iter_num);
         }
         else {
           GNNTrackFinder(input, wData, iter_num, fTrackFitter, frMonitorData);
@@ -265,6 +271,70 @@ namespace cbm::algo::ca
     frMonitorData.StopTimer(ETimer::FitTracks);
   }
 
+  // -------------------------------------------------------------------------------------------------------------------
+  void TrackFinderWindow::GnnGpuTrackFinderBatch(const ca::InputData& input, const std::vector<WindowData*>& batch)
+  {
+    // Init windows and grids
+    for (WindowData* wData : batch) {
+      frMonitorData.StartTimer(ETimer::InitWindow);
+      ReadWindowData(input.GetHits(), *wData);
+      frMonitorData.StopTimer(ETimer::InitWindow);
+
+      frMonitorData.StartTimer(ETimer::PrepareGrid);
+      PrepareGrid(input.GetHits(), *wData);
+      frMonitorData.StopTimer(ETimer::PrepareGrid);
+    }
+
+    // Set up environment for GPU tracking once for the whole batch
+    std::optional<ca::GnnGpuTrackFinderSetup> setup;
+    InitGnnGpuTrackFinder(setup, input, *batch.front());
+    ca::GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup = setup.value();
+
+    frMonitorData.StartTimer(ETimer::FindTracks);
+    auto& caIterations = fParameters.GetCAIterations();
+    size_t iter_num    = 0;
+    for (auto iter = caIterations.begin(); iter != caIterations.end(); ++iter, ++iter_num) {
+      if (iter_num == 2) {
+        LOG(info) << "Skip 3rd iteration of CA";
+        continue;
+      }
+      // ----- Prepare iteration -----
+      frMonitorData.StartTimer(ETimer::PrepareIteration);
+      for (WindowData* wData : batch) {
+        GnnGpuTrackFinderSetup.SetWindow(*wData);
+        PrepareCAIteration(*iter, *wData, iter == caIterations.begin());
+      }
+      frMonitorData.StopTimer(ETimer::PrepareIteration);
+
+      frMonitorData.StartTimer(ETimer::GNNTracking);
+      ConstructGnnTripletsGpu(batch, GnnGpuTrackFinderSetup, iter_num);
+      frMonitorData.StopTimer(ETimer::GNNTracking);
+    }  // ---- Loop over Track Finder iterations: END ----//
+    frMonitorData.StopTimer(ETimer::FindTracks);
+
+    for (WindowData* wData : batch) {
+      GnnGpuTrackFinderSetup.SetWindow(*wData);
+
+      // Fit tracks
+      frMonitorData.StartTimer(ETimer::FitTracks);
+      fTrackFitter.FitCaTracks(input, *wData);
+      frMonitorData.StopTimer(ETimer::FitTracks);
+
+      // Merge clones
+      frMonitorData.StartTimer(ETimer::MergeClones);
+      fCloneMerger.Exec(input, *wData);
+      frMonitorData.StopTimer(ETimer::MergeClones);
+
+      // Fit tracks
+      frMonitorData.StartTimer(ETimer::FitTracks);
+      fTrackFitter.FitCaTracks(input, *wData);
+      frMonitorData.StopTimer(ETimer::FitTracks);
+    }
+
+    // Return the hit key flags to the first window
+    GnnGpuTrackFinderSetup.SetWindow(*batch.front());
+  }
+
   // -------------------------------------------------------------------------------------------------------------------
   void TrackFinderWindow::ReadWindowData(const Vector<Hit>& hits, WindowData& wData)
   {
@@ -975,13 +1045,22 @@ namespace cbm::algo::ca
   }
 
   // -------------------------------------------------------------------------------------------------------------------
-  void TrackFinderWindow::ConstructGnnTripletsGpu(WindowData& wData, GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup,
-                                                  int iteration)
+  void TrackFinderWindow::ConstructGnnTripletsGpu(const std::vector<WindowData*>& batch,
+                                                  GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup, int iteration)
   {
+    // The GNN kernels do not use the grid, it is only uploaded for a single window
     xpu::push_timer("SetupGridTime");
-    GnnGpuTrackFinderSetup.SetupGrid();
+    if (batch.size() == 1) {
+      GnnGpuTrackFinderSetup.SetupGrid();
+    }
     xpu::timings SetupGridTime = xpu::pop_timer();
 
+    // Collect the active hits of the windows. For a batch, this also sets the number of hits of the kernel chain.
+    GnnGpuTrackFinderSetup.ClearBatch();
+    for (WindowData* wData : batch) {
+      GnnGpuTrackFinderSetup.AddBatchWindow(*wData);
+    }
+
     xpu::push_timer("SetupIterationDataTime");
     GnnGpuTrackFinderSetup.SetupIterationData(iteration);
     xpu::timings SetupIterationDataTime = xpu::pop_timer();
@@ -1007,7 +1086,7 @@ namespace cbm::algo::ca
   void TrackFinderWindow::GNNTrackFinder(const ca::InputData& input, WindowData& wData, const int iteration,
                                          TrackFitter& trackFitter, TrackingMonitorData& monitorData)
   {
-    GraphConstructor graphConstructor(input, wData, trackFitter, monitorData);
+    GraphConstructor graphConstructor(input, wData, fParameters, trackFitter, monitorData);
 
     // Argument to run classifier is:
     // 0 - Triplets as tracks, 1 - Candidates, 2 - Tracks
@@ -22,6 +22,8 @@
 #include "CaWindowData.h"
 #include "GnnGpuTrackFinderSetup.h"
 
+#include <optional>
+
 namespace cbm::algo::ca
 {
 
@@ -53,9 +55,19 @@ namespace cbm::algo::ca
 
     void CaTrackFinderSlice(const ca::InputData& input, WindowData& wData);
 
+    /// \brief Runs the GNN GPU track finder on consecutive time windows with one kernel chain per iteration
+    /// \param batch  Windows of the batch; the first one holds the hit key flags on entry and on exit
+    ///
+    /// The active hits of all windows are packed into one set of device buffers. The tracks are scattered back to
+    /// the windows in their order, so a window sees the hits used by the tracks of the previous ones.
+    void GnnGpuTrackFinderBatch(const ca::InputData& input, const std::vector<WindowData*>& batch);
+
     /// \note The function initializes global arrays for a given thread
     void InitTimeslice(size_t nHitKeys) { fvHitKeyToTrack.reset(nHitKeys, -1); }
 
+    /// \brief Sets the profiler of the GNN GPU kernels (constants::gpu::GnnGpuProfiling)
+    void SetGnnGpuProfiler(GnnGpuProfiler* profiler) { fpGnnGpuProfiler = profiler; }
+
    private:
     ///-------------------------------
     /// Private methods
@@ -96,10 +108,20 @@ namespace cbm::algo::ca
 
     void ConstructTripletsGPU(WindowData& wData, GpuTrackFinderSetup& gpuTrackFinderSetup, int iteration);
 
-    void ConstructGnnTripletsGpu(WindowData& wData, GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup, int iteration);
+    void ConstructGnnTripletsGpu(const std::vector<WindowData*>& batch, GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup,
+                                 int iteration);
 
     void SetupGnnGpuTrackFinder(GnnGpuTrackFinderSetup& GnnGpuTrackFinderSetup);
 
+    /// \brief Initializes XPU on the GPU device used for tracking
+    static void InitXpu();
+
+    /// \brief Initializes XPU and sets up the GNN GPU track finder
+    /// \param setup  Track finder setup, constructed by the function
+    /// \param wData  Window, or the first window of a batch
+    void InitGnnGpuTrackFinder(std::optional<GnnGpuTrackFinderSetup>& setup, const ca::InputData& input,
+                               WindowData& wData);
+
     void GNNTrackFinder(const ca::InputData& input, WindowData& wData, const int iteration, TrackFitter& fTrackFitter, TrackingMonitorData& fMonitorData);
 
     // ** Functions, which pack and unpack indexes of station and triplet **
@@ -150,6 +172,8 @@ namespace cbm::algo::ca
 
     // Triplet temporary storage. Only used in ConstructTriplets().
     Vector<ca::Triplet> fvTriplets;
+
+    GnnGpuProfiler* fpGnnGpuProfiler = nullptr;  ///< Profiler of the GNN GPU kernels, not owned
   };
 
   // ********************************************
@@ -22,15 +22,65 @@ namespace cbm::algo::ca
     , fDefaultMass(mass)
     , fTrackingMode(mode)
   {
+    SelectImplementation(fParameters.GetNstationsActive(), CompiledStationCounts_t{});
   }
 
   // -------------------------------------------------------------------------------------------------------------------
   //
   TrackFitter::~TrackFitter() {}
 
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<int... NStations>
+  void TrackFitter::SelectImplementation(int nStations, std::integer_sequence<int, NStations...>)
+  {
+    SetImplementation<kAnyNstations>();
+    static_cast<void>(((nStations == NStations && (SetImplementation<NStations>(), true)) || ...));
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<int NStations>
+  void TrackFitter::SetImplementation()
+  {
+    fpFitCaTracks     = &TrackFitter::FitCaTracksImpl<NStations>;
+    fpFitGNNTriplets  = &TrackFitter::FitGNNTripletsImpl<NStations>;
+    fpFitGNNTracklets = &TrackFitter::FitGNNTrackletsImpl<NStations>;
+  }
+
   // -------------------------------------------------------------------------------------------------------------------
   //
   void TrackFitter::FitCaTracks(const ca::InputData& input, WindowData& wData)
+  {
+    (this->*fpFitCaTracks)(input, wData);
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void TrackFitter::FitGNNTriplets(const ca::InputData& input, WindowData& wData, Vector<Track>& tripletCandidates,
+                                   Vector<HitIndex_t>& tripletHits, Vector<int>& selectedTripletIndexes,
+                                   Vector<float>& selectedTripletScores,
+                                   std::vector<std::vector<float>>& selectedTripletParams, const int GNNiteration)
+  {
+    (this->*fpFitGNNTriplets)(input, wData, tripletCandidates, tripletHits, selectedTripletIndexes,
+                              selectedTripletScores, selectedTripletParams, GNNiteration);
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  void TrackFitter::FitGNNTracklets(const ca::InputData& input, WindowData& wData, Vector<Track>& trackCandidates,
+                                    Vector<HitIndex_t>& trackHits, Vector<int>& selectedTrackIndexes,
+                                    Vector<float>& selectedTrackScores,
+                                    std::vector<std::vector<float>>& selectedTrackParams, const int GNNiteration)
+  {
+    (this->*fpFitGNNTracklets)(input, wData, trackCandidates, trackHits, selectedTrackIndexes, selectedTrackScores,
+                               selectedTrackParams, GNNiteration);
+  }
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<int NStations>
+  void TrackFitter::FitCaTracksImpl(const ca::InputData& input, WindowData& wData)
   {
     //  LOG(info) << " Start CA Track Fitter ";
     int start_hit = 0;  // for interation in wData.RecoHitIndices()
@@ -44,7 +94,9 @@ namespace cbm::algo::ca
     kf::FieldValue<fvec> fldB01, fldB11, fldB21 _fvecalignment;
     kf::FieldRegion<fvec> fld1 _fvecalignment;
 
-    const int nStations = fParameters.GetNstationsActive();
+    // Per-station state is sized by the compile-time number of stations, if it is known
+    constexpr int kNofStationsMax = (NStations == kAnyNstations) ? constants::size::MaxNstations : NStations;
+    const int nStations           = (NStations == kAnyNstations) ? fParameters.GetNstationsActive() : NStations;
     int nTracks_SIMD    = fvec::size();
 
     kf::TrackKalmanFilter<fvec> fit;  // fit parameters coresponding to the current track
@@ -58,14 +110,14 @@ namespace cbm::algo::ca
 
     // Spatial-time position of a hit vs. station and track in the portion
 
-    fvec x[constants::size::MaxNstations];                       // Hit position along the x-axis [cm]
-    fvec y[constants::size::MaxNstations];                       // Hit position along the y-axis [cm]
-    kf::MeasurementXy<fvec> mxy[constants::size::MaxNstations];  // Covariance matrix for x,y
+    fvec x[kNofStationsMax];                       // Hit position along the x-axis [cm]
+    fvec y[kNofStationsMax];                       // Hit position along the y-axis [cm]
+    kf::MeasurementXy<fvec> mxy[kNofStationsMax];  // Covariance matrix for x,y
 
-    fvec z[constants::size::MaxNstations];  // Hit position along the z-axis (precised) [cm]
+    fvec z[kNofStationsMax];  // Hit position along the z-axis (precised) [cm]
 
-    fvec time[constants::size::MaxNstations];  // Hit time [ns]
-    fvec dt2[constants::size::MaxNstations];   // Hit time uncertainty [ns] squared
+    fvec time[kNofStationsMax];  // Hit time [ns]
+    fvec dt2[kNofStationsMax];   // Hit time uncertainty [ns] squared
 
     fvec x_first;
     fvec y_first;
@@ -83,9 +135,9 @@ namespace cbm::algo::ca
     fvec wtime_last;
     fvec dt2_last;
 
-    fvec By[constants::size::MaxNstations];
-    fmask w[constants::size::MaxNstations];
-    fmask w_time[constants::size::MaxNstations];  // !!!
+    fvec By[kNofStationsMax];
+    fmask w[kNofStationsMax];
+    fmask w_time[kNofStationsMax];  // !!!
 
     fvec y_temp;
     fvec x_temp;
@@ -95,10 +147,10 @@ namespace cbm::algo::ca
     fvec z_start;
     fvec z_end;
 
-    kf::FieldValue<fvec> fB[constants::size::MaxNstations], fB_temp _fvecalignment;
+    kf::FieldValue<fvec> fB[kNofStationsMax], fB_temp _fvecalignment;
 
 
-    fvec ZSta[constants::size::MaxNstations];
+    fvec ZSta[kNofStationsMax];
     for (int ista = 0; ista < nStations; ista++) {
       ZSta[ista] = sta[ista].fZ;
       mxy[ista].SetCov(1., 0., 1.);
@@ -131,7 +183,7 @@ namespace cbm::algo::ca
       for (int iVec = 0; iVec < nTracks_SIMD; iVec++) {
 
         int nHitsTrack = t[iVec]->fNofHits;
-        int iSta[constants::size::MaxNstations];
+        int iSta[constants::size::MaxNstations];  // indexed by hit, not by station
 
         for (int ih = 0; ih < nHitsTrack; ih++) {
 
@@ -409,10 +461,11 @@ namespace cbm::algo::ca
 
   // -------------------------------------------------------------------------------------------------------------------
   //
-  void TrackFitter::FitGNNTriplets(const ca::InputData& input, WindowData& wData, Vector<Track>& tripletCandidates,
-                                   Vector<HitIndex_t>& tripletHits, Vector<int>& selectedTripletIndexes,
-                                   Vector<float>& selectedTripletScores,
-                                   std::vector<std::vector<float>>& selectedTripletParams, const int GNNiteration)
+  template<int NStations>
+  void TrackFitter::FitGNNTripletsImpl(const ca::InputData& input, WindowData& wData,
+                                       Vector<Track>& tripletCandidates, Vector<HitIndex_t>& tripletHits,
+                                       Vector<int>& selectedTripletIndexes, Vector<float>& selectedTripletScores,
+                                       std::vector<std::vector<float>>& selectedTripletParams, const int GNNiteration)
   {
     //  LOG(info) << " Start CA Track Fitter ";
     int start_hit = 0;  // for interation in wData.RecoHitIndices()
@@ -425,7 +478,9 @@ namespace cbm::algo::ca
     kf::FieldValue<fvec> fldB01, fldB11, fldB21 _fvecalignment;
     kf::FieldRegion<fvec> fld1 _fvecalignment;
 
-    const int nStations = fParameters.GetNstationsActive();
+    // Per-station state is sized by the compile-time number of stations, if it is known
+    constexpr int kNofStationsMax = (NStations == kAnyNstations) ? constants::size::MaxNstations : NStations;
+    const int nStations           = (NStations == kAnyNstations) ? fParameters.GetNstationsActive() : NStations;
     int nTracks_SIMD    = fvec::size();
 
     kf::TrackKalmanFilter<fvec> fit;  // fit parameters coresponding to the current track
@@ -439,14 +494,14 @@ namespace cbm::algo::ca
 
     // Spatial-time position of a hit vs. station and track in the portion
 
-    fvec x[constants::size::MaxNstations];                       // Hit position along the x-axis [cm]
-    fvec y[constants::size::MaxNstations];                       // Hit position along the y-axis [cm]
-    kf::MeasurementXy<fvec> mxy[constants::size::MaxNstations];  // Covariance matrix for x,y
+    fvec x[kNofStationsMax];                       // Hit position along the x-axis [cm]
+    fvec y[kNofStationsMax];                       // Hit position along the y-axis [cm]
+    kf::MeasurementXy<fvec> mxy[kNofStationsMax];  // Covariance matrix for x,y
 
-    fvec z[constants::size::MaxNstations];  // Hit position along the z-axis (precised) [cm]
+    fvec z[kNofStationsMax];  // Hit position along the z-axis (precised) [cm]
 
-    fvec time[constants::size::MaxNstations];  // Hit time [ns]
-    fvec dt2[constants::size::MaxNstations];   // Hit time uncertainty [ns] squared
+    fvec time[kNofStationsMax];  // Hit time [ns]
+    fvec dt2[kNofStationsMax];   // Hit time uncertainty [ns] squared
 
     fvec x_first;
     fvec y_first;
@@ -462,9 +517,9 @@ namespace cbm::algo::ca
     fvec wtime_last;
     fvec dt2_last;
 
-    fvec By[constants::size::MaxNstations];
-    fmask w[constants::size::MaxNstations];
-    fmask w_time[constants::size::MaxNstations];  // !!!
+    fvec By[kNofStationsMax];
+    fmask w[kNofStationsMax];
+    fmask w_time[kNofStationsMax];  // !!!
 
     fvec y_temp;
     fvec x_temp;
@@ -474,10 +529,10 @@ namespace cbm::algo::ca
     fvec z_start;
     fvec z_end;
 
-    kf::FieldValue<fvec> fB[constants::size::MaxNstations], fB_temp _fvecalignment;
+    kf::FieldValue<fvec> fB[kNofStationsMax], fB_temp _fvecalignment;
 
 
-    fvec ZSta[constants::size::MaxNstations];
+    fvec ZSta[kNofStationsMax];
     for (int ista = 0; ista < nStations; ista++) {
       ZSta[ista] = sta[ista].fZ;
       mxy[ista].SetCov(1., 0., 1.);
@@ -515,7 +570,7 @@ namespace cbm::algo::ca
 
       for (int iVec = 0; iVec < nTracks_SIMD; iVec++) {
         int nHitsTrack = t[iVec]->fNofHits;
-        int iSta[constants::size::MaxNstations];
+        int iSta[constants::size::MaxNstations];  // indexed by hit, not by station
 
         for (int ih = 0; ih < nHitsTrack; ih++) {
           const ca::Hit& hit           = input.GetHit(tripletHits[start_hit++]);
@@ -857,10 +912,13 @@ namespace cbm::algo::ca
 
   }  // FitGNNTriplets
 
-  void TrackFitter::FitGNNTracklets(const ca::InputData& input, WindowData& wData, Vector<Track>& trackCandidates,
-                                    Vector<HitIndex_t>& trackHits, Vector<int>& selectedTrackIndexes,
-                                    Vector<float>& selectedTrackScores,
-                                    std::vector<std::vector<float>>& selectedTrackParams, const int GNNiteration)
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<int NStations>
+  void TrackFitter::FitGNNTrackletsImpl(const ca::InputData& input, WindowData& wData,
+                                        Vector<Track>& trackCandidates, Vector<HitIndex_t>& trackHits,
+                                        Vector<int>& selectedTrackIndexes, Vector<float>& selectedTrackScores,
+                                        std::vector<std::vector<float>>& selectedTrackParams, const int GNNiteration)
   {
     // LOG(info) << "Start GNN Tracklet Fitter";
     int start_hit = 0;  // for interation in frAlgo.fSliceRecoHits[]
@@ -873,7 +931,9 @@ namespace cbm::algo::ca
     kf::FieldValue<fvec> fldB01, fldB11, fldB21 _fvecalignment;
     kf::FieldRegion<fvec> fld1 _fvecalignment;
 
-    const int nStations = fParameters.GetNstationsActive();
+    // Per-station state is sized by the compile-time number of stations, if it is known
+    constexpr int kNofStationsMax = (NStations == kAnyNstations) ? constants::size::MaxNstations : NStations;
+    const int nStations           = (NStations == kAnyNstations) ? fParameters.GetNstationsActive() : NStations;
     int nTracks_SIMD    = fvec::size();
 
     kf::TrackKalmanFilter<fvec> fit;  // fit parameters coresponding to the current track
@@ -886,14 +946,14 @@ namespace cbm::algo::ca
     const ca::Station<fvec>* sta = fParameters.GetStations().begin();
 
     // Spatial-time position of a hit vs. station and track in the portion
-    fvec x[constants::size::MaxNstations];                       // Hit position along the x-axis [cm]
-    fvec y[constants::size::MaxNstations];                       // Hit position along the y-axis [cm]
-    kf::MeasurementXy<fvec> mxy[constants::size::MaxNstations];  // Covariance matrix for x,y
+    fvec x[kNofStationsMax];                       // Hit position along the x-axis [cm]
+    fvec y[kNofStationsMax];                       // Hit position along the y-axis [cm]
+    kf::MeasurementXy<fvec> mxy[kNofStationsMax];  // Covariance matrix for x,y
 
-    fvec z[constants::size::MaxNstations];  // Hit position along the z-axis (precised) [cm]
+    fvec z[kNofStationsMax];  // Hit position along the z-axis (precised) [cm]
 
-    fvec time[constants::size::MaxNstations];  // Hit time [ns]
-    fvec dt2[constants::size::MaxNstations];   // Hit time uncertainty [ns] squared
+    fvec time[kNofStationsMax];  // Hit time [ns]
+    fvec dt2[kNofStationsMax];   // Hit time uncertainty [ns] squared
 
     fvec x_first;
     fvec y_first;
@@ -911,9 +971,9 @@ namespace cbm::algo::ca
     fvec wtime_last;
     fvec dt2_last;
 
-    fvec By[constants::size::MaxNstations];
-    fmask w[constants::size::MaxNstations];
-    fmask w_time[constants::size::MaxNstations];  // !!!
+    fvec By[kNofStationsMax];
+    fmask w[kNofStationsMax];
+    fmask w_time[kNofStationsMax];  // !!!
 
     fvec y_temp;
     fvec x_temp;
@@ -923,9 +983,9 @@ namespace cbm::algo::ca
     fvec z_start;
     fvec z_end;
 
-    kf::FieldValue<fvec> fB[constants::size::MaxNstations], fB_temp _fvecalignment;
+    kf::FieldValue<fvec> fB[kNofStationsMax], fB_temp _fvecalignment;
 
-    fvec ZSta[constants::size::MaxNstations];
+    fvec ZSta[kNofStationsMax];
     for (int ista = 0; ista < nStations; ista++) {
       ZSta[ista] = sta[ista].fZ;
       mxy[ista].SetCov(1., 0., 1.);
@@ -957,7 +1017,7 @@ namespace cbm::algo::ca
 
       for (int iVec = 0; iVec < nTracks_SIMD; iVec++) {
         int nHitsTrack = t[iVec]->fNofHits;
-        int iSta[constants::size::MaxNstations];
+        int iSta[constants::size::MaxNstations];  // indexed by hit, not by station
 
         for (int ih = 0; ih < nHitsTrack; ih++) {
           const ca::Hit& hit           = input.GetHit(trackHits[start_hit++]);
@@ -17,6 +17,7 @@
 #include "CaWindowData.h"
 #include "KfTrackParam.h"
 
+#include <utility>
 
 namespace cbm::algo::ca
 {
@@ -26,6 +27,10 @@ namespace cbm::algo::ca
   ///
   class TrackFitter {
    public:
+    /// Numbers of active stations, for which the fit routines are compiled with a compile-time number of stations.
+    /// For other numbers the generic routines, looping up to the run-time number of stations, are used.
+    using CompiledStationCounts_t = std::integer_sequence<int, 4, 5, 6, 7, 8, 9, 10, 11, 12>;
+
     /// Default constructor
     TrackFitter(const ca::Parameters<fvec>& pars, const fscal mass, const ca::TrackingMode& mode);
 
@@ -60,12 +65,53 @@ namespace cbm::algo::ca
                          const int GNNiteration);
 
    private:
+    /// Template parameter of the generic routines, which take the number of stations from the parameters
+    static constexpr int kAnyNstations = 0;
+
+    using FitCaTracksFn_t = void (TrackFitter::*)(const ca::InputData&, WindowData&);
+    using FitGNNFn_t      = void (TrackFitter::*)(const ca::InputData&, WindowData&, Vector<Track>&,
+                                             Vector<HitIndex_t>&, Vector<int>&, Vector<float>&,
+                                             std::vector<std::vector<float>>&, const int);
+
+    /// \brief Selects the fit routines for the number of active stations
+    /// \param nStations  Number of active stations
+    template<int... NStations>
+    void SelectImplementation(int nStations, std::integer_sequence<int, NStations...>);
+
+    /// \brief Sets the fit routines for a given compile-time number of stations
+    template<int NStations>
+    void SetImplementation();
+
+    /// \brief Implementation of FitCaTracks
+    /// \tparam NStations  Number of active stations, or kAnyNstations
+    template<int NStations>
+    void FitCaTracksImpl(const ca::InputData& input, WindowData& wData);
+
+    /// \brief Implementation of FitGNNTriplets
+    /// \tparam NStations  Number of active stations, or kAnyNstations
+    template<int NStations>
+    void FitGNNTripletsImpl(const ca::InputData& input, WindowData& wData, Vector<Track>& tripletCandidates,
+                            Vector<HitIndex_t>& tripletHits, Vector<int>& selectedTripletIndexes,
+                            Vector<float>& selectedTripletScores,
+                            std::vector<std::vector<float>>& selectedTripletParams, const int GNNiteration);
+
+    /// \brief Implementation of FitGNNTracklets
+    /// \tparam NStations  Number of active stations, or kAnyNstations
+    template<int NStations>
+    void FitGNNTrackletsImpl(const ca::InputData& input, WindowData& wData, Vector<Track>& trackCandidates,
+                             Vector<HitIndex_t>& trackHits, Vector<int>& selectedTrackIndexes,
+                             Vector<float>& selectedTrackScores, std::vector<std::vector<float>>& selectedTrackParams,
+                             const int GNNiteration);
+
     ///-------------------------------
     /// Data members
     const Parameters<fvec>& fParameters;            ///< Object of Framework parameters class
     const cbm::algo::kf::Setup<fvec>& fSetup;       ///< Setup instance
     fscal fDefaultMass{constants::phys::MuonMass};  ///< mass of the propagated particle [GeV/c2]
     ca::TrackingMode fTrackingMode;
+    FitCaTracksFn_t fpFitCaTracks{nullptr};  ///< Track fit routine for the number of active stations
+    FitGNNFn_t fpFitGNNTriplets{nullptr};    ///< GNN triplet fit routine for the number of active stations
+    FitGNNFn_t fpFitGNNTracklets{nullptr};   ///< GNN tracklet fit routine for the number of active stations
   };
 
 }  // namespace cbm::algo::ca
@@ -13,13 +13,15 @@
 namespace cbm::algo::ca
 {
 
-  GraphConstructor::GraphConstructor(const ca::InputData& input, WindowData& wData, TrackFitter& fTrackFitter,
-                                     TrackingMonitorData& fMonitorData)
-    : frInput(input)
+  GraphConstructor::GraphConstructor(const ca::InputData& input, WindowData& wData, const Parameters<fvec>& pars,
+                                     TrackFitter& fTrackFitter, TrackingMonitorData& fMonitorData)
+    : frMonitorData(fMonitorData)
+    , frInput(input)
     , frWData(wData)
     , frTrackFitter(fTrackFitter)
-    , frMonitorData(fMonitorData)
+    , NStations(pars.GetNstationsActive())
   {
+    doublets.resize(NStations);
   }
 
   // @brief: for debugging save all found edges as tracks
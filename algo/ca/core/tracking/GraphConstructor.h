@@ -23,8 +23,8 @@ namespace cbm::algo::ca
   class alignas(kf::VcMemAlign) GraphConstructor {
    public:
     /// Constructor
-    GraphConstructor(const ca::InputData& input, WindowData& wData, TrackFitter& fTrackFitter,
-                     TrackingMonitorData& fMonitorData);
+    GraphConstructor(const ca::InputData& input, WindowData& wData, const Parameters<fvec>& pars,
+                     TrackFitter& fTrackFitter, TrackingMonitorData& fMonitorData);
 
     /// Destructor
     ~GraphConstructor() = default;
@@ -58,7 +58,7 @@ namespace cbm::algo::ca
 
     /// -- VARIABLES
 
-    std::vector<std::vector<unsigned int>> doublets[20];  // [sta][lhit][mhit]
+    std::vector<std::vector<std::vector<unsigned int>>> doublets;  // [sta][lhit][mhit]
     /// lhit is index in vGrid(no. of hits on station). use fAlgo.vGrid[sta].GetEntries()[lhit].GetObjectId() to get index in fWindowsHits
     /// doublets[sta][lhit][mhit] = index in frWData
 
@@ -77,7 +77,7 @@ namespace cbm::algo::ca
     WindowData& frWData;
     TrackFitter& frTrackFitter;
 
-    const int NStations = 12;  // set in constructor
+    const int NStations;  // number of active stations, set in constructor
 
     const int maxNeighOrderPrim_        = 20;  // def - 20
     const int maxNeighOrderAllPrim_     = 25;  // def - 25
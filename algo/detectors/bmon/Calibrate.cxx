@@ -11,11 +11,13 @@
 
 #include "AlgoFairloggerCompat.h"
 #include "CbmTofAddress.h"
+#include "util/TaskGraph.h"
 #include "util/TimingsFormat.h"
 
 #include <bitset>
 #include <chrono>
 
+using cbm::algo::TaskTimer;
 using cbm::algo::bmon::Calibrate;
 using cbm::algo::bmon::CalibrateSetup;
 using fles::Subsystem;
@@ -64,8 +66,8 @@ Calibrate::Calibrate(CalibrateSetup setup) : fSetup(setup), fSelectionBitsOffset
 //
 Calibrate::resultType Calibrate::operator()(gsl::span<const CbmBmonDigi> digiIn)
 {
-  xpu::push_timer("BmonCalibrate");
-  xpu::t_add_bytes(digiIn.size_bytes());
+  TaskTimer::Push("BmonCalibrate");
+  TaskTimer::AddBytes(digiIn.size_bytes());
 
   // --- Output data
   resultType result = {};
@@ -155,7 +157,7 @@ Calibrate::resultType Calibrate::operator()(gsl::span<const CbmBmonDigi> digiIn)
   //  std::sort(calDigiOut.begin(), calDigiOut.end(),
   //  [](const CbmTofDigi& a, const CbmTofDigi& b) -> bool { return a.GetTime() < b.GetTime(); });
 
-  monitor.fTime     = xpu::pop_timer();
+  monitor.fTime     = TaskTimer::Pop();
   monitor.fNumDigis = digiIn.size();
   return result;
 }
@@ -9,6 +9,7 @@
 #include "PODVector.h"
 #include "compat/OpenMP.h"
 
+#include <algorithm>
 #include <numeric>
 
 using namespace cbm::algo;
@@ -16,6 +17,7 @@ using namespace cbm::algo;
 void sts::HitfinderChain::SetParameters(const HitfinderChainPars& parameters)
 {
   fPars.emplace(parameters);
+  fDigiMap = {};  // Module map depends on the setup, rebuilt on next timeslice
   AllocateStatic();
   auto& memoryPars = fPars->memory;
 
@@ -58,7 +60,8 @@ sts::HitfinderChain::Result sts::HitfinderChain::operator()(gsl::span<const CbmS
 
   // Getting the digis on the GPU requires 3 steps
   // 1. Sort digis into buckets by module
-  DigiMap digiMap = CountDigisPerModules(digis);
+  DigiMap& digiMap = fDigiMap;
+  CountDigisPerModules(digis, digiMap);
   // 2. Once we know number of digis per module, we can allocate
   //    the dynamic buffers on the gpu, as the buffer sizes depend on that value
   if (fPars->memory.IsDynamic())
@@ -394,7 +397,7 @@ void sts::HitfinderChain::AllocateDynamic(size_t maxNDigisPerModule, size_t nDig
   fHitfinder.hitsFlat.reset(maxHitsTotal, xpu::buf_pinned);
 }
 
-sts::HitfinderChain::DigiMap sts::HitfinderChain::CountDigisPerModules(gsl::span<const CbmStsDigi> digis)
+void sts::HitfinderChain::CountDigisPerModules(gsl::span<const CbmStsDigi> digis, DigiMap& digiMap)
 {
   L_(debug) << "STS Hitfinder Chain: Sorting " << digis.size() << " digis into modules";
   xpu::scoped_timer t_("Count Digis By Module");
@@ -402,34 +405,34 @@ sts::HitfinderChain::DigiMap sts::HitfinderChain::CountDigisPerModules(gsl::span
 
   size_t nModules     = fPars->setup.modules.size();
   size_t nModuleSides = nModules * 2;
-  DigiMap digiMap;
   digiMap.nDigisPerModule.resize(nModuleSides);
 
   // Create map from module address to index
-  // This could be done just once in the beginning,
-  // but overhead is negligible compared to the digi copying
-  digiMap.addrToIndex.resize(1 << 17, InvalidModule);
-  for (size_t m = 0; m < nModules; m++) {
-    const auto& module         = fPars->setup.modules[m];
-    i32 paddr                  = CbmStsAddress::PackDigiAddress(module.address);
-    digiMap.addrToIndex[paddr] = u16(m);
+  // Only depends on the setup, so it's kept until the parameters change
+  if (digiMap.addrToIndex.empty()) {
+    digiMap.addrToIndex.resize(1 << 17, InvalidModule);
+    for (size_t m = 0; m < nModules; m++) {
+      const auto& module         = fPars->setup.modules[m];
+      i32 paddr                  = CbmStsAddress::PackDigiAddress(module.address);
+      digiMap.addrToIndex[paddr] = u16(m);
+    }
   }
 
   int nChannelsPerSide = fPars->setup.nChannels / 2;
 
-  // TODO: try to parallise
-  // Count digis per module in parallel
-  // Then calculate offset per module
-  // Write digis directly to flat array in parallel
-  // Use atomic add to increment offset per module
-  digiMap.nDigisPerThread.resize(openmp::GetMaxThreads());
-  for (auto& v : digiMap.nDigisPerThread)
-    v.resize(nModuleSides, 0);
-
+  // Count digis per module side in parallel, each thread into its own row of the count matrix
+  size_t maxNDigisPerModule = 0;
   CBM_PARALLEL()
   {
-    int threadId = openmp::GetThreadNum();  // Move out of the loop, seems to create small overhead
-    auto& nDigis = digiMap.nDigisPerThread.at(threadId);
+    CBM_OMP(single)
+    {
+      digiMap.nThreads = openmp::GetNumThreads();
+      digiMap.nDigisPerThread.resize(digiMap.nThreads * nModuleSides);
+    }
+
+    int threadId   = openmp::GetThreadNum();  // Move out of the loop, seems to create small overhead
+    size_t* nDigis = &digiMap.nDigisPerThread[threadId * nModuleSides];
+    std::fill_n(nDigis, nModuleSides, 0);  // Row is first touched by the thread using it
 
     CBM_OMP(for schedule(static))
     for (size_t i = 0; i < digis.size(); i++) {
@@ -443,15 +446,19 @@ sts::HitfinderChain::DigiMap sts::HitfinderChain::CountDigisPerModules(gsl::span
       bool isFront = digi.GetChannel() < nChannelsPerSide;
       nDigis[moduleIndex + (isFront ? 0 : nModules)]++;
     }
-  }
 
-
-  // Sum up digis per module
-  for (auto& v : digiMap.nDigisPerThread) {
+    // Sum up digis per module
+    CBM_OMP(for schedule(static) reduction(max : maxNDigisPerModule))
     for (size_t m = 0; m < nModuleSides; m++) {
-      digiMap.nDigisPerModule[m] += v[m];
+      size_t nDigisModule = 0;
+      for (size_t t = 0; t < digiMap.nThreads; t++) {
+        nDigisModule += digiMap.nDigisPerThread[t * nModuleSides + m];
+      }
+      digiMap.nDigisPerModule[m] = nDigisModule;
+      maxNDigisPerModule         = std::max(maxNDigisPerModule, nDigisModule);
     }
   }
+  digiMap.maxNDigisPerModule = maxNDigisPerModule;
 
   // if (nPulsers > 0) L_(warning) << "STS Hitfinder: Discarded " << nPulsers << " pulser digis";
 
@@ -463,13 +470,6 @@ sts::HitfinderChain::DigiMap sts::HitfinderChain::CountDigisPerModules(gsl::span
     L_(debug) << "Module " << moduleAddr << " has " << digiMap.nDigisPerModule[moduleIndex] << " front digis and "
               << digiMap.nDigisPerModule[moduleIndex + nModules] << " back digis";
   }
-
-  digiMap.maxNDigisPerModule = 0;
-  for (const auto& nDigis : digiMap.nDigisPerModule) {
-    digiMap.maxNDigisPerModule = std::max(digiMap.maxNDigisPerModule, nDigis);
-  }
-
-  return digiMap;
 }
 
 void sts::HitfinderChain::FlattenDigis(gsl::span<const CbmStsDigi> digis, DigiMap& digiMap)
@@ -486,26 +486,47 @@ void sts::HitfinderChain::FlattenDigis(gsl::span<const CbmStsDigi> digis, DigiMa
   xpu::h_view pDigisFlat(fHitfinder.digisPerModule);  // Final input copied the GPU
 
   xpu::h_view pMdigiOffset(fHitfinder.digiOffsetPerModule);
-  pMdigiOffset[0] = 0;
-  for (size_t m = 1; m < nModuleSides + 1; m++) {
-    pMdigiOffset[m] = pMdigiOffset[m - 1] + digiMap.nDigisPerModule.at(m - 1);
-  }
 
-  std::vector<std::vector<size_t>> digiOffsetsPerThread(openmp::GetMaxThreads());
-  for (auto& v : digiOffsetsPerThread)
-    v.resize(nModuleSides);
-  for (size_t i = 1; i < digiOffsetsPerThread.size(); i++) {
-    for (size_t m = 0; m < nModuleSides; m++) {
-      for (size_t j = 0; j < i; j++) {
-        digiOffsetsPerThread[i][m] += digiMap.nDigisPerThread[j][m];
-      }
-    }
-  }
+  // Exclusive prefix sum over the count matrix in (module side, thread) order:
+  // Gives the offset of the first digi of each thread in each module side.
+  // Each thread scans a contiguous range of module sides, starting at the sum of all digis in the preceding ranges.
+  size_t* digiOffsets = digiMap.nDigisPerThread.data();  // Counts are replaced by offsets in place
+  std::vector<size_t> chunkOffsets(openmp::GetMaxThreads() + 1, 0);
 
   CBM_PARALLEL()
   {
-    int threadId      = openmp::GetThreadNum();  // Move out of the loop, seems to create small overhead
-    auto& digiOffsets = digiOffsetsPerThread.at(threadId);
+    size_t nChunks = openmp::GetNumThreads();
+    size_t iChunk  = openmp::GetThreadNum();
+    size_t mBegin  = nModuleSides * iChunk / nChunks;
+    size_t mEnd    = nModuleSides * (iChunk + 1) / nChunks;
+
+    size_t nDigisChunk = 0;
+    for (size_t m = mBegin; m < mEnd; m++) {
+      nDigisChunk += digiMap.nDigisPerModule[m];
+    }
+    chunkOffsets[iChunk + 1] = nDigisChunk;
+
+    CBM_OMP(barrier)
+    CBM_OMP(single)
+    std::partial_sum(chunkOffsets.begin(), chunkOffsets.begin() + nChunks + 1, chunkOffsets.begin());
+
+    size_t offset = chunkOffsets[iChunk];
+    for (size_t m = mBegin; m < mEnd; m++) {
+      pMdigiOffset[m] = offset;
+      for (size_t t = 0; t < digiMap.nThreads; t++) {
+        size_t nDigis                     = digiOffsets[t * nModuleSides + m];
+        digiOffsets[t * nModuleSides + m] = offset;
+        offset += nDigis;
+      }
+    }
+    if (iChunk == nChunks - 1) pMdigiOffset[nModuleSides] = chunkOffsets[nChunks];
+
+    CBM_OMP(barrier)
+
+    // Scatter digis with the same schedule used for counting,
+    // so every thread writes its digis behind those of the threads before it.
+    int threadId          = openmp::GetThreadNum();  // Move out of the loop, seems to create small overhead
+    size_t* threadOffsets = &digiOffsets[threadId * nModuleSides];
 
     CBM_OMP(for schedule(static))
     for (size_t i = 0; i < digis.size(); i++) {
@@ -518,10 +539,7 @@ void sts::HitfinderChain::FlattenDigis(gsl::span<const CbmStsDigi> digis, DigiMa
       bool isFront = digi.GetChannel() < nChannelsPerSide;
       moduleIndex += isFront ? 0 : nModules;
 
-      size_t moduleOffset = pMdigiOffset[moduleIndex];
-      size_t digiOffset   = digiOffsets[moduleIndex]++;
-
-      pDigisFlat[moduleOffset + digiOffset] = digi;
+      pDigisFlat[threadOffsets[moduleIndex]++] = digi;
     }
   }
 
@@ -6,6 +6,7 @@
 #define CBM_ALGO_STS_HITFINDER_CHAIN_H
 
 #include "CbmStsDigi.h"
+#include "PODVector.h"
 #include "PartitionedSpan.h"
 #include "PartitionedVector.h"
 #include "SubChain.h"
@@ -70,8 +71,11 @@ namespace cbm::algo::sts
       std::vector<u16> addrToIndex;
       // Map modules to number of Digis, 2 * NModules entries, first half is front, second half is back
       std::vector<size_t> nDigisPerModule;
-      std::vector<std::vector<size_t>> nDigisPerThread;  //< Number of digis per module per thread [thread][module]
-      size_t maxNDigisPerModule = 0;                     //< Upper bound on number of digis per module
+      // Number of digis per module side per thread [thread * nModuleSides + side].
+      // FlattenDigis turns the counts into the offsets of the digis of each thread in the flat digi array.
+      PODVector<size_t> nDigisPerThread;
+      size_t nThreads           = 0;  //< Number of threads that counted the digis
+      size_t maxNDigisPerModule = 0;  //< Upper bound on number of digis per module
 
       u16 ModuleIndex(const CbmStsDigi& digi) const
       {
@@ -101,7 +105,7 @@ namespace cbm::algo::sts
     /**
       * Count Digis per module.
       */
-    DigiMap CountDigisPerModules(gsl::span<const CbmStsDigi> digis);
+    void CountDigisPerModules(gsl::span<const CbmStsDigi> digis, DigiMap& digiMap);
 
     /**
       * Copy Digis into flat array that can be copied to the GPU.
@@ -153,6 +157,9 @@ namespace cbm::algo::sts
 
     Hitfinder fHitfinder;
 
+    // Digi counts and offsets per module, storage is reused across timeslices
+    DigiMap fDigiMap;
+
     // Output buffer, used by the returned PartitionedSpan
     std::vector<u32> fAddresses;
     std::vector<size_t> fHitOffsets;
@@ -5,9 +5,13 @@
 #include "UnpackMS.h"
 
 #include "AlgoFairloggerCompat.h"
+#include "CbmStsAddress.h"
 #include "StsRecoUtils.h"
 #include "StsXyterMessage.h"
+#include "compat/OpenMP.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
@@ -20,9 +24,56 @@ using std::vector;
 namespace cbm::algo::sts
 {
 
-  UnpackMS::UnpackMS(const UnpackPar& pars) : fParams(pars) {}
+  UnpackMS::UnpackMS(const UnpackPar& pars) : fParams(pars) { InitLookupTables(); }
   UnpackMS::~UnpackMS() = default;
 
+  // ----   Initialisation of lookup tables   ---------------------------------
+  void UnpackMS::InitLookupTables()
+  {
+    // --- The tables cover all eLink indices, which can be encoded in a message, so the eLink needs no range check
+    // --- when unpacking. eLinks not contained in the parameters are flagged.
+    fChanPars.assign(fkNumElinks * fkNumChannels, ChannelPar{});
+    fAdcPars.assign(fkNumElinks * fkNumAdcValues, AdcPar{});
+    for (uint32_t elink = 0; elink < fkNumElinks; elink++) {
+      AdcPar* adcPars = &fAdcPars[elink * fkNumAdcValues];
+      if (elink >= fParams.fElinkParams.size()) {
+        for (uint32_t adc = 0; adc < fkNumAdcValues; adc++) {
+          adcPars[adc].flags = kElinkOutOfRange;
+        }
+        continue;
+      }
+      const UnpackElinkPar& elinkPar = fParams.fElinkParams[elink];
+
+      // --- Hardware-to-software address, masked channels. eLinks without connected module have no valid address
+      // --- (-1 in the readout config, which is not even a known address version), hits on them are counted as errors
+      // --- and dropped.
+      ChannelPar* chanPars = &fChanPars[elink * fkNumChannels];
+      const bool connected = CbmStsAddress::GetVersion(elinkPar.fAddress) <= CbmStsAddress::kCurrentVersion
+                             && CbmStsAddress::GetSystemId(elinkPar.fAddress) == ECbmModuleId::kSts;
+      for (uint16_t chan = 0; connected && chan < fkNumChannels; chan++) {
+        if (!elinkPar.fChanMask.empty() && elinkPar.fChanMask[chan] == true) continue;
+        const auto maybe_channel = Module::ChannelInModule(chan, elinkPar.fAsicNr);
+        if (!maybe_channel.has_value()) continue;
+        chanPars[chan].digi   = CbmStsDigi(elinkPar.fAddress, *maybe_channel, 0, 0);
+        chanPars[chan].active = 1;
+      }
+
+      // --- ADC cut, walk correction and charge. ADC = 0 is not a hit message.
+      for (uint32_t adc = 1; adc < fkNumAdcValues; adc++) {
+        AdcPar& adcPar    = adcPars[adc];
+        adcPar.timeOffset = elinkPar.fTimeOffset;
+        adcPar.charge     = static_cast<uint16_t>(elinkPar.fAdcOffset + (adc - 1) * elinkPar.fAdcGain);
+        if (adc > elinkPar.fAdcMinCut) adcPar.flags |= kAboveCut;
+        if (adc <= elinkPar.fWalk.size()) {
+          adcPar.walk = elinkPar.fWalk[adc - 1];
+          adcPar.flags |= kApplyWalk;
+        }
+        if (!connected) adcPar.flags |= kNotConnected;
+      }
+    }
+  }
+  // --------------------------------------------------------------------------
+
   // ----   Algorithm execution   ---------------------------------------------
   UnpackMS::Result_t UnpackMS::operator()(const uint8_t* msContent, const fles::MicrosliceDescriptor& msDescr,
                                           const uint64_t tTimeslice) const
@@ -54,8 +105,11 @@ namespace cbm::algo::sts
       return result;
     }
 
+    // --- Digis are written branch-free into a buffer sized for the worst case and truncated at the end
     const u32 maxDigis = numMessages - 2;  // -2 for the TS_MSB and EPOCH messages
-    std::get<0>(result).reserve(maxDigis);
+    auto& digis        = std::get<0>(result);
+    digis.resize(maxDigis);
+    size_t numDigis = 0;
 
     // --- Interpret MS content as sequence of SMX messages
     auto message = reinterpret_cast<const stsxyter::Message*>(msContent);
@@ -64,6 +118,7 @@ namespace cbm::algo::sts
     if (message[0].GetMessType() != stsxyter::MessType::Epoch) {
       L_(error) << "First message in microslice is not of type EPOCH";
       std::get<1>(result).fNumErrInvalidFirstMessage++;
+      digis.clear();
       return result;
     }
 
@@ -71,97 +126,107 @@ namespace cbm::algo::sts
     if (message[1].GetMessType() != stsxyter::MessType::TsMsb) {
       L_(error) << "Second message in microslice is not of type TS_MSB";
       std::get<1>(result).fNumErrInvalidFirstMessage++;
+      digis.clear();
       return result;
     }
     ProcessTsmsbMessage(message[1], time);
 
-    // --- Message loop
-    for (uint32_t messageNr = 2; messageNr < numMessages; messageNr++) {
-
-      // --- Action depending on message type
-      switch (message[messageNr].GetMessType()) {
-
-        case stsxyter::MessType::Hit: {
-          ProcessHitMessage(message[messageNr], time, std::get<0>(result), std::get<1>(result), std::get<2>(result));
-          break;
-        }
-        case stsxyter::MessType::TsMsb: {
-          ProcessTsmsbMessage(message[messageNr], time);
-          break;
-        }
-        default: {
-          std::get<1>(result).fNumNonHitOrTsbMessage++;
-          break;
-        }
-
-      }  //? Message type
-
-    }  //# Messages
-
+    // --- Message loop, in blocks of messages
+    for (uint32_t blockStart = 2; blockStart < numMessages; blockStart += fkBlockSize) {
+      const uint32_t blockSize = std::min(fkBlockSize, numMessages - blockStart);
+      const auto* block        = message + blockStart;
+
+      // --- Classify the messages of the block: same as stsxyter::Message::GetMessType(), but for hit and TS_MSB only
+      std::array<uint8_t, fkBlockSize> isHit;
+      std::array<uint8_t, fkBlockSize> isTsmsb;
+      uint32_t numTsmsb = 0;
+      uint32_t numOther = 0;
+      CBM_OMP(simd reduction(+ : numTsmsb, numOther))
+      for (uint32_t i = 0; i < blockSize; i++) {
+        const uint32_t data    = block[i].GetData();
+        const uint32_t notHit  = data >> stsxyter::kusPosNotHitFlag;
+        const uint32_t subtype = (data >> stsxyter::kusPosSubtype) & ((1u << stsxyter::kusLenSubtype) - 1);
+        const uint32_t adc     = (data >> stsxyter::kusPosHitAdc) & (fkNumAdcValues - 1);
+        isHit[i]               = (notHit == 0) & (adc != 0);
+        isTsmsb[i]               = (notHit == 1) & (subtype == static_cast<uint32_t>(stsxyter::MessSubType::TsMsb));
+        numTsmsb += isTsmsb[i];
+        numOther += 1 - isHit[i] - isTsmsb[i];
+      }
+      std::get<1>(result).fNumNonHitOrTsbMessage += numOther;
+
+      // --- Hits between TS_MSB messages share the epoch time
+      uint32_t segmentStart = 0;
+      for (uint32_t i = 0; numTsmsb > 0 && i < blockSize; i++) {
+        if (!isTsmsb[i]) continue;
+        ProcessHitMessages(block + segmentStart, isHit.data() + segmentStart, i - segmentStart, time, digis.data(),
+                           numDigis, std::get<1>(result), std::get<2>(result));
+        ProcessTsmsbMessage(block[i], time);
+        segmentStart = i + 1;
+        numTsmsb--;
+      }
+      ProcessHitMessages(block + segmentStart, isHit.data() + segmentStart, blockSize - segmentStart, time,
+                         digis.data(), numDigis, std::get<1>(result), std::get<2>(result));
+
+    }  //# Message blocks
+
+    digis.resize(numDigis);
     return result;
   }
   // --------------------------------------------------------------------------
 
 
-  // -----   Process hit message   --------------------------------------------
-  inline void UnpackMS::ProcessHitMessage(const stsxyter::Message& message, const TimeSpec& time,
-                                          vector<CbmStsDigi>& digiVec, UnpackMonitorData& monitor,
-                                          UnpackAuxData& aux) const
+  // -----   Process hit messages   -------------------------------------------
+  inline void UnpackMS::ProcessHitMessages(const stsxyter::Message* messages, const uint8_t* isHit,
+                                           uint32_t numMessages, const TimeSpec& time, CbmStsDigi* digis,
+                                           size_t& numDigis, UnpackMonitorData& monitor, UnpackAuxData& aux) const
   {
-
-    // --- Check eLink and get parameters
-    uint16_t elink = message.GetLinkIndexHitBinning();
-    if (elink >= fParams.fElinkParams.size()) {
-      monitor.fNumErrElinkOutOfRange++;
-      return;
-    }
-    const UnpackElinkPar& elinkPar = fParams.fElinkParams.at(elink);
-    uint32_t asicNr                = elinkPar.fAsicNr;
-
-    // --- Check minimum adc cut
-    if (message.GetHitAdc() <= elinkPar.fAdcMinCut) {
-      return;
-    }
-
-    // --- Check for masked channel
-    const uint16_t msg_channel = message.GetHitChannel();
-    if (!elinkPar.fChanMask.empty() && elinkPar.fChanMask[msg_channel] == true) {
-      return;
-    }
-
-    // --- Hardware-to-software address
-    const auto maybe_channel = Module::ChannelInModule(msg_channel, asicNr);
-    if (!maybe_channel.has_value()) return;
-
-    // --- Expand time stamp to time within timeslice (in clock cycle)
-    uint64_t messageTime = message.GetHitTimeBinning() + time.currentEpochTime;
-
-    // --- Convert time stamp from clock cycles to ns. Round to nearest full ns.
-    messageTime = (messageTime * fkClockCycleNom + fkClockCycleDen / 2) / fkClockCycleDen;
-
-    // --- Correct ASIC-wise offsets
-    messageTime -= elinkPar.fTimeOffset;
-
-    // --- Apply walk correction if applicable
-    if (message.GetHitAdc() <= elinkPar.fWalk.size()) {
-      double walk = elinkPar.fWalk[message.GetHitAdc() - 1];
-      messageTime += walk;
-    }
-
-    // --- Charge
-    double charge = elinkPar.fAdcOffset + (message.GetHitAdc() - 1) * elinkPar.fAdcGain;
-
-    if (messageTime > CbmStsDigi::kMaxTimestamp) {
-      monitor.fNumErrTimestampOverflow++;
-      return;
-    }
-
-    // --- Create output digi
-    digiVec.emplace_back(elinkPar.fAddress, *maybe_channel, messageTime, charge);
-
-    if (fParams.fWriteAux) {
-      aux.fQaDigis.emplace_back(message.IsHitMissedEvts(), elinkPar.fAddress, *maybe_channel, messageTime, charge,
-                                elink);
+    const ChannelPar* chanPars = fChanPars.data();
+    const AdcPar* adcPars      = fAdcPars.data();
+
+    for (uint32_t messageNr = 0; messageNr < numMessages; messageNr++) {
+      const stsxyter::Message& message = messages[messageNr];
+
+      // --- Parameters of the eLink, channel and ADC value
+      const uint16_t elink       = message.GetLinkIndexHitBinning();
+      const uint16_t msg_channel = message.GetHitChannel();
+      const uint16_t adc         = message.GetHitAdc();
+      const ChannelPar& chanPar  = chanPars[elink * fkNumChannels + msg_channel];
+      const AdcPar& adcPar       = adcPars[elink * fkNumAdcValues + adc];
+
+      // --- Expand time stamp to time within timeslice (in clock cycle)
+      uint64_t messageTime = message.GetHitTimeBinning() + time.currentEpochTime;
+
+      // --- Convert time stamp from clock cycles to ns. Round to nearest full ns.
+      messageTime = (messageTime * fkClockCycleNom + fkClockCycleDen / 2) / fkClockCycleDen;
+
+      // --- Correct ASIC-wise offsets
+      messageTime -= adcPar.timeOffset;
+
+      // --- Apply walk correction if applicable
+      if (adcPar.flags & kApplyWalk) {
+        messageTime += adcPar.walk;
+      }
+
+      // --- Checks: eLink range, connected module, minimum ADC cut, masked channel, time stamp overflow
+      const uint32_t hit      = isHit[messageNr];
+      const uint32_t accepted = hit & (adcPar.flags & kAboveCut) & chanPar.active;
+      const uint32_t overflow = messageTime > CbmStsDigi::kMaxTimestamp;
+      monitor.fNumErrElinkOutOfRange += hit & ((adcPar.flags & kElinkOutOfRange) != 0);
+      monitor.fNumErrElinkNotConnected += hit & ((adcPar.flags & kNotConnected) != 0);
+      monitor.fNumErrTimestampOverflow += accepted & overflow;
+
+      // --- Create output digi, kept only if accepted
+      CbmStsDigi& digi = digis[numDigis];
+      digi             = chanPar.digi;
+      digi.SetTime(messageTime);
+      digi.SetCharge(adcPar.charge);
+      const uint32_t valid = accepted & (overflow ^ 1);
+
+      if (fParams.fWriteAux && valid) {
+        aux.fQaDigis.emplace_back(message.IsHitMissedEvts(), digi.GetAddress(), digi.GetChannel(), messageTime,
+                                  adcPar.charge, elink);
+      }
+      numDigis += valid;
     }
   }
   // --------------------------------------------------------------------------
@@ -59,17 +59,19 @@ namespace cbm::algo::sts
     uint32_t fNumErrInvalidFirstMessage = 0;  ///< First message is not TS_MSB or second is not EPOCH
     uint32_t fNumErrInvalidMsSize       = 0;  ///< Microslice size is not multiple of message size
     uint32_t fNumErrTimestampOverflow   = 0;  ///< Overflow in 64 bit time stamp
+    uint32_t fNumErrElinkNotConnected   = 0;  ///< Hit on an eLink without connected module (no valid STS address)
     bool HasErrors()
     {
       uint32_t numErrors = fNumNonHitOrTsbMessage + fNumErrElinkOutOfRange + fNumErrInvalidFirstMessage
-                           + fNumErrInvalidMsSize + fNumErrTimestampOverflow;
+                           + fNumErrInvalidMsSize + fNumErrTimestampOverflow + fNumErrElinkNotConnected;
       return (numErrors > 0 ? true : false);
     }
     std::string print()
     {
       std::stringstream ss;
       ss << "errors " << fNumNonHitOrTsbMessage << " | " << fNumErrElinkOutOfRange << " | "
-         << fNumErrInvalidFirstMessage << " | " << fNumErrInvalidMsSize << " | " << fNumErrTimestampOverflow << " | ";
+         << fNumErrInvalidFirstMessage << " | " << fNumErrInvalidMsSize << " | " << fNumErrTimestampOverflow << " | "
+         << fNumErrElinkNotConnected << " | ";
       return ss.str();
     }
   };
@@ -137,7 +139,11 @@ namespace cbm::algo::sts
     /** @brief Set the parameter container
      ** @param params Pointer to parameter container
      **/
-    void SetParams(std::unique_ptr<UnpackPar> params) { fParams = *(std::move(params)); }
+    void SetParams(std::unique_ptr<UnpackPar> params)
+    {
+      fParams = *(std::move(params));
+      InitLookupTables();
+    }
 
    private:  // types
     /**
@@ -150,15 +156,48 @@ namespace cbm::algo::sts
       u64 currentEpochTime = 0;  ///< Current epoch time relative to timeslice in clock cycles
     };
 
+    /** @brief Unpacking parameters of a readout channel, indexed by (eLink, channel in ASIC) **/
+    struct ChannelPar {
+      CbmStsDigi digi;      ///< Digi with module address and channel in module; time and charge are set on unpacking
+      uint32_t active = 0;  ///< 1 if the channel exists and is not masked, 0 otherwise
+    };
+
+    /** @brief Unpacking parameters depending on the ADC value, indexed by (eLink, ADC) **/
+    struct AdcPar {
+      uint64_t timeOffset = 0;   ///< Time calibration parameter of the eLink
+      double walk         = 0.;  ///< Walk correction
+      uint16_t charge     = 0;   ///< Calibrated charge
+      uint8_t flags       = 0;   ///< Combination of AdcFlags
+    };
+
+    /** @brief Flags of AdcPar **/
+    enum AdcFlags : uint8_t
+    {
+      kAboveCut        = 1 << 0,  ///< ADC value passes the minimum ADC cut of the eLink
+      kApplyWalk       = 1 << 1,  ///< Walk correction is defined for the ADC value
+      kElinkOutOfRange = 1 << 2,  ///< eLink is not contained in the parameters
+      kNotConnected    = 1 << 3,  ///< eLink has no connected module
+    };
+
    private:  // methods
-    /** @brief Process a hit message
-     ** @param message SMX message (32-bit word)
-     ** @param digiVec Vector to append the created digi to
+    /** @brief Flatten the eLink parameters into the lookup tables used for unpacking **/
+    void InitLookupTables();
+
+    /** @brief Process a sequence of messages without TS_MSB messages in between
+     ** @param messages SMX messages (32-bit words)
+     ** @param isHit    Flags for messages of type hit (1 for a hit message, 0 otherwise)
+     ** @param numMessages Number of messages
+     ** @param time     Time information of the current epoch
+     ** @param digis    Output buffer, at least numMessages digis after numDigis
+     ** @param numDigis Number of digis in the output buffer, incremented for each created digi
      ** @param monitor Reference to monitor object
      ** @param aux Reference to auxiliary data object
+     **
+     ** Digis are written for every message and kept only for valid hits, so the loop has no data dependent branches.
      **/
-    void ProcessHitMessage(const stsxyter::Message& message, const TimeSpec& time, std::vector<CbmStsDigi>& digiVec,
-                           UnpackMonitorData& monitor, UnpackAuxData& aux) const;
+    void ProcessHitMessages(const stsxyter::Message* messages, const uint8_t* isHit, uint32_t numMessages,
+                            const TimeSpec& time, CbmStsDigi* digis, size_t& numDigis, UnpackMonitorData& monitor,
+                            UnpackAuxData& aux) const;
 
     /** @brief Process an epoch message (TS_MSB)
      ** @param message SMX message (32-bit word)
@@ -166,8 +205,18 @@ namespace cbm::algo::sts
     void ProcessTsmsbMessage(const stsxyter::Message& message, TimeSpec& time) const;
 
 
-   private:                  // members
-    UnpackPar fParams = {};  ///< Parameter container
+   private:                             // members
+    UnpackPar fParams = {};             ///< Parameter container
+    std::vector<ChannelPar> fChanPars;  ///< Channel parameters [eLink * fkNumChannels + channel]
+    std::vector<AdcPar> fAdcPars;       ///< ADC dependent parameters [eLink * fkNumAdcValues + ADC]
+
+    /** Number of eLink indices, channels per ASIC and ADC values, which can be encoded in a hit message **/
+    static constexpr uint32_t fkNumElinks    = 1 << 6;
+    static constexpr uint32_t fkNumChannels  = 1 << stsxyter::kusLenHitChannel;
+    static constexpr uint32_t fkNumAdcValues = 1 << stsxyter::kusLenHitAdc;
+
+    /** Number of messages classified at once **/
+    static constexpr uint32_t fkBlockSize = 64;
 
     /** Number of TS_MSB epochs per cycle **/
     static constexpr uint64_t fkEpochsPerCycle = stsxyter::kuTsMsbNbTsBinsBinning;
@@ -5,6 +5,7 @@
 #include "Calibrate.h"
 
 #include "AlgoFairloggerCompat.h"
+#include "util/TaskGraph.h"
 #include "util/TimingsFormat.h"
 
 #include <chrono>
@@ -37,8 +38,8 @@ namespace cbm::algo::tof
   // -----   Execution   -------------------------------------------------------
   Calibrate::resultType Calibrate::operator()(gsl::span<const CbmTofDigi> digiIn)
   {
-    xpu::push_timer("TofCalibrate");
-    xpu::t_add_bytes(digiIn.size_bytes());
+    TaskTimer::Push("TofCalibrate");
+    TaskTimer::AddBytes(digiIn.size_bytes());
 
     // --- Output data
     resultType result = {};
@@ -133,7 +134,7 @@ namespace cbm::algo::tof
     //  std::sort(calDigiOut.begin(), calDigiOut.end(),
     //  [](const CbmTofDigi& a, const CbmTofDigi& b) -> bool { return a.GetTime() < b.GetTime(); });
 
-    monitor.fTime     = xpu::pop_timer();
+    monitor.fTime     = TaskTimer::Pop();
     monitor.fNumDigis = digiIn.size();
     return result;
   }
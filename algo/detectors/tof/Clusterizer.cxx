@@ -16,34 +16,15 @@
 namespace cbm::algo::tof
 {
 
-  Clusterizer::resultType Clusterizer::operator()(const std::vector<std::pair<CbmTofDigi, int32_t>>& digisIn)
+  Clusterizer::resultType Clusterizer::operator()(gsl::span<DigiRef> digisIn, gsl::span<const uint32_t> chanOffsets)
   {
-    std::vector<inputType> input = chanSortDigis(digisIn);
-    return buildClusters(input);
-  }
-
-  std::vector<Clusterizer::inputType>
-  Clusterizer::chanSortDigis(const std::vector<std::pair<CbmTofDigi, int32_t>>& digisIn)
-  {
-    std::vector<inputType> result(fParams.fChanPar.size());  //[nbCh][nDigis]
-
-    // Bucket-sort by channel
-    for (size_t iDigi = 0; iDigi < digisIn.size(); iDigi++) {
-      const CbmTofDigi* pDigi = &digisIn[iDigi].first;
-      const int32_t index     = digisIn[iDigi].second;
-      const double chan       = pDigi->GetChannel();
-      result[chan].emplace_back(pDigi, index);
+    // Digis are already sorted by channel, only the channel ranges are needed
+    fChanDigis.resize(NumChan());
+    for (size_t chan = 0; chan < fChanDigis.size(); chan++) {
+      fChanDigis[chan].first = digisIn.data() + (chanOffsets[chan] - chanOffsets[0]);
+      fChanDigis[chan].last  = digisIn.data() + (chanOffsets[chan + 1] - chanOffsets[0]);
     }
-
-    /// Sort channel-wise by time    // not needed if digis are pre-sorted
-    //for (size_t chan = 0; chan < fParams.fChanPar.size(); chan++) {
-    //  std::sort(
-    //    result[chan].begin(), result[chan].end(),
-    //    [](const std::pair<const CbmTofDigi*, int32_t>& a, const std::pair<const CbmTofDigi*, int32_t>& b) -> bool {
-    //      return a.first->GetTime() < b.first->GetTime();
-    //    });
-    //}
-    return result;
+    return buildClusters(fChanDigis);
   }
 
   //Iterator-based version. Faster than index-based version.
@@ -67,7 +48,8 @@ namespace cbm::algo::tof
     const size_t numChan = fParams.fChanPar.size();
 
     //Store last position in input channels to avoid unnecessary checks in AddNextChan().
-    std::vector<inputType::iterator> lastChanPos;
+    std::vector<DigiRef*>& lastChanPos = fLastChanPos;
+    lastChanPos.clear();
     for (size_t chan = 0; chan < numChan; chan++) {
       lastChanPos.push_back(input[chan].begin());
     }
@@ -177,7 +159,7 @@ namespace cbm::algo::tof
       chanSizes.back() = clustersOut.size() - chanSizes.back();
 
       // In rare cases, a single digi remains and is deleted here.
-      storDigi.clear();
+      storDigi.last = storDigi.first;
     }  // for( int32_t chan = 0; chan < iNbCh; chan++ )
 
     // Now check if another hit/cluster is started
@@ -193,7 +175,7 @@ namespace cbm::algo::tof
 
   bool Clusterizer::AddNextChan(std::vector<inputType>& input, int32_t lastChan, Hit& cluster,
                                 std::vector<Hit>& clustersOut, std::vector<int32_t>& digiIndRef,
-                                std::vector<inputType::iterator>* lastChanPos)
+                                std::vector<DigiRef*>* lastChanPos)
   {
     //D.Smith 25.8.23: Why are "C" digis (position "2") not considered here?
 
@@ -291,7 +273,7 @@ namespace cbm::algo::tof
         // remove digis at positions i1 and i2 from pool in efficient way (replaces two vector::erase calls).
         std::move(i1 + 1, i2, i1);
         std::move(i2 + 1, storDigi.end(), i2 - 1);
-        storDigi.resize(storDigi.size() - 2);
+        storDigi.last -= 2;
 
         if (AddNextChan(input, chan, cluster, clustersOut, digiIndRef)) {
           return true;  // signal hit was already added
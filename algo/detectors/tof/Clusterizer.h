@@ -20,12 +20,17 @@ class CbmTofDigi;
 #include <memory>
 #include <vector>
 
+#include <gsl/span>
+
 namespace cbm::algo::tof
 {
   class Clusterizer {
    public:
     typedef std::tuple<std::vector<Hit>, std::vector<size_t>, std::vector<u32>, std::vector<int32_t>> resultType;
 
+    /** @brief Reference to an input digi: pointer and index in the digi timeslice **/
+    typedef std::pair<const CbmTofDigi*, int32_t> DigiRef;
+
     /**
        ** @brief Constructor.
        **/
@@ -38,20 +43,37 @@ namespace cbm::algo::tof
 
     /**
        ** @brief Build clusters out of ToF Digis and store the resulting info in a TofHit.
+       ** @param digisIn Digis of the RPC, sorted by channel and time within each channel. Modified during clustering.
+       ** @param chanOffsets Start of each channel and end of the last one [NumChan() + 1]. Offsets may refer to a larger
+       ** buffer, digisIn starts at chanOffsets[0].
+       **/
+    resultType operator()(gsl::span<DigiRef> digisIn, gsl::span<const uint32_t> chanOffsets);
+
+    /**
+       ** @brief Number of channels of the RPC
        **/
-    resultType operator()(const std::vector<std::pair<CbmTofDigi, int32_t>>& digisIn);
+    size_t NumChan() const { return fParams.fChanPar.size(); }
 
    private:
-    typedef std::vector<std::pair<const CbmTofDigi*, int32_t>> inputType;
+    /** @brief Digis of a single channel, a range of the input buffer which shrinks as digis are used **/
+    struct inputType {
+      DigiRef* first = nullptr;
+      DigiRef* last  = nullptr;
+
+      DigiRef* begin() const { return first; }
+      DigiRef* end() const { return last; }
+      size_t size() const { return last - first; }
+    };
 
     ClusterizerRpcPar fParams;  ///< Parameter container
 
-    std::vector<inputType> chanSortDigis(const std::vector<std::pair<CbmTofDigi, int32_t>>& digisIn);
+    std::vector<inputType> fChanDigis;   ///< Digis per channel, reused between timeslices
+    std::vector<DigiRef*> fLastChanPos;  ///< Last position in the input channels, reused between timeslices
 
     resultType buildClusters(std::vector<inputType>& input);
 
     bool AddNextChan(std::vector<inputType>& input, int32_t iLastChan, Hit& cluster, std::vector<Hit>& clustersOut,
-                     std::vector<int32_t>& digiIndRef, std::vector<inputType::iterator>* lastChanPos = nullptr);
+                     std::vector<int32_t>& digiIndRef, std::vector<DigiRef*>* lastChanPos = nullptr);
   };
 
 }  // namespace cbm::algo::tof
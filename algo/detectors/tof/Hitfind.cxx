@@ -6,6 +6,7 @@
 
 #include "AlgoFairloggerCompat.h"
 #include "compat/OpenMP.h"
+#include "util/TaskGraph.h"
 #include "util/TimingsFormat.h"
 
 #include <chrono>
@@ -16,15 +17,16 @@ using fles::Subsystem;
 namespace cbm::algo::tof
 {
   // -----   Constructor   ------------------------------------------------------
-  Hitfind::Hitfind(tof::HitfindSetup setup) : fNbSm(setup.NbSm), fNbRpc(setup.NbRpc), fStorDigi(fNbSm.size())
+  Hitfind::Hitfind(tof::HitfindSetup setup) : fNbSm(setup.NbSm), fNbRpc(setup.NbRpc), fRpcOffset(fNbSm.size())
   {
+    fChanOffset.push_back(0);
 
     // Create one algorithm per RPC for TOF and configure it with parametersa
     for (uint32_t SmType = 0; SmType < fNbSm.size(); SmType++) {
 
       int32_t NbSm  = fNbSm[SmType];
       int32_t NbRpc = fNbRpc[SmType];
-      fStorDigi[SmType].resize(NbSm * NbRpc);
+      fRpcOffset[SmType] = fAlgo.size();
 
       for (int32_t Sm = 0; Sm < NbSm; Sm++) {
         for (int32_t Rpc = 0; Rpc < NbRpc; Rpc++) {
@@ -59,8 +61,8 @@ namespace cbm::algo::tof
           }
           fAlgo.emplace_back(std::move(*par));
 
-          // fill unique rpc pointer vectors for parallelization
-          fStorDigiPtr.push_back(&fStorDigi[SmType][Sm * NbRpc + Rpc]);
+          // flat channel numbering over all RPCs for the digi sorting
+          fChanOffset.push_back(fChanOffset.back() + NbChan);
         }
       }
     }
@@ -79,24 +81,60 @@ namespace cbm::algo::tof
     auto& monitor   = std::get<1>(result);
     auto& digiInd   = std::get<2>(result);
 
-    // Loop over the digis array and store the Digis in separate vectors for
-    // each RPC modules
-    xpu::push_timer("TofHitfindChanSort");
-    for (size_t idigi = 0; idigi < digiIn.size(); idigi++) {
-      CbmTofDigi* pDigi = &(digiIn[idigi]);
-
-      // These are doubles in the digi class
-      const double SmType = pDigi->GetType();
-      const double Sm     = pDigi->GetSm();
-      const double Rpc    = pDigi->GetRpc();
-      const int NbRpc     = fNbRpc[SmType];
-      if (SmType >= fNbSm.size() || Sm * NbRpc + Rpc >= fNbSm[SmType] * NbRpc) {
-        // Error already counted for monitoring during Digis calibration, so just discard here
-        continue;
+    // Counting sort of the digis by RPC and channel into one flat buffer: count digis per thread and channel,
+    // prefix sum over channels and threads, then scatter. Both loops use the same static schedule, so each thread
+    // scatters exactly the digis it counted, which keeps the time order within the channels.
+    TaskTimer::Push("TofHitfindChanSort");
+    const size_t nChan = fChanOffset.back();
+    fDigiChan.resize(digiIn.size());
+    fChanDigiOffset.resize(nChan + 1);
+
+    CBM_PARALLEL()
+    {
+      const int ithread  = openmp::GetThreadNum();
+      const int nthreads = openmp::GetNumThreads();
+
+      CBM_OMP(single)
+      {
+        fChanCount.assign(nthreads * nChan, 0);
+      }
+
+      uint32_t* chanCount = fChanCount.data() + ithread * nChan;
+
+      CBM_OMP(for schedule(static))
+      for (size_t idigi = 0; idigi < digiIn.size(); idigi++) {
+        // Error already counted for monitoring during Digis calibration, so just discard invalid digis
+        const int32_t chan = GetChannel(digiIn[idigi]);
+        fDigiChan[idigi]   = chan;
+        if (chan >= 0) {
+          chanCount[chan]++;
+        }
+      }
+
+      CBM_OMP(single)
+      {
+        uint32_t offset = 0;
+        for (size_t chan = 0; chan < nChan; chan++) {
+          fChanDigiOffset[chan] = offset;
+          for (int thread = 0; thread < nthreads; thread++) {
+            const uint32_t count              = fChanCount[thread * nChan + chan];
+            fChanCount[thread * nChan + chan] = offset;
+            offset += count;
+          }
+        }
+        fChanDigiOffset[nChan] = offset;
+        fSortedDigis.resize(offset);
+      }
+
+      CBM_OMP(for schedule(static))
+      for (size_t idigi = 0; idigi < digiIn.size(); idigi++) {
+        const int32_t chan = fDigiChan[idigi];
+        if (chan >= 0) {
+          fSortedDigis[chanCount[chan]++] = Clusterizer::DigiRef(&digiIn[idigi], idigi);
+        }
       }
-      fStorDigi[SmType][Sm * NbRpc + Rpc].emplace_back(*pDigi, idigi);
     }
-    monitor.fSortTime = xpu::pop_timer();
+    monitor.fSortTime = TaskTimer::Pop();
 
     PODVector<Hit> clustersFlat;   // cluster storage
     PODVector<size_t> chanSizes;   // nClusters per channel
@@ -108,8 +146,8 @@ namespace cbm::algo::tof
     std::vector<size_t> addrPrefix;
     std::vector<size_t> indPrefix;
 
-    xpu::push_timer("TofHitfind");
-    xpu::t_add_bytes(digiIn.size_bytes());
+    TaskTimer::Push("TofHitfind");
+    TaskTimer::AddBytes(digiIn.size_bytes());
 
     CBM_PARALLEL()
     {
@@ -135,11 +173,14 @@ namespace cbm::algo::tof
       for (uint32_t iRpc = 0; iRpc < fAlgo.size(); iRpc++) {
 
         // Get digis
-        std::vector<std::pair<CbmTofDigi, int32_t>>& digiExp = *fStorDigiPtr[iRpc];
+        const uint32_t* rpcChanOffsets = fChanDigiOffset.data() + fChanOffset[iRpc];
+        gsl::span<const uint32_t> chanOffsets(rpcChanOffsets, fAlgo[iRpc].NumChan() + 1);
+        gsl::span<Clusterizer::DigiRef> digiExp(fSortedDigis.data() + chanOffsets.front(),
+                                                chanOffsets.back() - chanOffsets.front());
 
         // Build clusters
         //auto [rpc_clu, rpc_size, rpc_addr, rpc_ind] = fAlgo[iRpc](digiExp);     // TO DO: Re-activte this when compiler bug is fixed
-        auto rpc_result = fAlgo[iRpc](digiExp);
+        auto rpc_result = fAlgo[iRpc](digiExp, chanOffsets);
         auto& rpc_clu   = std::get<0>(rpc_result);
         auto& rpc_size  = std::get<1>(rpc_result);
         auto& rpc_addr  = std::get<2>(rpc_result);
@@ -158,9 +199,6 @@ namespace cbm::algo::tof
 
         // store digi indices
         indices.insert(indices.end(), std::make_move_iterator(rpc_ind.begin()), std::make_move_iterator(rpc_ind.end()));
-
-        // Clear digi storage
-        digiExp.clear();
       }
       cluPrefix[ithread + 1]  = clusters.size();
       sizePrefix[ithread + 1] = sizes.size();
@@ -189,7 +227,7 @@ namespace cbm::algo::tof
     }
 
     // Monitoring
-    monitor.fTime     = xpu::pop_timer();
+    monitor.fTime     = TaskTimer::Pop();
     monitor.fNumDigis = digiIn.size();
     monitor.fNumHits  = clustersFlat.size();
 
@@ -200,4 +238,25 @@ namespace cbm::algo::tof
   }
   // ----------------------------------------------------------------------------
 
+
+  // -----   Channel index of a digi   -----------------------------------------
+  int32_t Hitfind::GetChannel(const CbmTofDigi& digi) const
+  {
+    // These are doubles in the digi class
+    const int32_t SmType = digi.GetType();
+    const int32_t Sm     = digi.GetSm();
+    const int32_t Rpc    = digi.GetRpc();
+    if (SmType < 0 || (size_t) SmType >= fNbSm.size() || Sm < 0 || Sm >= fNbSm[SmType] || Rpc < 0
+        || Rpc >= fNbRpc[SmType]) {
+      return -1;
+    }
+    const int32_t iRpc = fRpcOffset[SmType] + Sm * fNbRpc[SmType] + Rpc;
+    const int32_t Chan = digi.GetChannel();
+    if (Chan < 0 || (size_t) Chan >= fAlgo[iRpc].NumChan()) {
+      return -1;
+    }
+    return fChanOffset[iRpc] + Chan;
+  }
+  // ----------------------------------------------------------------------------
+
 }  // namespace cbm::algo::tof
@@ -75,11 +75,26 @@ namespace cbm::algo::tof
     /** @brief Number of RPCs per super module type **/
     std::vector<int32_t> fNbRpc;
 
-    /** @brief Intermediate storage variables (digi, index) **/
-    std::vector<std::vector<std::vector<std::pair<CbmTofDigi, int32_t>>>> fStorDigi;  //[nbType][nbSm*nbRpc][nDigis]
+    /** @brief Unique index of the first RPC per super module type **/
+    std::vector<int32_t> fRpcOffset;  //[nbType]
 
-    /** @brief Pointer to storage variables with unique RPC index (for OpenMP) **/
-    std::vector<std::vector<std::pair<CbmTofDigi, int32_t>>*> fStorDigiPtr;  //[rpcUnique][nDigis]
+    /** @brief Index of the first channel of each RPC in the flat channel numbering **/
+    std::vector<uint32_t> fChanOffset;  //[rpcUnique + 1]
+
+    /** @brief Flat channel index per input digi, -1 for invalid digis **/
+    PODVector<int32_t> fDigiChan;  //[nDigis]
+
+    /** @brief Digi counts per thread and channel, turned into scatter positions by the prefix sum **/
+    std::vector<uint32_t> fChanCount;  //[nThreads * nChan]
+
+    /** @brief Start of each channel in the sorted digi buffer **/
+    std::vector<uint32_t> fChanDigiOffset;  //[nChan + 1]
+
+    /** @brief Digis sorted by RPC and channel, time order within each channel is kept **/
+    PODVector<Clusterizer::DigiRef> fSortedDigis;  //[nDigis]
+
+    /** @brief Flat channel index of a digi, -1 if its address is outside the setup **/
+    int32_t GetChannel(const CbmTofDigi& digi) const;
   };
 }  // namespace cbm::algo::tof
 
@@ -6,6 +6,7 @@
 
 #include "AlgoFairloggerCompat.h"
 #include "compat/OpenMP.h"
+#include "util/TaskGraph.h"
 #include "util/TimingsFormat.h"
 
 #include <chrono>
@@ -152,7 +153,7 @@ namespace cbm::algo::trd
 
     // Loop over the digis array and store the digis in separate vectors for
     // each module and row
-    xpu::push_timer("DigiModuleSort");
+    TaskTimer::Push("DigiModuleSort");
     for (size_t idigi = 0; idigi < digiIn.size(); idigi++) {
       const CbmTrdDigi* digi = &digiIn[idigi];
       const int address      = digi->GetAddressModule();
@@ -175,7 +176,7 @@ namespace cbm::algo::trd
       const int row        = digi->GetAddressChannel() / numCols;
       digiBuffer[modId][row].emplace_back(*digi, idigi);
     }
-    monitor.sortTime = xpu::pop_timer();
+    monitor.sortTime = TaskTimer::Pop();
 
     // Hit finding results
     PODVector<Hit> hitsFlat;       // hit storage
@@ -187,8 +188,8 @@ namespace cbm::algo::trd
     std::vector<size_t> sizePrefix;
     std::vector<size_t> addrPrefix;
 
-    xpu::push_timer("BuildHits");
-    xpu::t_add_bytes(digiIn.size_bytes());
+    TaskTimer::Push("BuildHits");
+    TaskTimer::AddBytes(digiIn.size_bytes());
 
     CBM_PARALLEL()
     {
@@ -303,7 +304,7 @@ namespace cbm::algo::trd
     }
 
     // Monitoring
-    monitor.timeHitfind = xpu::pop_timer();
+    monitor.timeHitfind = TaskTimer::Pop();
     monitor.numDigis    = digiIn.size();
     monitor.numHits     = hitsFlat.size();
 
@@ -348,7 +349,7 @@ namespace cbm::algo::trd
 
     // Loop over the digis array and store the digis in separate vectors for
     // each module and row
-    xpu::push_timer("DigiModuleSort");
+    TaskTimer::Push("DigiModuleSort");
     for (size_t idigi = 0; idigi < digiIn.size(); idigi++) {
       const CbmTrdDigi* digi = &digiIn[idigi];
       const int address      = digi->GetAddressModule();
@@ -371,10 +372,10 @@ namespace cbm::algo::trd
       const int row        = digi->GetAddressChannel() / numCols;
       digiBuffer[address][row].emplace_back(*digi, idigi);
     }
-    monitor.sortTime = xpu::pop_timer();
+    monitor.sortTime = TaskTimer::Pop();
 
-    xpu::push_timer("BuildClusters");
-    xpu::t_add_bytes(digiIn.size_bytes());
+    TaskTimer::Push("BuildClusters");
+    TaskTimer::AddBytes(digiIn.size_bytes());
 
     // Cluster building and hit finding
     CBM_PARALLEL_FOR(schedule(dynamic))
@@ -441,7 +442,7 @@ namespace cbm::algo::trd
     }
 #endif
 
-    monitor.timeClusterize = xpu::pop_timer();
+    monitor.timeClusterize = TaskTimer::Pop();
 
     // Result storage
     PODVector<Hit> hitsFlat;       // hit storage
@@ -453,7 +454,7 @@ namespace cbm::algo::trd
     std::vector<size_t> sizePrefix;
     std::vector<size_t> addrPrefix;
 
-    xpu::push_timer("FindHits");
+    TaskTimer::Push("FindHits");
 
     // Combine row buffers into module buffers.
     // Then run a final module-wise row-merging iteration and arrange results.
@@ -534,7 +535,7 @@ namespace cbm::algo::trd
       std::move(local_addresses.begin(), local_addresses.end(), modAddresses.begin() + addrPrefix[ithread]);
     }
     // Monitoring
-    monitor.timeHitfind = xpu::pop_timer();
+    monitor.timeHitfind = TaskTimer::Pop();
     monitor.numDigis    = digiIn.size();
     monitor.numHits     = hitsFlat.size();
 
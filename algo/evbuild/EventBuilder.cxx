@@ -6,6 +6,7 @@
 
 #include <cassert>
 #include <iomanip>
+#include <numeric>
 
 #include <xpu/host.h>
 
@@ -16,28 +17,52 @@ namespace cbm::algo::evbuild
 {
 
   // -----   Algorithm execution   --------------------------------------------
-  EventBuilder::resultType EventBuilder::operator()(const DigiData& ts, const vector<double> triggers,
+  EventBuilder::resultType EventBuilder::operator()(const DigiData& ts, const vector<double>& triggers,
                                                     std::optional<DigiEventSelector> selector) const
   {
     xpu::push_timer("EventBuilder");
     xpu::t_add_bytes(ts.TotalSizeBytes());
 
     // --- Output data
-    resultType result = {};
-    auto& events      = result.first;
-    events.resize(triggers.size());
+    resultType result                = {};
+    auto& events                     = result.first;
+    EventBuilderMonitorData& monitor = result.second;
 
-    std::transform(triggers.begin(), triggers.end(), events.begin(),
-                   [&ts, &result, this](const double& trigger) { return BuildEvent(ts, result.second, trigger); });
+    // --- Build events as digi index ranges, no digis are copied here
+    std::vector<DigiEventRange> ranges = BuildRanges(ts, triggers);
+
+    for (const auto& range : ranges) {
+      monitor.sts.nDigisInEvents += range.Size(ECbmModuleId::kSts);
+      monitor.rich.nDigisInEvents += range.Size(ECbmModuleId::kRich);
+      monitor.much.nDigisInEvents += range.Size(ECbmModuleId::kMuch);
+      monitor.trd.nDigisInEvents += range.Size(ECbmModuleId::kTrd);
+      monitor.trd2d.nDigisInEvents += range.Size(ECbmModuleId::kTrd2d);
+      monitor.tof.nDigisInEvents += range.Size(ECbmModuleId::kTof);
+      monitor.psd.nDigisInEvents += range.Size(ECbmModuleId::kPsd);
+      monitor.fsd.nDigisInEvents += range.Size(ECbmModuleId::kFsd);
+      monitor.bmon.nDigisInEvents += range.Size(ECbmModuleId::kBmon);
+    }
 
-    // --- Apply event selector
+    // --- Apply event selector on the ranges, so rejected events are never copied
     if (selector.has_value()) {
-      auto notSelected = [&](DigiEvent& ev) { return !((*selector)(ev)); };
-      auto removeIt    = std::remove_if(events.begin(), events.end(), notSelected);
-      events.erase(removeIt, events.end());
+      std::vector<char> selected(ranges.size());
+      CBM_PARALLEL_FOR(schedule(dynamic, 64))
+      for (size_t i = 0; i < ranges.size(); i++) {
+        selected[i] = (*selector)(ranges[i], ts);
+      }
+      size_t nSelected = 0;
+      for (size_t i = 0; i < ranges.size(); i++) {
+        if (selected[i]) ranges[nSelected++] = ranges[i];
+      }
+      ranges.resize(nSelected);
     }
 
-    EventBuilderMonitorData& monitor = result.second;
+    // --- Copy the digis of the selected events
+    events.resize(ranges.size());
+    CBM_PARALLEL_FOR(schedule(dynamic, 64))
+    for (size_t i = 0; i < ranges.size(); i++) {
+      events[i] = ranges[i].Materialize(ts);
+    }
 
     monitor.sts.nDigis += ts.fSts.size();
     monitor.rich.nDigis += ts.fRich.size();
@@ -54,71 +79,51 @@ namespace cbm::algo::evbuild
     monitor.time = xpu::pop_timer();
     return result;
   }
+  // --------------------------------------------------------------------------
 
-  // --- Build a single event
-  DigiEvent EventBuilder::BuildEvent(const DigiData& ts, EventBuilderMonitorData& monitor, double trigger) const
-  {
-    DigiEvent event;
-    event.fTime = trigger;
 
-    // --- Loop over systems
-    for (auto entry : fConfig.fWindows) {
+  // -----   Build events as digi index ranges   ------------------------------
+  std::vector<DigiEventRange> EventBuilder::BuildRanges(const DigiData& ts, gsl::span<const double> triggers) const
+  {
+    // --- FindRanges needs time-ordered triggers. Unsorted triggers (e.g. from V0Trigger) are built in time order
+    // --- and the events are put back into the order of the input triggers.
+    if (!is_sorted(triggers.begin(), triggers.end())) {
+      std::vector<size_t> order(triggers.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return triggers[a] < triggers[b]; });
+      std::vector<double> sortedTriggers(triggers.size());
+      for (size_t i = 0; i < order.size(); i++) {
+        sortedTriggers[i] = triggers[order[i]];
+      }
+      std::vector<DigiEventRange> sortedRanges = BuildRanges(ts, sortedTriggers);
+      std::vector<DigiEventRange> ranges(triggers.size());
+      for (size_t i = 0; i < order.size(); i++) {
+        ranges[order[i]] = sortedRanges[i];
+      }
+      return ranges;
+    }
 
-      auto system       = entry.first;
-      const double tMin = trigger + entry.second.first;
-      const double tMax = trigger + entry.second.second;
+    std::vector<DigiEventRange> ranges(triggers.size());
+    for (size_t i = 0; i < triggers.size(); i++) {
+      ranges[i].fTime = triggers[i];
+    }
 
-      // --- Build the event using trigger window
+    // --- Loop over systems
+    for (const auto& [system, window] : fConfig.fWindows) {
       switch (system) {
-        case ECbmModuleId::kSts: {
-          event.fSts = CopyRange(ts.fSts, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kRich: {
-          event.fRich = CopyRange(ts.fRich, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kMuch: {
-          event.fMuch = CopyRange(ts.fMuch, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kTrd: {
-          event.fTrd = CopyRange(ts.fTrd, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kTrd2d: {
-          event.fTrd2d = CopyRange(ts.fTrd2d, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kTof: {
-          event.fTof = CopyRange(ts.fTof, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kPsd: {
-          event.fPsd = CopyRange(ts.fPsd, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kFsd: {
-          event.fFsd = CopyRange(ts.fFsd, tMin, tMax);
-          break;
-        }
-        case ECbmModuleId::kBmon: {
-          event.fBmon = CopyRange(ts.fBmon, tMin, tMax);
-          break;
-        }
+        case ECbmModuleId::kSts: FindRanges(ts.fSts, triggers, window, ranges, &DigiEventRange::fSts); break;
+        case ECbmModuleId::kRich: FindRanges(ts.fRich, triggers, window, ranges, &DigiEventRange::fRich); break;
+        case ECbmModuleId::kMuch: FindRanges(ts.fMuch, triggers, window, ranges, &DigiEventRange::fMuch); break;
+        case ECbmModuleId::kTrd: FindRanges(ts.fTrd, triggers, window, ranges, &DigiEventRange::fTrd); break;
+        case ECbmModuleId::kTrd2d: FindRanges(ts.fTrd2d, triggers, window, ranges, &DigiEventRange::fTrd2d); break;
+        case ECbmModuleId::kTof: FindRanges(ts.fTof, triggers, window, ranges, &DigiEventRange::fTof); break;
+        case ECbmModuleId::kPsd: FindRanges(ts.fPsd, triggers, window, ranges, &DigiEventRange::fPsd); break;
+        case ECbmModuleId::kFsd: FindRanges(ts.fFsd, triggers, window, ranges, &DigiEventRange::fFsd); break;
+        case ECbmModuleId::kBmon: FindRanges(ts.fBmon, triggers, window, ranges, &DigiEventRange::fBmon); break;
         default: break;
       }
     }
-    monitor.sts.nDigisInEvents += event.fSts.size();
-    monitor.rich.nDigisInEvents += event.fRich.size();
-    monitor.much.nDigisInEvents += event.fMuch.size();
-    monitor.trd.nDigisInEvents += event.fTrd.size();
-    monitor.trd2d.nDigisInEvents += event.fTrd2d.size();
-    monitor.tof.nDigisInEvents += event.fTof.size();
-    monitor.psd.nDigisInEvents += event.fPsd.size();
-    monitor.fsd.nDigisInEvents += event.fFsd.size();
-    monitor.bmon.nDigisInEvents += event.fBmon.size();
-    return event;
+    return ranges;
   }
   // --------------------------------------------------------------------------
 
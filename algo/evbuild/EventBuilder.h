@@ -9,6 +9,7 @@
 #include "DigiData.h"
 #include "DigiEventSelector.h"
 #include "EventBuilderConfig.h"
+#include "compat/OpenMP.h"
 
 #include <algorithm>
 #include <gsl/span>
@@ -59,15 +60,17 @@ namespace cbm::algo::evbuild
    ** @since 2021
    ** @brief Constructs CbmDigiEvents out of CbmDigiTimeslices
    **
-   ** Events are constructed by copying digi data from the source (CbmDigiTimeslice).
    ** Digis are selected in trigger windows, the sizes of which relative to a trigger time are configurable.
    ** For each trigger time, an event is generated. The time intervals may overlap, resulting in digis
    ** being attributed to multiple events.
    **
+   ** Events are first built as index ranges into the source (DigiEventRange), which costs no copies of
+   ** digis. Only the events passing the selection are materialized by copying their digis.
+   **
    ** The source digi vectors (in CbmDigiTimeslice) must be sorted w.r.t. time, otherwise the behaviour is
    ** undefined.
    **
-   ** The trigger vector must be sorted.
+   ** The triggers need not be sorted. The events are returned in the order of the triggers.
    **/
   class EventBuilder {
 
@@ -88,50 +91,71 @@ namespace cbm::algo::evbuild
      ** @param  selector Optional event selector
      ** @return Vector of constructed events and monitoring data
      **/
-    resultType operator()(const DigiData& ts, const std::vector<double> triggers,
+    resultType operator()(const DigiData& ts, const std::vector<double>& triggers,
                           std::optional<DigiEventSelector> selector) const;
 
 
+    /** @brief Build events as index ranges into the source, without copying digis
+     ** @param  ts       Digi source (timeslice)
+     ** @param  triggers List of trigger times, in any order
+     ** @return One digi index range event per trigger, in the order of the triggers
+     **
+     ** Unsorted triggers are sorted into a copy first, since FindRanges relies on the time order.
+     **/
+    std::vector<DigiEventRange> BuildRanges(const DigiData& ts, gsl::span<const double> triggers) const;
+
+
     /** @brief Info to string **/
     std::string ToString() const;
 
 
    private:  // methods
-    /** @brief Build a single event from a trigger time
-     ** @param  ts      Digi source (timeslice)
-     ** @param  monitor Monitoring data
-     ** @param  trigger Trigger time
-     ** @return Digi event
-     **/
-    DigiEvent BuildEvent(const DigiData& ts, EventBuilderMonitorData& monitor, double trigger) const;
-
-
-    /** @brief Copy data objects in a given time interval from the source to the target vector
-     ** @param source Source data vector
-     ** @param tMin   Minimal time
-     ** @param tMax   Maximal time
-     ** @return Target data vector
-     **
-     ** The Data class specialisation must implement the method double GetTime(), which is used to
-     ** check whether the Data object falls into the specified time interval.
+    /** @brief Find the range of digis in the trigger window for each trigger
+     ** @param source  Source data vector
+     ** @param triggers List of trigger times (sorted)
+     ** @param window  Trigger window [tmin, tmax] relative to the trigger time
+     ** @param ranges  Events to fill
+     ** @param member  Range of the detector in DigiEventRange
      **
-     ** The source vector must be ordered w.r.t. GetTime(), otherwise the behaviour is undefined.
+     ** The Data class specialisation must implement the method double GetTime(). The source vector must be
+     ** ordered w.r.t. GetTime(), otherwise the behaviour is undefined.
      **
-     ** TODO: The current implementation searches, for each trigger, the entire source vector. This
-     ** can surely be optimised when the contract that the trigger vector be sorted is properly exploited,
-     ** e.g., by starting the search for the first digi in the trigger window from the start of the
-     ** previous trigger window. This, however, requires bookkeeping hardly to be realised without
-     ** changing the state of the class. I leave this for the future and for bright specialists.
+     ** As the triggers are sorted, the window borders only move forward. Each thread processes a contiguous
+     ** chunk of triggers, searches for the window of its first trigger and then advances two cursors.
      **/
     template<typename Vector>
-    static Vector CopyRange(const Vector& source, double tMin, double tMax)
+    static void FindRanges(const Vector& source, gsl::span<const double> triggers,
+                           const std::pair<double, double>& window, std::vector<DigiEventRange>& ranges,
+                           DigiEventRange::Range DigiEventRange::*member)
     {
-      using Data = typename Vector::value_type;
-      auto comp1 = [](const Data& obj, double value) { return obj.GetTime() < value; };
-      auto comp2 = [](double value, const Data& obj) { return value < obj.GetTime(); };
-      auto lower = std::lower_bound(source.begin(), source.end(), tMin, comp1);
-      auto upper = std::upper_bound(lower, source.end(), tMax, comp2);
-      return Vector(lower, upper);
+      using Data             = typename Vector::value_type;
+      const size_t nTriggers = triggers.size();
+      CBM_PARALLEL()
+      {
+        const size_t nThreads = openmp::GetNumThreads();
+        const size_t iThread  = openmp::GetThreadNum();
+        const size_t first    = nTriggers * iThread / nThreads;
+        const size_t last     = nTriggers * (iThread + 1) / nThreads;
+        if (first < last) {
+          auto comp  = [](const Data& obj, double value) { return obj.GetTime() < value; };
+          auto lower = std::lower_bound(source.begin(), source.end(), triggers[first] + window.first, comp);
+          auto upper = lower;
+          for (size_t i = first; i < last; i++) {
+            const double tMin = triggers[i] + window.first;
+            const double tMax = triggers[i] + window.second;
+            while (lower != source.end() && lower->GetTime() < tMin) {
+              ++lower;
+            }
+            if (upper < lower) upper = lower;
+            while (upper != source.end() && !(tMax < upper->GetTime())) {
+              ++upper;
+            }
+            const size_t begin = lower - source.begin();
+            const size_t end   = upper - source.begin();
+            ranges[i].*member  = {begin, end};
+          }
+        }
+      }
     }
 
 
@@ -18,11 +18,31 @@ namespace cbm::algo::evbuild
 
   // -----   Test one digi event   --------------------------------------------
   bool DigiEventSelector::operator()(const DigiEvent& event) const
+  {
+    return Select([&](ECbmModuleId system) { return event.Size(system); }, event.fSts, event.fTof, event.fBmon);
+  }
+  // --------------------------------------------------------------------------
+
+
+  // -----   Test one digi event given as index ranges   ----------------------
+  bool DigiEventSelector::operator()(const DigiEventRange& event, const DigiData& ts) const
+  {
+    return Select([&](ECbmModuleId system) { return event.Size(system); },
+                  DigiEventRange::Span(ts.fSts, event.fSts), DigiEventRange::Span(ts.fTof, event.fTof),
+                  DigiEventRange::Span(ts.fBmon, event.fBmon));
+  }
+  // --------------------------------------------------------------------------
+
+
+  // -----   Test the selection criteria   ------------------------------------
+  template<class SizeFn>
+  bool DigiEventSelector::Select(SizeFn size, gsl::span<const CbmStsDigi> sts, gsl::span<const CbmTofDigi> tof,
+                                 gsl::span<const CbmBmonDigi> bmon) const
   {
 
     // --- Test number of digis per detector system
     for (auto& entry : fConfig.fMinNumDigis) {
-      if (!(event.Size(entry.first) >= entry.second)) {
+      if (!(size(entry.first) >= entry.second)) {
         return false;
         break;
       }
@@ -33,10 +53,10 @@ namespace cbm::algo::evbuild
       if (entry.second == 0) continue;
       switch (entry.first) {
         case ECbmModuleId::kSts:
-          if (!CheckStsStations(event.fSts, entry.second)) return false;
+          if (!CheckStsStations(sts, entry.second)) return false;
           break;
         case ECbmModuleId::kTof:
-          if (!CheckTofLayers(event.fTof, entry.second)) return false;
+          if (!CheckTofLayers(tof, entry.second)) return false;
           break;
         default:
           throw std::runtime_error("Number of layers for " + ::ToString(entry.first) + " is not implemented");
@@ -52,7 +72,7 @@ namespace cbm::algo::evbuild
       if (itMinNumDigis != fConfig.fMinNumDigis.end() && itMinNumDigis->second > 0) {
         switch (det) {
           case ECbmModuleId::kBmon:
-            for (const auto& digi : event.fBmon) {
+            for (const auto& digi : bmon) {
               if (entry.second.find(digi.GetAddress()) == entry.second.end()) {
                 ++nDigisAccepted;
               }
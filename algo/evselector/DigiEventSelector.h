@@ -49,6 +49,13 @@ namespace cbm::algo::evbuild
      **/
     bool operator()(const DigiEvent& event) const;
 
+    /** @brief Test one event, given as index ranges into a timeslice, for the selection criteria
+     ** @param event Digi index ranges of the event
+     ** @param ts    Timeslice the event was built from
+     ** @return true if event satisfies the criteria; else false
+     **/
+    bool operator()(const DigiEventRange& event, const DigiData& ts) const;
+
     /** @brief Registers tracking setup
      ** @param pSetup  The tracking setup instance
      **/
@@ -59,6 +66,16 @@ namespace cbm::algo::evbuild
 
 
    private:  // methods
+    /** @brief Test the selection criteria
+     ** @param size Number of digis per detector system
+     ** @param sts  STS digis of the event
+     ** @param tof  TOF digis of the event
+     ** @param bmon Bmon digis of the event
+     **/
+    template<class SizeFn>
+    bool Select(SizeFn size, gsl::span<const CbmStsDigi> sts, gsl::span<const CbmTofDigi> tof,
+                gsl::span<const CbmBmonDigi> bmon) const;
+
     /** @brief Test for the number of STS stations
      ** @param digis Vector of STS digis
      ** @param minNum Requested minimum of active STS stations
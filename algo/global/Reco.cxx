@@ -13,6 +13,7 @@
 #include "ParFiles.h"
 #include "RecoGeneralQa.h"
 #include "StsDigiQa.h"
+#include "System.h"
 #include "TrackingSetup.h"
 #include "bmon/Calibrate.h"
 #include "bmon/Hitfind.h"
@@ -37,6 +38,7 @@
 #include "trd/Hitfind.h"
 #include "trd/Unpack.h"
 #include "trd2d/Unpack.h"
+#include "util/TaskGraph.h"
 #include "util/TimingsFormat.h"
 #include "util/TsUtils.h"
 #include "yaml/Yaml.h"
@@ -44,6 +46,10 @@
 #include <Monitor.hpp>
 #include <System.hpp>
 
+#include <algorithm>
+#include <array>
+#include <optional>
+
 #include <xpu/host.h>
 
 using namespace cbm::algo;
@@ -262,37 +268,62 @@ void Reco::Init(const Options& opts)
   if (fbReconstructDigiEvents) {
     fEvSelectingMonitor.Reset();
 
+    // Events are reconstructed in parallel, unless a QA of the event reconstruction is filled
+    fbEventRecoQa = fQaManager != nullptr
+                    && (Opts().Has(QaStep::RecoBmon) || Opts().Has(QaStep::Tracking) || Opts().Has(QaStep::V0Finder));
+    const int nThreads = fbEventRecoQa ? 1 : openmp::GetMaxThreads();
+    if (fbEventRecoQa && openmp::GetMaxThreads() > 1) {
+      L_(info) << "Reco: QA of the event reconstruction is active, events are reconstructed in a single thread";
+    }
+
     // BMON hit finding in event reconstruction
     auto bmonCalSetup = yaml::ReadFromFile<bmon::CalibrateSetup>(opts.ParamsDir() / parFiles.bmon.calibrate);
     auto bmonHitSetup = yaml::ReadFromFile<bmon::HitfindSetup>(opts.ParamsDir() / parFiles.bmon.hitfinder);
-    fBmonCalibrator   = std::make_unique<bmon::Calibrate>(bmonCalSetup);
-    fBmonHitFinder    = std::make_unique<bmon::Hitfind>(bmonHitSetup);
+    fBmonHitFinder    = std::make_unique<bmon::Hitfind>(bmonHitSetup, nThreads);
     if (fQaManager != nullptr && Opts().Has(QaStep::RecoBmon)) {
       fBmonHitFinderQa = std::make_unique<bmon::HitfindQa>(fQaManager, "BmonHitfindEvent");
       fBmonHitFinderQa->InitParameters(bmonCalSetup, bmonHitSetup);
       fBmonHitFinderQa->Init();
     }
 
-    // Tracking in event reconstruction
-    if (fQaManager != nullptr && Opts().Has(QaStep::Tracking)) {
-      fTrackingEvent = std::make_unique<TrackingChain>(ECbmRecoMode::EventByEvent, fQaManager, "CaEvent");
-    }
-    else {
-      fTrackingEvent = std::make_unique<TrackingChain>(ECbmRecoMode::EventByEvent);
-    }
-    fTrackingEvent->RegisterSetup(pTrackingSetup);
-    fTrackingEvent->SetContext(&fContext);
-    fTrackingEvent->Init();
+    auto tofCalSetup = yaml::ReadFromFile<tof::CalibrateSetup>(opts.ParamsDir() / parFiles.tof.calibrate);
+    auto tofHitSetup = yaml::ReadFromFile<tof::HitfindSetup>(opts.ParamsDir() / parFiles.tof.hitfinder);
+    auto trdHitSetup = yaml::ReadFromFile<trd::HitfindSetup>(opts.ParamsDir() / parFiles.trd.hitfinder);
+    auto trd2dSetup  = yaml::ReadFromFile<trd::Hitfind2DSetup>(opts.ParamsDir() / parFiles.trd.hitfinder2d);
+
+    fEventReco.resize(nThreads);
+    for (auto& reco : fEventReco) {
+      reco.bmonCalibrator = std::make_unique<bmon::Calibrate>(bmonCalSetup);
+      reco.tofCalibrator  = std::make_unique<tof::Calibrate>(tofCalSetup);
+      reco.tofHitFinder   = std::make_unique<tof::Hitfind>(tofHitSetup);
+      reco.trdHitfind     = std::make_unique<trd::Hitfind>(trdHitSetup, trd2dSetup);
+
+      // Tracking in event reconstruction
+      if (fQaManager != nullptr && Opts().Has(QaStep::Tracking)) {
+        reco.tracking = std::make_unique<TrackingChain>(ECbmRecoMode::EventByEvent, fQaManager, "CaEvent");
+      }
+      else {
+        reco.tracking = std::make_unique<TrackingChain>(ECbmRecoMode::EventByEvent);
+      }
+      reco.tracking->RegisterSetup(pTrackingSetup);
+      reco.tracking->SetContext(&fContext);
+      if (&reco == &fEventReco.front()) {
+        reco.tracking->Init();
+      }
+      else {
+        reco.tracking->Init(*fEventReco.front().tracking);  // Shares the tracking parameters
+      }
 
-    if (fQaManager != nullptr && Opts().Has(QaStep::V0Finder)) {
-      fV0Finder = std::make_unique<V0FinderChain>(fQaManager);
-    }
-    else {
-      fV0Finder = std::make_unique<V0FinderChain>();
+      if (fQaManager != nullptr && Opts().Has(QaStep::V0Finder)) {
+        reco.v0Finder = std::make_unique<V0FinderChain>(fQaManager);
+      }
+      else {
+        reco.v0Finder = std::make_unique<V0FinderChain>();
+      }
+      reco.v0Finder->SetContext(&fContext);
+      reco.v0Finder->SetBmonDefinedAddresses(fBmonHitFinder->GetDiamondAddresses());
+      reco.v0Finder->Init();
     }
-    fV0Finder->SetContext(&fContext);
-    fV0Finder->SetBmonDefinedAddresses(fBmonHitFinder->GetDiamondAddresses());
-    fV0Finder->Init();
   }
 
   // Initialize the QA manager
@@ -313,6 +344,7 @@ RecoResults Reco::Run(const fles::Timeslice& ts)
   }
 
   ProcessingMonitor procMon;
+  const size_t pageFaultsStart = GetPageFaults();
 
   RecoResults recoData;  /// transient
   RecoResults results;   /// persistent (return object)
@@ -326,107 +358,194 @@ RecoResults Reco::Run(const fles::Timeslice& ts)
     DigiData digis;
     AuxDigiData auxDigis;
 
-    if (Opts().Has(Step::Unpack)) {
-      xpu::scoped_timer timerU("Unpack", &procMon.timeUnpack);
-      xpu::t_add_bytes(ts_utils::SizeBytes(ts));
+    // Unpacking, local reconstruction and tracking form a task graph. Stages of different detectors are independent
+    // and run concurrently with --concurrent-stages. Stages using the GPU stay on this thread.
+    //
+    // Objects used by the stages while the graph runs:
+    // - Digis, aux digis, hits and stage timings of a detector are written by its stages only.
+    // - The unpackers, hit finders, fTrdDigiBuffer and the TOF hit finder QA each belong to a single stage. The QA
+    //   fills only its own histograms, they are sent after the graph has run.
+    // - fStsDigiQa belongs to the STS digi QA stage. It is the only user of fSender while the graph runs, all other
+    //   histograms are sent after the graph.
+    // - The monitor is not thread-safe. The stages keep their monitor data in their own variables below, and the
+    //   metrics are queued on this thread after the graph has run, in the order of the serial mode.
+    TaskGraph stages(Opts().ConcurrentStages());
+    std::vector<TaskGraph::TaskId> unpackSts, unpackTof, unpackTrd, localReco;
+
+    // Stages on worker threads can't use xpu timers, so the stage timings for the monitor are taken from the graph
+    std::optional<TaskGraph::TaskId> stsRecoStage, tofRecoStage, trdRecoStage, caStage;
+    std::vector<TaskGraph::TaskId> unpackStages;
+    std::array<size_t, 7> unpackBytes{};
+    std::array<std::function<void()>, 7> unpackMetrics{};
+    auto AddUnpacker = [&](std::string_view det, const auto& unpacker, auto& digisOut, auto& auxOut) {
+      auto name        = fmt::format("Unpack {}", det);
+      const size_t iUn = unpackStages.size();
+      return unpackStages.emplace_back(stages.Add(name, [&, name, &bytes = unpackBytes.at(iUn),
+                                                         &metrics = unpackMetrics.at(iUn), &u = unpacker,
+                                                         &d = digisOut, &a = auxOut] {
+        TaskTimer timerU(name);
+        std::tie(d, a) = RunUnpacker(u, ts, bytes, metrics);
+      }));
+    };
 
-      std::tie(digis.fBmon, auxDigis.fBmon)   = RunUnpacker(fBmonUnpack, ts);
-      std::tie(digis.fMuch, auxDigis.fMuch)   = RunUnpacker(fMuchUnpack, ts);
-      std::tie(digis.fRich, auxDigis.fRich)   = RunUnpacker(fRichUnpack, ts);
-      std::tie(digis.fSts, auxDigis.fSts)     = RunUnpacker(fStsUnpack, ts);
-      std::tie(digis.fTof, auxDigis.fTof)     = RunUnpacker(fTofUnpack, ts);
-      std::tie(digis.fTrd, auxDigis.fTrd)     = RunUnpacker(fTrdUnpack, ts);
-      std::tie(digis.fTrd2d, auxDigis.fTrd2d) = RunUnpacker(fTrd2dUnpack, ts);
+    if (Opts().Has(Step::Unpack)) {
+      AddUnpacker("BMON", fBmonUnpack, digis.fBmon, auxDigis.fBmon);
+      AddUnpacker("MUCH", fMuchUnpack, digis.fMuch, auxDigis.fMuch);
+      AddUnpacker("RICH", fRichUnpack, digis.fRich, auxDigis.fRich);
+      unpackSts.push_back(AddUnpacker("STS", fStsUnpack, digis.fSts, auxDigis.fSts));
+      unpackTof.push_back(AddUnpacker("TOF", fTofUnpack, digis.fTof, auxDigis.fTof));
+      unpackTrd.push_back(AddUnpacker("TRD", fTrdUnpack, digis.fTrd, auxDigis.fTrd));
+      unpackTrd.push_back(AddUnpacker("TRD2D", fTrd2dUnpack, digis.fTrd2d, auxDigis.fTrd2d));
 
       // No unpackers for these yet
       // digis.fPsd   = RunUnpacker(fPsdUnpack, ts);
       // digis.fFsd   = RunUnpacker(fFsdUnpack, ts);
 
-      L_(info) << "TS contains Digis: STS=" << digis.fSts.size() << " MUCH=" << digis.fMuch.size()
-               << " TOF=" << digis.fTof.size() << " BMON=" << digis.fBmon.size() << " TRD=" << digis.fTrd.size()
-               << " TRD2D=" << digis.fTrd2d.size() << " RICH=" << digis.fRich.size() << " PSD=" << digis.fPsd.size()
-               << " FSD=" << digis.fFsd.size();
       // --- Raw digi QAs
       if (fSender != nullptr && Opts().Has(Subsystem::STS)) {
-        fStsDigiQa->RegisterDigiData(&digis.fSts);
-        fStsDigiQa->RegisterAuxDigiData(&auxDigis.fSts);
-        fStsDigiQa->SetTimesliceIndex(ts.index());
-        fStsDigiQa->Exec();
+        stages.Add(
+          "STS Digi QA",
+          [&] {
+            fStsDigiQa->RegisterDigiData(&digis.fSts);
+            fStsDigiQa->RegisterAuxDigiData(&auxDigis.fSts);
+            fStsDigiQa->SetTimesliceIndex(ts.index());
+            fStsDigiQa->Exec();
+          },
+          unpackSts);
       }
     }
 
-
     sts::HitfinderMon stsHitfinderMonitor;
     if (fStsHitFinder) {
-      xpu::scoped_timer timerSTS("STS Reco", &procMon.timeSTS);
-      xpu::t_add_bytes(digis.fSts.size() * sizeof(CbmStsDigi));
-      bool storeClusters   = Opts().HasOutput(RecoData::Cluster);
-      auto stsResults      = (*fStsHitFinder)(digis.fSts, storeClusters);
-      stsHitfinderMonitor  = std::move(stsResults.monitor);
-      recoData.stsHits     = stsResults.hits;
-      recoData.stsClusters = std::move(stsResults.clusters);
-      QueueStsRecoMetrics(stsHitfinderMonitor);
+      stsRecoStage = stages.Add(
+        "STS Reco",
+        [&] {
+          TaskTimer timerSTS("STS Reco");
+          procMon.timeSTS.bytes = digis.fSts.size() * sizeof(CbmStsDigi);
+          TaskTimer::AddBytes(procMon.timeSTS.bytes);
+          bool storeClusters   = Opts().HasOutput(RecoData::Cluster);
+          auto stsResults      = (*fStsHitFinder)(digis.fSts, storeClusters);
+          stsHitfinderMonitor  = std::move(stsResults.monitor);
+          recoData.stsHits     = stsResults.hits;
+          recoData.stsClusters = std::move(stsResults.clusters);
+        },
+        unpackSts, true);
+      localReco.push_back(*stsRecoStage);
     }
 
     PartitionedVector<tof::Hit> tofHits;
+    tof::CalibrateMonitorData tofCalibMonitor;
+    tof::HitfindMonitorData tofHitfindMonitor;
     if (Opts().Has(Step::LocalReco) && Opts().Has(fles::Subsystem::TOF)) {
-      xpu::scoped_timer timerTOF("TOF Reco", &procMon.timeTOF);
-      xpu::t_add_bytes(digis.fTof.size() * sizeof(CbmTofDigi));
-      auto [caldigis, calmonitor] = (*fTofCalibrator)(digis.fTof);
-      auto nUnknownRPC            = calmonitor.fDigiCalibUnknownRPC;
-      if (nUnknownRPC > 0) {
-        L_(error) << "TOF Digis with unknown RPCs: " << nUnknownRPC;
-      }
-      auto [hits, hitmonitor, digiindices] = (*fTofHitFinder)(caldigis);
-      if (fTofHitFinderQa != nullptr) {
-        fTofHitFinderQa->RegisterHits(&hits);
-        fTofHitFinderQa->Exec();
-      }
-      recoData.tofHits                     = std::move(hits);
-      QueueTofCalibMetrics(calmonitor);
-      QueueTofRecoMetrics(hitmonitor);
+      tofRecoStage = stages.Add(
+        "TOF Reco",
+        [&] {
+          TaskTimer timerTOF("TOF Reco");
+          procMon.timeTOF.bytes = digis.fTof.size() * sizeof(CbmTofDigi);
+          TaskTimer::AddBytes(procMon.timeTOF.bytes);
+          auto [caldigis, calmonitor] = (*fTofCalibrator)(digis.fTof);
+          auto nUnknownRPC            = calmonitor.fDigiCalibUnknownRPC;
+          if (nUnknownRPC > 0) {
+            L_(error) << "TOF Digis with unknown RPCs: " << nUnknownRPC;
+          }
+          auto [hits, hitmonitor, digiindices] = (*fTofHitFinder)(caldigis);
+          if (fTofHitFinderQa != nullptr) {
+            fTofHitFinderQa->RegisterHits(&hits);
+            fTofHitFinderQa->Exec();
+          }
+          recoData.tofHits  = std::move(hits);
+          tofCalibMonitor   = std::move(calmonitor);
+          tofHitfindMonitor = std::move(hitmonitor);
+        },
+        unpackTof);
+      localReco.push_back(*tofRecoStage);
     }
 
     PartitionedVector<trd::Hit> trdHits;
+    trd::HitfindMonitorData trdHitfindMonitor;
     if (fTrdHitfind) {
-      xpu::scoped_timer timerTRD("TRD Reco", &procMon.timeTRD);
-      xpu::t_add_bytes(digis.fTrd.size() * sizeof(CbmTrdDigi));
-      // FIXME: additional copy of digis, figure out how to pass 1d + 2d digis at once to hitfinder
-      const auto& digis1d = digis.fTrd;
-      const auto& digis2d = digis.fTrd2d;
-      PODVector<CbmTrdDigi> allDigis{};
-      allDigis.reserve(digis1d.size() + digis2d.size());
-      std::copy(digis1d.begin(), digis1d.end(), std::back_inserter(allDigis));
-      std::copy(digis2d.begin(), digis2d.end(), std::back_inserter(allDigis));
-      auto trdResults  = (*fTrdHitfind)(allDigis);
-      recoData.trdHits = std::move(std::get<0>(trdResults));
-      QueueTrdRecoMetrics(std::get<1>(trdResults));
+      trdRecoStage = stages.Add(
+        "TRD Reco",
+        [&] {
+          TaskTimer timerTRD("TRD Reco");
+          procMon.timeTRD.bytes = digis.fTrd.size() * sizeof(CbmTrdDigi);
+          TaskTimer::AddBytes(procMon.timeTRD.bytes);
+          // FIXME: additional copy of digis, figure out how to pass 1d + 2d digis at once to hitfinder
+          const auto& digis1d = digis.fTrd;
+          const auto& digis2d = digis.fTrd2d;
+          PODVector<CbmTrdDigi> allDigis = fTrdDigiBuffer.Take();
+          allDigis.reserve(digis1d.size() + digis2d.size());
+          std::copy(digis1d.begin(), digis1d.end(), std::back_inserter(allDigis));
+          std::copy(digis2d.begin(), digis2d.end(), std::back_inserter(allDigis));
+          auto trdResults  = (*fTrdHitfind)(allDigis);
+          recoData.trdHits = std::move(std::get<0>(trdResults));
+          fTrdDigiBuffer.Give(std::move(allDigis));
+          trdHitfindMonitor = std::move(std::get<1>(trdResults));
+        },
+        unpackTrd);
+      localReco.push_back(*trdRecoStage);
     }
 
-    L_(info) << "TS contains Hits: STS=" << recoData.stsHits.NElements() << " TOF=" << recoData.tofHits.NElements()
-             << " TRD=" << recoData.trdHits.NElements();
-
-
     // --- Tracking
     TrackingChain::Output_t trackingOutput{};
     if (Opts().Has(Step::Tracking)) {
-      xpu::scoped_timer timerCA("CA", &procMon.timeCA);
-      xpu::t_add_bytes(recoData.stsHits.NElements() * sizeof(sts::Hit));
-      xpu::t_add_bytes(recoData.tofHits.NElements() * sizeof(tof::Hit));
-      xpu::t_add_bytes(recoData.trdHits.NElements() * sizeof(trd::Hit));
-      TrackingChain::Input_t input{
-        .stsHits = recoData.stsHits,
-        .tofHits = recoData.tofHits,
-        .trdHits = recoData.trdHits,
-      };
-      trackingOutput  = fTracking->Run(input);
-      recoData.tracks = std::move(trackingOutput.tracks);
-      std::sort(recoData.tracks.begin(), recoData.tracks.end(),
-                [](const cbm::algo::ca::Track& track1, const cbm::algo::ca::Track& track2) {
-                  return track1.fParPV.Time() < track2.fParPV.Time();
-                });
-      QueueTrackingMetrics(trackingOutput.monitorData);
+      caStage = stages.Add(
+        "CA",
+        [&] {
+          TaskTimer timerCA("CA");
+          procMon.timeCA.bytes = recoData.stsHits.NElements() * sizeof(sts::Hit)
+                                 + recoData.tofHits.NElements() * sizeof(tof::Hit)
+                                 + recoData.trdHits.NElements() * sizeof(trd::Hit);
+          TaskTimer::AddBytes(procMon.timeCA.bytes);
+          TrackingChain::Input_t input{
+            .stsHits = recoData.stsHits,
+            .tofHits = recoData.tofHits,
+            .trdHits = recoData.trdHits,
+          };
+          trackingOutput  = fTracking->Run(input);
+          recoData.tracks = std::move(trackingOutput.tracks);
+          std::sort(recoData.tracks.begin(), recoData.tracks.end(),
+                    [](const cbm::algo::ca::Track& track1, const cbm::algo::ca::Track& track2) {
+                      return track1.fParPV.Time() < track2.fParPV.Time();
+                    });
+        },
+        localReco, true);
+    }
+
+    stages.Run();
+
+    for (const auto& queueMetrics : unpackMetrics) {
+      if (queueMetrics) queueMetrics();
     }
+    if (stsRecoStage) QueueStsRecoMetrics(stsHitfinderMonitor);
+    if (tofRecoStage) {
+      QueueTofCalibMetrics(tofCalibMonitor);
+      QueueTofRecoMetrics(tofHitfindMonitor);
+    }
+    if (trdRecoStage) QueueTrdRecoMetrics(trdHitfindMonitor);
+    if (caStage) QueueTrackingMetrics(trackingOutput.monitorData);
+
+    for (size_t i = 0; i < unpackStages.size(); i++) {
+      procMon.timeUnpack.wall += stages.Timing(unpackStages[i]).Duration();
+      procMon.timeUnpack.bytes += unpackBytes[i];
+    }
+    for (auto [id, timings] : {std::pair{stsRecoStage, &procMon.timeSTS}, std::pair{tofRecoStage, &procMon.timeTOF},
+                               std::pair{trdRecoStage, &procMon.timeTRD}, std::pair{caStage, &procMon.timeCA}}) {
+      if (id) timings->wall = stages.Timing(*id).Duration();
+    }
+    procMon.timeCriticalPath = stages.CriticalPathTime();
+    if (Opts().Profiling() >= ProfilingPerTS) {
+      L_(info) << stages.Report();
+    }
+
+    if (Opts().Has(Step::Unpack)) {
+      L_(info) << "TS contains Digis: STS=" << digis.fSts.size() << " MUCH=" << digis.fMuch.size()
+               << " TOF=" << digis.fTof.size() << " BMON=" << digis.fBmon.size() << " TRD=" << digis.fTrd.size()
+               << " TRD2D=" << digis.fTrd2d.size() << " RICH=" << digis.fRich.size() << " PSD=" << digis.fPsd.size()
+               << " FSD=" << digis.fFsd.size();
+    }
+    L_(info) << "TS contains Hits: STS=" << recoData.stsHits.NElements() << " TOF=" << recoData.tofHits.NElements()
+             << " TRD=" << recoData.trdHits.NElements();
 
     // --- Event building
     std::vector<DigiEvent> events;
@@ -442,14 +561,43 @@ RecoResults Reco::Run(const fles::Timeslice& ts)
     if (fbReconstructDigiEvents) {
       fEvSelectingMonitor.IncrementCounter(evselect::ECounter::Timeslices);
       fEvSelectingMonitor.IncrementCounter(evselect::ECounter::EventsTotal, events.size());
-      for (auto& event : events) {
-        fEvSelectingMonitor.StartTimer(evselect::ETimer::EventReconstruction);
-        event.fSelectionTriggers = ReconstructEvent(event);
-        fEvSelectingMonitor.StopTimer(evselect::ETimer::EventReconstruction);
+
+      // STS hit finding runs on the xpu device and stays serial, the hits are copied out of the device buffers.
+      // The events are processed in batches, so that only the STS hits of one batch are kept in memory.
+      const size_t batchSize = kEventsPerThreadInBatch * fEventReco.size();
+      std::vector<PartitionedVector<sts::Hit>> stsHits;
+      stsHits.reserve(std::min(batchSize, events.size()));
+      evselect::MonitorData_t stsMonitor;
+      for (size_t iFirst = 0; iFirst < events.size(); iFirst += batchSize) {
+        const size_t iLast = std::min(iFirst + batchSize, events.size());
+        stsHits.clear();
+        for (size_t iEvent = iFirst; iEvent < iLast; iEvent++) {
+          stsMonitor.StartTimer(evselect::ETimer::StsHitFinder);
+          stsHits.emplace_back((*fStsHitFinder)(events[iEvent].fSts).hits);
+          stsMonitor.StopTimer(evselect::ETimer::StsHitFinder);
+        }
+
+        CBM_PARALLEL_FOR(schedule(dynamic) if (!fbEventRecoQa))
+        for (size_t iEvent = iFirst; iEvent < iLast; iEvent++) {
+          EventReco& reco = fEventReco[openmp::GetThreadNum()];
+          reco.monitor.StartTimer(evselect::ETimer::EventReconstruction);
+          events[iEvent].fSelectionTriggers = ReconstructEvent(events[iEvent], stsHits[iEvent - iFirst], reco);
+          reco.monitor.StopTimer(evselect::ETimer::EventReconstruction);
+        }
       }
-      auto v0FinderMonitor = fV0Finder->GetMonitor();
-      fEvSelectingMonitor.IncrementCounter(evselect::ECounter::LambdaCandidates,
-                                           v0FinderMonitor.GetCounterValue(kfp::ECounter::KfpLambdaCandidates));
+
+      // Merge the monitors of the threads
+      evselect::MonitorData_t eventMonitor;
+      for (auto& reco : fEventReco) {
+        eventMonitor.AddMonitorData(reco.monitor, true);
+        reco.monitor.Reset();
+
+        auto v0FinderMonitor = reco.v0Finder->GetMonitor();
+        eventMonitor.IncrementCounter(evselect::ECounter::LambdaCandidates,
+                                      v0FinderMonitor.GetCounterValue(kfp::ECounter::KfpLambdaCandidates));
+      }
+      eventMonitor.AddMonitorData(stsMonitor);
+      fEvSelectingMonitor.AddMonitorData(eventMonitor);
     }
 
     // --- Filter data for output
@@ -475,6 +623,9 @@ RecoResults Reco::Run(const fles::Timeslice& ts)
       results.trdHits = std::move(recoData.trdHits);
     }
 
+    // Digis that are not part of the output keep their memory for the next timeslice
+    RecycleDigis(digis);
+
     // QA
     if (fSender != nullptr) {
       (*fGeneralQa)(ts);
@@ -488,12 +639,38 @@ RecoResults Reco::Run(const fles::Timeslice& ts)
   if (prevTsId) {
     procMon.tsDelta = ts.index() - *prevTsId;
   }
-  prevTsId = ts.index();
+  prevTsId            = ts.index();
+  procMon.nPageFaults = GetPageFaults() - pageFaultsStart;
+  L_(debug) << "TS " << ts.index() << ": " << procMon.nPageFaults << " page faults";
   QueueProcessingMetrics(procMon);
 
   return results;
 }
 
+void Reco::Recycle(RecoResults&& results)
+{
+  DigiData digis;
+  digis.fBmon  = std::move(results.bmonDigis);
+  digis.fSts   = std::move(results.stsDigis);
+  digis.fMuch  = std::move(results.muchDigis);
+  digis.fTrd2d = std::move(results.trd2dDigis);
+  digis.fTrd   = std::move(results.trdDigis);
+  digis.fTof   = std::move(results.tofDigis);
+  digis.fRich  = std::move(results.richDigis);
+  RecycleDigis(digis);
+}
+
+void Reco::RecycleDigis(DigiData& digis)
+{
+  if (fBmonUnpack) fBmonUnpack->Recycle(std::move(digis.fBmon));
+  if (fStsUnpack) fStsUnpack->Recycle(std::move(digis.fSts));
+  if (fMuchUnpack) fMuchUnpack->Recycle(std::move(digis.fMuch));
+  if (fTrd2dUnpack) fTrd2dUnpack->Recycle(std::move(digis.fTrd2d));
+  if (fTrdUnpack) fTrdUnpack->Recycle(std::move(digis.fTrd));
+  if (fTofUnpack) fTofUnpack->Recycle(std::move(digis.fTof));
+  if (fRichUnpack) fRichUnpack->Recycle(std::move(digis.fRich));
+}
+
 void Reco::Finalize()
 {
   if (fStsHitFinder) {
@@ -503,12 +680,16 @@ void Reco::Finalize()
     L_(info) << "Track finding in a timeslice:";
     fTracking->Finalize();
   }
-  if (fTrackingEvent) {
-    L_(info) << "Track finding in digi events:";
-    fTrackingEvent->Finalize();
-  }
   if (fbReconstructDigiEvents) {
-    fV0Finder->Finalize();
+    // Collect the monitors of all threads in the first instance
+    auto& first = fEventReco.front();
+    for (size_t iThread = 1; iThread < fEventReco.size(); iThread++) {
+      first.tracking->MergeMonitor(*fEventReco[iThread].tracking);
+      first.v0Finder->MergeMonitor(*fEventReco[iThread].v0Finder);
+    }
+    L_(info) << "Track finding in digi events:";
+    first.tracking->Finalize();
+    first.v0Finder->Finalize();
     L_(info) << fEvSelectingMonitor.ToString();
   }
 
@@ -538,16 +719,16 @@ void Reco::PrintTimings(xpu::timings& timings)
   }
 }
 
-CbmEventTriggers Reco::ReconstructEvent(const DigiEvent& digiEvent)
+CbmEventTriggers Reco::ReconstructEvent(const DigiEvent& digiEvent, PartitionedSpan<sts::Hit> stsHits, EventReco& reco)
 {
   CbmEventTriggers triggers(0);
   RecoResults recoEvent;
   //* BMON hit reconstruction
   {
-    fEvSelectingMonitor.StartTimer(evselect::ETimer::BmonHitFinder);
-    auto [calDigis, calMonitor]          = (*fBmonCalibrator)(digiEvent.fBmon);
-    auto [hits, hitMonitor, digiIndices] = (*fBmonHitFinder)(calDigis);
-    fEvSelectingMonitor.StopTimer(evselect::ETimer::BmonHitFinder);
+    reco.monitor.StartTimer(evselect::ETimer::BmonHitFinder);
+    auto [calDigis, calMonitor]          = (*reco.bmonCalibrator)(digiEvent.fBmon);
+    auto [hits, hitMonitor, digiIndices] = (*fBmonHitFinder)(calDigis, openmp::GetThreadNum());
+    reco.monitor.StopTimer(evselect::ETimer::BmonHitFinder);
     if (fBmonHitFinderQa != nullptr) {
       fBmonHitFinderQa->RegisterDigis(&calDigis);
       fBmonHitFinderQa->RegisterHits(&hits);
@@ -557,26 +738,23 @@ CbmEventTriggers Reco::ReconstructEvent(const DigiEvent& digiEvent)
     recoEvent.bmonHits = std::move(hits);
   }
 
-  //* STS hit reconstruction
+  //* STS hits, found before the parallel event loop
   {
-    fEvSelectingMonitor.StartTimer(evselect::ETimer::StsHitFinder);
-    auto stsResults = (*fStsHitFinder)(digiEvent.fSts);
-    fEvSelectingMonitor.StopTimer(evselect::ETimer::StsHitFinder);
-    if (stsResults.hits.NElements() < 4) {  // TODO: Provide a config for cuts (testing mode for now)
-      fEvSelectingMonitor.IncrementCounter(evselect::ECounter::EventsNeStsHits);
+    if (stsHits.NElements() < 4) {  // TODO: Provide a config for cuts (testing mode for now)
+      reco.monitor.IncrementCounter(evselect::ECounter::EventsNeStsHits);
       return triggers;
     }
-    recoEvent.stsHits = stsResults.hits;
+    recoEvent.stsHits = stsHits;
   }
 
   //* TOF hit reconstruction
   {
-    fEvSelectingMonitor.StartTimer(evselect::ETimer::TofHitFinder);
-    auto [caldigis, calmonitor]          = (*fTofCalibrator)(digiEvent.fTof);
-    auto [hits, hitmonitor, digiindices] = (*fTofHitFinder)(caldigis);
-    fEvSelectingMonitor.StopTimer(evselect::ETimer::TofHitFinder);
+    reco.monitor.StartTimer(evselect::ETimer::TofHitFinder);
+    auto [caldigis, calmonitor]          = (*reco.tofCalibrator)(digiEvent.fTof);
+    auto [hits, hitmonitor, digiindices] = (*reco.tofHitFinder)(caldigis);
+    reco.monitor.StopTimer(evselect::ETimer::TofHitFinder);
     if (hits.NElements() < 2) {  // TODO: Provide a config for cuts (testing mode for now)
-      fEvSelectingMonitor.IncrementCounter(evselect::ECounter::EventsNeTofHits);
+      reco.monitor.IncrementCounter(evselect::ECounter::EventsNeTofHits);
       return triggers;
     }
     recoEvent.tofHits = std::move(hits);
@@ -585,57 +763,60 @@ CbmEventTriggers Reco::ReconstructEvent(const DigiEvent& digiEvent)
   //* TRD hit reconstruction
   {
     // FIXME: additional copy of digis, figure out how to pass 1d + 2d digis at once to hitfinder
-    fEvSelectingMonitor.StartTimer(evselect::ETimer::TrdHitFinder);
+    reco.monitor.StartTimer(evselect::ETimer::TrdHitFinder);
     const auto& digis1d = digiEvent.fTrd;
     const auto& digis2d = digiEvent.fTrd2d;
     PODVector<CbmTrdDigi> allDigis{};
     allDigis.reserve(digis1d.size() + digis2d.size());
     std::copy(digis1d.begin(), digis1d.end(), std::back_inserter(allDigis));
     std::copy(digis2d.begin(), digis2d.end(), std::back_inserter(allDigis));
-    auto trdResults = (*fTrdHitfind)(allDigis);
-    fEvSelectingMonitor.StopTimer(evselect::ETimer::TrdHitFinder);
+    auto trdResults = (*reco.trdHitfind)(allDigis);
+    reco.monitor.StopTimer(evselect::ETimer::TrdHitFinder);
     recoEvent.trdHits = std::move(std::get<0>(trdResults));
   }
 
   //* Tracking
   {
-    fEvSelectingMonitor.StartTimer(evselect::ETimer::TrackFinder);
+    reco.monitor.StartTimer(evselect::ETimer::TrackFinder);
     TrackingChain::Input_t input{.stsHits = recoEvent.stsHits,
                                  .tofHits = recoEvent.tofHits,
                                  .trdHits = recoEvent.trdHits};
-    TrackingChain::Output_t output = fTrackingEvent->Run(input);
+    TrackingChain::Output_t output = reco.tracking->Run(input);
     recoEvent.tracks               = std::move(output.tracks);
     recoEvent.trackStsHitIndices   = std::move(output.stsHitIndices);
     recoEvent.trackTofHitIndices   = std::move(output.tofHitIndices);
     recoEvent.trackTrdHitIndices   = std::move(output.trdHitIndices);
-    fEvSelectingMonitor.StopTimer(evselect::ETimer::TrackFinder);
+    reco.monitor.StopTimer(evselect::ETimer::TrackFinder);
     if (recoEvent.tracks.size() < 2) {  // Reject all events with less then two tracks
-      fEvSelectingMonitor.IncrementCounter(evselect::ECounter::EventsNeTracks);
+      reco.monitor.IncrementCounter(evselect::ECounter::EventsNeTracks);
       return triggers;
     }
   }
 
   //* V0-selector
-  fEvSelectingMonitor.StartTimer(evselect::ETimer::V0Finder);
-  triggers = fV0Finder->ProcessEvent(recoEvent);
+  reco.monitor.StartTimer(evselect::ETimer::V0Finder);
+  triggers = reco.v0Finder->ProcessEvent(recoEvent);
   if (triggers.Test(CbmEventTriggers::ETrigger::Lambda)) {
     L_(info) << "!!! Found event with potential lambda candidates";
-    fEvSelectingMonitor.IncrementCounter(evselect::ECounter::EventsSelected);
+    reco.monitor.IncrementCounter(evselect::ECounter::EventsSelected);
   }
-  fEvSelectingMonitor.StopTimer(evselect::ETimer::V0Finder);
+  reco.monitor.StopTimer(evselect::ETimer::V0Finder);
   return triggers;
 }
 
 
 template<class Unpacker>
-auto Reco::RunUnpacker(const std::unique_ptr<Unpacker>& unpacker, const fles::Timeslice& ts) -> UnpackResult_t<Unpacker>
+auto Reco::RunUnpacker(const std::unique_ptr<Unpacker>& unpacker, const fles::Timeslice& ts, size_t& bytesIn,
+                       std::function<void()>& queueMetrics) -> UnpackResult_t<Unpacker>
 {
   if (!unpacker) {
     return {};
   }
   auto [digis, monitor, aux] = (*unpacker)(ts);
-  QueueUnpackerMetricsDet(monitor);
-  return std::make_tuple(digis, aux);
+  bytesIn                    = monitor.sizeBytesIn;
+  TaskTimer::AddBytes(monitor.sizeBytesIn);
+  queueMetrics = [this, mon = std::move(monitor)] { QueueUnpackerMetricsDet(mon); };
+  return std::make_tuple(std::move(digis), std::move(aux));
 }
 
 template<class MSMonitor>
@@ -657,6 +838,9 @@ void Reco::QueueUnpackerMetricsDet(const UnpackMonitor<MSMonitor>& monitor)
                              {MkKey("unpackNumMs"), monitor.numMs},
                              {MkKey("unpackNumErrInvalidSysVer"), monitor.errInvalidSysVer},
                              {MkKey("unpackNumErrInvalidEqId"), monitor.errInvalidEqId},
+                             {MkKey("unpackNumUnsortedMs"), monitor.numUnsortedMs},
+                             {MkKey("unpackTime"), monitor.time},
+                             {MkKey("unpackThroughputGBps"), FilterNan(monitor.Throughput())},
                            });
 }
 
@@ -783,11 +967,12 @@ void Reco::QueueProcessingMetrics(const ProcessingMonitor& mon)
 
   MetricFieldSet fields = {
     {"processingTimeTotal", mon.time.wall()},   {"processingThroughput", FilterNan(mon.time.throughput())},
-    {"caRecoTimeTotal", mon.timeCA.wall()},     {"caRecoThroughput", FilterNan(mon.timeCA.throughput())},
-    {"trdRecoTimeTotal", mon.timeTRD.wall()},   {"trdRecoThroughput", FilterNan(mon.timeTRD.throughput())},
-    {"tofRecoTimeTotal", mon.timeTOF.wall()},   {"tofRecoThroughput", FilterNan(mon.timeTOF.throughput())},
-    {"stsRecoTimeTotal", mon.timeSTS.wall()},   {"stsRecoThroughput", FilterNan(mon.timeSTS.throughput())},
-    {"unpackTimeTotal", mon.timeUnpack.wall()}, {"unpackThroughput", FilterNan(mon.timeUnpack.throughput())}};
+    {"caRecoTimeTotal", mon.timeCA.wall},       {"caRecoThroughput", mon.timeCA.Throughput()},
+    {"trdRecoTimeTotal", mon.timeTRD.wall},     {"trdRecoThroughput", mon.timeTRD.Throughput()},
+    {"tofRecoTimeTotal", mon.timeTOF.wall},     {"tofRecoThroughput", mon.timeTOF.Throughput()},
+    {"stsRecoTimeTotal", mon.timeSTS.wall},     {"stsRecoThroughput", mon.timeSTS.Throughput()},
+    {"unpackTimeTotal", mon.timeUnpack.wall},   {"unpackThroughput", mon.timeUnpack.Throughput()},
+    {"processingTimeCriticalPath", mon.timeCriticalPath}, {"processingPageFaults", mon.nPageFaults}};
 
   if (mon.tsDelta) {
     fields.emplace_back("tsDelta", *mon.tsDelta);
@@ -803,10 +988,22 @@ void Reco::QueueProcessingExtraMetrics(const ProcessingExtraMonitor& mon)
     return;
   }
 
+  // In pipelined mode the archive is written on the writer thread, where no xpu timer is available. The write time
+  // is then measured there and passed back in timeWriter.
+  double timeWriteArchive       = mon.timeWriteArchive.wall();
+  double throughputWriteArchive = mon.timeWriteArchive.throughput();
+  if (mon.timeWriter > 0.) {
+    timeWriteArchive       = mon.timeWriter;
+    throughputWriteArchive = mon.bytesWritten / (mon.timeWriter * 1.e6);  // GB/s, as xpu::timings::throughput()
+  }
+
   MetricFieldSet fields = {{"processingTimeIdle", FilterNan(mon.timeIdle)},
-                           {"processingTimeWriteArchive", mon.timeWriteArchive.wall()},
-                           {"processingThroughputWriteArchive", FilterNan(mon.timeWriteArchive.throughput())},
-                           {"processingBytesWritten", FilterNan(mon.bytesWritten)}};
+                           {"processingTimeWriteArchive", timeWriteArchive},
+                           {"processingThroughputWriteArchive", FilterNan(throughputWriteArchive)},
+                           {"processingBytesWritten", FilterNan(mon.bytesWritten)},
+                           {"processingTimeWriter", FilterNan(mon.timeWriter)},
+                           {"processingQueuedTimeslices", mon.nQueuedTimeslices},
+                           {"processingQueuedResults", mon.nQueuedResults}};
 
   GetMonitor().QueueMetric("cbmreco", {{"hostname", fles::system::current_hostname()}, {"child", Opts().ChildId()}},
                            std::move(fields));
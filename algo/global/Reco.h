@@ -7,6 +7,9 @@
 #include "SubChain.h"
 #include "evselector/RecoEventSelectorMonitor.h"
 #include "global/RecoResults.h"
+#include "util/RecyclingBuffer.h"
+
+#include <functional>
 
 #include <xpu/host.h>
 
@@ -103,14 +106,28 @@ namespace cbm::algo
 
 namespace cbm::algo
 {
+  /**
+   * @brief Wall time and processed bytes of a processing stage
+   * @note Taken from the task graph of Reco::Run, since stages on worker threads can't use xpu timers
+   */
+  struct StageTimings {
+    double wall  = 0.;  //< wall time [ms]
+    size_t bytes = 0;   //< processed bytes
+
+    /** @brief Throughput [GB/s] **/
+    double Throughput() const { return wall > 0. ? bytes / (wall * 1.e6) : 0.; }
+  };
+
   struct ProcessingMonitor {
-    xpu::timings time;           //< total processing time
-    xpu::timings timeUnpack;     //< time spent in unpacking
-    xpu::timings timeSTS;        //< time spent in STS reco
-    xpu::timings timeTOF;        //< time spent in TOF reco
-    xpu::timings timeTRD;        //< time spent in TRD reco
-    xpu::timings timeCA;         //< time spent in tracking
-    std::optional<i64> tsDelta;  //< id difference between current and previous timeslice
+    xpu::timings time;             //< total processing time
+    StageTimings timeUnpack;       //< time spent in unpacking (summed over detectors)
+    StageTimings timeSTS;          //< time spent in STS reco
+    StageTimings timeTOF;          //< time spent in TOF reco
+    StageTimings timeTRD;          //< time spent in TRD reco
+    StageTimings timeCA;           //< time spent in tracking
+    double timeCriticalPath = 0.;  //< longest chain of dependent stages [ms]
+    size_t nPageFaults      = 0;   //< page faults while processing the timeslice
+    std::optional<i64> tsDelta;    //< id difference between current and previous timeslice
   };
 
   /**
@@ -118,9 +135,12 @@ namespace cbm::algo
    * @note Used in the main function, this should be eventually merged with ProcessingMonitor and we have a single class that handles the full processing loop
    */
   struct ProcessingExtraMonitor {
-    xpu::timings timeWriteArchive;  //< time spent writing archive
+    xpu::timings timeWriteArchive;  //< time spent writing archive (serial mode)
     size_t bytesWritten;            //< bytes written to archive (estimated)
-    double timeIdle = 0.;           //< time spent idle (waiting for next timeslice) [ms]
+    double timeIdle          = 0.;  //< time spent idle (waiting for next timeslice) [ms]
+    double timeWriter        = 0.;  //< time spent writing the last result (pipelined mode) [ms]
+    size_t nQueuedTimeslices = 0;   //< timeslices fetched but not yet reconstructed (pipelined mode)
+    size_t nQueuedResults    = 0;   //< results waiting for the writer thread (pipelined mode)
   };
 
   class Reco : SubChain {
@@ -136,7 +156,11 @@ namespace cbm::algo
     void Init(const Options&);
     RecoResults Run(const fles::Timeslice&);
 
-    CbmEventTriggers ReconstructEvent(const DigiEvent& event);
+    /**
+     * @brief Return the results of Run() once they are no longer needed, so their memory is reused
+     */
+    void Recycle(RecoResults&&);
+
     void Finalize();
     void PrintTimings(xpu::timings&);
 
@@ -157,7 +181,6 @@ namespace cbm::algo
 
     // BMON
     std::unique_ptr<bmon::Unpack> fBmonUnpack;
-    std::unique_ptr<bmon::Calibrate> fBmonCalibrator;
     std::unique_ptr<bmon::Hitfind> fBmonHitFinder;
     std::unique_ptr<bmon::HitfindQa> fBmonHitFinderQa;
 
@@ -182,18 +205,34 @@ namespace cbm::algo
     std::unique_ptr<trd::Unpack> fTrdUnpack;
     std::unique_ptr<trd2d::Unpack> fTrd2dUnpack;
     std::unique_ptr<trd::Hitfind> fTrdHitfind;
+    RecyclingBuffer<CbmTrdDigi> fTrdDigiBuffer;  ///< Combined 1D and 2D digis as hitfinder input
 
     // Eventbuilding
     std::unique_ptr<evbuild::EventbuildChain> fEventBuild;
 
     // Tracking
-    std::unique_ptr<TrackingChain> fTracking;       ///< Tracking in timeslice
-    std::unique_ptr<TrackingChain> fTrackingEvent;  ///< Tracking in event
-
-    // V0-finding
-    std::unique_ptr<V0FinderChain> fV0Finder;  ///< V0-finding chain (in event or a bunch of events)
-
-    // Event selection
+    std::unique_ptr<TrackingChain> fTracking;  ///< Tracking in timeslice
+
+    // Event reconstruction and selection
+    /**
+     * @brief Algorithms with internal state, used in the event reconstruction. One instance per thread.
+     * @note The tracking parameters are shared between the instances, the buffers are not: memory grows with the
+     *       number of threads.
+     */
+    struct EventReco {
+      std::unique_ptr<bmon::Calibrate> bmonCalibrator;
+      std::unique_ptr<tof::Calibrate> tofCalibrator;
+      std::unique_ptr<tof::Hitfind> tofHitFinder;
+      std::unique_ptr<trd::Hitfind> trdHitfind;
+      std::unique_ptr<TrackingChain> tracking;  //< Tracking in event
+      std::unique_ptr<V0FinderChain> v0Finder;  //< V0-finding chain (in event or a bunch of events)
+      evselect::MonitorData_t monitor;          //< Monitor data of the current timeslice
+    };
+    /// Number of events per thread, whose STS hits are found before the events are reconstructed in parallel
+    static constexpr size_t kEventsPerThreadInBatch = 16;
+
+    std::vector<EventReco> fEventReco;      ///< Event reconstruction per thread
+    bool fbEventRecoQa = false;             ///< QA of the event reconstruction, events are processed serially
     evselect::Monitor fEvSelectingMonitor;  ///< Monitor for event selecting
 
     // QA
@@ -203,8 +242,15 @@ namespace cbm::algo
 
     void Validate(const Options& opts);
 
+    CbmEventTriggers ReconstructEvent(const DigiEvent& event, PartitionedSpan<sts::Hit> stsHits, EventReco& reco);
+
+    void RecycleDigis(DigiData&);
+
+    /// Run an unpacker. Its monitor metrics are not queued but returned in queueMetrics, so that they can be queued
+    /// on the calling thread of the stage graph.
     template<class Unpacker>
-    auto RunUnpacker(const std::unique_ptr<Unpacker>&, const fles::Timeslice&) -> UnpackResult_t<Unpacker>;
+    auto RunUnpacker(const std::unique_ptr<Unpacker>&, const fles::Timeslice&, size_t& bytesIn,
+                     std::function<void()>& queueMetrics) -> UnpackResult_t<Unpacker>;
 
     template<class MSMonitor>
     void QueueUnpackerMetricsDet(const UnpackMonitor<MSMonitor>&);
@@ -13,6 +13,7 @@
 #include "PartitionedSpan.h"
 #include "PartitionedVector.h"
 #include "bmon/Hit.h"
+#include "ca/TrackHitIndices.h"
 #include "ca/core/data/CaTrack.h"
 #include "ca/core/utils/CaVector.h"
 #include "sts/Cluster.h"
@@ -27,7 +28,7 @@ namespace cbm::algo
   /// @name RecoResults
   /// @brief  Structure to keep reconstructed results: digi-events, hits and tracks
   struct RecoResults {
-    using HitId_t = std::pair<uint32_t, uint32_t>;  // Hit ID by track
+    using HitId_t = ca::TrackHitIndices::HitId_t;  // Hit ID by track
 
     PODVector<CbmBmonDigi> bmonDigis;
     PODVector<CbmStsDigi> stsDigis;
@@ -47,8 +48,8 @@ namespace cbm::algo
     PartitionedVector<bmon::Hit> bmonHits;
 
     ca::Vector<ca::Track> tracks;
-    ca::Vector<std::vector<HitId_t>> trackStsHitIndices;  // [trk][hit][(iPart, iHit)]
-    ca::Vector<std::vector<HitId_t>> trackTofHitIndices;  // [trk][hit][(iPart, iHit)]
-    ca::Vector<std::vector<HitId_t>> trackTrdHitIndices;  // [trk][hit][(iPart, iHit)]
+    ca::TrackHitIndices trackStsHitIndices;  // [trk][hit][(iPart, iHit)]
+    ca::TrackHitIndices trackTofHitIndices;  // [trk][hit][(iPart, iHit)]
+    ca::TrackHitIndices trackTrdHitIndices;  // [trk][hit][(iPart, iHit)]
   };
 }  // namespace cbm::algo
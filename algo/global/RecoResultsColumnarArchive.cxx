@@ -0,0 +1,411 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "RecoResultsColumnarArchive.h"
+
+#include "BuildInfo.h"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/serialization/vector.hpp>
+#ifdef HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cbm::algo;
+using namespace cbm::algo::columnar;
+
+namespace b_io = boost::iostreams;
+namespace b_ar = boost::archive;
+
+RecoResultsColumnarWriter::RecoResultsColumnarWriter(const std::string& path, bool compress)
+  : fFile(path, std::ios::binary | std::ios::trunc)
+  , fCompress(compress)
+{
+  if (!fFile) {
+    throw FatalError("Columnar archive: Failed to open '{}' for writing", path);
+  }
+  if (fCompress && !BuildInfo::WITH_ZSTD) {
+    throw FatalError("Columnar archive: Compression requested, but zstd is not available");
+  }
+  WriteRaw(Magic, sizeof(Magic));
+}
+
+RecoResultsColumnarWriter::~RecoResultsColumnarWriter()
+{
+  try {
+    Close();
+  }
+  catch (...) {
+    // Destructor must not throw, the archive is incomplete in this case
+  }
+}
+
+size_t RecoResultsColumnarWriter::Put(u64 tsIndex, u64 tsStartTime, const RecoResults& results)
+{
+  if (fClosed) {
+    throw FatalError("Columnar archive: Put() after Close()");
+  }
+
+  const u64 start = fPos;
+  fTsCols.clear();
+
+  WriteColumn(RecoColumn::BmonDigis, gsl::span<const CbmBmonDigi>(results.bmonDigis));
+  WriteColumn(RecoColumn::StsDigis, gsl::span<const CbmStsDigi>(results.stsDigis));
+  WriteColumn(RecoColumn::MuchDigis, gsl::span<const CbmMuchDigi>(results.muchDigis));
+  WriteColumn(RecoColumn::Trd2dDigis, gsl::span<const CbmTrdDigi>(results.trd2dDigis));
+  WriteColumn(RecoColumn::TrdDigis, gsl::span<const CbmTrdDigi>(results.trdDigis));
+  WriteColumn(RecoColumn::TofDigis, gsl::span<const CbmTofDigi>(results.tofDigis));
+  WriteColumn(RecoColumn::RichDigis, gsl::span<const CbmRichDigi>(results.richDigis));
+
+  // Digi events have a nested layout, keep them as a boost archive in a single column
+  {
+    std::vector<CbmDigiEvent> events;
+    events.reserve(results.events.size());
+    for (const auto& event : results.events) {
+      events.emplace_back(event.ToStorable());
+    }
+    std::string blob;
+    {
+      b_io::back_insert_device<std::string> inserter(blob);
+      b_io::stream<b_io::back_insert_device<std::string>> stream(inserter);
+      b_ar::binary_oarchive oa(stream, b_ar::no_header);
+      oa << events;
+    }
+    WriteColumn(RecoColumn::DigiEvents, blob.data(), blob.size());
+  }
+
+  WritePartitioned<sts::Cluster>(RecoColumn::StsClusters, RecoColumn::StsClusterOffsets,
+                                 RecoColumn::StsClusterAddresses, results.stsClusters);
+  WritePartitioned<sts::Hit>(RecoColumn::StsHits, RecoColumn::StsHitOffsets, RecoColumn::StsHitAddresses,
+                             results.stsHits);
+  WritePartitioned<tof::Hit>(RecoColumn::TofHits, RecoColumn::TofHitOffsets, RecoColumn::TofHitAddresses,
+                             results.tofHits);
+  WritePartitioned<trd::Hit>(RecoColumn::TrdHits, RecoColumn::TrdHitOffsets, RecoColumn::TrdHitAddresses,
+                             results.trdHits);
+
+  const auto& tracks = results.tracks;
+  WriteColumn(RecoColumn::Tracks, tracks.size() == 0 ? nullptr : &tracks[0], tracks.size() * sizeof(ca::Track));
+  WriteTrackHitIndices(RecoColumn::TrackStsHitOffsets, RecoColumn::TrackStsHitIndices, results.trackStsHitIndices);
+  WriteTrackHitIndices(RecoColumn::TrackTofHitOffsets, RecoColumn::TrackTofHitIndices, results.trackTofHitIndices);
+  WriteTrackHitIndices(RecoColumn::TrackTrdHitOffsets, RecoColumn::TrackTrdHitIndices, results.trackTrdHitIndices);
+
+  Align();
+  fTsIndexOffsets.push_back(fPos);
+  TsIndexHeader header{tsIndex, tsStartTime, fTsCols.size()};
+  WriteRaw(&header, sizeof(header));
+  WriteRaw(fTsCols.data(), fTsCols.size() * sizeof(ColumnEntry));
+  fFile.flush();
+
+  return fPos - start;
+}
+
+void RecoResultsColumnarWriter::Close()
+{
+  if (fClosed) return;
+  fClosed = true;
+
+  WriteRaw(fTsIndexOffsets.data(), fTsIndexOffsets.size() * sizeof(u64));
+  Footer footer{fTsIndexOffsets.size(), {}};
+  std::copy(std::begin(Magic), std::end(Magic), footer.magic);
+  WriteRaw(&footer, sizeof(footer));
+  fFile.close();
+  if (!fFile) {
+    throw FatalError("Columnar archive: Failed to close output file");
+  }
+}
+
+void RecoResultsColumnarWriter::WriteRaw(const void* data, size_t size)
+{
+  if (size == 0) return;
+  fFile.write(static_cast<const char*>(data), size);
+  if (!fFile) {
+    throw FatalError("Columnar archive: Failed to write {} bytes at position {}", size, fPos);
+  }
+  fPos += size;
+}
+
+void RecoResultsColumnarWriter::Align()
+{
+  static constexpr std::array<char, ColumnAlignment> zeros{};
+  WriteRaw(zeros.data(), (ColumnAlignment - fPos % ColumnAlignment) % ColumnAlignment);
+}
+
+void RecoResultsColumnarWriter::WriteColumn(RecoColumn column, const void* data, size_t size)
+{
+  Align();
+  ColumnEntry entry{column, ColumnCompression::None, fPos, size, size};
+
+#ifdef HAVE_ZSTD
+  if (fCompress && size > 0) {
+    std::string compressed;
+    {
+      b_io::filtering_ostream out;
+      out.push(b_io::zstd_compressor(b_io::zstd::best_speed));
+      out.push(b_io::back_inserter(compressed));
+      out.write(static_cast<const char*>(data), size);
+    }
+    // Keep incompressible columns raw, so they can still be viewed in place
+    if (compressed.size() < size) {
+      entry.compression = ColumnCompression::Zstd;
+      entry.storedSize  = compressed.size();
+      WriteRaw(compressed.data(), compressed.size());
+      fTsCols.push_back(entry);
+      return;
+    }
+  }
+#endif
+
+  WriteRaw(data, size);
+  fTsCols.push_back(entry);
+}
+
+bool RecoResultsColumnarReader::IsColumnarArchive(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(Magic)] = {};
+  file.read(magic, sizeof(magic));
+  return file && std::equal(std::begin(magic), std::end(magic), std::begin(Magic));
+}
+
+RecoResultsColumnarReader::RecoResultsColumnarReader(const std::string& path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw FatalError("Columnar archive: Failed to open '{}'", path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw FatalError("Columnar archive: Failed to stat '{}'", path);
+  }
+  fSize = st.st_size;
+  if (fSize < sizeof(Magic) + sizeof(Footer)) {
+    close(fd);
+    throw FatalError("Columnar archive: '{}' is too small to be a columnar archive", path);
+  }
+
+  void* data = mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw FatalError("Columnar archive: Failed to map '{}'", path);
+  }
+  fData = static_cast<const char*>(data);
+
+  Footer footer;
+  std::memcpy(&footer, fData + fSize - sizeof(Footer), sizeof(Footer));
+  if (!std::equal(std::begin(Magic), std::end(Magic), fData)
+      || !std::equal(std::begin(Magic), std::end(Magic), footer.magic)) {
+    munmap(const_cast<char*>(fData), fSize);
+    throw FatalError("Columnar archive: '{}' has no valid header or footer (writer not closed?)", path);
+  }
+
+  const size_t indexBytes = footer.nTimeslices * sizeof(u64);
+  if (indexBytes > fSize - sizeof(Magic) - sizeof(Footer)) {
+    munmap(const_cast<char*>(fData), fSize);
+    throw FatalError("Columnar archive: '{}' has a corrupt footer", path);
+  }
+  fTimeslices.resize(footer.nTimeslices);
+  std::memcpy(fTimeslices.data(), fData + fSize - sizeof(Footer) - indexBytes, indexBytes);
+
+  try {
+    CheckIndex(fSize - sizeof(Footer) - indexBytes);
+  }
+  catch (const FatalError&) {
+    munmap(const_cast<char*>(fData), fSize);
+    throw;
+  }
+}
+
+void RecoResultsColumnarReader::CheckIndex(size_t indexEnd) const
+{
+  // The index positions and sizes come from the file, so they are checked before anything is read through them
+  for (size_t ts = 0; ts < fTimeslices.size(); ts++) {
+    const u64 pos = fTimeslices[ts];
+    if (pos < sizeof(Magic) || pos > indexEnd || indexEnd - pos < sizeof(TsIndexHeader)) {
+      throw FatalError("Columnar archive: Index of TS {} at {} is outside of the file", ts, pos);
+    }
+    TsIndexHeader header;
+    std::memcpy(&header, fData + pos, sizeof(header));
+    if (header.nColumns > (indexEnd - pos - sizeof(TsIndexHeader)) / sizeof(ColumnEntry)) {
+      throw FatalError("Columnar archive: Index of TS {} has {} columns, more than fit into the file", ts,
+                       header.nColumns);
+    }
+    for (u64 iCol = 0; iCol < header.nColumns; iCol++) {
+      ColumnEntry entry;
+      std::memcpy(&entry, fData + pos + sizeof(TsIndexHeader) + iCol * sizeof(ColumnEntry), sizeof(entry));
+      if (entry.offset < sizeof(Magic) || entry.offset > fSize || entry.storedSize > fSize - entry.offset) {
+        throw FatalError("Columnar archive: Column {} of TS {} exceeds the file size", static_cast<u32>(entry.column),
+                         ts);
+      }
+      if (entry.compression == ColumnCompression::None && entry.rawSize != entry.storedSize) {
+        throw FatalError("Columnar archive: Uncompressed column {} of TS {} has inconsistent sizes",
+                         static_cast<u32>(entry.column), ts);
+      }
+    }
+  }
+}
+
+RecoResultsColumnarReader::~RecoResultsColumnarReader()
+{
+  if (fData != nullptr) munmap(const_cast<char*>(fData), fSize);
+}
+
+const TsIndexHeader& RecoResultsColumnarReader::Header(size_t ts) const
+{
+  return *reinterpret_cast<const TsIndexHeader*>(fData + fTimeslices.at(ts));
+}
+
+const ColumnEntry* RecoResultsColumnarReader::Find(size_t ts, RecoColumn column) const
+{
+  const auto& header = Header(ts);
+  const auto* cols   = reinterpret_cast<const ColumnEntry*>(fData + fTimeslices[ts] + sizeof(TsIndexHeader));
+  const auto* entry  = std::find_if(cols, cols + header.nColumns, [&](const auto& e) { return e.column == column; });
+  return entry == cols + header.nColumns ? nullptr : entry;
+}
+
+gsl::span<const char> RecoResultsColumnarReader::Raw(size_t ts, const ColumnEntry& entry, size_t elementSize,
+                                                     std::vector<char>& buffer) const
+{
+  if (entry.offset > fSize || entry.storedSize > fSize - entry.offset) {
+    throw FatalError("Columnar archive: Column {} of TS {} exceeds the file size", static_cast<u32>(entry.column), ts);
+  }
+  if (entry.rawSize % elementSize != 0) {
+    throw FatalError("Columnar archive: Column {} of TS {} has {} bytes, not a multiple of the element size {}",
+                     static_cast<u32>(entry.column), ts, entry.rawSize, elementSize);
+  }
+  const char* src = fData + entry.offset;
+
+  switch (entry.compression) {
+    case ColumnCompression::None: return gsl::span<const char>(src, entry.rawSize);
+    case ColumnCompression::Zstd: {
+#ifdef HAVE_ZSTD
+      // The buffer grows with the decompressed data, not with the size in the index. One byte more than the expected
+      // size is requested to detect columns that are longer than stated.
+      constexpr size_t ChunkSize = 1 << 20;
+      b_io::filtering_istream in;
+      in.push(b_io::zstd_decompressor());
+      in.push(b_io::array_source(src, entry.storedSize));
+      buffer.clear();
+      while (buffer.size() <= entry.rawSize) {
+        const size_t pos  = buffer.size();
+        const size_t want = std::min<size_t>(ChunkSize, entry.rawSize + 1 - pos);
+        buffer.resize(pos + want);
+        in.read(buffer.data() + pos, want);
+        buffer.resize(pos + in.gcount());
+        if (static_cast<size_t>(in.gcount()) < want) break;
+      }
+      if (buffer.size() != entry.rawSize) {
+        throw FatalError("Columnar archive: Column {} of TS {} decompresses to {} bytes than the {} in the index",
+                         static_cast<u32>(entry.column), ts, buffer.size() > entry.rawSize ? "more" : "fewer",
+                         entry.rawSize);
+      }
+      return gsl::span<const char>(buffer.data(), buffer.size());
+#else
+      throw FatalError("Columnar archive: Column {} is zstd compressed, but zstd is not available",
+                       static_cast<u32>(entry.column));
+#endif
+    }
+  }
+  throw FatalError("Columnar archive: Unknown compression {}", static_cast<u32>(entry.compression));
+}
+
+void RecoResultsColumnarReader::CheckOffsets(size_t ts, RecoColumn column, gsl::span<const size_t> offsets,
+                                             size_t nPartitions, size_t dataSize)
+{
+  // A missing offset column is only valid without data
+  if (offsets.empty() && nPartitions == 0 && dataSize == 0) return;
+
+  if (offsets.size() != nPartitions + 1) {
+    throw FatalError("Columnar archive: Offset column {} of TS {} has {} entries for {} partitions",
+                     static_cast<u32>(column), ts, offsets.size(), nPartitions);
+  }
+  if (offsets.front() != 0) {
+    throw FatalError("Columnar archive: Offset column {} of TS {} starts at {} instead of 0", static_cast<u32>(column),
+                     ts, offsets.front());
+  }
+  if (!std::is_sorted(offsets.begin(), offsets.end())) {
+    throw FatalError("Columnar archive: Offset column {} of TS {} is decreasing", static_cast<u32>(column), ts);
+  }
+  if (offsets.back() != dataSize) {
+    throw FatalError("Columnar archive: Offset column {} of TS {} ends at {}, but the data have {} entries",
+                     static_cast<u32>(column), ts, offsets.back(), dataSize);
+  }
+}
+
+std::vector<CbmDigiEvent> RecoResultsColumnarReader::ReadDigiEvents(size_t ts) const
+{
+  std::vector<CbmDigiEvent> events;
+  const auto blob = ReadColumn<char>(ts, RecoColumn::DigiEvents);
+  if (blob.empty()) return events;
+  b_io::stream<b_io::array_source> stream(blob.data(), blob.size());
+  b_ar::binary_iarchive ia(stream, b_ar::no_header);
+  ia >> events;
+  return events;
+}
+
+PartitionedVector<sts::Hit> RecoResultsColumnarReader::ReadStsHits(size_t ts) const
+{
+  return ReadPartitioned<sts::Hit>(ts, RecoColumn::StsHits, RecoColumn::StsHitOffsets, RecoColumn::StsHitAddresses);
+}
+
+PartitionedVector<tof::Hit> RecoResultsColumnarReader::ReadTofHits(size_t ts) const
+{
+  return ReadPartitioned<tof::Hit>(ts, RecoColumn::TofHits, RecoColumn::TofHitOffsets, RecoColumn::TofHitAddresses);
+}
+
+PartitionedVector<trd::Hit> RecoResultsColumnarReader::ReadTrdHits(size_t ts) const
+{
+  return ReadPartitioned<trd::Hit>(ts, RecoColumn::TrdHits, RecoColumn::TrdHitOffsets, RecoColumn::TrdHitAddresses);
+}
+
+ca::Vector<ca::Track> RecoResultsColumnarReader::ReadTracks(size_t ts) const
+{
+  ca::Vector<ca::Track> tracks;
+  const auto* entry = Find(ts, RecoColumn::Tracks);
+  if (entry == nullptr || entry->rawSize == 0) return tracks;
+  std::vector<char> buffer;
+  const auto raw = Raw(ts, *entry, sizeof(ca::Track), buffer);
+  tracks.reset(raw.size() / sizeof(ca::Track));
+  std::memcpy(static_cast<void*>(&tracks[0]), raw.data(), raw.size());
+  return tracks;
+}
+
+RecoResultsColumnarReader::TrackHitIndices_t RecoResultsColumnarReader::ReadTrackStsHitIndices(size_t ts) const
+{
+  return ReadTrackHitIndices(ts, RecoColumn::TrackStsHitOffsets, RecoColumn::TrackStsHitIndices);
+}
+
+RecoResultsColumnarReader::TrackHitIndices_t RecoResultsColumnarReader::ReadTrackTofHitIndices(size_t ts) const
+{
+  return ReadTrackHitIndices(ts, RecoColumn::TrackTofHitOffsets, RecoColumn::TrackTofHitIndices);
+}
+
+RecoResultsColumnarReader::TrackHitIndices_t RecoResultsColumnarReader::ReadTrackTrdHitIndices(size_t ts) const
+{
+  return ReadTrackHitIndices(ts, RecoColumn::TrackTrdHitOffsets, RecoColumn::TrackTrdHitIndices);
+}
+
+RecoResultsColumnarReader::TrackHitIndices_t RecoResultsColumnarReader::ReadTrackHitIndices(size_t ts,
+                                                                                            RecoColumn offsets,
+                                                                                            RecoColumn indices) const
+{
+  auto trackOffsets = ReadColumn<size_t>(ts, offsets);
+  auto hits         = ReadColumn<RecoResults::HitId_t>(ts, indices);
+  CheckOffsets(ts, offsets, trackOffsets, trackOffsets.empty() ? 0 : trackOffsets.size() - 1, hits.size());
+  return TrackHitIndices_t(std::move(trackOffsets), std::move(hits));
+}
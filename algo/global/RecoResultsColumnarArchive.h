@@ -0,0 +1,333 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+#pragma once
+
+#include "CbmDigiEvent.h"
+#include "Definitions.h"
+#include "Exceptions.h"
+#include "PartitionedVector.h"
+#include "RecoResults.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
+/**
+ * @file RecoResultsColumnarArchive.h
+ * @brief Columnar archive format for RecoResults, where each collection of a timeslice can be read on its own
+ *
+ * File layout:
+ *   - File header: magic
+ *   - Per timeslice: one block per column, followed by the index of the timeslice (TS index, start time and the
+ *     position, size and compression of each column)
+ *   - Footer: positions of the timeslice indices, number of timeslices, magic
+ *
+ * All blocks are aligned to ColumnAlignment bytes, so uncompressed columns can be used in place from a memory mapped
+ * file. Columns are compressed individually and only if compression actually reduces their size.
+**/
+
+namespace cbm::algo
+{
+
+  /**
+   * @brief Collections stored in a columnar archive
+   *
+   * Partitioned collections are stored as three columns: the flat data, the partition offsets and the partition
+   * addresses. Hit indices of tracks are stored in their CSR format: offsets per track and flat (partition, hit) pairs.
+  **/
+  enum class RecoColumn : u32
+  {
+    BmonDigis,
+    StsDigis,
+    MuchDigis,
+    Trd2dDigis,
+    TrdDigis,
+    TofDigis,
+    RichDigis,
+    DigiEvents,  //< Boost binary archive of std::vector<CbmDigiEvent>
+    StsClusters,
+    StsClusterOffsets,
+    StsClusterAddresses,
+    StsHits,
+    StsHitOffsets,
+    StsHitAddresses,
+    TofHits,
+    TofHitOffsets,
+    TofHitAddresses,
+    TrdHits,
+    TrdHitOffsets,
+    TrdHitAddresses,
+    Tracks,
+    TrackStsHitOffsets,
+    TrackStsHitIndices,
+    TrackTofHitOffsets,
+    TrackTofHitIndices,
+    TrackTrdHitOffsets,
+    TrackTrdHitIndices,
+  };
+
+  /**
+   * @brief Compression of a single column block
+  **/
+  enum class ColumnCompression : u32
+  {
+    None,
+    Zstd,
+  };
+
+  namespace columnar
+  {
+    inline constexpr char Magic[8]          = {'C', 'B', 'M', 'R', 'C', 'O', 'L', '1'};
+    inline constexpr size_t ColumnAlignment = 64;
+
+    /**
+     * @brief Location of a column block in the file
+    **/
+    struct ColumnEntry {
+      RecoColumn column;              //< Stored collection
+      ColumnCompression compression;  //< Compression of the block
+      u64 offset;                     //< Position of the block in the file
+      u64 storedSize;                 //< Size of the block in the file [bytes]
+      u64 rawSize;                    //< Size of the uncompressed column [bytes]
+    };
+
+    /**
+     * @brief Header of the index of a timeslice, followed by nColumns ColumnEntry
+    **/
+    struct TsIndexHeader {
+      u64 tsIndex;
+      u64 tsStartTime;
+      u64 nColumns;
+    };
+
+    /**
+     * @brief Last bytes of the file, preceded by nTimeslices positions of the timeslice indices
+    **/
+    struct Footer {
+      u64 nTimeslices;
+      char magic[8];
+    };
+  }  // namespace columnar
+
+  /**
+   * @brief Writes RecoResults in the columnar archive format
+   *
+   * Columns are written directly from the buffers of the RecoResults, so writing doesn't copy the digis or hits
+   * (except when compressing). The footer is written by Close(), a file without footer can't be read.
+  **/
+  class RecoResultsColumnarWriter {
+
+   public:
+    /**
+     * @brief Constructor
+     * @param path Output file, overwritten if it exists
+     * @param compress Compress the columns with zstd
+    **/
+    RecoResultsColumnarWriter(const std::string& path, bool compress);
+
+    RecoResultsColumnarWriter(const RecoResultsColumnarWriter&) = delete;
+    RecoResultsColumnarWriter& operator=(const RecoResultsColumnarWriter&) = delete;
+
+    /**
+     * @brief Destructor, closes the file if Close() wasn't called
+    **/
+    ~RecoResultsColumnarWriter();
+
+    /**
+     * @brief Write the results of a timeslice
+     * @return Number of bytes written
+    **/
+    size_t Put(u64 tsIndex, u64 tsStartTime, const RecoResults& results);
+
+    /**
+     * @brief Write the footer and close the file
+    **/
+    void Close();
+
+    /**
+     * @brief Total number of bytes written so far
+    **/
+    size_t BytesWritten() const { return fPos; }
+
+   private:
+    std::ofstream fFile;
+    bool fCompress = false;
+    bool fClosed   = false;
+    u64 fPos       = 0;
+    std::vector<u64> fTsIndexOffsets;            //< Position of the index of each timeslice
+    std::vector<columnar::ColumnEntry> fTsCols;  //< Columns of the timeslice currently written
+
+    void WriteRaw(const void* data, size_t size);
+    void Align();
+    void WriteColumn(RecoColumn column, const void* data, size_t size);
+
+    template<typename T>
+    void WriteColumn(RecoColumn column, gsl::span<const T> data)
+    {
+      WriteColumn(column, data.data(), data.size_bytes());
+    }
+
+    template<typename T, typename Partitioned>
+    void WritePartitioned(RecoColumn data, RecoColumn offsets, RecoColumn addresses, const Partitioned& col)
+    {
+      WriteColumn(data, gsl::span<const T>(col.Data()));
+      WriteColumn(offsets, gsl::span<const size_t>(col.Offsets()));
+      WriteColumn(addresses, gsl::span<const u32>(col.Addresses()));
+    }
+
+    void WriteTrackHitIndices(RecoColumn offsets, RecoColumn indices, const ca::TrackHitIndices& trackHits)
+    {
+      WriteColumn(offsets, trackHits.Offsets());
+      WriteColumn(indices, trackHits.Data());
+    }
+  };
+
+  /**
+   * @brief Reads a columnar RecoResults archive
+   *
+   * The file is memory mapped and only the index is parsed on construction. Columns are loaded on request, so reading
+   * e.g. only the tracks of a timeslice touches only the pages of the track column. Uncompressed columns can be
+   * accessed in place with ViewColumn().
+  **/
+  class RecoResultsColumnarReader {
+
+   public:
+    using TrackHitIndices_t = ca::TrackHitIndices;
+
+    /**
+     * @brief Check if a file starts with the magic of the columnar format
+    **/
+    static bool IsColumnarArchive(const std::string& path);
+
+    /**
+     * @brief Map a file and read its index
+     * @throws FatalError if the file isn't a closed columnar archive, or its index is corrupt
+    **/
+    explicit RecoResultsColumnarReader(const std::string& path);
+
+    RecoResultsColumnarReader(const RecoResultsColumnarReader&) = delete;
+    RecoResultsColumnarReader& operator=(const RecoResultsColumnarReader&) = delete;
+
+    ~RecoResultsColumnarReader();
+
+    size_t NTimeslices() const { return fTimeslices.size(); }
+
+    u64 TsIndex(size_t ts) const { return Header(ts).tsIndex; }
+
+    u64 TsStartTime(size_t ts) const { return Header(ts).tsStartTime; }
+
+    /**
+     * @brief Check if a timeslice contains a column
+    **/
+    bool Has(size_t ts, RecoColumn column) const { return Find(ts, column) != nullptr; }
+
+    /**
+     * @brief Number of elements of type T in a column, without loading it
+    **/
+    template<typename T>
+    size_t Count(size_t ts, RecoColumn column) const
+    {
+      const auto* entry = Find(ts, column);
+      return entry == nullptr ? 0 : entry->rawSize / sizeof(T);
+    }
+
+    /**
+     * @brief Access an uncompressed column in place
+     * @throws FatalError if the column is compressed
+    **/
+    template<typename T>
+    gsl::span<const T> ViewColumn(size_t ts, RecoColumn column) const
+    {
+      const auto* entry = Find(ts, column);
+      if (entry == nullptr) return {};
+      if (entry->compression != ColumnCompression::None) {
+        throw FatalError("Columnar archive: column {} of TS {} is compressed and can't be viewed in place",
+                         static_cast<u32>(column), ts);
+      }
+      return gsl::span<const T>(reinterpret_cast<const T*>(fData + entry->offset), entry->rawSize / sizeof(T));
+    }
+
+    /**
+     * @brief Load a column, decompressing it if needed
+     * @throws FatalError if the column doesn't decompress to its size in the index, or the size is not a multiple of
+     * sizeof(T)
+    **/
+    template<typename T>
+    std::vector<T> ReadColumn(size_t ts, RecoColumn column) const
+    {
+      const auto* entry = Find(ts, column);
+      if (entry == nullptr) return {};
+      std::vector<char> buffer;
+      const auto raw = Raw(ts, *entry, sizeof(T), buffer);
+      std::vector<T> result(raw.size() / sizeof(T));
+      if (!raw.empty()) std::memcpy(static_cast<void*>(result.data()), raw.data(), raw.size());
+      return result;
+    }
+
+    std::vector<CbmDigiEvent> ReadDigiEvents(size_t ts) const;
+    PartitionedVector<sts::Hit> ReadStsHits(size_t ts) const;
+    PartitionedVector<tof::Hit> ReadTofHits(size_t ts) const;
+    PartitionedVector<trd::Hit> ReadTrdHits(size_t ts) const;
+    ca::Vector<ca::Track> ReadTracks(size_t ts) const;
+    TrackHitIndices_t ReadTrackStsHitIndices(size_t ts) const;
+    TrackHitIndices_t ReadTrackTofHitIndices(size_t ts) const;
+    TrackHitIndices_t ReadTrackTrdHitIndices(size_t ts) const;
+
+   private:
+    const char* fData = nullptr;  //< Memory mapped file
+    size_t fSize      = 0;
+    std::vector<u64> fTimeslices;  //< Position of the index of each timeslice
+
+    /**
+     * @brief Check the index of all timeslices against the file size
+     * @param indexEnd Position of the timeslice index positions, which follow all other data
+     * @throws FatalError if an index or a column lies outside of the file
+    **/
+    void CheckIndex(size_t indexEnd) const;
+
+    const columnar::TsIndexHeader& Header(size_t ts) const;
+    const columnar::ColumnEntry* Find(size_t ts, RecoColumn column) const;
+
+    /**
+     * @brief Bytes of a column: in place for uncompressed columns, decompressed into buffer otherwise
+     * @param elementSize Size of the stored type, the column size must be a multiple of it
+     * @throws FatalError if the column doesn't decompress to the size in the index
+     *
+     * Compressed columns are decompressed in chunks, so a corrupt size in the index can't cause a huge allocation.
+    **/
+    gsl::span<const char> Raw(size_t ts, const columnar::ColumnEntry& entry, size_t elementSize,
+                              std::vector<char>& buffer) const;
+
+    /**
+     * @brief Check the offsets of a partitioned column: first 0, not decreasing, last equal to the size of the data
+     * @param nPartitions Number of partitions, there must be one more offset
+     * @throws FatalError if the offsets don't describe the data
+    **/
+    static void CheckOffsets(size_t ts, RecoColumn column, gsl::span<const size_t> offsets, size_t nPartitions,
+                             size_t dataSize);
+
+    template<typename T>
+    PartitionedVector<T> ReadPartitioned(size_t ts, RecoColumn dataCol, RecoColumn offsetCol,
+                                         RecoColumn addressCol) const
+    {
+      auto data      = ReadColumn<T>(ts, dataCol);
+      auto offsets   = ReadColumn<size_t>(ts, offsetCol);
+      auto addresses = ReadColumn<u32>(ts, addressCol);
+      CheckOffsets(ts, offsetCol, offsets, addresses.size(), data.size());
+      std::vector<size_t> sizes(addresses.size());
+      for (size_t i = 0; i < sizes.size(); i++) {
+        sizes[i] = offsets[i + 1] - offsets[i];
+      }
+      return PartitionedVector<T>(std::move(data), sizes, addresses);
+    }
+
+    TrackHitIndices_t ReadTrackHitIndices(size_t ts, RecoColumn offsets, RecoColumn indices) const;
+  };
+
+}  // namespace cbm::algo
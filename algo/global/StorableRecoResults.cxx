@@ -27,9 +27,8 @@ size_t StorableRecoResults::SizeBytes() const
 
   size += fTracks.size() * sizeof(ca::Track);
 
-  // Exclude TrackHitIndexContainers for now to avoid looping over all tracks
-  // Better way to do this: Just query from boost the size of the written archive.
-  // Requires changes in flesnet to the archive classes for this
+  size += fTrackStsHitIndices.Offsets().size_bytes() + fTrackStsHitIndices.Data().size_bytes();
+  size += fTrackTofHitIndices.Offsets().size_bytes() + fTrackTofHitIndices.Data().size_bytes();
 
   return size;
 }
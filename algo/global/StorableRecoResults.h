@@ -6,6 +6,7 @@
 
 #include "CbmDigiEvent.h"
 #include "PartitionedVector.h"
+#include "ca/TrackHitIndices.h"
 #include "ca/core/data/CaTrack.h"
 #include "ca/core/utils/CaVector.h"
 #include "sts/Cluster.h"
@@ -15,6 +16,7 @@
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/utility.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <cstdint>
@@ -25,7 +27,7 @@ namespace cbm::algo
   class StorableRecoResults {
 
    public:
-    using TrackHitIndexContainer_t = ca::Vector<std::vector<std::pair<uint32_t, uint32_t>>>;
+    using TrackHitIndexContainer_t = ca::TrackHitIndices;
 
     /**
      * @brief Default constructor (required by boost::serialization)
@@ -130,7 +132,7 @@ namespace cbm::algo
     friend class boost::serialization::access;
 
     template<class Archive>
-    void serialize(Archive& ar, unsigned int /*version*/)
+    void serialize(Archive& ar, unsigned int version)
     {
       ar& fTsIndex;
       ar& fTsStartTime;
@@ -151,11 +153,38 @@ namespace cbm::algo
       ar& fTrdHits;
 
       ar& fTracks;
-      ar& fTrackStsHitIndices;
-      ar& fTrackTofHitIndices;
+      if (version >= 1) {
+        ar& fTrackStsHitIndices;
+        ar& fTrackTofHitIndices;
+      }
+      else if constexpr (Archive::is_loading::value) {
+        // Version 0 stored a vector of hit indices per track
+        ReadLegacyHitIndices(ar, fTrackStsHitIndices);
+        ReadLegacyHitIndices(ar, fTrackTofHitIndices);
+      }
+    }
+
+    template<class Archive>
+    static void ReadLegacyHitIndices(Archive& ar, TrackHitIndexContainer_t& indices)
+    {
+      ca::Vector<std::vector<std::pair<uint32_t, uint32_t>>> legacy;
+      ar& legacy;
+      size_t nHits = 0;
+      for (size_t iTrk = 0; iTrk < legacy.size(); iTrk++) {
+        nHits += legacy[iTrk].size();
+      }
+      indices.Reset(legacy.size(), nHits);
+      for (size_t iTrk = 0; iTrk < legacy.size(); iTrk++) {
+        for (const auto& [iPartition, iPartHit] : legacy[iTrk]) {
+          indices.AddHit(iPartition, iPartHit);
+        }
+        indices.CloseTrack();
+      }
     }
   };
 
 }  // namespace cbm::algo
 
+BOOST_CLASS_VERSION(cbm::algo::StorableRecoResults, 1)
+
 #endif  // CBM_ALGO_GLOBAL_STORABLE_RECO_RESULTS_H
@@ -26,7 +26,8 @@ namespace cbm::algo::kf
   enum class EFieldMode
   {
     Intrpl,  ///< Interpolated magnetic field
-    Orig     ///< Original magnetic field function
+    Orig,    ///< Original magnetic field function
+    Cached   ///< Original magnetic field function, cached on a grid
   };
 
   /// \enum  EFieldType
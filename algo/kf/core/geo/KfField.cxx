@@ -9,6 +9,7 @@
 
 #include "KfField.h"
 
+#include <algorithm>
 #include <mutex>
 #include <sstream>
 #include <tuple>
@@ -16,6 +17,7 @@
 using cbm::algo::kf::EFieldMode;
 using cbm::algo::kf::Field;
 using cbm::algo::kf::FieldFactory;
+using cbm::algo::kf::FieldGrid;
 using cbm::algo::kf::detail::FieldBase;
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -47,6 +49,9 @@ std::string FieldBase<T, EFieldMode::Orig>::ToString(int indentLevel, int /*verb
   for (int iSlice = 0; iSlice < GetNofFieldSlices(); ++iSlice) {
     msg << "\n " << indent << iSlice << ") " << fvFieldSliceZ[iSlice];
   }
+  if (fpGrid) {
+    msg << '\n' << fpGrid->ToString(indentLevel);
+  }
   return msg.str();
 }
 
@@ -55,12 +60,12 @@ std::string FieldBase<T, EFieldMode::Orig>::ToString(int indentLevel, int /*verb
 template<typename T>
 void Field<T>::RemoveSlice(int iLayer)
 {
-  if (fFieldMode == EFieldMode::Orig) {
-    foFldOrig->RemoveSlice(iLayer);
-  }
-  else if (fFieldMode == EFieldMode::Intrpl) {
+  if (fFieldMode == EFieldMode::Intrpl) {
     foFldIntrpl->RemoveSlice(iLayer);
   }
+  else {
+    foFldOrig->RemoveSlice(iLayer);
+  }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -74,12 +79,12 @@ std::string Field<T>::ToString(int indentLevel, int verbose) const
   msg << indent << "Field near primary vertex:\n" << this->fPrimVertexField.ToString(indentLevel + 1, verbose) << '\n';
   msg << indent << "Field type: " << static_cast<int>(this->fFieldType) << '\n';
   msg << indent << "Field mode: " << static_cast<int>(this->fFieldMode) << '\n';
-  if (fFieldMode == EFieldMode::Orig) {
-    msg << foFldOrig->ToString(indentLevel, verbose);
-  }
-  else if (fFieldMode == EFieldMode::Intrpl) {
+  if (fFieldMode == EFieldMode::Intrpl) {
     msg << foFldIntrpl->ToString(indentLevel, verbose);
   }
+  else {
+    msg << foFldOrig->ToString(indentLevel, verbose);
+  }
   return msg.str();
 }
 
@@ -95,6 +100,7 @@ namespace cbm::algo::kf
 //
 void FieldFactory::AddSliceReference(double halfSizeX, double halfSizeY, double zRef)
 {
+  fpFieldGrid = nullptr;
   if (!fSliceReferences.emplace(halfSizeX, halfSizeY, zRef).second) {
     std::stringstream msg;
     msg << "FieldFactory::AddReference: attempt of adding another slice reference with zRef = " << zRef
@@ -107,3 +113,28 @@ void FieldFactory::AddSliceReference(double halfSizeX, double halfSizeY, double
   }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void FieldFactory::BuildFieldGrid()
+{
+  if (fpFieldGrid) {
+    return;
+  }
+
+  // The grid covers the transverse size of all the slices and the z-range from the target to the last slice
+  std::array<double, 3> lo{0., 0., fTarget[2]};
+  std::array<double, 3> hi{0., 0., fTarget[2]};
+  for (const auto& sliceRef : fSliceReferences) {
+    hi[0] = std::max(hi[0], sliceRef.fHalfSizeX);
+    hi[1] = std::max(hi[1], sliceRef.fHalfSizeY);
+    lo[2] = std::min(lo[2], sliceRef.fRefZ);
+    hi[2] = std::max(hi[2], sliceRef.fRefZ);
+  }
+  lo[0] = -hi[0];
+  lo[1] = -hi[1];
+  for (int k = 0; k < 3; ++k) {  // Margin of one step
+    lo[k] -= fCacheStep;
+    hi[k] += fCacheStep;
+  }
+  fpFieldGrid = FieldGrid::Make(fFieldFn, lo, hi, fCacheStep, fCacheMaxDeviation, kCacheMaxNofNodes);
+}
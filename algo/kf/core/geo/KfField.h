@@ -17,8 +17,10 @@
 #include <boost/serialization/split_free.hpp>
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <set>
+#include <utility>
 
 namespace cbm::algo::kf
 {
@@ -47,7 +49,7 @@ namespace cbm::algo::kf
       /// \brief  Copy constructor
       /// \tparam I  Underlying floating type of the source
       template<typename I>
-      FieldBase(const FieldBase<I, EFieldMode::Orig>& other) : fFieldFn(other.fFieldFn)
+      FieldBase(const FieldBase<I, EFieldMode::Orig>& other) : fFieldFn(other.fFieldFn), fpGrid(other.fpGrid)
       {
         fvFieldSliceZ.reserve(other.fvFieldSliceZ.size());
         for (const auto& slice : other.fvFieldSliceZ) {
@@ -61,6 +63,7 @@ namespace cbm::algo::kf
         if (this != &other) {
           fvFieldSliceZ = other.fvFieldSliceZ;
           fFieldFn      = other.fFieldFn;
+          fpGrid        = other.fpGrid;
         }
         return *this;
       }
@@ -75,12 +78,16 @@ namespace cbm::algo::kf
       /// \param y        y-coordinate of the point [cm]
       FieldValue<T> GetFieldValue(int sliceID, const T& x, const T& y) const
       {
-        return GlobalField::GetFieldValue(fFieldFn, x, y, fvFieldSliceZ[sliceID]);
+        const T& z = fvFieldSliceZ[sliceID];
+        return fpGrid ? fpGrid->GetFieldValue(fFieldFn, x, y, z) : GlobalField::GetFieldValue(fFieldFn, x, y, z);
       }
 
       /// \brief Gets field function
       const FieldFn_t& GetFieldFunction() const { return fFieldFn; }
 
+      /// \brief Gets field function cached on a grid (nullptr, if the field is not cached)
+      const std::shared_ptr<const FieldGrid>& GetFieldGrid() const { return fpGrid; }
+
       /// \brief Gets number of field slices in the instance
       int GetNofFieldSlices() const { return fvFieldSliceZ.size(); }
 
@@ -92,14 +99,19 @@ namespace cbm::algo::kf
       /// \param fieldFn  Magnetic field function (KF-format)
       void SetFieldFunction(const FieldFn_t& fieldFn) { fFieldFn = fieldFn; }
 
+      /// \brief Sets field function cached on a grid
+      /// \param pGrid  Grid, created from the field function
+      void SetFieldGrid(std::shared_ptr<const FieldGrid> pGrid) { fpGrid = std::move(pGrid); }
+
       /// \brief String representation of the class
       /// \param indentLevel  Indent level of the string output
       /// \param verbose      Verbosity level
       std::string ToString(int indentLevel, int verbose) const;
 
      private:
-      std::vector<T> fvFieldSliceZ{};         ///< z-positions of field slices to emulate functionality
-      FieldFn_t fFieldFn{defs::ZeroFieldFn};  ///< Field function: (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+      std::vector<T> fvFieldSliceZ{};                    ///< z-positions of field slices to emulate functionality
+      FieldFn_t fFieldFn{defs::ZeroFieldFn};             ///< Field function: (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+      std::shared_ptr<const FieldGrid> fpGrid{nullptr};  ///< Field function cached on a grid (EFieldMode::Cached)
     };
 
 
@@ -197,8 +209,8 @@ namespace cbm::algo::kf
     Field(EFieldMode fldMode, EFieldType fldType)
       : foFldIntrpl(fldMode == EFieldMode::Intrpl ? std::make_optional(detail::FieldBase<T, EFieldMode::Intrpl>())
                                                   : std::nullopt)
-      , foFldOrig(fldMode == EFieldMode::Orig ? std::make_optional(detail::FieldBase<T, EFieldMode::Orig>())
-                                              : std::nullopt)
+      , foFldOrig(fldMode != EFieldMode::Intrpl ? std::make_optional(detail::FieldBase<T, EFieldMode::Orig>())
+                                                : std::nullopt)
       , fPrimVertexField(FieldRegion<T>(fldMode, fldType))
       , fFieldType(fldType)
       , fFieldMode(fldMode)
@@ -259,12 +271,13 @@ namespace cbm::algo::kf
     /// \param z1  Second node z-coordinate [cm]
     /// \param b2  Field value in the first node [kG]
     /// \param z2  Third node z-coordinate [cm]
-    /// \note  Parameters b0-b2, z0-z2 are ignored, if fFieldMode == EFieldMode::Orig
+    /// \note  Parameters b0-b2, z0-z2 are ignored, if fFieldMode != EFieldMode::Intrpl
     FieldRegion<T> GetFieldRegion(const FieldValue<T>& b0, const T& z0, const FieldValue<T>& b1, const T& z1,
                                   const FieldValue<T>& b2, const T& z2) const
     {
-      return (fFieldMode == EFieldMode::Intrpl ? FieldRegion<T>(b0, z0, b1, z1, b2, z2)
-                                               : FieldRegion<T>(fFieldType, foFldOrig->GetFieldFunction()));
+      return (fFieldMode == EFieldMode::Intrpl
+                ? FieldRegion<T>(b0, z0, b1, z1, b2, z2)
+                : FieldRegion<T>(fFieldType, foFldOrig->GetFieldFunction(), foFldOrig->GetFieldGrid()));
     }
 
     /// \brief Removes a field slice
@@ -303,8 +316,8 @@ namespace cbm::algo::kf
         ar << fFieldType;
         ar << fFieldMode;
       }
-      else if (fFieldMode == EFieldMode::Orig) {
-        throw std::logic_error("Attempt to serialize a kf::FieldRegion object with fFieldMode == EFieldMode::Orig");
+      else {
+        throw std::logic_error("Attempt to serialize a kf::Field object with the original field function");
       }
     }
 
@@ -373,23 +386,46 @@ namespace cbm::algo::kf
     template<typename T>
     Field<T> MakeField() const;
 
+    /// \brief Builds the field cache, which covers the slices and the target
+    /// \note  Must be called before MakeField in EFieldMode::Cached. The grid is shared by all the fields made
+    ///        afterwards, until the field function, the slices, the target or the cache parameters are changed.
+    /// \throw std::runtime_error  If the cache accuracy cannot be reached
+    void BuildFieldGrid();
+
     /// \brief Resets the instance
     void Reset() { *this = FieldFactory(); }
 
     /// \brief Resets slicer references
-    void ResetSliceReferences() { fSliceReferences.clear(); }
+    void ResetSliceReferences()
+    {
+      fSliceReferences.clear();
+      fpFieldGrid = nullptr;
+    }
 
     /// \brief Sets magnetic field function
     /// \param fieldFn  Magnetic field function (KF-format)
     void SetFieldFunction(const FieldFn_t& fieldFn, EFieldType fldType)
     {
-      fFieldFn   = fieldFn;
-      fFieldType = fldType;
+      fFieldFn    = fieldFn;
+      fFieldType  = fldType;
+      fpFieldGrid = nullptr;
     }
 
     /// \brief Sets field mode
     void SetFieldMode(EFieldMode fldMode) { fFieldMode = fldMode; }
 
+    /// \brief Sets parameters of the field cache (EFieldMode::Cached)
+    /// \param step          Initial distance between the grid nodes [cm]
+    /// \param maxDeviation  Maximal deviation of the cached field from the field function [kG]
+    ///
+    /// The step is refined until the cached field reproduces the field function within maxDeviation
+    void SetFieldCache(double step, double maxDeviation)
+    {
+      fCacheStep         = step;
+      fCacheMaxDeviation = maxDeviation;
+      fpFieldGrid        = nullptr;
+    }
+
     /// \brief Sets a step for the primary vertex field region estimation
     /// \param step  A step between nodal points in z-axis direction [cm]
     void SetStep(double step = 2.5) { fTargetStep = step; }
@@ -398,14 +434,23 @@ namespace cbm::algo::kf
     /// \param x  x-coordinate of the target position [cm]
     /// \param y  y-coordinate of the target position [cm]
     /// \param z  z-coordinate of the target position [cm]
-    void SetTarget(double x, double y, double z) { fTarget = {x, y, z}; }
+    void SetTarget(double x, double y, double z)
+    {
+      fTarget     = {x, y, z};
+      fpFieldGrid = nullptr;
+    }
 
    private:
+    static constexpr size_t kCacheMaxNofNodes{1 << 24};  ///< Maximal number of nodes of the field cache
+
     std::set<SliceRef> fSliceReferences;      ///< Set of slice references
     FieldFn_t fFieldFn{defs::ZeroFieldFn};    ///< Field function (x, y, z) [cm] -> (Bx, By, Bz) [kG]
     double fTargetStep{2.5};                  ///< Step between nodal points for the primary vertex field estimation
     EFieldType fFieldType{EFieldType::Null};  ///< Field type
     EFieldMode fFieldMode{EFieldMode::Intrpl};  ///< FieldMode
+    double fCacheStep{2.};                      ///< Initial distance between the nodes of the field cache [cm]
+    double fCacheMaxDeviation{0.01};            ///< Maximal deviation of the field cache from the field function [kG]
+    std::shared_ptr<const FieldGrid> fpFieldGrid{nullptr};  ///< Field cache, created by BuildFieldGrid
 
     /// \brief Target position
     std::array<double, 3> fTarget{{defs::Undef<double>, defs::Undef<double>, defs::Undef<double>}};
@@ -430,9 +475,15 @@ namespace cbm::algo::kf
     }
 
     // Initialize the Field object
-    if (fFieldMode == EFieldMode::Orig) {
+    if (fFieldMode == EFieldMode::Orig || fFieldMode == EFieldMode::Cached) {
       field.foFldOrig->SetFieldFunction(fFieldFn);
-      field.fPrimVertexField = FieldRegion<T>(fFieldType, fFieldFn);
+      if (fFieldMode == EFieldMode::Cached) {
+        if (!fpFieldGrid) {
+          throw std::logic_error("FieldFactory::MakeField: the field cache was not built");
+        }
+        field.foFldOrig->SetFieldGrid(fpFieldGrid);
+      }
+      field.fPrimVertexField = FieldRegion<T>(fFieldType, fFieldFn, field.foFldOrig->GetFieldGrid());
       for (const auto& sliceRef : fSliceReferences) {
         field.foFldOrig->AddFieldSlice(sliceRef.fRefZ);
       }
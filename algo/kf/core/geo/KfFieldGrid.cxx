@@ -0,0 +1,113 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   KfFieldGrid.cxx
+/// \brief  Original magnetic field cached on a regular grid (source)
+
+#include "KfFieldGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+using cbm::algo::kf::FieldGrid;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+FieldGrid::FieldGrid(const FieldFn_t& fieldFn, const std::array<double, 3>& lo, const std::array<double, 3>& hi,
+                     double step)
+  : fLo(lo)
+  , fStep(step)
+  , fInvStep(1. / step)
+{
+  if (!(step > 0.)) {
+    throw std::logic_error("kf::FieldGrid: the step must be positive");
+  }
+  for (int k = 0; k < 3; ++k) {
+    if (!(hi[k] >= lo[k])) {
+      throw std::logic_error("kf::FieldGrid: the upper corner of the grid is below the lower one");
+    }
+    fNofNodes[k] = static_cast<int>(std::ceil((hi[k] - lo[k]) * fInvStep)) + 1;
+    fNofNodes[k] = std::max(fNofNodes[k], 2);  // At least one cell
+  }
+
+  fvNodes.resize(static_cast<size_t>(fNofNodes[0]) * fNofNodes[1] * fNofNodes[2]);
+  for (int iz = 0; iz < fNofNodes[2]; ++iz) {
+    double z = fLo[2] + iz * fStep;
+    for (int iy = 0; iy < fNofNodes[1]; ++iy) {
+      double y = fLo[1] + iy * fStep;
+      for (int ix = 0; ix < fNofNodes[0]; ++ix) {
+        double x          = fLo[0] + ix * fStep;
+        auto [bx, by, bz] = fieldFn(x, y, z);
+
+        fvNodes[NodeIndex(ix, iy, iz)] = {static_cast<float>(bx), static_cast<float>(by), static_cast<float>(bz)};
+      }
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+std::shared_ptr<const FieldGrid> FieldGrid::Make(const FieldFn_t& fieldFn, const std::array<double, 3>& lo,
+                                                 const std::array<double, 3>& hi, double step, double maxDeviation,
+                                                 size_t maxNofNodes)
+{
+  auto nofNodes = [&](double s) {
+    size_t n = 1;
+    for (int k = 0; k < 3; ++k) {
+      n *= static_cast<size_t>(std::max(std::ceil((hi[k] - lo[k]) * (1. / s)) + 1., 2.));
+    }
+    return n;
+  };
+
+  double deviation = defs::Undef<double>;
+  for (; nofNodes(step) <= maxNofNodes; step *= 0.5) {
+    auto pGrid = std::make_shared<const FieldGrid>(fieldFn, lo, hi, step);
+    deviation  = pGrid->GetMaxDeviation(fieldFn);
+    if (deviation <= maxDeviation) {
+      return pGrid;
+    }
+  }
+
+  std::stringstream msg;
+  msg << "kf::FieldGrid::Make: the field cannot be cached with a deviation below " << maxDeviation << " kG within "
+      << maxNofNodes << " nodes (deviation with the finest step " << 2. * step << " cm: " << deviation << " kG)";
+  throw std::runtime_error(msg.str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+double FieldGrid::GetMaxDeviation(const FieldFn_t& fieldFn) const
+{
+  // The trilinear interpolation is least accurate in the cell centers
+  double deviation = 0.;
+  for (int iz = 0; iz < fNofNodes[2] - 1; ++iz) {
+    double z = fLo[2] + (iz + 0.5) * fStep;
+    for (int iy = 0; iy < fNofNodes[1] - 1; ++iy) {
+      double y = fLo[1] + (iy + 0.5) * fStep;
+      for (int ix = 0; ix < fNofNodes[0] - 1; ++ix) {
+        double x          = fLo[0] + (ix + 0.5) * fStep;
+        auto [bx, by, bz] = fieldFn(x, y, z);
+        auto b            = GetFieldValue<double>(fieldFn, x, y, z);
+        deviation         = std::max({deviation, std::fabs(b.GetBx() - bx), std::fabs(b.GetBy() - by),  //
+                              std::fabs(b.GetBz() - bz)});
+      }
+    }
+  }
+  return deviation;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+std::string FieldGrid::ToString(int indentLevel) const
+{
+  constexpr char IndentChar = '\t';
+  std::stringstream msg;
+  std::string indent(indentLevel, IndentChar);
+  msg << indent << "Field grid: " << fNofNodes[0] << " x " << fNofNodes[1] << " x " << fNofNodes[2]
+      << " nodes, step = " << fStep << " cm, lower corner = (" << fLo[0] << ", " << fLo[1] << ", " << fLo[2]
+      << ") cm";
+  return msg.str();
+}
@@ -0,0 +1,152 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   KfFieldGrid.h
+/// \brief  Original magnetic field cached on a regular grid (header)
+
+#pragma once
+
+#include "KfDefs.h"
+#include "KfFieldValue.h"
+#include "KfUtils.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cbm::algo::kf
+{
+  /// \class FieldGrid
+  /// \brief Original magnetic field, sampled on a regular 3D grid and evaluated with the trilinear interpolation
+  ///
+  /// The grid is filled once from the field function. On evaluation, the cell coordinates are calculated for all the
+  /// SIMD lanes at once. The field values in the eight corners of the cell are looked up in a scalar loop over the
+  /// lanes (there is no SIMD gather), only the blending of the corners is vectorized. Points outside the grid are
+  /// evaluated with the field function.
+  class FieldGrid {
+   public:
+    /// \brief Constructor
+    /// \param fieldFn  Field function (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+    /// \param lo       Lower corner of the grid (x,y,z) [cm]
+    /// \param hi       Upper corner of the grid (x,y,z) [cm]
+    /// \param step     Distance between the grid nodes [cm]
+    FieldGrid(const FieldFn_t& fieldFn, const std::array<double, 3>& lo, const std::array<double, 3>& hi, double step);
+
+    /// \brief Creates a grid, which reproduces the field function within a given accuracy
+    /// \param fieldFn       Field function (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+    /// \param lo            Lower corner of the grid (x,y,z) [cm]
+    /// \param hi            Upper corner of the grid (x,y,z) [cm]
+    /// \param step          Initial distance between the grid nodes [cm]
+    /// \param maxDeviation  Maximal deviation of a field component from the field function [kG]
+    /// \param maxNofNodes   Maximal number of the grid nodes
+    /// \throw std::runtime_error  If the accuracy cannot be reached with maxNofNodes nodes
+    ///
+    /// The step is halved until the deviation in the cell centers does not exceed maxDeviation.
+    static std::shared_ptr<const FieldGrid> Make(const FieldFn_t& fieldFn, const std::array<double, 3>& lo,
+                                                 const std::array<double, 3>& hi, double step, double maxDeviation,
+                                                 size_t maxNofNodes);
+
+    /// \brief Gets the field value in a spatial point
+    /// \tparam T        Underlying floating point type (float/double/fvec)
+    /// \param fieldFn   Field function, used for points outside the grid
+    /// \param x         x-coordinate of the point [cm]
+    /// \param y         y-coordinate of the point [cm]
+    /// \param z         z-coordinate of the point [cm]
+    template<typename T>
+    FieldValue<T> GetFieldValue(const FieldFn_t& fieldFn, const T& x, const T& y, const T& z) const;
+
+    /// \brief Maximal deviation of a field component from the field function in the cell centers [kG]
+    /// \param fieldFn  Field function, from which the grid was created
+    double GetMaxDeviation(const FieldFn_t& fieldFn) const;
+
+    /// \brief Gets number of the grid nodes
+    size_t GetNofNodes() const { return fvNodes.size(); }
+
+    /// \brief Gets the distance between the grid nodes [cm]
+    double GetStep() const { return fStep; }
+
+    /// \brief String representation of the class
+    /// \param indentLevel  Indent level of the string output
+    std::string ToString(int indentLevel = 0) const;
+
+   private:
+    /// \brief Index of a node in the node array
+    size_t NodeIndex(int ix, int iy, int iz) const
+    {
+      return (static_cast<size_t>(iz) * fNofNodes[1] + iy) * fNofNodes[0] + ix;
+    }
+
+    std::vector<std::array<float, 3>> fvNodes;  ///< Field (Bx,By,Bz) in the nodes [kG], x runs fastest
+    std::array<double, 3> fLo;                  ///< Lower corner of the grid [cm]
+    std::array<int, 3> fNofNodes;               ///< Number of nodes along x, y and z
+    double fStep;                               ///< Distance between the nodes [cm]
+    double fInvStep;                            ///< Inverse distance between the nodes [1/cm]
+  };
+
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<typename T>
+  FieldValue<T> FieldGrid::GetFieldValue(const FieldFn_t& fieldFn, const T& x, const T& y, const T& z) const
+  {
+    using utils::simd::Cast;
+    using utils::simd::SetEntry;
+
+    // Cell coordinates in units of the step
+    const T invStep = Cast<double, T>(fInvStep);
+    const std::array<T, 3> u{(x - Cast<double, T>(fLo[0])) * invStep, (y - Cast<double, T>(fLo[1])) * invStep,
+                             (z - Cast<double, T>(fLo[2])) * invStep};
+
+    const size_t dy = fNofNodes[0];
+    const size_t dz = dy * fNofNodes[1];
+
+    std::array<T, 3> w;                      // Position inside the cell
+    std::array<std::array<T, 3>, 8> corner;  // Field in the cell corners [corner][component]
+    for (size_t i = 0; i < utils::simd::Size<T>(); ++i) {
+      std::array<double, 3> ui;
+      std::array<int, 3> idx;
+      bool bInside = true;
+      for (int k = 0; k < 3; ++k) {
+        ui[k] = Cast<T, double>(u[k], i);
+        bInside &= (ui[k] >= 0. && ui[k] < fNofNodes[k] - 1);  // NOTE: false for NaN
+        idx[k] = bInside ? static_cast<int>(ui[k]) : 0;
+      }
+      if (!bInside) {
+        auto [bx, by, bz] = fieldFn(Cast<T, double>(x, i), Cast<T, double>(y, i), Cast<T, double>(z, i));
+        for (int k = 0; k < 3; ++k) {
+          SetEntry(w[k], 0., i);
+        }
+        for (size_t iC = 0; iC < 8; ++iC) {
+          SetEntry(corner[iC][0], bx, i);
+          SetEntry(corner[iC][1], by, i);
+          SetEntry(corner[iC][2], bz, i);
+        }
+        continue;
+      }
+      for (int k = 0; k < 3; ++k) {
+        SetEntry(w[k], ui[k] - idx[k], i);
+      }
+      const size_t iNode = NodeIndex(idx[0], idx[1], idx[2]);
+      for (size_t iC = 0; iC < 8; ++iC) {
+        const auto& node = fvNodes[iNode + (iC & 1) + ((iC >> 1) & 1) * dy + (iC >> 2) * dz];
+        for (int k = 0; k < 3; ++k) {
+          SetEntry(corner[iC][k], node[k], i);
+        }
+      }
+    }
+
+    // Lanes outside the grid have the same value in all the corners
+    std::array<T, 3> b;
+    for (int k = 0; k < 3; ++k) {
+      T c00 = corner[0][k] + w[0] * (corner[1][k] - corner[0][k]);
+      T c10 = corner[2][k] + w[0] * (corner[3][k] - corner[2][k]);
+      T c01 = corner[4][k] + w[0] * (corner[5][k] - corner[4][k]);
+      T c11 = corner[6][k] + w[0] * (corner[7][k] - corner[6][k]);
+      T c0  = c00 + w[1] * (c10 - c00);
+      T c1  = c01 + w[1] * (c11 - c01);
+      b[k]  = c0 + w[2] * (c1 - c0);
+    }
+    return FieldValue<T>(b[0], b[1], b[2]);
+  }
+}  // namespace cbm::algo::kf
@@ -168,6 +168,9 @@ namespace cbm::algo::kf
     std::stringstream msg;
     std::string indent(indentLevel, IndentChar);
     msg << indent << "Field region: created from the original field function";
+    if (fpGrid) {
+      msg << '\n' << fpGrid->ToString(indentLevel);
+    }
     return msg.str();
   }
 
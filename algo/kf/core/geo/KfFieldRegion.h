@@ -11,6 +11,7 @@
 #pragma once
 
 #include "KfDefs.h"
+#include "KfFieldGrid.h"
 #include "KfFieldValue.h"
 #include "KfMath.h"
 #include "KfUtils.h"
@@ -21,9 +22,11 @@
 #include <boost/serialization/split_free.hpp>
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 namespace cbm::algo::kf
 {
@@ -94,12 +97,20 @@ namespace cbm::algo::kf
       FieldRegionBase() = default;
 
       /// \brief Constructor
-      FieldRegionBase(const FieldFn_t& fieldFn) : fFieldFn(fieldFn) {}
+      /// \param fieldFn  Field function
+      /// \param pGrid    Field function cached on a grid (optional)
+      FieldRegionBase(const FieldFn_t& fieldFn, std::shared_ptr<const FieldGrid> pGrid = nullptr)
+        : fFieldFn(fieldFn)
+        , fpGrid(std::move(pGrid))
+      {
+      }
 
       /// \brief  Copy constructor
       /// \tparam I  Underlying floating point type of the source
       template<typename I>
-      FieldRegionBase(const FieldRegionBase<I, EFieldMode::Orig>& other) : fFieldFn(other.fFieldFn)
+      FieldRegionBase(const FieldRegionBase<I, EFieldMode::Orig>& other)
+        : fFieldFn(other.fFieldFn)
+        , fpGrid(other.fpGrid)
       {
       }
 
@@ -116,7 +127,7 @@ namespace cbm::algo::kf
       /// \note  The x and y coordinates are ignored, if the interpolated field is used
       FieldValue<T> Get(const T& x, const T& y, const T& z) const
       {
-        return GlobalField::GetFieldValue(fFieldFn, x, y, z);
+        return fpGrid ? fpGrid->GetFieldValue(fFieldFn, x, y, z) : GlobalField::GetFieldValue(fFieldFn, x, y, z);
       }
 
       /// \brief Gets the double integrals of the field along the track
@@ -136,7 +147,8 @@ namespace cbm::algo::kf
       std::string ToString(int indentLevel = 0, int verbose = 1) const;
 
      protected:
-      FieldFn_t fFieldFn{defs::ZeroFieldFn};  ///< Field function: (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+      FieldFn_t fFieldFn{defs::ZeroFieldFn};             ///< Field function: (x,y,z) [cm] -> (Bx,By,Bz) [kG]
+      std::shared_ptr<const FieldGrid> fpGrid{nullptr};  ///< Field function cached on a grid (EFieldMode::Cached)
     };
 
 
@@ -263,8 +275,8 @@ namespace cbm::algo::kf
     FieldRegion(EFieldMode fldMode = EFieldMode::Intrpl, EFieldType fldType = EFieldType::Normal)
       : foFldIntrpl(fldMode == EFieldMode::Intrpl ? std::make_optional<detail::FieldRegionBase<T, EFieldMode::Intrpl>>()
                                                   : std::nullopt)
-      , foFldOrig(fldMode == EFieldMode::Orig ? std::make_optional<detail::FieldRegionBase<T, EFieldMode::Orig>>()
-                                              : std::nullopt)
+      , foFldOrig(fldMode != EFieldMode::Intrpl ? std::make_optional<detail::FieldRegionBase<T, EFieldMode::Orig>>()
+                                                : std::nullopt)
       , fFieldType(fldType)
       , fFieldMode(fldMode)
     {
@@ -309,11 +321,13 @@ namespace cbm::algo::kf
 
     /// \brief  Constructor for the field region with the original field function
     /// \param  fieldType  Type of the field
-    FieldRegion(EFieldType fieldType, const FieldFn_t& fieldFn)
+    /// \param  fieldFn    Field function
+    /// \param  pGrid      Field function cached on a grid (EFieldMode::Cached, if provided)
+    FieldRegion(EFieldType fieldType, const FieldFn_t& fieldFn, std::shared_ptr<const FieldGrid> pGrid = nullptr)
       : foFldIntrpl(std::nullopt)
-      , foFldOrig(std::make_optional<detail::FieldRegionBase<T, EFieldMode::Orig>>(fieldFn))
+      , foFldOrig(std::make_optional<detail::FieldRegionBase<T, EFieldMode::Orig>>(fieldFn, pGrid))
       , fFieldType(fieldType)
-      , fFieldMode(EFieldMode::Orig)
+      , fFieldMode(pGrid ? EFieldMode::Cached : EFieldMode::Orig)
     {
     }
 
@@ -408,8 +422,8 @@ namespace cbm::algo::kf
         ar << fFieldType;
         ar << fFieldMode;
       }
-      else if (fFieldMode == EFieldMode::Orig) {
-        throw std::logic_error("Attempt to serialize a kf::FieldRegion object with fFieldMode == EFieldMode::Orig");
+      else {
+        throw std::logic_error("Attempt to serialize a kf::FieldRegion object with the original field function");
       }
     }
 
@@ -89,6 +89,8 @@ namespace cbm::algo::kf
 
     /// \brief Creates a setup instance
     /// \param fldMode  Field mode of the setup
+    /// \note  With EFieldMode::Cached, the field function is sampled on a grid once and the grid is shared by all the
+    ///        setups created afterwards. Other modes provide the interpolated field.
     template<typename T>
     Setup<T> MakeSetup(EFieldMode fldMode);
 
@@ -106,6 +108,11 @@ namespace cbm::algo::kf
       fbIfFieldFunctionSet = true;
     }
 
+    /// \brief Sets parameters of the cached field, used by MakeSetup(EFieldMode::Cached)
+    /// \param step          Initial distance between the grid nodes [cm]
+    /// \param maxDeviation  Maximal deviation of the cached field from the field function [kG]
+    void SetFieldCache(double step, double maxDeviation) { fFieldFactory.SetFieldCache(step, maxDeviation); }
+
     /// \brief  Initializes the setup builder from existing setup
     /// \tparam T  Underlying data type of the setup
     /// \param  inSetup
@@ -276,6 +283,10 @@ namespace cbm::algo::kf
     for (const auto& material : this->fvMaterial) {
       setup.fvMaterialLayers.push_back(material);
     }
+    fFieldFactory.SetFieldMode(fldMode == EFieldMode::Cached ? EFieldMode::Cached : EFieldMode::Intrpl);
+    if (fldMode == EFieldMode::Cached) {
+      fFieldFactory.BuildFieldGrid();
+    }
     setup.fField          = fFieldFactory.MakeField<T>();
     setup.fModuleIndexMap = fModuleIndexFactory.MakeIndexMap();
     return setup;
@@ -9,9 +9,12 @@
 
 #include "kfp/KfpV0Finder.h"
 
+#include "compat/OpenMP.h"
 #include "global/RecoResults.h"
 
 #include <algorithm>
+#include <array>
+#include <iterator>
 #include <limits>
 #include <sstream>
 
@@ -21,24 +24,17 @@ using cbm::algo::kfp::V0Finder;
 
 // ---------------------------------------------------------------------------------------------------------------------
 //
-bool V0Finder::AssignMomentum(const PartitionedVector<tof::Hit>& tofHits,
-                              const std::vector<RecoResults::HitId_t>& tofHitIds, double t0, ParticleInfo& particleInfo)
+bool V0Finder::AssignMomentum(uint32_t iCand, ParticleInfo& particleInfo)
 {
-  if (tofHitIds.empty()) {
-    fEventMonitor.IncrementCounter(ECounter::TracksWoTofHits);
-    return false;
-  }
-
   double beta{0.};
   if constexpr (kUseAverageSpeed) {
-    for (const auto& hitId : tofHitIds) {
-      beta += EstimateBeta(tofHits[hitId.first][hitId.second], t0);
+    for (uint32_t iHit = fvTofHitOffsets[iCand]; iHit < fvTofHitOffsets[iCand + 1]; ++iHit) {
+      beta += fvTofHitBeta[iHit];
     }
-    beta /= tofHitIds.size();
+    beta /= (fvTofHitOffsets[iCand + 1] - fvTofHitOffsets[iCand]);
   }
   else {
-    const auto& hitId = tofHitIds.back();
-    beta              = EstimateBeta(tofHits[hitId.first][hitId.second], t0);
+    beta = fvTofHitBeta[fvTofHitOffsets[iCand]];
   }
   if (beta < 0.) {
     fEventMonitor.IncrementCounter(ECounter::TracksWNegativeTofHitTime);
@@ -89,16 +85,54 @@ void V0Finder::AssignPid(ParticleInfo& particleInfo)
 void V0Finder::CollectDca(const RecoResults& recoEvent)
 {
   const auto& stsHitIndices = recoEvent.trackStsHitIndices;
-  for (size_t iTrk = 0; iTrk < stsHitIndices.size(); ++iTrk) {
-    const auto& stsHitIndicesInTrack = stsHitIndices[iTrk];
-    if (stsHitIndicesInTrack.size() < 2) {  // DCA cannot be estimated
-      fEventMonitor.IncrementCounter(ECounter::TracksWoStsHits);
+  const size_t nTracks      = stsHitIndices.NTracks();
+
+  // Gather coordinates of the first two STS hits of the tracks
+  fvDcaInput.assign(7 * nTracks, 0.);
+  double* x0  = fvDcaInput.data();
+  double* y0  = x0 + nTracks;
+  double* z0  = y0 + nTracks;
+  double* x1  = z0 + nTracks;
+  double* y1  = x1 + nTracks;
+  double* z1  = y1 + nTracks;
+  double* dca = z1 + nTracks;
+  for (size_t iTrk = 0; iTrk < nTracks; ++iTrk) {
+    const auto stsHitIndicesInTrack = stsHitIndices[iTrk];
+    if (stsHitIndicesInTrack.size() < 2) {
+      z1[iTrk] = 1.;  // dummy values, the DCA is not used
       continue;
     }
-    auto& particleInfo     = fvParticleInfo[iTrk];
     auto [iPtFst, iHitFst] = stsHitIndicesInTrack[0];
     auto [iPtSnd, iHitSnd] = stsHitIndicesInTrack[1];
-    particleInfo.fDca      = EstimateDca(recoEvent.stsHits[iPtFst][iHitFst], recoEvent.stsHits[iPtSnd][iHitSnd]);
+    const auto& fst        = recoEvent.stsHits[iPtFst][iHitFst];
+    const auto& snd        = recoEvent.stsHits[iPtSnd][iHitSnd];
+    x0[iTrk]               = fst.X();
+    y0[iTrk]               = fst.Y();
+    z0[iTrk]               = fst.Z();
+    x1[iTrk]               = snd.X();
+    y1[iTrk]               = snd.Y();
+    z1[iTrk]               = snd.Z();
+  }
+
+  // Estimate DCA of the straight line through the hits to the origin
+  const double xOrigin{fOrigin[0]};
+  const double yOrigin{fOrigin[1]};
+  const double zOrigin{fOrigin[2]};
+  CBM_OMP(simd)
+  for (size_t iTrk = 0; iTrk < nTracks; ++iTrk) {
+    double factor{(z0[iTrk] - zOrigin) / (z1[iTrk] - z0[iTrk])};
+    double dcaX{x0[iTrk] - xOrigin - factor * (x1[iTrk] - x0[iTrk])};
+    double dcaY{y0[iTrk] - yOrigin - factor * (y1[iTrk] - y0[iTrk])};
+    dca[iTrk] = std::sqrt(dcaX * dcaX + dcaY * dcaY);
+  }
+
+  for (size_t iTrk = 0; iTrk < nTracks; ++iTrk) {
+    if (stsHitIndices[iTrk].size() < 2) {  // DCA cannot be estimated
+      fEventMonitor.IncrementCounter(ECounter::TracksWoStsHits);
+      continue;
+    }
+    auto& particleInfo = fvParticleInfo[iTrk];
+    particleInfo.fDca  = dca[iTrk];
     AssignPid(particleInfo);
   }
 }
@@ -115,27 +149,57 @@ void V0Finder::CollectT0(gsl::span<const bmon::Hit> bmonHits)
 
 // ---------------------------------------------------------------------------------------------------------------------
 //
-double V0Finder::EstimateDca(const sts::Hit& fst, const sts::Hit& snd) const
+void V0Finder::CollectTofHits(const RecoResults& recoEvent)
 {
-  double factor{(fst.Z() - fOrigin[2]) / (snd.Z() - fst.Z())};
-  double dcaX{fst.X() - fOrigin[0] - factor * (snd.X() - fst.X())};
-  double dcaY{fst.Y() - fOrigin[1] - factor * (snd.Y() - fst.Y())};
-  return std::sqrt(dcaX * dcaX + dcaY * dcaY);
+  fvMomentumCandIds.clear();
+  fvTofHitOffsets.clear();
+  fvTofHitDist.clear();
+  fvTofHitTime.clear();
+  fNofTracksWoTofHits = 0;
+  fvTofHitOffsets.push_back(0);
+  for (uint32_t iTrk = 0; iTrk < fvParticleInfo.size(); ++iTrk) {
+    // NOTE: if fPdg == kUndefPdg, the momentum is not estimated for the track
+    if (fvParticleInfo[iTrk].fPdg == kUndefPdg) {
+      continue;
+    }
+    const auto tofHitIds = recoEvent.trackTofHitIndices[iTrk];
+    if (tofHitIds.empty()) {
+      ++fNofTracksWoTofHits;
+      continue;
+    }
+    fvMomentumCandIds.push_back(iTrk);
+    auto itHitFst = kUseAverageSpeed ? tofHitIds.begin() : std::prev(tofHitIds.end());
+    for (auto itHit = itHitFst; itHit != tofHitIds.end(); ++itHit) {
+      const auto& hit = recoEvent.tofHits[itHit->first][itHit->second];
+      double x{hit.X() - fOrigin[0]};
+      double y{hit.Y() - fOrigin[1]};
+      double z{hit.Z() - fOrigin[2]};
+      double x2{x * x};
+      double y2{y * y};
+      double z2{z * z};
+      double r2{x2 + y2 + z2};
+      fvTofHitDist.push_back(std::sqrt(r2));
+      fvTofHitTime.push_back(hit.Time());
+    }
+    fvTofHitOffsets.push_back(fvTofHitDist.size());
+  }
+  fvTofHitBeta.resize(fvTofHitDist.size());
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 //
-double V0Finder::EstimateBeta(const tof::Hit& hit, double t0) const
+void V0Finder::EstimateBeta(double t0)
 {
-  double t = hit.Time() - t0 - fTzeroOffset;
-  double x{hit.X() - fOrigin[0]};
-  double y{hit.Y() - fOrigin[1]};
-  double z{hit.Z() - fOrigin[2]};
-  double x2{x * x};
-  double y2{y * y};
-  double z2{z * z};
-  double r2{x2 + y2 + z2};
-  return std::sqrt(r2) / (t * kSpeedOfLight);
+  const size_t nHits{fvTofHitDist.size()};
+  const double* dist{fvTofHitDist.data()};
+  const double* time{fvTofHitTime.data()};
+  double* beta{fvTofHitBeta.data()};
+  const double tOffset{fTzeroOffset};
+  CBM_OMP(simd)
+  for (size_t iHit = 0; iHit < nHits; ++iHit) {
+    double t   = time[iHit] - t0 - tOffset;
+    beta[iHit] = dist[iHit] / (t * kSpeedOfLight);
+  }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -145,10 +209,13 @@ bool V0Finder::FindV0Candidates(const RecoResults& recoEvent, double t0)
   const auto& tracks = recoEvent.tracks;
 
   // Reset temporary data structures
-  InitTrackParamVectors(tracks);
+  // NOTE: The track parameters are copied once per event, only the ones of the tracks selected for the previous t0
+  //       were modified.
+  for (uint32_t iTrk : fvSelectedTrackIds) {
+    fvTrackParam[iTrk] = std::make_pair(tracks[iTrk].fParFirst, tracks[iTrk].fParLast);
+  }
   fpTopoReconstructor->Clear();
   fvSelectedTrackIds.clear();
-  fvSelectedTrackIds.reserve(tracks.size());
   fEventMonitor.ResetCounter(ECounter::TracksWoMomentum);
   fEventMonitor.ResetCounter(ECounter::TracksSelected);
   fEventMonitor.ResetCounter(ECounter::Pions);
@@ -156,26 +223,26 @@ bool V0Finder::FindV0Candidates(const RecoResults& recoEvent, double t0)
   fEventMonitor.ResetCounter(ECounter::EventsLambdaCand);
 
   // Preselect tracks
+  // NOTE: Tracks with undefined PID (fPdg == kUndefPdg) and tracks without TOF hits were already excluded from the
+  //       momentum candidates in CollectTofHits()
   uint32_t nProtonCandidates{0};
   uint32_t nPionCandidates{0};
   uint32_t nSelectedTracks{0};
   fEventMonitor.StartTimer(ETimer::PreselectTracks);
-  for (size_t iTrk = 0; iTrk < tracks.size(); ++iTrk) {  // Over all tracks
+  fEventMonitor.IncrementCounter(ECounter::TracksWoTofHits, fNofTracksWoTofHits);
+  fEventMonitor.IncrementCounter(ECounter::TracksWoMomentum, fNofTracksWoTofHits);
+  EstimateBeta(t0);
+  for (uint32_t iCand = 0; iCand < fvMomentumCandIds.size(); ++iCand) {  // Over tracks with PID and TOF hits
+    uint32_t iTrk{fvMomentumCandIds[iCand]};
     auto& particleInfo = fvParticleInfo[iTrk];
 
-    // Cut tracks with undefined dca (by PID == -2)
-    // NOTE: if fPdg == kUndefPdg, beta and QP were not estimated for this track on previous iterations as well
-    if (particleInfo.fPdg == kUndefPdg) {
-      continue;
-    }
-
     // Reset fields of the ParticleInfo, which could be filled on the previous iteration
     particleInfo.fBeta      = std::numeric_limits<double>::quiet_NaN();
     particleInfo.fQp        = std::numeric_limits<double>::quiet_NaN();
     particleInfo.fbSelected = false;
 
     // Assign momentum to tracks
-    if (!AssignMomentum(recoEvent.tofHits, recoEvent.trackTofHitIndices[iTrk], t0, particleInfo)) {
+    if (!AssignMomentum(iCand, particleInfo)) {
       fEventMonitor.IncrementCounter(ECounter::TracksWoMomentum);
       continue;  // No momentum was assigned
     }
@@ -213,18 +280,9 @@ bool V0Finder::FindV0Candidates(const RecoResults& recoEvent, double t0)
 
   // Initialize and run the KFParticleFinder
   fEventMonitor.StartTimer(ETimer::InitKfp);
-  KFPTrackVector kfpTracksFst;
-  KFPTrackVector kfpTracksLst;
-  kfpTracksFst.Resize(nSelectedTracks);
-  kfpTracksLst.Resize(nSelectedTracks);
-  for (uint32_t iKfpTrk = 0; iKfpTrk < fvSelectedTrackIds.size(); ++iKfpTrk) {  // Over selected tracks
-    uint32_t iCaTrk{fvSelectedTrackIds[iKfpTrk]};
-    const auto& trkParam{fvTrackParam[iCaTrk]};
-    const auto& particleInfo{fvParticleInfo[iCaTrk]};
-    SetKfpTrackParameters(kfpTracksFst, iKfpTrk, iCaTrk, trkParam.first, particleInfo);
-    SetKfpTrackParameters(kfpTracksLst, iKfpTrk, iCaTrk, trkParam.second, particleInfo);
-  }
-  fpTopoReconstructor->Init(kfpTracksFst, kfpTracksLst);
+  SetKfpTrackParameters(fKfpTracksFst, false);
+  SetKfpTrackParameters(fKfpTracksLst, true);
+  fpTopoReconstructor->Init(fKfpTracksFst, fKfpTracksLst);
   fpTopoReconstructor->AddPV(MakeKfpPrimaryVertex(fOrigin));
   fpTopoReconstructor->SortTracks();
   fEventMonitor.StopTimer(ETimer::InitKfp);
@@ -304,6 +362,10 @@ CbmEventTriggers V0Finder::Process(const RecoResults& recoEvent)
   // ----- Try to find lambdas for different T0
   fSelectedT0 = std::numeric_limits<double>::quiet_NaN();
   fEventMonitor.StartTimer(ETimer::FindV0Candidates);
+  // T0-independent preparations
+  InitTrackParamVectors(recoEvent.tracks);
+  CollectTofHits(recoEvent);
+  fvSelectedTrackIds.clear();
   for (double t0 : fvT0s) {
     if (FindV0Candidates(recoEvent, t0)) {
       fSelectedT0 = t0;
@@ -337,105 +399,192 @@ bool V0Finder::SelectTrack(const ParticleInfo& particleInfo) const
 
 // ---------------------------------------------------------------------------------------------------------------------
 //
-void V0Finder::SetKfpTrackParameters(KFPTrackVector& trackVector, uint32_t iKfpTrk, uint32_t iCaTrk,
-                                     const ca::Track::TrackParam_t& trkParam, const ParticleInfo& particleInfo) const
+void V0Finder::SetKfpTrackParameters(KFPTrackVector& trackVector, bool bLast)
 {
-  // ----- Parameter definition
-  double tx{trkParam.GetTx()};
-  double ty{trkParam.GetTy()};
-  double qp{trkParam.GetQp()};
-  double p{particleInfo.fCharge / qp};
-  double p2{p * p};
-  double t2inv{1. / (1. + tx * tx + ty * ty)};
-  double pz{std::sqrt(t2inv * p2)};
-  double px{tx * pz};
-  double py{ty * pz};
-
-  trackVector.SetParameter(trkParam.GetX(), 0, iKfpTrk);
-  trackVector.SetParameter(trkParam.GetY(), 1, iKfpTrk);
-  trackVector.SetParameter(trkParam.GetZ(), 2, iKfpTrk);
-  trackVector.SetParameter(px, 3, iKfpTrk);
-  trackVector.SetParameter(py, 4, iKfpTrk);
-  trackVector.SetParameter(pz, 5, iKfpTrk);
-
-  // Jacobian matrix for (tx, ty, qp) -> (px, py, pz)
-  std::array<std::array<double, 3>, 3> Jp;
-  Jp[2][0] = -t2inv * px;         // d(pz)/d(tx)
-  Jp[2][1] = -t2inv * py;         // d(pz)/d(ty)
-  Jp[2][2] = -pz / qp;            // d(pz)/d(qp)
-  Jp[0][0] = tx * Jp[2][0] + pz;  // d(px)/d(tx)
-  Jp[0][1] = tx * Jp[2][1];       // d(px)/d(ty)
-  Jp[0][2] = tx * Jp[2][2];       // d(px)/d(qp)
-  Jp[1][0] = ty * Jp[2][0];       // d(py)/d(tx)
-  Jp[1][1] = ty * Jp[2][1] + pz;  // d(py)/d(ty)
-  Jp[1][2] = ty * Jp[2][2];       // d(py)/d(qp)
-
-
-  // ----- Covariance matrix definition
-  // Position covariance
-  trackVector.SetCovariance(trkParam.C00(), 0, iKfpTrk);  // var(x)
-  trackVector.SetCovariance(trkParam.C01(), 1, iKfpTrk);  // cov(x, y)
-  trackVector.SetCovariance(trkParam.C11(), 2, iKfpTrk);  // var(y)
-
-  // Momentum-position covariances
-  auto MomPosCovariance = [&](const int k, const int l) constexpr->double
+  // Columns of the SoA buffer: input track parameters and output momentum parameters
+  enum EColumn : uint32_t
   {
-    double val{0.};
-    const auto& JpA = Jp[k];
-    for (int i = 0; i < 3; ++i) {
-      val += JpA[i] * trkParam.C(i + 2, l);
-    }
-    return val;
+    kTx,
+    kTy,
+    kQp,
+    kQ,
+    kC20,
+    kC21,
+    kC22,
+    kC30,
+    kC31,
+    kC32,
+    kC33,
+    kC40,
+    kC41,
+    kC42,
+    kC43,
+    kC44,
+    kPx,
+    kPy,
+    kPz,
+    kCovXPx,
+    kCovYPx,
+    kCovXPy,
+    kCovYPy,
+    kCovXPz,
+    kCovYPz,
+    kVarPx,
+    kCovPxPy,
+    kVarPy,
+    kCovPxPz,
+    kCovPyPz,
+    kVarPz,
+    kNofColumns
   };
-  trackVector.SetCovariance(MomPosCovariance(0, 0), 6, iKfpTrk);   // cov(x, px)
-  trackVector.SetCovariance(MomPosCovariance(0, 1), 7, iKfpTrk);   // cov(y, px)
-  trackVector.SetCovariance(MomPosCovariance(1, 0), 10, iKfpTrk);  // cov(x, py)
-  trackVector.SetCovariance(MomPosCovariance(1, 1), 11, iKfpTrk);  // cov(y, py)
-  trackVector.SetCovariance(MomPosCovariance(2, 0), 15, iKfpTrk);  // cov(x, pz)
-  trackVector.SetCovariance(MomPosCovariance(2, 1), 16, iKfpTrk);  // cov(y, pz)
-
-  // Momentum covariances
-  auto MomentumCovariance = [&](const int k, const int l) constexpr->double
-  {
-    double val{0.};
-    const auto& JpA = Jp[k];
-    const auto& JpB = Jp[l];
-    for (int i = 0; i < 3; ++i) {
-      double factor{0.};
-      for (int j = 0; j < 3; ++j) {
-        factor += JpB[j] * trkParam.C(i + 2, j + 2);
-      }
-      val += JpA[i] * factor;
+
+  const uint32_t nTracks = fvSelectedTrackIds.size();
+  trackVector.Resize(nTracks);
+  fvKfpInput.resize(kNofColumns * nTracks);
+  std::array<double*, kNofColumns> col;
+  for (uint32_t iCol = 0; iCol < kNofColumns; ++iCol) {
+    col[iCol] = fvKfpInput.data() + iCol * nTracks;
+  }
+
+  // ----- Gather track parameters, set the t0-independent fields
+  for (uint32_t iKfpTrk = 0; iKfpTrk < nTracks; ++iKfpTrk) {
+    uint32_t iCaTrk{fvSelectedTrackIds[iKfpTrk]};
+    const auto& trkParam{bLast ? fvTrackParam[iCaTrk].second : fvTrackParam[iCaTrk].first};
+    const auto& particleInfo{fvParticleInfo[iCaTrk]};
+    col[kTx][iKfpTrk]  = trkParam.GetTx();
+    col[kTy][iKfpTrk]  = trkParam.GetTy();
+    col[kQp][iKfpTrk]  = trkParam.GetQp();
+    col[kQ][iKfpTrk]   = particleInfo.fCharge;
+    col[kC20][iKfpTrk] = trkParam.C20();
+    col[kC21][iKfpTrk] = trkParam.C21();
+    col[kC22][iKfpTrk] = trkParam.C22();
+    col[kC30][iKfpTrk] = trkParam.C30();
+    col[kC31][iKfpTrk] = trkParam.C31();
+    col[kC32][iKfpTrk] = trkParam.C32();
+    col[kC33][iKfpTrk] = trkParam.C33();
+    col[kC40][iKfpTrk] = trkParam.C40();
+    col[kC41][iKfpTrk] = trkParam.C41();
+    col[kC42][iKfpTrk] = trkParam.C42();
+    col[kC43][iKfpTrk] = trkParam.C43();
+    col[kC44][iKfpTrk] = trkParam.C44();
+
+    trackVector.SetParameter(trkParam.GetX(), 0, iKfpTrk);
+    trackVector.SetParameter(trkParam.GetY(), 1, iKfpTrk);
+    trackVector.SetParameter(trkParam.GetZ(), 2, iKfpTrk);
+
+    // Position covariance
+    trackVector.SetCovariance(trkParam.C00(), 0, iKfpTrk);  // var(x)
+    trackVector.SetCovariance(trkParam.C01(), 1, iKfpTrk);  // cov(x, y)
+    trackVector.SetCovariance(trkParam.C11(), 2, iKfpTrk);  // var(y)
+
+    // Zero covariances (with z-coordinate)
+    trackVector.SetCovariance(0.f, 3, iKfpTrk);   // cov(x,z)
+    trackVector.SetCovariance(0.f, 4, iKfpTrk);   // cov(y,z)
+    trackVector.SetCovariance(0.f, 5, iKfpTrk);   // var(z)
+    trackVector.SetCovariance(0.f, 8, iKfpTrk);   // cov(z,px)
+    trackVector.SetCovariance(0.f, 12, iKfpTrk);  // cov(z,py)
+    trackVector.SetCovariance(0.f, 17, iKfpTrk);  // var(z,pz)
+
+    // ----- Other quantities
+    // Magnetic field (NOTE: zero fom mCBM)
+    // FIXME: Provide a proper initialization for full CBM
+    for (int iF = 0; iF < 10; ++iF) {
+      trackVector.SetFieldCoefficient(0.f, iF, iKfpTrk);
     }
-    return val;
-  };
-  trackVector.SetCovariance(MomentumCovariance(0, 0), 9, iKfpTrk);   // var(px)
-  trackVector.SetCovariance(MomentumCovariance(1, 0), 13, iKfpTrk);  // cov(px, py)
-  trackVector.SetCovariance(MomentumCovariance(1, 1), 14, iKfpTrk);  // var(py)
-  trackVector.SetCovariance(MomentumCovariance(2, 0), 18, iKfpTrk);  // cov(px, pz)
-  trackVector.SetCovariance(MomentumCovariance(2, 1), 19, iKfpTrk);  // cov(py, pz)
-  trackVector.SetCovariance(MomentumCovariance(2, 2), 20, iKfpTrk);  // var(pz)
-
-  // Zero covariances (with z-coordinate)
-  trackVector.SetCovariance(0.f, 3, iKfpTrk);   // cov(x,z)
-  trackVector.SetCovariance(0.f, 4, iKfpTrk);   // cov(y,z)
-  trackVector.SetCovariance(0.f, 5, iKfpTrk);   // var(z)
-  trackVector.SetCovariance(0.f, 8, iKfpTrk);   // cov(z,px)
-  trackVector.SetCovariance(0.f, 12, iKfpTrk);  // cov(z,py)
-  trackVector.SetCovariance(0.f, 17, iKfpTrk);  // var(z,pz)
-
-  // ----- Other quantities
-  // Magnetic field (NOTE: zero fom mCBM)
-  // FIXME: Provide a proper initialization for full CBM
-  for (int iF = 0; iF < 10; ++iF) {
-    trackVector.SetFieldCoefficient(0.f, iF, iKfpTrk);
+
+    trackVector.SetId(iCaTrk, iKfpTrk);
+    trackVector.SetPDG(particleInfo.fPdg, iKfpTrk);
+    trackVector.SetQ(particleInfo.fCharge, iKfpTrk);
+    trackVector.SetNPixelHits(0, iKfpTrk);
+
+    // NOTE: 0 - primary tracks, -1 - secondary tracks. Here for now we assign ALL tracks as secondary
+    trackVector.SetPVIndex(-1, iKfpTrk);
   }
 
-  trackVector.SetId(iCaTrk, iKfpTrk);
-  trackVector.SetPDG(particleInfo.fPdg, iKfpTrk);
-  trackVector.SetQ(particleInfo.fCharge, iKfpTrk);
-  trackVector.SetNPixelHits(0, iKfpTrk);
+  // ----- Transform (tx, ty, qp) -> (px, py, pz) and the covariance matrix, vectorized over tracks
+  CBM_OMP(simd)
+  for (uint32_t iKfpTrk = 0; iKfpTrk < nTracks; ++iKfpTrk) {
+    double tx{col[kTx][iKfpTrk]};
+    double ty{col[kTy][iKfpTrk]};
+    double qp{col[kQp][iKfpTrk]};
+    double p{col[kQ][iKfpTrk] / qp};
+    double p2{p * p};
+    double t2inv{1. / (1. + tx * tx + ty * ty)};
+    double pz{std::sqrt(t2inv * p2)};
+    double px{tx * pz};
+    double py{ty * pz};
+
+    // Jacobian matrix for (tx, ty, qp) -> (px, py, pz)
+    double j20{-t2inv * px};    // d(pz)/d(tx)
+    double j21{-t2inv * py};    // d(pz)/d(ty)
+    double j22{-pz / qp};       // d(pz)/d(qp)
+    double j00{tx * j20 + pz};  // d(px)/d(tx)
+    double j01{tx * j21};       // d(px)/d(ty)
+    double j02{tx * j22};       // d(px)/d(qp)
+    double j10{ty * j20};       // d(py)/d(tx)
+    double j11{ty * j21 + pz};  // d(py)/d(ty)
+    double j12{ty * j22};       // d(py)/d(qp)
+
+    // Covariances of (tx, ty, qp) with x, y and among each other
+    double c20{col[kC20][iKfpTrk]};
+    double c21{col[kC21][iKfpTrk]};
+    double c22{col[kC22][iKfpTrk]};
+    double c30{col[kC30][iKfpTrk]};
+    double c31{col[kC31][iKfpTrk]};
+    double c32{col[kC32][iKfpTrk]};
+    double c33{col[kC33][iKfpTrk]};
+    double c40{col[kC40][iKfpTrk]};
+    double c41{col[kC41][iKfpTrk]};
+    double c42{col[kC42][iKfpTrk]};
+    double c43{col[kC43][iKfpTrk]};
+    double c44{col[kC44][iKfpTrk]};
+
+    col[kPx][iKfpTrk] = px;
+    col[kPy][iKfpTrk] = py;
+    col[kPz][iKfpTrk] = pz;
+
+    // Momentum-position covariances: J * C(tx..qp, x..y)
+    col[kCovXPx][iKfpTrk] = j00 * c20 + j01 * c30 + j02 * c40;
+    col[kCovYPx][iKfpTrk] = j00 * c21 + j01 * c31 + j02 * c41;
+    col[kCovXPy][iKfpTrk] = j10 * c20 + j11 * c30 + j12 * c40;
+    col[kCovYPy][iKfpTrk] = j10 * c21 + j11 * c31 + j12 * c41;
+    col[kCovXPz][iKfpTrk] = j20 * c20 + j21 * c30 + j22 * c40;
+    col[kCovYPz][iKfpTrk] = j20 * c21 + j21 * c31 + j22 * c41;
+
+    // Momentum covariances: J * C(tx..qp, tx..qp) * J^T
+    double f00{j00 * c22 + j01 * c32 + j02 * c42};  // (C * J^T)[0][0]
+    double f10{j00 * c32 + j01 * c33 + j02 * c43};
+    double f20{j00 * c42 + j01 * c43 + j02 * c44};
+    double f01{j10 * c22 + j11 * c32 + j12 * c42};  // (C * J^T)[0][1]
+    double f11{j10 * c32 + j11 * c33 + j12 * c43};
+    double f21{j10 * c42 + j11 * c43 + j12 * c44};
+    double f02{j20 * c22 + j21 * c32 + j22 * c42};  // (C * J^T)[0][2]
+    double f12{j20 * c32 + j21 * c33 + j22 * c43};
+    double f22{j20 * c42 + j21 * c43 + j22 * c44};
+    col[kVarPx][iKfpTrk]   = j00 * f00 + j01 * f10 + j02 * f20;
+    col[kCovPxPy][iKfpTrk] = j10 * f00 + j11 * f10 + j12 * f20;
+    col[kVarPy][iKfpTrk]   = j10 * f01 + j11 * f11 + j12 * f21;
+    col[kCovPxPz][iKfpTrk] = j20 * f00 + j21 * f10 + j22 * f20;
+    col[kCovPyPz][iKfpTrk] = j20 * f01 + j21 * f11 + j22 * f21;
+    col[kVarPz][iKfpTrk]   = j20 * f02 + j21 * f12 + j22 * f22;
+  }
 
-  // NOTE: 0 - primary tracks, -1 - secondary tracks. Here for now we assign ALL tracks as secondary
-  trackVector.SetPVIndex(-1, iKfpTrk);
+  // ----- Scatter the momentum parameters
+  for (uint32_t iKfpTrk = 0; iKfpTrk < nTracks; ++iKfpTrk) {
+    trackVector.SetParameter(col[kPx][iKfpTrk], 3, iKfpTrk);
+    trackVector.SetParameter(col[kPy][iKfpTrk], 4, iKfpTrk);
+    trackVector.SetParameter(col[kPz][iKfpTrk], 5, iKfpTrk);
+    trackVector.SetCovariance(col[kCovXPx][iKfpTrk], 6, iKfpTrk);    // cov(x, px)
+    trackVector.SetCovariance(col[kCovYPx][iKfpTrk], 7, iKfpTrk);    // cov(y, px)
+    trackVector.SetCovariance(col[kCovXPy][iKfpTrk], 10, iKfpTrk);   // cov(x, py)
+    trackVector.SetCovariance(col[kCovYPy][iKfpTrk], 11, iKfpTrk);   // cov(y, py)
+    trackVector.SetCovariance(col[kCovXPz][iKfpTrk], 15, iKfpTrk);   // cov(x, pz)
+    trackVector.SetCovariance(col[kCovYPz][iKfpTrk], 16, iKfpTrk);   // cov(y, pz)
+    trackVector.SetCovariance(col[kVarPx][iKfpTrk], 9, iKfpTrk);     // var(px)
+    trackVector.SetCovariance(col[kCovPxPy][iKfpTrk], 13, iKfpTrk);  // cov(px, py)
+    trackVector.SetCovariance(col[kVarPy][iKfpTrk], 14, iKfpTrk);    // var(py)
+    trackVector.SetCovariance(col[kCovPxPz][iKfpTrk], 18, iKfpTrk);  // cov(px, pz)
+    trackVector.SetCovariance(col[kCovPyPz][iKfpTrk], 19, iKfpTrk);  // cov(py, pz)
+    trackVector.SetCovariance(col[kVarPz][iKfpTrk], 20, iKfpTrk);    // var(pz)
+  }
 }
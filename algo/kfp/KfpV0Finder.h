@@ -168,18 +168,12 @@ namespace cbm::algo::kfp
 
    private:
     /// \brief  Assigns momentum based on the TOF measurement
-    /// \param[in]  tofHits      Tof hits container
-    /// \param[in]  tofHitIds    Tof hit indices, used by the track
-    /// \param[in]  t0           A t0 value
+    /// \param[in]  iCand       Index of the track among the momentum candidates
     /// \param[inout]  pidInfo   PID information for the track
     /// \return  true  A physically reasonable momentum assigned
     /// \return  false Momentum was not assigned, because it was nonphysical
-    /* clang-format off */
-    bool AssignMomentum(const PartitionedVector<tof::Hit>& tofHits, 
-                        const std::vector<RecoResults::HitId_t>& tofHitIds,
-                        double t0, 
-                        ParticleInfo& pidInfo);
-    /* clang-format on */
+    /// \note   The speed estimations for the current t0 must be computed with EstimateBeta() beforehand
+    bool AssignMomentum(uint32_t iCand, ParticleInfo& pidInfo);
 
     /// \brief  Assigns PID info based on the estimated DCA
     /// \param  dca  DCA of track to origin
@@ -190,23 +184,21 @@ namespace cbm::algo::kfp
     /// \param  recoEvent  Instance of a reconstructed event
     void CollectDca(const RecoResults& recoEvent);
 
+    /// \brief  Collects TOF hits, used for the momentum estimation, of tracks with defined PID
+    /// \param  recoEvent  Instance of a reconstructed event
+    ///
+    /// The distance of the hits to the origin does not depend on t0, so it is calculated once per event
+    void CollectTofHits(const RecoResults& recoEvent);
+
     /// \brief  Collects T0 values among the BMON hits
     /// \param  bmonHits  A span of BMON hits
     ///
     /// If multiple T0-s are found, the routine will run multiple times, until V0-candidates are found
     void CollectT0(gsl::span<const bmon::Hit> bmonHits);
 
-    /// \brief  Estimates speed of particle, using TOF measurement
-    /// \param  tofHit   A TOF hit
-    /// \param  t0       An t0 value
-    /// \return Speed of particle [c]
-    double EstimateBeta(const tof::Hit& tofHit, double t0) const;
-
-    /// \brief  Estimate DCA of a track to origin
-    /// \param  fst  first  STS hit
-    /// \param  snd  second STS hit
-    /// \return dca [cm]
-    double EstimateDca(const sts::Hit& fst, const sts::Hit& snd) const;
+    /// \brief  Estimates speed of particles for all collected TOF hits, using TOF measurement
+    /// \param  t0  An t0 value
+    void EstimateBeta(double t0);
 
     /// \brief  Tries to find V0-candidates for a given t0
     /// \param  recoEvent  Instance of a reconstructed event
@@ -229,14 +221,10 @@ namespace cbm::algo::kfp
     /// \return false Track is rejected
     bool SelectTrack(const ParticleInfo& particleInfo) const;
 
-    /// \brief  Sets KFP track parameters
+    /// \brief  Sets KFP track parameters of the selected tracks
     /// \param[inout]  kfpTrkVector  Reference to the KFP track vector
-    /// \param[in]     iKfpTrk       Index of the KFP track
-    /// \param[in]     iCaTrk        Index of the CA track
-    /// \param[in]     trkParam      Track parameters
-    /// \param[in]     particleInfo  Particle information
-    void SetKfpTrackParameters(KFPTrackVector& kfpTrkVector, uint32_t iKfpTrk, uint32_t iCaTrk,
-                               const ca::Track::TrackParam_t& trkParam, const ParticleInfo& particleInfo) const;
+    /// \param[in]     bLast         If the parameters on the last station are used (otherwise: on the first station)
+    void SetKfpTrackParameters(KFPTrackVector& kfpTrkVector, bool bLast);
 
 
     //* Framework and physical constants (private)
@@ -263,12 +251,22 @@ namespace cbm::algo::kfp
     std::vector<double> fvT0s;                                     ///< Found t0s [ns] (in event)
     std::vector<ParticleInfo> fvParticleInfo;                      ///< PID info of tracks (in event)
     std::vector<uint32_t> fvSelectedTrackIds;                      ///< IDs of selected tracks (in event)
+    std::vector<uint32_t> fvMomentumCandIds;                       ///< IDs of tracks with PID and TOF hits (in event)
+    std::vector<uint32_t> fvTofHitOffsets;                         ///< Offsets of candidate TOF hits (in event)
+    std::vector<double> fvTofHitDist;                              ///< Distance from origin to TOF hit [cm]
+    std::vector<double> fvTofHitTime;                              ///< Time of TOF hit [ns]
+    std::vector<double> fvTofHitBeta;                              ///< Speed estimated for TOF hit and t0 [c]
+    uint32_t fNofTracksWoTofHits{0};                               ///< Number of tracks with PID, but w/o TOF hits
     double fSelectedT0{std::numeric_limits<double>::quiet_NaN()};  ///< A t0 value selected by the lambda-finder
 
     /// \brief A copy of track parameters (first, last)
     std::vector<std::pair<ca::Track::TrackParam_t, ca::Track::TrackParam_t>> fvTrackParam;
 
     //* Auxilary variables
+    std::vector<double> fvDcaInput;  ///< Coordinates of the first two STS hits of tracks (SoA)
+    std::vector<double> fvKfpInput;  ///< Track parameters of selected tracks and their transformation (SoA)
+    KFPTrackVector fKfpTracksFst;    ///< KFP input: selected tracks on the first station
+    KFPTrackVector fKfpTracksLst;    ///< KFP input: selected tracks on the last station
 
     /// \brief An instance of the topology reconstructor
     std::unique_ptr<KFParticleTopoReconstructor> fpTopoReconstructor{std::make_unique<KFParticleTopoReconstructor>()};
@@ -43,6 +43,14 @@ cbm::algo::kfp::V0FinderMonitorData_t V0FinderChain::GetMonitor()
   return monitorData;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void V0FinderChain::MergeMonitor(V0FinderChain& other)
+{
+  other.GetMonitor();  // Moves the timeslice monitor of the other instance to its run monitor
+  fMonitorRun.AddMonitorData(other.fMonitorRun.GetMonitorData());
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 //
 void V0FinderChain::Init()
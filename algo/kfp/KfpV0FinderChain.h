@@ -61,6 +61,10 @@ namespace cbm::algo
     /// \brief Gets a monitor
     kfp::V0FinderMonitorData_t GetMonitor();
 
+    /// \brief Adds the run monitor of another instance (e.g. of another thread) to the run monitor
+    /// \param other  Other V0-finder chain
+    void MergeMonitor(V0FinderChain& other);
+
     /// \brief Sets BMON diamond addresses array
     /// \note  The addresses must be taken from bmon::Hitfind::GetDiamondAddresses()
     void SetBmonDefinedAddresses(const PODVector<uint32_t>& addresses) { fBmonDefinedAddresses = addresses; }
@@ -5,6 +5,7 @@
 #include "DigiEventQa.h"
 
 #include "Histogram.h"
+#include "compat/OpenMP.h"
 
 #include <functional>
 #include <iomanip>
@@ -32,12 +33,25 @@ namespace cbm::algo::evbuild
                                                    detConfig.fNumBins, detConfig.fMinValue, detConfig.fMaxValue));
     }
 
+    // --- Per-thread shards of the histograms, merged after the event loop
+    std::vector<ECbmModuleId> subsystems;
+    std::vector<qa::HistogramShards<H1D>> shards;
+    shards.reserve(result.fDigiTimeHistos.size());
+    for (auto& [subsystem, histo] : result.fDigiTimeHistos) {
+      subsystems.push_back(subsystem);
+      shards.emplace_back(histo);
+    }
+
     // --- Event loop. Fill histograms.
-    for (const auto& event : events) {                  //
-      for (auto& subsystem : result.fDigiTimeHistos) {  //
-        QaDigiTimeInEvent(event, subsystem.first, subsystem.second);
+    CBM_PARALLEL_FOR(schedule(dynamic))
+    for (size_t iEvent = 0; iEvent < events.size(); iEvent++) {
+      for (size_t iSys = 0; iSys < subsystems.size(); iSys++) {
+        QaDigiTimeInEvent(events[iEvent], subsystems[iSys], shards[iSys].Local());
       }
     }
+    for (auto& histo : shards) {
+      histo.Merge();
+    }
     result.fNumEvents = events.size();
 
     return result;
@@ -46,7 +60,8 @@ namespace cbm::algo::evbuild
 
 
   // ---  QA: digi time within event   ----------------------------------------
-  void DigiEventQa::QaDigiTimeInEvent(const DigiEvent& event, ECbmModuleId system, H1D* histo) const
+  void DigiEventQa::QaDigiTimeInEvent(const DigiEvent& event, ECbmModuleId system,
+                                      qa::HistogramShards<H1D>::Shard& histo) const
   {
     switch (system) {
 
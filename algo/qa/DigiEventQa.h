@@ -8,6 +8,7 @@
 #include "CbmDefs.h"
 #include "DigiData.h"
 #include "HistogramContainer.h"
+#include "HistogramShards.h"
 #include "evbuild/EventBuilderConfig.h"
 
 #include <gsl/span>
@@ -141,18 +142,19 @@ namespace cbm::algo::evbuild
      ** The templated class is required to implement the method double GetTime().
      **/
     template<class Digi>
-    void FillDeltaT(gsl::span<const Digi> digis, double eventTime, qa::H1D* histo) const
+    void FillDeltaT(gsl::span<const Digi> digis, double eventTime, qa::HistogramShards<qa::H1D>::Shard& histo) const
     {
       for (const Digi& digi : digis)
-        histo->Fill(digi.GetTime() - eventTime);
+        histo.Count(digi.GetTime() - eventTime);
     }
 
     /** @brief Fill histogram with digi time within event
      ** @param digis  Vector with digi objects
      ** @param eventTime  Time of event
-     ** @param histo  Histogram to be filled
+     ** @param histo  Shard of the histogram of the calling thread
      **/
-    void QaDigiTimeInEvent(const DigiEvent& event, ECbmModuleId system, qa::H1D* histo) const;
+    void QaDigiTimeInEvent(const DigiEvent& event, ECbmModuleId system,
+                           qa::HistogramShards<qa::H1D>::Shard& histo) const;
 
 
    private:  // members
@@ -16,6 +16,7 @@
 #include <boost/histogram/serialization.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/base_object.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 
@@ -23,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -171,6 +173,15 @@ namespace cbm::algo::qa
       fTotSumWX2 = 0;
     }
 
+    /// \brief Adds the sums of another histogram
+    void Add(const TotalSums1D& other)
+    {
+      fTotSumW += other.fTotSumW;
+      fTotSumW2 += other.fTotSumW2;
+      fTotSumWX += other.fTotSumWX;
+      fTotSumWX2 += other.fTotSumWX2;
+    }
+
     double fTotSumW   = 0.;  ///< Total sum (over all bins) of weights
     double fTotSumW2  = 0.;  ///< Total sum (over all bins) of squared weights
     double fTotSumWX  = 0.;  ///< Total sum (over all bins) of weight over x products
@@ -212,6 +223,15 @@ namespace cbm::algo::qa
       fTotSumWY2 = 0;
     }
 
+    /// \brief Adds the sums of another histogram
+    void Add(const TotalSums2D& other)
+    {
+      TotalSums1D::Add(other);
+      fTotSumWXY += other.fTotSumWXY;
+      fTotSumWY += other.fTotSumWY;
+      fTotSumWY2 += other.fTotSumWY2;
+    }
+
     /// \brief Updates the sums
     /// \param x  X value
     /// \param y  Y value
@@ -348,6 +368,18 @@ namespace cbm::algo::qa
     /// \brief Gets title
     const std::string& GetTitle() const { return fTitle; }
 
+    /// \brief Checks, if the histogram was not filled since the last reset
+    bool IsEmpty() const { return fEntries == 0; }
+
+    /// \brief Adds the content of another histogram with the same binning
+    /// \throws std::invalid_argument  If the axes of the histograms differ
+    void Add(const Histogram<Axes, Storage, TotalSums>& other)
+    {
+      fHistogram += other.fHistogram;
+      TotalSums::Add(other);
+      fEntries += other.fEntries;
+    }
+
     /// \brief Resets the histogram
     void Reset()
     {
@@ -418,18 +450,82 @@ namespace cbm::algo::qa
 
 
    private:
+    using Cell_t = typename Storage::value_type;
+
+    template<class>
+    friend class HistogramShards;
+
     friend class boost::serialization::access;
+    /// \brief Serialization rule: save
+    ///
+    /// Only the axes and the filled cells of the underlying histogram are stored. If less than a half of the cells
+    /// are filled, the cells are written sparsely as (index, cell) pairs, otherwise all the cells are written.
     template<class Archive>
-    /// \brief Serialization rule
-    void serialize(Archive& ar, const unsigned int /*version*/)
+    void save(Archive& ar, const unsigned int /*version*/) const
     {
       ar& boost::serialization::base_object<TotalSums>(*this);
-      ar& fHistogram;
+      std::apply([&](const auto&... axis) { ((ar & axis), ...); }, bh::unsafe_access::axes(fHistogram));
+
+      const auto& cells = bh::unsafe_access::storage(fHistogram);
+      uint32_t nCells   = cells.size();
+      uint32_t nFilled  = std::count_if(cells.begin(), cells.end(), [](const Cell_t& c) { return c != Cell_t{}; });
+      bool bSparse      = 2 * nFilled < nCells;
+      ar& bSparse;
+      if (bSparse) {
+        ar& nFilled;
+        for (uint32_t iCell = 0; iCell < nCells; ++iCell) {
+          if (cells[iCell] != Cell_t{}) {
+            ar& iCell;
+            ar& cells[iCell];
+          }
+        }
+      }
+      else {
+        std::for_each(cells.begin(), cells.end(), [&](const Cell_t& c) { ar& c; });
+      }
       ar& fName;
       ar& fTitle;
       ar& fEntries;
       ar& fMetadata;
     }
+
+    /// \brief Serialization rule: load
+    template<class Archive>
+    void load(Archive& ar, const unsigned int /*version*/)
+    {
+      ar& boost::serialization::base_object<TotalSums>(*this);
+      Axes axes;
+      std::apply([&](auto&... axis) { ((ar & axis), ...); }, axes);
+      fHistogram = Hist_t(std::move(axes));
+
+      auto& cells     = bh::unsafe_access::storage(fHistogram);
+      uint32_t nCells = cells.size();
+      bool bSparse    = false;
+      ar& bSparse;
+      if (bSparse) {
+        uint32_t nFilled = 0;
+        ar& nFilled;
+        for (uint32_t iEntry = 0; iEntry < nFilled; ++iEntry) {
+          uint32_t iCell = 0;
+          Cell_t cell;
+          ar& iCell;
+          ar& cell;
+          if (iCell >= nCells) {
+            throw std::runtime_error(fmt::format("qa::Histogram: cell {} out of range ({} cells)", iCell, nCells));
+          }
+          cells[iCell] = cell;
+        }
+      }
+      else {
+        std::for_each(cells.begin(), cells.end(), [&](Cell_t& c) { ar& c; });
+      }
+      ar& fName;
+      ar& fTitle;
+      ar& fEntries;
+      ar& fMetadata;
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
   };
 
   using BaseH1D    = Histogram<Axes1D_t, HistStorage_t, TotalSums1D>;
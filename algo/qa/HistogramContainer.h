@@ -11,20 +11,26 @@
 
 #include "Histogram.h"  // for H1D, H2D
 
-#include <boost/serialization/forward_list.hpp>
+#include <boost/serialization/split_member.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <forward_list>
 
 namespace cbm::algo::qa
 {
   /// \struct HistogramContainer
   /// \brief  Structure to keep the histograms for sending them on the histogram server
+  ///
+  /// With fbSkipEmpty set, only the histograms filled since the last reset are serialized, so a message carries only
+  /// the updates since the previous emission. The histogram server adds them to the histograms it already holds.
   struct HistogramContainer {
-    std::forward_list<qa::H1D> fvH1    = {};  ///< List of 1D-histograms
-    std::forward_list<qa::H2D> fvH2    = {};  ///< List of 2D-histograms
-    std::forward_list<qa::Prof1D> fvP1 = {};  ///< List of 1D-profiles
-    std::forward_list<qa::Prof2D> fvP2 = {};  ///< List of 2D-profiles
-    uint64_t fTimesliceId              = 0;   ///< Index of the timeslice
+    std::forward_list<qa::H1D> fvH1    = {};     ///< List of 1D-histograms
+    std::forward_list<qa::H2D> fvH2    = {};     ///< List of 2D-histograms
+    std::forward_list<qa::Prof1D> fvP1 = {};     ///< List of 1D-profiles
+    std::forward_list<qa::Prof2D> fvP2 = {};     ///< List of 2D-profiles
+    uint64_t fTimesliceId              = 0;      ///< Index of the timeslice
+    bool fbSkipEmpty                   = false;  ///< Omit empty histograms in serialization (not serialized)
 
     /// \brief Resets the histograms
     void Reset();
@@ -32,13 +38,54 @@ namespace cbm::algo::qa
    private:
     friend class boost::serialization::access;
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int /*version*/)
+    void save(Archive& ar, const unsigned int /*version*/) const
     {
-      ar& fvH1;
-      ar& fvH2;
-      ar& fvP1;
-      ar& fvP2;
+      SaveList(ar, fvH1);
+      SaveList(ar, fvH2);
+      SaveList(ar, fvP1);
+      SaveList(ar, fvP2);
       ar& fTimesliceId;
     }
+
+    template<class Archive>
+    void load(Archive& ar, const unsigned int /*version*/)
+    {
+      LoadList(ar, fvH1);
+      LoadList(ar, fvH2);
+      LoadList(ar, fvP1);
+      LoadList(ar, fvP2);
+      ar& fTimesliceId;
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    /// \brief Saves a list of histograms, omitting the empty ones if requested
+    template<class Archive, class Histo>
+    void SaveList(Archive& ar, const std::forward_list<Histo>& list) const
+    {
+      auto IsSent = [&](const Histo& h) { return !fbSkipEmpty || !h.IsEmpty(); };
+
+      uint32_t nHistos = std::count_if(list.begin(), list.end(), IsSent);
+      ar& nHistos;
+      for (const auto& h : list) {
+        if (IsSent(h)) {
+          ar& h;
+        }
+      }
+    }
+
+    /// \brief Loads a list of histograms
+    template<class Archive, class Histo>
+    static void LoadList(Archive& ar, std::forward_list<Histo>& list)
+    {
+      uint32_t nHistos = 0;
+      ar& nHistos;
+      list.clear();
+      auto it = list.before_begin();
+      for (uint32_t iH = 0; iH < nHistos; ++iH) {
+        it = list.emplace_after(it);
+        ar&(*it);
+      }
+    }
   };
 }  // namespace cbm::algo::qa
@@ -0,0 +1,196 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/// \file   HistogramShards.h
+/// \brief  Per-thread shards of a QA histogram for filling from parallel regions
+
+#pragma once
+
+#include "Histogram.h"
+#include "compat/OpenMP.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cbm::algo::qa
+{
+  /// \class HistogramShardsBase
+  /// \brief Interface to merge shards of any histogram type
+  class HistogramShardsBase {
+   public:
+    /// \brief Destructor
+    virtual ~HistogramShardsBase() = default;
+
+    /// \brief Adds the content of all the shards to the histogram and resets the shards
+    virtual void Merge() = 0;
+  };
+
+  /// \class  HistogramShards
+  /// \brief  Per-thread copies of a histogram, which are added to the histogram on Merge()
+  /// \tparam Histo  Histogram type (H1D, H2D, Prof1D, Prof2D)
+  ///
+  /// Each thread fills its own shard, selected by the OpenMP thread number, so filling from a parallel region needs
+  /// no synchronization. Unweighted fills of H1D and H2D with Shard::Count() go to a plain counter per cell, which
+  /// avoids the generic boost::histogram fill and halves the memory traffic compared to the weighted storage.
+  ///
+  /// Usage: get the shard of a thread once with Local() and fill it in the loop:
+  ///
+  ///     auto& shard = shards.Local();
+  ///     for (...) shard.Count(x);  // or shard.GetHistogram().Fill(x, w) for weighted fills
+  ///
+  /// \note The number of shards is fixed on construction, the shards must not be filled from more threads.
+  template<class Histo>
+  class HistogramShards : public HistogramShardsBase {
+    static constexpr bool IsCounting = std::is_same_v<Histo, H1D> || std::is_same_v<Histo, H2D>;
+    static constexpr unsigned Rank   = std::is_same_v<Histo, H1D> || std::is_same_v<Histo, Prof1D> ? 1 : 2;
+
+   public:
+    /// \class Shard
+    /// \brief Histogram of a single thread, aligned to a cache line to avoid false sharing
+    class alignas(64) Shard {
+     public:
+      /// \brief Histogram of the shard, for weighted fills and profiles
+      Histo& GetHistogram() { return fHisto; }
+
+      /// \brief Unweighted fill of a 1D-histogram
+      /// \param x  Value
+      template<class H = Histo, std::enable_if_t<std::is_same_v<H, H1D>, bool> = true>
+      void Count(double x)
+      {
+        int iBin = FindBin(x, 0);
+        ++fvCounts[iBin];
+        if (iBin > 0 && iBin <= fNbins[0]) {
+          fSums[0] += 1.;
+          fSums[1] += x;
+          fSums[2] += x * x;
+        }
+        else {
+          ++fNofFlowEntries;
+        }
+      }
+
+      /// \brief Unweighted fill of a 2D-histogram
+      /// \param x  Value along x-axis
+      /// \param y  Value along y-axis
+      template<class H = Histo, std::enable_if_t<std::is_same_v<H, H2D>, bool> = true>
+      void Count(double x, double y)
+      {
+        int iBinX = FindBin(x, 0);
+        int iBinY = FindBin(y, 1);
+        ++fvCounts[iBinX + iBinY * (fNbins[0] + 2)];
+        if (iBinX > 0 && iBinX <= fNbins[0] && iBinY > 0 && iBinY <= fNbins[1]) {
+          fSums[0] += 1.;
+          fSums[1] += x;
+          fSums[2] += x * x;
+          fSums[3] += x * y;
+          fSums[4] += y;
+          fSums[5] += y * y;
+        }
+        else {
+          ++fNofFlowEntries;
+        }
+      }
+
+     private:
+      friend class HistogramShards;
+
+      /// \brief Bin index along an axis, including the underflow (0) and the overflow (nBins + 1) bins
+      int FindBin(double v, unsigned iAxis) const { return fAxes[iAxis].index(v) + 1; }
+
+      /// \brief Number of unweighted fills
+      double NofCounts() const { return fSums[0] + fNofFlowEntries; }
+
+      Histo fHisto;                           ///< Weighted fills
+      std::vector<uint32_t> fvCounts;         ///< Unweighted fills per cell (H1D and H2D only)
+      std::array<double, 6> fSums{};          ///< Sums of unweighted fills: w, w*x, w*x*x, w*x*y, w*y, w*y*y
+      double fNofFlowEntries = 0.;            ///< Number of unweighted fills in under- and overflow bins
+      std::array<RegularAxis_t, Rank> fAxes;  ///< Axes of the histogram
+      std::array<int, Rank> fNbins{};         ///< Number of bins along the axes
+    };
+
+    /// \brief Constructor
+    /// \param pHisto   Histogram, into which the shards are merged
+    /// \param nShards  Number of shards (maximal number of threads filling the histogram)
+    explicit HistogramShards(Histo* pHisto, int nShards = openmp::GetMaxThreads())
+      : fpHisto(pHisto)
+      , fvShards(nShards)
+    {
+      for (auto& shard : fvShards) {
+        shard.fHisto = *pHisto;
+        shard.fHisto.Reset();
+        if constexpr (IsCounting) {
+          shard.fvCounts.resize(bh::unsafe_access::storage(AsBase(shard.fHisto).fHistogram).size(), 0);
+          const auto& hist = AsBase(*pHisto).fHistogram;
+          shard.fAxes[0]   = hist.template axis<0>();
+          if constexpr (Rank > 1) {
+            shard.fAxes[1] = hist.template axis<1>();
+          }
+          for (unsigned iAxis = 0; iAxis < Rank; ++iAxis) {
+            shard.fNbins[iAxis] = shard.fAxes[iAxis].size();
+          }
+        }
+      }
+    }
+
+    /// \brief Shard of the calling thread
+    Shard& Local() { return fvShards[openmp::GetThreadNum()]; }
+
+    /// \brief Adds the content of all the shards to the histogram and resets the shards
+    void Merge() override
+    {
+      auto& target = AsBase(*fpHisto);
+      for (auto& shard : fvShards) {
+        if constexpr (IsCounting) {
+          if (shard.NofCounts() > 0) {
+            MergeCounts(shard, target);
+          }
+        }
+        if (!shard.fHisto.IsEmpty()) {
+          target.Add(shard.fHisto);
+          shard.fHisto.Reset();
+        }
+      }
+    }
+
+   private:
+    /// \brief Access to the histogram base class
+    template<class Axes, class Storage, class TotalSums>
+    static Histogram<Axes, Storage, TotalSums>& AsBase(Histogram<Axes, Storage, TotalSums>& h)
+    {
+      return h;
+    }
+
+    /// \brief Adds the unweighted fills of a shard to the histogram and resets them
+    template<class Target>
+    static void MergeCounts(Shard& shard, Target& target)
+    {
+      using Cell_t = typename Target::Cell_t;
+      auto& cells  = bh::unsafe_access::storage(target.fHistogram);
+      for (size_t iCell = 0; iCell < shard.fvCounts.size(); ++iCell) {
+        if (uint32_t n = shard.fvCounts[iCell]; n > 0) {
+          cells[iCell] += Cell_t(n, n);  // (sum of weights, sum of squared weights)
+          shard.fvCounts[iCell] = 0;
+        }
+      }
+      const auto& sums = shard.fSums;
+      target.fEntries += static_cast<int>(shard.NofCounts());
+      target.fTotSumW += sums[0];
+      target.fTotSumW2 += sums[0];
+      target.fTotSumWX += sums[1];
+      target.fTotSumWX2 += sums[2];
+      if constexpr (Rank > 1) {
+        target.fTotSumWXY += sums[3];
+        target.fTotSumWY += sums[4];
+        target.fTotSumWY2 += sums[5];
+      }
+      shard.fSums.fill(0.);
+      shard.fNofFlowEntries = 0.;
+    }
+
+    Histo* fpHisto = nullptr;     ///< Histogram, into which the shards are merged
+    std::vector<Shard> fvShards;  ///< Shards, one per thread
+  };
+}  // namespace cbm::algo::qa
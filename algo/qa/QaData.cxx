@@ -106,14 +106,28 @@ void Data::RegisterNewTask(std::string_view name)
                                                .fRangeP2 = std::make_pair(itP2, itP2)});
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//
+void Data::MergeShards()
+{
+  std::for_each(fvpShards.begin(), fvpShards.end(), [](auto& pShards) { pShards->Merge(); });
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 //
 void Data::Send(std::shared_ptr<HistogramSender> histoSender)
 {
   if (histoSender.get() && fbNotEmpty) {
-    histoSender->PrepareAndSendMsg(fHistograms, zmq::send_flags::none);
+    this->MergeShards();
+    // NOTE: If the message was dropped, the histograms are kept and their content is sent with the next emission
+    if (!histoSender->PrepareAndSendMsg(fHistograms, zmq::send_flags::none)) {
+      L_(warn) << fsTaskNames << ": Failed to publish histograms, keeping them until the next emission";
+      return;
+    }
     L_(info) << fsTaskNames << ": Published " << fNofH1 << " 1D- and " << fNofH2 << " 2D-histograms, " << fNofP1
              << " 1D- and " << fNofP2 << " 2D-profiles";
+    // The first emission contains all the histograms, so the server knows them, further ones only the filled ones
+    fHistograms.fbSkipEmpty = true;
     this->Reset();
   }
 }
@@ -13,6 +13,7 @@
 #include "base/HistogramSender.h"
 #include "qa/CanvasConfig.h"
 #include "qa/HistogramContainer.h"
+#include "qa/HistogramShards.h"
 #include "qa/TaskProperties.h"
 
 #include <boost/serialization/forward_list.hpp>
@@ -65,12 +66,28 @@ namespace cbm::algo::qa
     template<class Obj, typename... Args>
     Obj* MakeObj(Args... args);
 
+    /// \brief  Creates per-thread shards of a QA-object, to fill it from a parallel region
+    /// \tparam Obj   A type of the histogram (H1D, H2D, Prof1D, Prof2D)
+    /// \param  pObj  A pointer to the QA-object, created with MakeObj
+    /// \note   The shards are merged into the QA-object on Send()
+    template<class Obj>
+    HistogramShards<Obj>* MakeShards(Obj* pObj)
+    {
+      auto pShards = std::make_shared<HistogramShards<Obj>>(pObj);
+      fvpShards.push_back(pShards);
+      return pShards.get();
+    }
+
+    /// \brief Merges the content of the per-thread shards into the QA-objects
+    void MergeShards();
+
     /// \brief Resets the histograms
     void Reset() { fHistograms.Reset(); }
 
     /// \brief Sends QA data to the HistogramSender
     /// \param histoSender  A pointer to the histogram sender
-    /// \note  Calls this->Reset() after sending the message to the histogram server
+    /// \note  Calls this->Reset() after sending the message to the histogram server. Only the histograms filled since
+    ///        the previous emission are sent, except for the first emission, which contains all the histograms.
     void Send(std::shared_ptr<HistogramSender> histoSender);
 
     /// \brief Updates the timeslice index
@@ -87,6 +104,8 @@ namespace cbm::algo::qa
     std::vector<qa::TaskProperties> fvTaskProperties;  ///< A vector to store properties for multiple QA-tasks
     std::vector<std::string> fvsCanvCfgs = {};         ///< Vector of canvas configs
 
+    std::vector<std::shared_ptr<HistogramShardsBase>> fvpShards = {};  ///< Per-thread shards of the QA-objects
+
     uint32_t fNofH1{0};     ///< Number of 1D-histograms
     uint32_t fNofH2{0};     ///< Number of 2D-histograms
     uint32_t fNofP1{0};     ///< Number of 1D-profiles
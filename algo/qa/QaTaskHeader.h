@@ -71,6 +71,15 @@ namespace cbm::algo::qa
       return fpData->MakeObj<Obj>(args...);
     }
 
+    /// \brief  Creates per-thread shards of a QA-object, to fill it from a parallel region
+    /// \tparam Obj   A type of the histogram (H1D, H2D, Prof1D, Prof2D)
+    /// \param  pObj  A pointer to the QA-object, created with MakeObj
+    template<class Obj>
+    HistogramShards<Obj>* MakeShards(Obj* pObj)
+    {
+      return fpData->MakeShards(pObj);
+    }
+
    private:
     std::string fsName{};                   ///< Name of the task
     std::shared_ptr<Data> fpData{nullptr};  ///< An instance of the QA data (shared between different tasks)
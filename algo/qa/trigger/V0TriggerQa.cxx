@@ -24,6 +24,9 @@ void V0TriggerQa::Init()
                                     kPairZVertexL, kPairZVertexU);
   fphPairDca     = MakeObj<qa::H1D>("v0trigger_pair_dca", "Track pair distance of closest approach;DCA [cm];Counts",
                                 kPairDcaB, kPairDcaL, kPairDcaU);
+  fpPairDeltaTShards  = MakeShards(fphPairDeltaT);
+  fpPairZVertexShards = MakeShards(fphPairZVertex);
+  fpPairDcaShards     = MakeShards(fphPairDca);
 
   // Canvas
   auto canv = qa::CanvasConfig(GetTaskName(), "V0 Trigger summary", 3, 1);
@@ -9,13 +9,9 @@
 
 #pragma once
 
+#include "qa/HistogramShards.h"
 #include "qa/QaTaskHeader.h"
 
-namespace cbm::algo::qa
-{
-  class H1D;
-}  // namespace cbm::algo::qa
-
 
 namespace cbm::algo::evbuild
 {
@@ -64,5 +60,10 @@ namespace cbm::algo::evbuild
     qa::H1D* fphPairDeltaT{nullptr};   ///< Track pair delta T
     qa::H1D* fphPairZVertex{nullptr};  ///< Track pair z-vertex
     qa::H1D* fphPairDca{nullptr};      ///< Track pair distance at closest approach
+
+    //* Per-thread shards of the histograms, filled by the trigger
+    qa::HistogramShards<qa::H1D>* fpPairDeltaTShards{nullptr};   ///< Track pair delta T
+    qa::HistogramShards<qa::H1D>* fpPairZVertexShards{nullptr};  ///< Track pair z-vertex
+    qa::HistogramShards<qa::H1D>* fpPairDcaShards{nullptr};      ///< Track pair distance at closest approach
   };
 }  // namespace cbm::algo::evbuild
@@ -0,0 +1,453 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CaCloneMerger.h"
+#include "CaParameters.h"
+#include "CaTrack.h"
+#include "CaVector.h"
+#include "KfTrackKalmanFilter.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace cbm::algo;
+using namespace cbm::algo::ca;
+
+namespace cbm::algo::ca
+{
+  /// \brief Access to the steps of the clone merger
+  class CloneMergerTest {
+   public:
+    using Candidate = CloneMerger::Candidate;
+
+    static const Vector<Candidate>& CollectCandidates(CloneMerger& merger, const Vector<Track>& tracks,
+                                                      const Vector<unsigned short>& firstStation,
+                                                      const Vector<unsigned short>& lastStation, int nStations,
+                                                      unsigned char maxLengthForMerge)
+    {
+      merger.CollectCandidates(tracks, firstStation, lastStation, nStations, maxLengthForMerge);
+      return merger.fCandidates;
+    }
+
+    static const Vector<Candidate>& MergeTracks(CloneMerger& merger, Vector<Track>& tracks,
+                                                Vector<HitIndex_t>& recoHits,
+                                                const Vector<unsigned short>& firstStation,
+                                                const Vector<unsigned short>& lastStation,
+                                                const StationsContainer_t<fvec>& stations, int nStations)
+    {
+      merger.MergeTracks(tracks, recoHits, firstStation, lastStation, stations, nStations);
+      return merger.fCandidates;
+    }
+
+    static void FilterTracks(fvec const r[5], fvec const C[15], fvec const m[5], fvec const V[15], fvec* chi2)
+    {
+      CloneMerger::FilterTracks(r, C, m, V, nullptr, nullptr, chi2);
+    }
+  };
+}  // namespace cbm::algo::ca
+
+namespace
+{
+  constexpr int NofStations = 12;
+
+  struct Input {
+    Vector<Track> tracks{"Input::tracks"};
+    Vector<unsigned short> firstStation{"Input::firstStation"};
+    Vector<unsigned short> lastStation{"Input::lastStation"};
+    Vector<HitIndex_t> recoHits{"Input::recoHits"};
+  };
+
+  /// \brief Random short tracks, partially without time, with overlapping time windows
+  Input MakeInput(unsigned seed, int nTracks)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> station(0, NofStations - 1);
+    std::uniform_int_distribution<int> nHits(3, NofStations);
+    std::uniform_real_distribution<float> time(0.f, 500.f);
+    std::uniform_real_distribution<float> sigmaT(0.5f, 5.f);
+    std::bernoulli_distribution timed(0.8);
+
+    auto setTime = [&](Track::TrackParam_t& par) {
+      const float sigma = sigmaT(gen);
+      par.SetTime(time(gen));
+      par.SetC55(sigma * sigma);
+      par.SetNdfTime(timed(gen) ? 1.f : -2.f);
+    };
+
+    Input input;
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      int sta1 = station(gen);
+      int sta2 = station(gen);
+      Track track;
+      track.fNofHits = nHits(gen);
+      setTime(track.fParFirst);
+      setTime(track.fParLast);
+      input.tracks.push_back_no_warning(track);
+      input.firstStation.push_back_no_warning(std::min(sta1, sta2));
+      input.lastStation.push_back_no_warning(std::max(sta1, sta2));
+    }
+    return input;
+  }
+
+  /// \brief Candidates of the original algorithm, which tests all the pairs of tracks
+  std::vector<std::pair<int, int>> CollectAllPairs(const Input& input, unsigned char maxLengthForMerge)
+  {
+    std::vector<std::pair<int, int>> candidates;
+    const int nTracks = input.tracks.size();
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      if (input.tracks[iTr].fNofHits > maxLengthForMerge) continue;
+      for (int jTr = 0; jTr < nTracks; jTr++) {
+        if (input.tracks[jTr].fNofHits > maxLengthForMerge) continue;
+        if (iTr == jTr) continue;
+        if (input.firstStation[iTr] <= input.lastStation[jTr]) continue;
+
+        const auto& Tb = input.tracks[iTr].fParFirst;
+        const auto& Tf = input.tracks[jTr].fParLast;
+        if (Tf.NdfTime() >= 0. && Tb.NdfTime() >= 0.) {
+          if (std::fabs(Tf.GetTime() - Tb.GetTime()) > 3 * std::sqrt(Tf.C55() + Tb.C55())) continue;
+        }
+        candidates.emplace_back(iTr, jTr);
+      }
+    }
+    return candidates;
+  }
+
+  std::vector<std::pair<int, int>> CollectBucketed(CloneMerger& merger, const Input& input,
+                                                   unsigned char maxLengthForMerge)
+  {
+    const auto& collected = CloneMergerTest::CollectCandidates(merger, input.tracks, input.firstStation,
+                                                               input.lastStation, NofStations, maxLengthForMerge);
+    std::vector<std::pair<int, int>> candidates;
+    for (const auto& candidate : collected) {
+      candidates.emplace_back(candidate.iTr, candidate.jTr);
+    }
+    return candidates;
+  }
+
+  /// \brief Stations every 30 cm in a field, which varies in x, y and z
+  std::unique_ptr<StationsContainer_t<fvec>> MakeStations()
+  {
+    auto field = [](double x, double y, double z) {
+      return std::make_tuple(0.1 * y, -2. - 0.02 * x + 0.005 * z, 0.05 * x * y / 100.);
+    };
+    auto stations = std::make_unique<StationsContainer_t<fvec>>();
+    for (int iSt = 0; iSt < NofStations; iSt++) {
+      auto& station      = (*stations)[iSt];
+      station.fZ         = 30.f + 30.f * iSt;
+      station.fieldSlice = kf::FieldSlice<fvec>(field, 50., 50., 30. + 30. * iSt);
+    }
+    return stations;
+  }
+
+  /// \brief Tracks split into an upstream and a downstream segment, and single tracks. The segments are straight
+  ///        lines, so their chi2 is small but not zero. Some track parameters are off the station z.
+  Input MakeSegments(std::mt19937& gen, const StationsContainer_t<fvec>& stations, int nParticles)
+  {
+    std::uniform_real_distribution<float> pos(-20.f, 20.f);
+    std::uniform_real_distribution<float> slope(-0.2f, 0.2f);
+    std::uniform_real_distribution<float> qp(-0.3f, 0.3f);
+    std::uniform_real_distribution<float> time(0.f, 100.f);
+    std::uniform_int_distribution<int> station(0, NofStations - 1);
+    std::normal_distribution<float> noise(0.f, 1.f);
+    std::bernoulli_distribution offStation(0.3);
+    std::bernoulli_distribution split(0.7);
+
+    Input input;
+    auto addTrack = [&](int first, int last, float x0, float y0, float tx, float ty, float q, float t0) {
+      auto setPar = [&](Track::TrackParam_t& par, int iSt) {
+        const float z = stations[iSt].fZ[0] + (offStation(gen) ? 0.5f * noise(gen) : 0.f);
+        par.SetZ(z);
+        par.SetX(x0 + tx * z + 0.05f * noise(gen));
+        par.SetY(y0 + ty * z + 0.05f * noise(gen));
+        par.SetTx(tx + 0.002f * noise(gen));
+        par.SetTy(ty + 0.002f * noise(gen));
+        par.SetQp(q + 0.01f * noise(gen));
+        par.SetTime(t0 + 0.033f * z + noise(gen));
+        par.SetVi(kf::defs::SpeedOfLightInv<float>);
+        par.ResetCovMatrix();
+        par.SetC00(0.01f);
+        par.SetC11(0.01f);
+        par.SetC22(1.e-4f);
+        par.SetC33(1.e-4f);
+        par.SetC44(1.e-3f);
+        par.SetC55(4.f);
+        par.SetC66(1.e-6f);
+        par.SetNdfTime(1.f);
+      };
+      Track track;
+      track.fNofHits = last - first + 1;
+      setPar(track.fParFirst, first);
+      setPar(track.fParLast, last);
+      input.tracks.push_back_no_warning(track);
+      input.firstStation.push_back_no_warning(first);
+      input.lastStation.push_back_no_warning(last);
+    };
+
+    for (int iParticle = 0; iParticle < nParticles; iParticle++) {
+      int first      = station(gen);
+      int last       = station(gen);
+      const float x0 = pos(gen);
+      const float y0 = pos(gen);
+      const float tx = slope(gen);
+      const float ty = slope(gen);
+      const float q  = qp(gen);
+      const float t0 = time(gen);
+      if (first > last) std::swap(first, last);
+      if (last - first < 2) continue;  // A track has at least three hits
+      if (last - first >= 5 && split(gen)) {
+        const int gap = std::uniform_int_distribution<int>(first + 3, last - 2)(gen);
+        addTrack(gap, last, x0, y0, tx, ty, q, t0);
+        addTrack(first, gap - 1, x0, y0, tx, ty, q, t0);
+      }
+      else {
+        addTrack(first, last, x0, y0, tx, ty, q, t0);
+      }
+    }
+
+    for (const auto& track : input.tracks) {
+      for (int iHit = 0; iHit < track.fNofHits; iHit++) {
+        input.recoHits.push_back_no_warning(input.recoHits.size());
+      }
+    }
+    return input;
+  }
+
+  /// \brief The original merging loop, which calculates the chi2 of each pair of tracks on its own
+  /// \param  chi2  Output: chi2 of each pair, which passes the station and time cuts
+  void MergeWithPairLoop(Vector<Track>& extTracks, Vector<HitIndex_t>& extRecoHits, const Input& input,
+                         const StationsContainer_t<fvec>& stations, std::map<std::pair<int, int>, fscal>& chi2)
+  {
+    const int nTracks                     = extTracks.size();
+    constexpr unsigned short kNoNeighbour = std::numeric_limits<unsigned short>::max();
+
+    std::vector<HitIndex_t> firstHit(nTracks);
+    std::vector<HitIndex_t> lastHit(nTracks);
+    std::vector<unsigned short> neighbour(nTracks, kNoNeighbour);
+    std::vector<fscal> trackChi2(nTracks, 100000.);
+    std::vector<char> isStored(nTracks, false);
+    std::vector<char> isDownstreamNeighbour(nTracks, false);
+    const auto& firstStation = input.firstStation;
+    const auto& lastStation  = input.lastStation;
+
+    HitIndex_t start_hit = 0;
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      firstHit[iTr] = start_hit;
+      start_hit += extTracks[iTr].fNofHits - 1;
+      lastHit[iTr] = start_hit;
+      start_hit++;
+    }
+
+    kf::TrackKalmanFilter<fvec> fitB;
+    fitB.SetParticleMass(constants::phys::MuonMass);
+    fitB.SetMask(fmask::One());
+    fitB.SetQp0(fvec(0.));
+
+    kf::TrackKalmanFilter<fvec> fitF;
+    fitF.SetParticleMass(constants::phys::MuonMass);
+    fitF.SetMask(fmask::One());
+    fitF.SetQp0(fvec(0.));
+
+    TrackParamV& Tb = fitB.Tr();
+    TrackParamV& Tf = fitF.Tr();
+    kf::FieldValue<fvec> fBm, fBb, fBf _fvecalignment;
+    kf::FieldRegion<fvec> fld _fvecalignment;
+
+    const unsigned char maxLengthForMerge = NofStations - 3;
+
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      if (extTracks[iTr].fNofHits > maxLengthForMerge) continue;
+      for (int jTr = 0; jTr < nTracks; jTr++) {
+        if (extTracks[jTr].fNofHits > maxLengthForMerge) continue;
+        if (iTr == jTr) continue;
+        if (firstStation[iTr] <= lastStation[jTr]) continue;
+
+        unsigned short stab = firstStation[iTr];
+        Tb.Set(extTracks[iTr].fParFirst);
+        fitB.SetQp0(fitB.Tr().GetQp());
+
+        unsigned short staf = lastStation[jTr];
+        Tf.Set(extTracks[jTr].fParLast);
+        fitF.SetQp0(fitF.Tr().GetQp());
+
+        if (Tf.NdfTime()[0] >= 0. && Tb.NdfTime()[0] >= 0.) {
+          if (fabs(Tf.GetTime()[0] - Tb.GetTime()[0]) > 3 * sqrt(Tf.C55()[0] + Tb.C55()[0])) continue;
+        }
+
+        fBf = stations[staf].fieldSlice.GetFieldValue(Tf.X(), Tf.Y());
+        fBb = stations[stab].fieldSlice.GetFieldValue(Tb.X(), Tb.Y());
+
+        unsigned short stam = (stab - staf > 1) ? staf + 1 : staf - 1;
+
+        fvec zm = stations[stam].fZ;
+        fvec xm = fvec(0.5) * (Tf.GetX() + Tf.Tx() * (zm - Tf.Z()) + Tb.GetX() + Tb.Tx() * (zm - Tb.Z()));
+        fvec ym = fvec(0.5) * (Tf.Y() + Tf.Ty() * (zm - Tf.Z()) + Tb.Y() + Tb.Ty() * (zm - Tb.Z()));
+        fBm     = stations[stam].fieldSlice.GetFieldValue(xm, ym);
+        fld.Set(fBb, Tb.Z(), fBm, zm, fBf, Tf.Z());
+
+        fvec zMiddle = fvec(0.5) * (Tb.Z() + Tf.Z());
+
+        fitF.Extrapolate(zMiddle, fld);
+        fitB.Extrapolate(zMiddle, fld);
+
+        fvec Chi2Tracks(0.);
+        CloneMergerTest::FilterTracks(&(Tf.X()), &(Tf.C00()), &(Tb.X()), &(Tb.C00()), &Chi2Tracks);
+        chi2[{iTr, jTr}] = Chi2Tracks[0];
+        if (Chi2Tracks[0] > 50) continue;
+
+        if (Chi2Tracks[0] < trackChi2[iTr] || Chi2Tracks[0] < trackChi2[jTr]) {
+          if (neighbour[iTr] < kNoNeighbour) {
+            neighbour[neighbour[iTr]]             = kNoNeighbour;
+            trackChi2[neighbour[iTr]]             = 100000.;
+            isDownstreamNeighbour[neighbour[iTr]] = false;
+          }
+          if (neighbour[jTr] < kNoNeighbour) {
+            neighbour[neighbour[jTr]]             = kNoNeighbour;
+            trackChi2[neighbour[jTr]]             = 100000.;
+            isDownstreamNeighbour[neighbour[jTr]] = false;
+          }
+          neighbour[iTr]             = jTr;
+          neighbour[jTr]             = iTr;
+          trackChi2[iTr]             = Chi2Tracks[0];
+          trackChi2[jTr]             = Chi2Tracks[0];
+          isDownstreamNeighbour[iTr] = true;
+          isDownstreamNeighbour[jTr] = false;
+        }
+      }
+    }
+
+    Vector<Track> tracksNew;
+    Vector<HitIndex_t> recoHitsNew;
+    for (int iTr = 0; iTr < nTracks; iTr++) {
+      if (isStored[iTr]) continue;
+
+      tracksNew.push_back_no_warning(extTracks[iTr]);
+      if (!isDownstreamNeighbour[iTr]) {
+        for (HitIndex_t HI = firstHit[iTr]; HI <= lastHit[iTr]; HI++) {
+          recoHitsNew.push_back_no_warning(extRecoHits[HI]);
+        }
+      }
+
+      if (neighbour[iTr] < kNoNeighbour) {
+        isStored[neighbour[iTr]] = true;
+        tracksNew.back().fNofHits += extTracks[neighbour[iTr]].fNofHits;
+        for (HitIndex_t HI = firstHit[neighbour[iTr]]; HI <= lastHit[neighbour[iTr]]; HI++)
+          recoHitsNew.push_back_no_warning(extRecoHits[HI]);
+      }
+
+      if (isDownstreamNeighbour[iTr]) {
+        for (HitIndex_t HI = firstHit[iTr]; HI <= lastHit[iTr]; HI++) {
+          recoHitsNew.push_back_no_warning(extRecoHits[HI]);
+        }
+      }
+    }
+    extTracks   = std::move(tracksNew);
+    extRecoHits = std::move(recoHitsNew);
+  }
+}  // namespace
+
+TEST(_GTestCaCloneMerger, BucketedCandidatesEqualAllPairs)
+{
+  Parameters<fvec> parameters;
+  CloneMerger merger(parameters, constants::phys::MuonMass);
+  const unsigned char maxLengthForMerge = NofStations - 3;
+
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    Input input = MakeInput(seed, 200);
+    auto expected = CollectAllPairs(input, maxLengthForMerge);
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(CollectBucketed(merger, input, maxLengthForMerge), expected) << "seed " << seed;
+  }
+}
+
+TEST(_GTestCaCloneMerger, BucketedCandidatesAtTimeWindowEdge)
+{
+  Parameters<fvec> parameters;
+  CloneMerger merger(parameters, constants::phys::MuonMass);
+  const unsigned char maxLengthForMerge = NofStations - 3;
+
+  // A downstream track and upstream tracks with the time difference just inside and outside of the 3-sigma cut, and
+  // an upstream track with a large time error, which widens the window of its station
+  Input input;
+  auto addTrack = [&](int first, int last, float time, float c55) {
+    Track track;
+    track.fNofHits = 3;
+    for (auto* par : {&track.fParFirst, &track.fParLast}) {
+      par->SetTime(time);
+      par->SetC55(c55);
+      par->SetNdfTime(1.f);
+    }
+    input.tracks.push_back_no_warning(track);
+    input.firstStation.push_back_no_warning(first);
+    input.lastStation.push_back_no_warning(last);
+  };
+  addTrack(6, 8, 100.f, 1.f);
+  for (float dt : {-8.49f, -8.48f, 8.48f, 8.49f, 0.f}) {
+    addTrack(1, 3, 100.f + dt, 7.f);
+  }
+  addTrack(1, 3, 150.f, 2500.f);
+  addTrack(0, 5, 400.f, 1.f);
+
+  auto expected = CollectAllPairs(input, maxLengthForMerge);
+  EXPECT_EQ(expected.size(), 4u);
+  EXPECT_EQ(CollectBucketed(merger, input, maxLengthForMerge), expected);
+
+  // Repeated calls reuse the internal buffers
+  input.tracks[0].fParFirst.SetNdfTime(-2.f);
+  expected = CollectAllPairs(input, maxLengthForMerge);
+  EXPECT_EQ(expected.size(), 7u);
+  EXPECT_EQ(CollectBucketed(merger, input, maxLengthForMerge), expected);
+}
+
+TEST(_GTestCaCloneMerger, MergedTracksEqualPairLoop)
+{
+  Parameters<fvec> parameters;
+  CloneMerger merger(parameters, constants::phys::MuonMass);
+  auto stations = MakeStations();
+
+  std::mt19937 gen(11);
+  int nMerged = 0;
+  for (int iTrial = 0; iTrial < 5; iTrial++) {
+    SCOPED_TRACE(iTrial);
+    const Input input = MakeSegments(gen, *stations, 150);
+
+    std::map<std::pair<int, int>, fscal> expectedChi2;
+    Vector<Track> expectedTracks    = input.tracks;
+    Vector<HitIndex_t> expectedHits = input.recoHits;
+    MergeWithPairLoop(expectedTracks, expectedHits, input, *stations, expectedChi2);
+
+    Vector<Track> tracks    = input.tracks;
+    Vector<HitIndex_t> hits = input.recoHits;
+    const auto& candidates  = CloneMergerTest::MergeTracks(merger, tracks, hits, input.firstStation,
+                                                           input.lastStation, *stations, NofStations);
+
+    // The chi2 of each pair is the same as calculated on its own
+    ASSERT_EQ(candidates.size(), expectedChi2.size());
+    for (const auto& candidate : candidates) {
+      auto it = expectedChi2.find({candidate.iTr, candidate.jTr});
+      ASSERT_NE(it, expectedChi2.end());
+      EXPECT_EQ(candidate.chi2, it->second) << "pair " << candidate.iTr << ", " << candidate.jTr;
+    }
+
+    // The same tracks are merged, with the hits in the same order
+    ASSERT_EQ(tracks.size(), expectedTracks.size());
+    for (size_t iTr = 0; iTr < tracks.size(); iTr++) {
+      EXPECT_EQ(tracks[iTr].fNofHits, expectedTracks[iTr].fNofHits) << "track " << iTr;
+      EXPECT_EQ(tracks[iTr].fParFirst.Z(), expectedTracks[iTr].fParFirst.Z()) << "track " << iTr;
+      EXPECT_EQ(tracks[iTr].fParFirst.X(), expectedTracks[iTr].fParFirst.X()) << "track " << iTr;
+    }
+    ASSERT_EQ(hits.size(), expectedHits.size());
+    for (size_t iHit = 0; iHit < hits.size(); iHit++) {
+      EXPECT_EQ(hits[iHit], expectedHits[iHit]) << "hit " << iHit;
+    }
+    nMerged += input.tracks.size() - tracks.size();
+  }
+  EXPECT_GT(nMerged, 0);
+}
@@ -0,0 +1,122 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CommonUnpacker.h"
+#include "compat/OpenMP.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace cbm::algo;
+
+namespace
+{
+  struct Element {
+    int time;
+    int index;  ///< Position in the input, to check the stability of the merge
+  };
+
+  bool TimeLess(const Element& a, const Element& b) { return a.time < b.time; }
+
+  /// \brief Random runs, sorted by time, with the given sizes. Small time ranges give equal times across runs.
+  PODVector<Element> MakeRuns(std::mt19937& gen, const std::vector<size_t>& sizes, int maxTime,
+                              std::vector<size_t>& runs)
+  {
+    std::uniform_int_distribution<int> time(0, maxTime);
+    PODVector<Element> data;
+    runs.clear();
+    for (size_t size : sizes) {
+      runs.push_back(data.size());
+      for (size_t i = 0; i < size; i++) {
+        data.push_back({time(gen), 0});
+      }
+      std::sort(data.begin() + runs.back(), data.end(), TimeLess);
+    }
+    runs.push_back(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i].index = i;
+    }
+    return data;
+  }
+
+  /// \brief Merge the runs and compare to a stable sort of the whole input
+  void ExpectMergeEqualsStableSort(std::mt19937& gen, const std::vector<size_t>& sizes, int maxTime)
+  {
+    std::vector<size_t> runs;
+    PODVector<Element> data = MakeRuns(gen, sizes, maxTime, runs);
+    PODVector<Element> expected(data.begin(), data.end());
+    std::stable_sort(expected.begin(), expected.end(), TimeLess);
+
+    PODVector<Element> buffer;
+    detail::MergeRuns(data, runs, buffer, TimeLess);
+    ASSERT_EQ(data.size(), expected.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      ASSERT_EQ(data[i].time, expected[i].time) << "element " << i << " of " << sizes.size() << " runs";
+      ASSERT_EQ(data[i].index, expected[i].index) << "element " << i << " of " << sizes.size() << " runs";
+    }
+  }
+}  // namespace
+
+TEST(_GTestCommonUnpacker, MergeRunBoundaries)
+{
+  std::mt19937 gen(1);
+
+  // No runs, only empty runs, a single run
+  ExpectMergeEqualsStableSort(gen, {}, 100);
+  ExpectMergeEqualsStableSort(gen, {0, 0, 0}, 100);
+  ExpectMergeEqualsStableSort(gen, {50}, 100);
+  ExpectMergeEqualsStableSort(gen, {0, 50, 0}, 100);
+
+  // Odd numbers of runs leave a run without partner in a merge round
+  ExpectMergeEqualsStableSort(gen, {10, 20, 30}, 100);
+  ExpectMergeEqualsStableSort(gen, {5, 0, 7, 0, 0, 9, 1}, 100);
+  ExpectMergeEqualsStableSort(gen, {1, 1, 1, 1, 1, 1, 1, 1, 1}, 100);
+
+  // Equal times across runs, including runs of a single time
+  ExpectMergeEqualsStableSort(gen, {100, 100, 100, 100, 100}, 3);
+  ExpectMergeEqualsStableSort(gen, {100, 100, 100}, 0);
+}
+
+TEST(_GTestCommonUnpacker, MergeRunsThatContinueEachOther)
+{
+  // Runs whose first element is not before the last element of the previous run are not merged, but must stay intact
+  PODVector<Element> data;
+  for (int i = 0; i < 30; i++) {
+    data.push_back({i / 2, i});
+  }
+  std::vector<size_t> runs{0, 10, 10, 20, 30};
+  PODVector<Element> buffer;
+  detail::MergeRuns(data, runs, buffer, TimeLess);
+  for (int i = 0; i < 30; i++) {
+    EXPECT_EQ(data[i].index, i);
+  }
+}
+
+TEST(_GTestCommonUnpacker, MergeRandomRuns)
+{
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<size_t> nRuns(1, 300);
+  std::uniform_int_distribution<size_t> runSize(0, 2000);
+  std::bernoulli_distribution empty(0.1);
+  for (int iTrial = 0; iTrial < 20; iTrial++) {
+    std::vector<size_t> sizes(nRuns(gen));
+    for (auto& size : sizes) {
+      size = empty(gen) ? 0 : runSize(gen);
+    }
+    ExpectMergeEqualsStableSort(gen, sizes, iTrial % 2 ? 1000 : 1000000);
+  }
+}
+
+TEST(_GTestCommonUnpacker, MergeSlicesOfLargeRuns)
+{
+  // Runs larger than a slice of the merge path, so the merges of the last rounds are split between the threads
+  const int nThreads = openmp::GetMaxThreads();
+  openmp::SetNumThreads(4);
+  std::mt19937 gen(3);
+  ExpectMergeEqualsStableSort(gen, {100000, 70000, 0, 130000}, 1000);
+  ExpectMergeEqualsStableSort(gen, {200000, 1, 200000, 5, 90000}, 50);
+  openmp::SetNumThreads(nThreads);
+}
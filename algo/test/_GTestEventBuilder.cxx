@@ -87,3 +87,103 @@ TEST(_GTestEventBuilder, CheckEventBuilderAlgorithmSimple)
   EXPECT_EQ(monitor.fsd.nDigis, nInput);
   EXPECT_EQ(monitor.bmon.nDigis, nInput);
 }
+
+TEST(_GTestEventBuilder, CheckEventBuilderOverlappingWindows)
+{
+  SCOPED_TRACE("CheckEventBuilderOverlappingWindows");
+
+  YAML::Node configNode;
+  configNode[ToString(ECbmModuleId::kSts)] = std::pair<double, double>{-25., 40.};
+  configNode[ToString(ECbmModuleId::kTof)] = std::pair<double, double>{0., 100.};
+  cbm::algo::evbuild::EventBuilderConfig config(configNode);
+  cbm::algo::evbuild::EventBuilder evbuild(config);
+
+  DigiData tsIn;
+  const uint nInput = 1000;
+  for (uint i = 0; i < nInput; i++) {
+    tsIn.fSts.push_back(CbmStsDigi(268502050, 1, i * 3.0 + (i % 7) * 0.1, 1.0));
+    tsIn.fTof.push_back(CbmTofDigi(1111, i * 5.0, 1.0));
+  }
+
+  // Irregular, overlapping trigger windows
+  std::vector<double> triggerIn;
+  for (double t = -50.; t < 5500.; t += 7.5 + static_cast<int>(t) % 11) {
+    triggerIn.push_back(t);
+  }
+
+  auto ranges = evbuild.BuildRanges(tsIn, triggerIn);
+  auto result = evbuild(tsIn, triggerIn, std::nullopt);
+  ASSERT_EQ(ranges.size(), triggerIn.size());
+  ASSERT_EQ(result.first.size(), triggerIn.size());
+
+  // Compare with a brute force count of the digis in each window
+  for (size_t i = 0; i < triggerIn.size(); i++) {
+    auto inWindow = [&](double tMin, double tMax) {
+      return [=](const auto& digi) { return digi.GetTime() >= tMin && digi.GetTime() <= tMax; };
+    };
+    size_t nSts = std::count_if(tsIn.fSts.begin(), tsIn.fSts.end(), inWindow(triggerIn[i] - 25., triggerIn[i] + 40.));
+    size_t nTof = std::count_if(tsIn.fTof.begin(), tsIn.fTof.end(), inWindow(triggerIn[i], triggerIn[i] + 100.));
+    EXPECT_EQ(ranges[i].Size(ECbmModuleId::kSts), nSts);
+    EXPECT_EQ(ranges[i].Size(ECbmModuleId::kTof), nTof);
+    EXPECT_EQ(result.first[i].fSts.size(), nSts);
+    EXPECT_EQ(result.first[i].fTof.size(), nTof);
+    if (nSts > 0) {
+      EXPECT_EQ(result.first[i].fSts.front().GetTime(), tsIn.fSts[ranges[i].fSts.first].GetTime());
+    }
+  }
+}
+
+TEST(_GTestEventBuilder, CheckEventBuilderUnsortedTriggers)
+{
+  SCOPED_TRACE("CheckEventBuilderUnsortedTriggers");
+
+  YAML::Node configNode;
+  configNode[ToString(ECbmModuleId::kSts)] = std::pair<double, double>{-25., 40.};
+  configNode[ToString(ECbmModuleId::kTof)] = std::pair<double, double>{0., 100.};
+  cbm::algo::evbuild::EventBuilderConfig config(configNode);
+  cbm::algo::evbuild::EventBuilder evbuild(config);
+
+  DigiData tsIn;
+  const uint nInput = 1000;
+  for (uint i = 0; i < nInput; i++) {
+    tsIn.fSts.push_back(CbmStsDigi(268502050, 1, i * 3.0 + (i % 7) * 0.1, 1.0));
+    tsIn.fTof.push_back(CbmTofDigi(1111, i * 5.0, 1.0));
+  }
+
+  // Out-of-order, overlapping triggers with duplicates, as produced by the V0 trigger (pair order)
+  std::vector<double> triggerIn;
+  for (uint i = 0; i < 400; i++) {
+    triggerIn.push_back((i * 379) % 5300 - 50. + (i % 3) * 0.5);
+  }
+  triggerIn.push_back(triggerIn[17]);
+  triggerIn.push_back(triggerIn[5]);
+
+  std::vector<double> triggerSorted = triggerIn;
+  std::sort(triggerSorted.begin(), triggerSorted.end());
+  auto rangesSorted = evbuild.BuildRanges(tsIn, triggerSorted);
+
+  auto ranges = evbuild.BuildRanges(tsIn, triggerIn);
+  auto result = evbuild(tsIn, triggerIn, std::nullopt);
+  ASSERT_EQ(ranges.size(), triggerIn.size());
+  ASSERT_EQ(result.first.size(), triggerIn.size());
+
+  for (size_t i = 0; i < triggerIn.size(); i++) {
+    auto inWindow = [&](double tMin, double tMax) {
+      return [=](const auto& digi) { return digi.GetTime() >= tMin && digi.GetTime() <= tMax; };
+    };
+    size_t nSts = std::count_if(tsIn.fSts.begin(), tsIn.fSts.end(), inWindow(triggerIn[i] - 25., triggerIn[i] + 40.));
+    size_t nTof = std::count_if(tsIn.fTof.begin(), tsIn.fTof.end(), inWindow(triggerIn[i], triggerIn[i] + 100.));
+    EXPECT_EQ(ranges[i].fTime, triggerIn[i]);
+    EXPECT_EQ(ranges[i].Size(ECbmModuleId::kSts), nSts);
+    EXPECT_EQ(ranges[i].Size(ECbmModuleId::kTof), nTof);
+    EXPECT_EQ(result.first[i].fTime, triggerIn[i]);
+    EXPECT_EQ(result.first[i].fSts.size(), nSts);
+    EXPECT_EQ(result.first[i].fTof.size(), nTof);
+
+    // Same ranges as for the sorted triggers
+    auto sorted          = std::lower_bound(triggerSorted.begin(), triggerSorted.end(), triggerIn[i]);
+    const size_t iSorted = sorted - triggerSorted.begin();
+    EXPECT_EQ(ranges[i].fSts, rangesSorted[iSorted].fSts);
+    EXPECT_EQ(ranges[i].fTof, rangesSorted[iSorted].fTof);
+  }
+}
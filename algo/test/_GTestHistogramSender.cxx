@@ -0,0 +1,139 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "HistogramSender.h"
+#include "gtest/gtest.h"
+#include "qa/QaData.h"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <chrono>
+#include <forward_list>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace cbm::algo;
+
+namespace
+{
+  template<class Object>
+  Object Deserialize(const zmq::message_t& msg)
+  {
+    namespace b_io = boost::iostreams;
+    b_io::basic_array_source<char> device(static_cast<const char*>(msg.data()), msg.size());
+    b_io::stream<b_io::basic_array_source<char>> s(device);
+    boost::archive::binary_iarchive iarch(s);
+    Object obj;
+    iarch >> obj;
+    return obj;
+  }
+
+  template<class Histo>
+  size_t NHistos(const std::forward_list<Histo>& list)
+  {
+    return std::distance(list.begin(), list.end());
+  }
+}  // namespace
+
+TEST(_GTestHistogramSender, SendsOnlyFilledHistogramsAfterFirstEmission)
+{
+  zmq::context_t context(1);
+  zmq::socket_t pull(context, zmq::socket_type::pull);
+  pull.set(zmq::sockopt::rcvtimeo, 5000);
+  pull.bind("tcp://127.0.0.1:*");
+  std::string endpoint = pull.get(zmq::sockopt::last_endpoint);
+
+  auto sender = std::make_shared<HistogramSender>(endpoint, 10);
+
+  // Wait until the connection is established, messages are dropped before
+  while (!sender->PrepareAndSendMsg(std::string("ping"), zmq::send_flags::none)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  zmq::message_t msg;
+  ASSERT_TRUE(pull.recv(msg));
+  EXPECT_EQ(Deserialize<std::string>(msg), "ping");
+
+  qa::Data qa("test");
+  auto* hA = qa.MakeObj<qa::H1D>("hA", "A", 100, 0., 100.);
+  auto* hB = qa.MakeObj<qa::H1D>("hB", "B", 100, 0., 100.);
+  auto* pC = qa.MakeObj<qa::Prof1D>("pC", "C", 10, 0., 10.);
+
+  // First emission contains all histograms
+  hA->Fill(10.5);
+  hA->Fill(10.5);
+  hA->Fill(20.5, 0.5);
+  qa.Send(sender);
+  EXPECT_TRUE(hA->IsEmpty());
+
+  ASSERT_TRUE(pull.recv(msg));
+  auto first = Deserialize<qa::HistogramContainer>(msg);
+  ASSERT_EQ(NHistos(first.fvH1), 2);
+  ASSERT_EQ(NHistos(first.fvP1), 1);
+  const auto& recvA = (first.fvH1.front().GetName() == "hA") ? first.fvH1.front() : *std::next(first.fvH1.begin());
+  EXPECT_EQ(recvA.GetNbinsX(), 100);
+  EXPECT_EQ(recvA.GetEntries(), 3);
+  EXPECT_DOUBLE_EQ(recvA.GetBinContent(11), 2.);
+  EXPECT_DOUBLE_EQ(recvA.GetBinContent(21), 0.5);
+  EXPECT_DOUBLE_EQ(recvA.GetBinContent(12), 0.);
+  EXPECT_DOUBLE_EQ(recvA.GetTotSumW(), 2.5);
+
+  // Further emissions contain only the histograms filled in between, with the content since the last emission
+  pC->Fill(3.5, 2.);
+  pC->Fill(3.5, 4.);
+  qa.Send(sender);
+
+  ASSERT_TRUE(pull.recv(msg));
+  auto second = Deserialize<qa::HistogramContainer>(msg);
+  EXPECT_EQ(NHistos(second.fvH1), 0);
+  ASSERT_EQ(NHistos(second.fvP1), 1);
+  EXPECT_EQ(second.fvP1.front().GetName(), "pC");
+  EXPECT_DOUBLE_EQ(second.fvP1.front().GetBinContent(4), 3.);
+  EXPECT_EQ(second.fvP1.front().GetEntries(), 2);
+
+  hB->Fill(50.5);
+  qa.Send(sender);
+
+  ASSERT_TRUE(pull.recv(msg));
+  auto third = Deserialize<qa::HistogramContainer>(msg);
+  ASSERT_EQ(NHistos(third.fvH1), 1);
+  EXPECT_EQ(NHistos(third.fvP1), 0);
+  EXPECT_EQ(third.fvH1.front().GetName(), "hB");
+  EXPECT_DOUBLE_EQ(third.fvH1.front().GetBinContent(51), 1.);
+}
+
+TEST(_GTestHistogramSender, DenseHistogramRoundTrip)
+{
+  qa::H2D hist("h2", "h2", 4, 0., 4., 3, 0., 3.);
+  for (int x = -1; x <= 4; ++x) {
+    for (int y = -1; y <= 3; ++y) {
+      hist.Fill(x + 0.5, y + 0.5, x + 10. * y);
+    }
+  }
+
+  std::stringstream buffer;
+  {
+    boost::archive::binary_oarchive oarch(buffer);
+    oarch << hist;
+  }
+  qa::H2D copy;
+  {
+    boost::archive::binary_iarchive iarch(buffer);
+    iarch >> copy;
+  }
+
+  ASSERT_EQ(copy.GetNbinsX(), 4);
+  ASSERT_EQ(copy.GetNbinsY(), 3);
+  EXPECT_EQ(copy.GetEntries(), hist.GetEntries());
+  for (uint32_t x = 0; x <= 5; ++x) {
+    for (uint32_t y = 0; y <= 4; ++y) {
+      EXPECT_DOUBLE_EQ(copy.GetBinContent(x, y), hist.GetBinContent(x, y));
+      EXPECT_DOUBLE_EQ(copy.GetBinError(x, y), hist.GetBinError(x, y));
+    }
+  }
+}
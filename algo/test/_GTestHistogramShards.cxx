@@ -0,0 +1,190 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "compat/OpenMP.h"
+#include "gtest/gtest.h"
+#include "qa/HistogramShards.h"
+
+#include <random>
+#include <vector>
+
+using namespace cbm::algo;
+
+namespace
+{
+  constexpr int NofValues = 100000;
+
+  /// \brief Random values, partially outside of the histogram range [-5, 5]
+  std::vector<double> MakeValues(unsigned seed)
+  {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0., 3.);
+    std::vector<double> values(NofValues);
+    for (auto& v : values) {
+      v = dist(gen);
+    }
+    return values;
+  }
+
+  void ExpectSameTotalSums(const qa::TotalSums1D& lhs, const qa::TotalSums1D& rhs)
+  {
+    // The summation order of the shards differs from the one of a single histogram
+    EXPECT_DOUBLE_EQ(lhs.GetTotSumW(), rhs.GetTotSumW());
+    EXPECT_DOUBLE_EQ(lhs.GetTotSumW2(), rhs.GetTotSumW2());
+    EXPECT_NEAR(lhs.GetTotSumWX(), rhs.GetTotSumWX(), 1.e-9 * NofValues);
+    EXPECT_NEAR(lhs.GetTotSumWX2(), rhs.GetTotSumWX2(), 1.e-9 * NofValues);
+  }
+
+  void ExpectSame(const qa::H1D& lhs, const qa::H1D& rhs)
+  {
+    ASSERT_EQ(lhs.GetNbinsX(), rhs.GetNbinsX());
+    EXPECT_EQ(lhs.GetEntries(), rhs.GetEntries());
+    for (uint32_t iBin = 0; iBin <= lhs.GetNbinsX() + 1; ++iBin) {
+      EXPECT_EQ(lhs.GetBinContent(iBin), rhs.GetBinContent(iBin)) << "bin " << iBin;
+      EXPECT_EQ(lhs.GetBinError(iBin), rhs.GetBinError(iBin)) << "bin " << iBin;
+    }
+    ExpectSameTotalSums(lhs, rhs);
+  }
+
+  void ExpectSame(const qa::H2D& lhs, const qa::H2D& rhs)
+  {
+    ASSERT_EQ(lhs.GetNbinsX(), rhs.GetNbinsX());
+    ASSERT_EQ(lhs.GetNbinsY(), rhs.GetNbinsY());
+    EXPECT_EQ(lhs.GetEntries(), rhs.GetEntries());
+    for (uint32_t iBinX = 0; iBinX <= lhs.GetNbinsX() + 1; ++iBinX) {
+      for (uint32_t iBinY = 0; iBinY <= lhs.GetNbinsY() + 1; ++iBinY) {
+        EXPECT_EQ(lhs.GetBinContent(iBinX, iBinY), rhs.GetBinContent(iBinX, iBinY)) << iBinX << ", " << iBinY;
+        EXPECT_EQ(lhs.GetBinError(iBinX, iBinY), rhs.GetBinError(iBinX, iBinY)) << iBinX << ", " << iBinY;
+      }
+    }
+    ExpectSameTotalSums(lhs, rhs);
+    EXPECT_NEAR(lhs.GetTotSumWXY(), rhs.GetTotSumWXY(), 1.e-9 * NofValues);
+    EXPECT_NEAR(lhs.GetTotSumWY(), rhs.GetTotSumWY(), 1.e-9 * NofValues);
+    EXPECT_NEAR(lhs.GetTotSumWY2(), rhs.GetTotSumWY2(), 1.e-9 * NofValues);
+  }
+}  // namespace
+
+TEST(_GTestHistogramShards, H1DCountEqualsSingleHistogram)
+{
+  auto values = MakeValues(1);
+
+  qa::H1D expected("h", "", 20, -5., 5.);
+  for (double x : values) {
+    expected.Fill(x);
+  }
+
+  qa::H1D merged("h", "", 20, -5., 5.);
+  qa::HistogramShards<qa::H1D> shards(&merged);
+  CBM_PARALLEL()
+  {
+    auto& shard = shards.Local();
+    CBM_OMP(for)
+    for (int i = 0; i < NofValues; ++i) {
+      shard.Count(values[i]);
+    }
+  }
+  shards.Merge();
+
+  ExpectSame(merged, expected);
+}
+
+TEST(_GTestHistogramShards, H1DRepeatedMergeAccumulates)
+{
+  auto values = MakeValues(2);
+
+  qa::H1D expected("h", "", 10, -5., 5.);
+  qa::H1D merged("h", "", 10, -5., 5.);
+  qa::HistogramShards<qa::H1D> shards(&merged);
+  for (int iTs = 0; iTs < 3; ++iTs) {
+    for (double x : values) {
+      expected.Fill(x);
+    }
+    CBM_PARALLEL_FOR()
+    for (int i = 0; i < NofValues; ++i) {
+      shards.Local().Count(values[i]);
+    }
+    shards.Merge();  // Resets the shards, the next fills must not be counted twice
+  }
+
+  ExpectSame(merged, expected);
+}
+
+TEST(_GTestHistogramShards, H1DWeightedFillEqualsSingleHistogram)
+{
+  auto values = MakeValues(3);
+
+  // Weighted and unweighted fills of the same shard are merged together
+  qa::H1D expected("h", "", 20, -5., 5.);
+  for (int i = 0; i < NofValues; ++i) {
+    expected.Fill(values[i], i % 2 ? 1. : 0.5);
+  }
+
+  qa::H1D merged("h", "", 20, -5., 5.);
+  qa::HistogramShards<qa::H1D> shards(&merged);
+  CBM_PARALLEL_FOR()
+  for (int i = 0; i < NofValues; ++i) {
+    auto& shard = shards.Local();
+    if (i % 2) {
+      shard.Count(values[i]);
+    }
+    else {
+      shard.GetHistogram().Fill(values[i], 0.5);
+    }
+  }
+  shards.Merge();
+
+  EXPECT_EQ(merged.GetEntries(), expected.GetEntries());
+  for (uint32_t iBin = 0; iBin <= merged.GetNbinsX() + 1; ++iBin) {
+    EXPECT_DOUBLE_EQ(merged.GetBinContent(iBin), expected.GetBinContent(iBin)) << "bin " << iBin;
+    EXPECT_DOUBLE_EQ(merged.GetBinError(iBin), expected.GetBinError(iBin)) << "bin " << iBin;
+  }
+  EXPECT_NEAR(merged.GetTotSumW(), expected.GetTotSumW(), 1.e-9 * NofValues);
+  EXPECT_NEAR(merged.GetTotSumWX(), expected.GetTotSumWX(), 1.e-9 * NofValues);
+}
+
+TEST(_GTestHistogramShards, H2DCountEqualsSingleHistogram)
+{
+  auto xs = MakeValues(4);
+  auto ys = MakeValues(5);
+
+  qa::H2D expected("h", "", 10, -5., 5., 8, -4., 4.);
+  for (int i = 0; i < NofValues; ++i) {
+    expected.Fill(xs[i], ys[i]);
+  }
+
+  qa::H2D merged("h", "", 10, -5., 5., 8, -4., 4.);
+  qa::HistogramShards<qa::H2D> shards(&merged);
+  CBM_PARALLEL_FOR()
+  for (int i = 0; i < NofValues; ++i) {
+    shards.Local().Count(xs[i], ys[i]);
+  }
+  shards.Merge();
+
+  ExpectSame(merged, expected);
+}
+
+TEST(_GTestHistogramShards, Prof1DFillEqualsSingleHistogram)
+{
+  auto xs = MakeValues(6);
+  auto ys = MakeValues(7);
+
+  qa::Prof1D expected("p", "", 10, -5., 5.);
+  for (int i = 0; i < NofValues; ++i) {
+    expected.Fill(xs[i], ys[i]);
+  }
+
+  qa::Prof1D merged("p", "", 10, -5., 5.);
+  qa::HistogramShards<qa::Prof1D> shards(&merged);
+  CBM_PARALLEL_FOR()
+  for (int i = 0; i < NofValues; ++i) {
+    shards.Local().GetHistogram().Fill(xs[i], ys[i]);
+  }
+  shards.Merge();
+
+  EXPECT_EQ(merged.GetEntries(), expected.GetEntries());
+  for (uint32_t iBin = 0; iBin <= merged.GetNbinsX() + 1; ++iBin) {
+    EXPECT_DOUBLE_EQ(merged.GetBinCount(iBin), expected.GetBinCount(iBin)) << "bin " << iBin;
+    EXPECT_NEAR(merged.GetBinContent(iBin), expected.GetBinContent(iBin), 1.e-9) << "bin " << iBin;
+  }
+}
@@ -0,0 +1,133 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "KfField.h"
+#include "KfFieldGrid.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+using namespace cbm::algo;
+using namespace cbm::algo::kf;
+
+namespace
+{
+  constexpr double MaxDeviation = 0.01;  // [kG]
+
+  const std::array<double, 3> Lo{-50., -50., 0.};  // [cm]
+  const std::array<double, 3> Hi{50., 50., 100.};  // [cm]
+
+  /// \brief Smooth non-linear field, which cannot be reproduced exactly by the trilinear interpolation
+  std::tuple<double, double, double> FieldFn(double x, double y, double z)
+  {
+    return std::make_tuple(0.5 * std::sin(x / 20.) * std::cos(z / 30.),         //
+                           10. * std::cos(y / 40.) * std::exp(-z * z / 1.e4),  //
+                           2.e-4 * x * y + 0.1 * std::sin(z / 15.));
+  }
+
+  std::shared_ptr<const FieldGrid> MakeGrid() { return FieldGrid::Make(FieldFn, Lo, Hi, 10., MaxDeviation, 1 << 22); }
+}  // namespace
+
+TEST(_GTestKfFieldGrid, DeviationWithinMaxDeviation)
+{
+  auto pGrid = MakeGrid();
+  ASSERT_LE(pGrid->GetMaxDeviation(FieldFn), MaxDeviation);
+  EXPECT_LT(pGrid->GetStep(), 10.);  // The initial step is too coarse
+
+  // The nodes are stored in single precision
+  constexpr double Tolerance = MaxDeviation + 1.e-5;
+
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  for (int i = 0; i < 100000; ++i) {
+    double x          = Lo[0] + dist(gen) * (Hi[0] - Lo[0]);
+    double y          = Lo[1] + dist(gen) * (Hi[1] - Lo[1]);
+    double z          = Lo[2] + dist(gen) * (Hi[2] - Lo[2]);
+    auto [bx, by, bz] = FieldFn(x, y, z);
+    auto b            = pGrid->GetFieldValue<double>(FieldFn, x, y, z);
+    EXPECT_NEAR(b.GetBx(), bx, Tolerance) << x << ", " << y << ", " << z;
+    EXPECT_NEAR(b.GetBy(), by, Tolerance) << x << ", " << y << ", " << z;
+    EXPECT_NEAR(b.GetBz(), bz, Tolerance) << x << ", " << y << ", " << z;
+  }
+}
+
+TEST(_GTestKfFieldGrid, MakeThrowsIfAccuracyIsNotReached)
+{
+  EXPECT_THROW(FieldGrid::Make(FieldFn, Lo, Hi, 10., MaxDeviation, 1000), std::runtime_error);
+}
+
+TEST(_GTestKfFieldGrid, FieldFunctionOutsideGrid)
+{
+  auto pGrid = MakeGrid();
+
+  // The grid spans at least [Lo, Hi], the points are beyond it in one or several coordinates
+  const std::array<std::array<double, 3>, 6> points{{{-200., 0., 50.},
+                                                     {0., 200., 50.},
+                                                     {0., 0., -30.},
+                                                     {0., 0., 300.},
+                                                     {120., -130., 250.},
+                                                     {-1.e6, 1.e6, 1.e6}}};
+  for (const auto& [x, y, z] : points) {
+    auto [bx, by, bz] = FieldFn(x, y, z);
+    auto b            = pGrid->GetFieldValue<double>(FieldFn, x, y, z);
+    EXPECT_DOUBLE_EQ(b.GetBx(), bx) << x << ", " << y << ", " << z;
+    EXPECT_DOUBLE_EQ(b.GetBy(), by) << x << ", " << y << ", " << z;
+    EXPECT_DOUBLE_EQ(b.GetBz(), bz) << x << ", " << y << ", " << z;
+  }
+}
+
+TEST(_GTestKfFieldGrid, SimdEqualsScalar)
+{
+  using utils::simd::Cast;
+  using utils::simd::SetEntry;
+
+  auto pGrid = MakeGrid();
+
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<float> dist(-0.5f, 1.5f);  // Partially outside of the grid
+  for (int iTrial = 0; iTrial < 1000; ++iTrial) {
+    fvec x, y, z;
+    for (size_t i = 0; i < utils::simd::Size<fvec>(); ++i) {
+      SetEntry(x, Lo[0] + dist(gen) * (Hi[0] - Lo[0]), i);
+      SetEntry(y, Lo[1] + dist(gen) * (Hi[1] - Lo[1]), i);
+      SetEntry(z, Lo[2] + dist(gen) * (Hi[2] - Lo[2]), i);
+    }
+    auto bV = pGrid->GetFieldValue<fvec>(FieldFn, x, y, z);
+    for (size_t i = 0; i < utils::simd::Size<fvec>(); ++i) {
+      float xi = Cast<fvec, float>(x, i);
+      float yi = Cast<fvec, float>(y, i);
+      float zi = Cast<fvec, float>(z, i);
+      auto bF  = pGrid->GetFieldValue<float>(FieldFn, xi, yi, zi);
+      auto bD  = pGrid->GetFieldValue<double>(FieldFn, xi, yi, zi);
+      for (int k = 0; k < 3; ++k) {
+        float bVk = Cast<fvec, float>(bV.GetComponent(k), i);
+        EXPECT_FLOAT_EQ(bVk, bF.GetComponent(k)) << "component " << k;
+        EXPECT_NEAR(bVk, bD.GetComponent(k), 1.e-4) << "component " << k;
+      }
+    }
+  }
+}
+
+TEST(_GTestKfFieldGrid, FactoryRequiresBuiltGrid)
+{
+  FieldFactory factory;
+  factory.SetFieldFunction(FieldFn, EFieldType::Normal);
+  factory.SetTarget(0., 0., 0.);
+  factory.AddSliceReference(40., 40., 50.);
+  factory.AddSliceReference(40., 40., 90.);
+  factory.SetFieldCache(10., MaxDeviation);
+  factory.SetFieldMode(EFieldMode::Cached);
+  EXPECT_THROW(factory.MakeField<float>(), std::logic_error);
+
+  factory.BuildFieldGrid();
+  auto field = factory.MakeField<float>();
+  EXPECT_EQ(field.GetPrimVertexField().GetFieldMode(), EFieldMode::Cached);
+
+  // The grid is dropped, when the field function is changed
+  factory.SetFieldFunction(FieldFn, EFieldType::Normal);
+  EXPECT_THROW(factory.MakeField<float>(), std::logic_error);
+}
@@ -0,0 +1,239 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "BuildInfo.h"
+#include "RecoResultsColumnarArchive.h"
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+
+using namespace cbm::algo;
+
+TEST(_GTestRecoResultsColumnarArchive, RoundTrip)
+{
+  const std::string path = "RecoResultsColumnarArchiveTest.bin";
+
+  RecoResults results;
+  for (uint32_t i = 0; i < 1000; i++) {
+    results.stsDigis.emplace_back(0x10008002, i % 1024, 10 * i, i % 32);
+  }
+
+  std::vector<sts::Hit> hits(3);
+  hits[0].fX = 1.f;
+  hits[1].fX = 2.f;
+  hits[2].fX = 3.f;
+  std::vector<size_t> offsets = {0, 1, 3};
+  std::vector<u32> addresses  = {0x100, 0x200};
+  results.stsHits             = PartitionedSpan<sts::Hit>(hits, offsets, addresses);
+
+  results.tracks.reset(2);
+  results.tracks[0].fNofHits = 3;
+  results.tracks[1].fNofHits = 2;
+  results.trackStsHitIndices.Reset(3, 5);
+  results.trackStsHitIndices.AddHit(0, 0);
+  results.trackStsHitIndices.AddHit(1, 0);
+  results.trackStsHitIndices.AddHit(1, 1);
+  results.trackStsHitIndices.CloseTrack();
+  results.trackStsHitIndices.AddHit(1, 1);
+  results.trackStsHitIndices.AddHit(0, 0);
+  results.trackStsHitIndices.CloseTrack();
+
+  {
+    RecoResultsColumnarWriter writer(path, false);
+    writer.Put(7, 1000, results);
+    results.tracks.push_back(ca::Track{});
+    results.trackStsHitIndices.CloseTrack();
+    writer.Put(8, 2000, results);
+    writer.Close();
+  }
+
+  ASSERT_TRUE(RecoResultsColumnarReader::IsColumnarArchive(path));
+  RecoResultsColumnarReader reader(path);
+  ASSERT_EQ(reader.NTimeslices(), 2);
+  EXPECT_EQ(reader.TsIndex(0), 7);
+  EXPECT_EQ(reader.TsStartTime(1), 2000);
+
+  auto digis = reader.ViewColumn<CbmStsDigi>(1, RecoColumn::StsDigis);
+  ASSERT_EQ(digis.size(), results.stsDigis.size());
+  for (size_t i = 0; i < digis.size(); i++) {
+    EXPECT_EQ(digis[i].GetChannel(), results.stsDigis[i].GetChannel());
+    EXPECT_EQ(digis[i].GetTime(), results.stsDigis[i].GetTime());
+  }
+
+  auto stsHits = reader.ReadStsHits(0);
+  ASSERT_EQ(stsHits.NPartitions(), 2);
+  EXPECT_EQ(stsHits.Address(1), 0x200);
+  ASSERT_EQ(stsHits[1].size(), 2);
+  EXPECT_EQ(stsHits[1][1].fX, 3.f);
+
+  EXPECT_EQ(reader.Count<ca::Track>(0, RecoColumn::Tracks), 2);
+  auto tracks = reader.ReadTracks(1);
+  ASSERT_EQ(tracks.size(), 3);
+  EXPECT_EQ(tracks[0].fNofHits, 3);
+  EXPECT_EQ(tracks[1].fNofHits, 2);
+
+  auto trackHits = reader.ReadTrackStsHitIndices(1);
+  ASSERT_EQ(trackHits.NTracks(), 3);
+  ASSERT_EQ(trackHits[0].size(), 3);
+  EXPECT_EQ(trackHits[0][2], RecoResults::HitId_t(1, 1));
+  EXPECT_EQ(trackHits[1][0], RecoResults::HitId_t(1, 1));
+  EXPECT_TRUE(trackHits[2].empty());
+
+  EXPECT_TRUE(reader.ReadDigiEvents(0).empty());
+  EXPECT_TRUE(reader.ReadTofHits(0).Data().empty());
+
+  std::remove(path.c_str());
+}
+
+TEST(_GTestRecoResultsColumnarArchive, UnclosedFileThrows)
+{
+  const std::string path = "RecoResultsColumnarArchiveUnclosed.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(columnar::Magic, sizeof(columnar::Magic));
+    file << std::string(64, '\0');
+  }
+  EXPECT_TRUE(RecoResultsColumnarReader::IsColumnarArchive(path));
+  EXPECT_THROW(RecoResultsColumnarReader{path}, FatalError);
+  std::remove(path.c_str());
+}
+
+TEST(_GTestRecoResultsColumnarArchive, CorruptIndexThrows)
+{
+  const std::string path = "RecoResultsColumnarArchiveCorrupt.bin";
+
+  RecoResults results;
+  for (uint32_t i = 0; i < 100; i++) {
+    results.stsDigis.emplace_back(0x10008002, i, 10 * i, 0);
+  }
+
+  auto write = [&] {
+    RecoResultsColumnarWriter writer(path, false);
+    writer.Put(1, 1000, results);
+    writer.Close();
+  };
+
+  // Overwrites a u64 in a valid archive, at the given position (negative: from the end of the file)
+  auto writeCorrupt = [&](std::streamoff pos, u64 value) {
+    write();
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(pos, pos < 0 ? std::ios::end : std::ios::beg);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  // Position of the index of TS 0, stored just before the footer
+  const std::streamoff tsIndexPos = -static_cast<std::streamoff>(sizeof(columnar::Footer) + sizeof(u64));
+  u64 indexPos                    = 0;
+  write();
+  {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(tsIndexPos, std::ios::end);
+    file.read(reinterpret_cast<char*>(&indexPos), sizeof(indexPos));
+  }
+  EXPECT_NO_THROW(RecoResultsColumnarReader{path});
+
+  writeCorrupt(tsIndexPos, u64{1} << 40);
+  EXPECT_THROW(RecoResultsColumnarReader{path}, FatalError);
+
+  writeCorrupt(tsIndexPos, 2);
+  EXPECT_THROW(RecoResultsColumnarReader{path}, FatalError);
+
+  writeCorrupt(indexPos + offsetof(columnar::TsIndexHeader, nColumns), u64{1} << 40);
+  EXPECT_THROW(RecoResultsColumnarReader{path}, FatalError);
+
+  // Size of the first column
+  writeCorrupt(indexPos + sizeof(columnar::TsIndexHeader) + offsetof(columnar::ColumnEntry, storedSize), ~u64{0});
+  EXPECT_THROW(RecoResultsColumnarReader{path}, FatalError);
+
+  std::remove(path.c_str());
+}
+
+TEST(_GTestRecoResultsColumnarArchive, CorruptColumnsThrow)
+{
+  const std::string path = "RecoResultsColumnarArchiveCorruptColumns.bin";
+
+  RecoResults results;
+  std::vector<sts::Hit> hits(3);
+  std::vector<size_t> offsets = {0, 1, 3};
+  std::vector<u32> addresses  = {0x100, 0x200};
+  results.stsHits             = PartitionedSpan<sts::Hit>(hits, offsets, addresses);
+  results.tracks.reset(2);
+  results.trackStsHitIndices.Reset(2, 3);
+  results.trackStsHitIndices.AddHit(0, 0);
+  results.trackStsHitIndices.CloseTrack();
+  results.trackStsHitIndices.AddHit(1, 0);
+  results.trackStsHitIndices.AddHit(1, 1);
+  results.trackStsHitIndices.CloseTrack();
+  for (uint32_t i = 0; i < 1000; i++) {
+    results.stsDigis.emplace_back(0x10008002, 0, 10, 0);  // Compresses well
+  }
+
+  // Position of the entry of a column in the index of TS 0
+  auto findEntry = [&](RecoColumn column) {
+    std::ifstream file(path, std::ios::binary);
+    u64 indexPos = 0;
+    file.seekg(-static_cast<std::streamoff>(sizeof(columnar::Footer) + sizeof(u64)), std::ios::end);
+    file.read(reinterpret_cast<char*>(&indexPos), sizeof(indexPos));
+    columnar::TsIndexHeader header;
+    file.seekg(indexPos);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    for (u64 i = 0; i < header.nColumns; i++) {
+      const std::streamoff pos = indexPos + sizeof(header) + i * sizeof(columnar::ColumnEntry);
+      columnar::ColumnEntry entry;
+      file.seekg(pos);
+      file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+      if (entry.column == column) return std::make_pair(pos, entry);
+    }
+    ADD_FAILURE() << "column " << static_cast<u32>(column) << " not found";
+    return std::make_pair(std::streamoff{0}, columnar::ColumnEntry{});
+  };
+
+  // Writes a valid archive and overwrites the u64 at position pos
+  auto writeCorrupt = [&](bool compress, auto&& pos, u64 value) {
+    {
+      RecoResultsColumnarWriter writer(path, compress);
+      writer.Put(1, 1000, results);
+      writer.Close();
+    }
+    const std::streamoff at = pos();
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(at);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  // Offset i of a partitioned or track hit offset column
+  auto offset = [&](RecoColumn column, size_t i) {
+    return [&, column, i] { return static_cast<std::streamoff>(findEntry(column).second.offset + i * sizeof(size_t)); };
+  };
+
+  // Track hit offsets {0, 1, 3}: first not 0, decreasing, last not the number of hits
+  writeCorrupt(false, offset(RecoColumn::TrackStsHitOffsets, 0), 1);
+  EXPECT_THROW(RecoResultsColumnarReader(path).ReadTrackStsHitIndices(0), FatalError);
+  writeCorrupt(false, offset(RecoColumn::TrackStsHitOffsets, 1), 5);
+  EXPECT_THROW(RecoResultsColumnarReader(path).ReadTrackStsHitIndices(0), FatalError);
+  writeCorrupt(false, offset(RecoColumn::TrackStsHitOffsets, 2), u64{1} << 40);
+  EXPECT_THROW(RecoResultsColumnarReader(path).ReadTrackStsHitIndices(0), FatalError);
+
+  // Hit partition offsets {0, 1, 3}
+  writeCorrupt(false, offset(RecoColumn::StsHitOffsets, 1), 4);
+  EXPECT_THROW(RecoResultsColumnarReader(path).ReadStsHits(0), FatalError);
+  writeCorrupt(false, offset(RecoColumn::StsHitOffsets, 2), 2);
+  EXPECT_THROW(RecoResultsColumnarReader(path).ReadStsHits(0), FatalError);
+
+  // Huge raw size of a compressed column: error instead of an allocation of that size
+  if (BuildInfo::WITH_ZSTD) {
+    auto rawSize = [&] { return findEntry(RecoColumn::StsDigis).first + offsetof(columnar::ColumnEntry, rawSize); };
+    writeCorrupt(true, rawSize, u64{1} << 50);
+    ASSERT_EQ(findEntry(RecoColumn::StsDigis).second.compression, ColumnCompression::Zstd);
+    EXPECT_THROW(RecoResultsColumnarReader(path).ReadColumn<CbmStsDigi>(0, RecoColumn::StsDigis), FatalError);
+    writeCorrupt(true, rawSize, sizeof(CbmStsDigi) * 999);
+    EXPECT_THROW(RecoResultsColumnarReader(path).ReadColumn<CbmStsDigi>(0, RecoColumn::StsDigis), FatalError);
+    writeCorrupt(true, rawSize, sizeof(CbmStsDigi) * 1000 + 1);
+    EXPECT_THROW(RecoResultsColumnarReader(path).ReadColumn<CbmStsDigi>(0, RecoColumn::StsDigis), FatalError);
+  }
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,167 @@
+/* Copyright (C) 2025 FIAS Frankfurt Institute for Advanced Studies, Frankfurt / Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CbmStsAddress.h"
+#include "MicrosliceDescriptor.hpp"
+#include "StsXyterMessage.h"
+#include "detectors/sts/UnpackMS.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace cbm::algo;
+
+namespace
+{
+  constexpr uint64_t TimeOffset = 10;
+
+  stsxyter::Message Epoch()
+  {
+    stsxyter::Message msg;
+    msg.SetBit(stsxyter::kFieldNotHitFlag, 1);
+    msg.SetField(stsxyter::kFieldSubtype, static_cast<uint16_t>(stsxyter::MessSubType::Epoch));
+    return msg;
+  }
+
+  stsxyter::Message TsMsb(uint32_t epoch)
+  {
+    stsxyter::Message msg;
+    msg.SetBit(stsxyter::kFieldNotHitFlag, 1);
+    msg.SetField(stsxyter::kFieldSubtype, static_cast<uint16_t>(stsxyter::MessSubType::TsMsb));
+    msg.SetField(stsxyter::kFieldTsMsbValBinning, epoch);
+    return msg;
+  }
+
+  stsxyter::Message Hit(uint16_t elink, uint16_t channel, uint16_t adc, uint16_t ts)
+  {
+    stsxyter::Message msg;
+    msg.SetField(stsxyter::kFieldLinkIndex, elink);
+    msg.SetHitChannel(channel);
+    msg.SetHitAdc(adc);
+    msg.SetHitTime(ts);
+    return msg;
+  }
+
+  // Time of a hit in ns, without walk correction
+  uint64_t HitTime(uint32_t epoch, uint16_t ts)
+  {
+    uint64_t clocks = uint64_t{epoch} * stsxyter::kuHitNbTsBinsBinning + ts;
+    return (clocks * stsxyter::kulClockCycleNom + stsxyter::kulClockCycleDen / 2) / stsxyter::kulClockCycleDen
+           - TimeOffset;
+  }
+
+  sts::UnpackPar MakePar(int32_t address)
+  {
+    sts::UnpackElinkPar elinkPar;
+    elinkPar.fAddress    = address;
+    elinkPar.fAsicNr     = 0;
+    elinkPar.fTimeOffset = TimeOffset;
+    elinkPar.fAdcMinCut  = 2;
+    elinkPar.fAdcOffset  = 1.;
+    elinkPar.fAdcGain    = 1.;
+    elinkPar.fWalk       = {1., 2., 3.};
+    elinkPar.fChanMask.resize(128, false);
+    elinkPar.fChanMask[5] = true;
+
+    sts::UnpackPar par;
+    par.fNumChansPerAsic   = 128;
+    par.fNumAsicsPerModule = 16;
+    par.fElinkParams       = {elinkPar, elinkPar};
+    return par;
+  }
+
+  sts::UnpackMS::Result_t Unpack(const sts::UnpackMS& unpack, const std::vector<stsxyter::Message>& messages)
+  {
+    fles::MicrosliceDescriptor descr{};
+    descr.idx  = 0;
+    descr.size = messages.size() * sizeof(stsxyter::Message);
+    return unpack(reinterpret_cast<const uint8_t*>(messages.data()), descr, 0);
+  }
+}  // namespace
+
+TEST(_GTestStsUnpackMS, DecodesHitMessages)
+{
+  const int32_t address = CbmStsAddress::GetAddress(1, 2, 0, 1);
+  sts::UnpackMS unpack(MakePar(address));
+
+  std::vector<stsxyter::Message> messages = {
+    Epoch(),
+    TsMsb(1),
+    Hit(0, 3, 10, 100),   // accepted
+    Hit(0, 5, 10, 100),   // masked channel
+    Hit(1, 4, 2, 100),    // below ADC cut
+    Hit(1, 4, 3, 101),    // accepted, with walk correction
+    Hit(7, 1, 10, 0),     // eLink out of range
+    stsxyter::Message(),  // dummy
+    TsMsb(2),
+    Hit(0, 3, 10, 0),  // accepted, next epoch
+  };
+
+  auto [digis, monitor, aux] = Unpack(unpack, messages);
+
+  ASSERT_EQ(digis.size(), 3);
+  EXPECT_EQ(digis[0].GetAddress(), address);
+  EXPECT_EQ(digis[0].GetChannel(), 3);
+  EXPECT_EQ(digis[0].GetTimeU32(), HitTime(1, 100));
+  EXPECT_EQ(digis[0].GetChargeU16(), 10);
+  EXPECT_EQ(digis[1].GetChannel(), 4);
+  EXPECT_EQ(digis[1].GetTimeU32(), HitTime(1, 101) + 3);
+  EXPECT_EQ(digis[1].GetChargeU16(), 3);
+  EXPECT_EQ(digis[2].GetTimeU32(), HitTime(2, 0));
+
+  EXPECT_EQ(monitor.fNumErrElinkOutOfRange, 1);
+  EXPECT_EQ(monitor.fNumNonHitOrTsbMessage, 1);
+  EXPECT_EQ(monitor.fNumErrTimestampOverflow, 0);
+  EXPECT_TRUE(aux.fQaDigis.empty());
+}
+
+TEST(_GTestStsUnpackMS, CountsHitsOnUnconnectedElinks)
+{
+  const int32_t address        = CbmStsAddress::GetAddress(1, 2, 0, 1);
+  sts::UnpackPar par           = MakePar(address);
+  par.fElinkParams[1].fAddress = -1;  // No module connected to eLink 1
+  sts::UnpackMS unpack(par);
+
+  std::vector<stsxyter::Message> messages = {
+    Epoch(),
+    TsMsb(1),
+    Hit(0, 3, 10, 100),  // accepted
+    Hit(1, 3, 10, 100),  // not connected
+    Hit(1, 4, 2, 100),   // not connected, below ADC cut
+  };
+
+  auto [digis, monitor, aux] = Unpack(unpack, messages);
+
+  ASSERT_EQ(digis.size(), 1);
+  EXPECT_EQ(digis[0].GetAddress(), address);
+  EXPECT_EQ(monitor.fNumErrElinkNotConnected, 2);
+  EXPECT_EQ(monitor.fNumErrElinkOutOfRange, 0);
+  EXPECT_TRUE(monitor.HasErrors());
+}
+
+TEST(_GTestStsUnpackMS, EpochsAcrossMessageBlocks)
+{
+  const int32_t address = CbmStsAddress::GetAddress(1, 2, 0, 1);
+  sts::UnpackMS unpack(MakePar(address));
+
+  // Epochs of different length, so TS_MSB messages fall on all positions within and at the edges of the blocks
+  std::vector<stsxyter::Message> messages = {Epoch(), TsMsb(0)};
+  std::vector<uint64_t> expectedTimes;
+  uint32_t epoch = 0;
+  for (uint16_t numHits = 0; numHits < 100; numHits++) {
+    for (uint16_t iHit = 0; iHit < numHits; iHit++) {
+      messages.push_back(Hit(iHit % 2, 10, 20, iHit));
+      expectedTimes.push_back(HitTime(epoch, iHit));
+    }
+    messages.push_back(TsMsb(++epoch));
+  }
+
+  auto [digis, monitor, aux] = Unpack(unpack, messages);
+
+  ASSERT_EQ(digis.size(), expectedTimes.size());
+  for (size_t i = 0; i < digis.size(); i++) {
+    EXPECT_EQ(digis[i].GetTimeU32(), expectedTimes[i]) << "digi " << i;
+  }
+  EXPECT_FALSE(monitor.HasErrors());
+}
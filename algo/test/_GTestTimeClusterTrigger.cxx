@@ -6,8 +6,39 @@
 #include "gtest/gtest-spi.h"
 #include "gtest/gtest.h"
 
+#include <random>
+
 using namespace cbm::algo::evbuild;
 
+namespace
+{
+  // Reference: serial two-pointer search over the full input
+  std::pair<std::vector<double>, size_t> SerialTrigger(const std::vector<double>& dataVec, double winSize,
+                                                       int32_t minNumData, double deadTime)
+  {
+    std::vector<double> triggerVec;
+    size_t numInTrigger = 0;
+
+    auto winStart = dataVec.begin();
+    auto current  = dataVec.begin();
+    while (current != dataVec.end()) {
+      while (*current - *winStart > winSize)
+        winStart++;
+      if (std::distance(winStart, current) >= minNumData - 1) {
+        triggerVec.push_back(0.5 * (*current + *winStart));
+        numInTrigger += std::distance(winStart, current) + 1;
+        winStart = current + 1;
+        while (winStart != dataVec.end() && *winStart - *current <= deadTime)
+          winStart++;
+        current = winStart;
+      }
+      else
+        current++;
+    }
+    return {triggerVec, numInTrigger};
+  }
+}  // namespace
+
 TEST(_GTestTimeClusterTrigger, CheckTriggerAlgorithmSimple)
 {
   SCOPED_TRACE("CheckTriggerAlgorithSimple");
@@ -38,3 +69,62 @@ TEST(_GTestTimeClusterTrigger, CheckTriggerAlgorithmSimple)
   EXPECT_EQ(dataIn.size(), monitor.num);
   EXPECT_EQ(nMinNumber * dataOut.size(), monitor.numInTrigger);
 }
+
+TEST(_GTestTimeClusterTrigger, CheckChunkedTriggerEqualsSerial)
+{
+  SCOPED_TRACE("CheckChunkedTriggerEqualsSerial");
+
+  std::mt19937 rng(1234);
+  for (int iTest = 0; iTest < 200; iTest++) {
+    const double windowSize = std::uniform_real_distribution<double>(1., 100.)(rng);
+    const uint nMinNumber   = std::uniform_int_distribution<uint>(1, 12)(rng);
+    const double deadTime   = std::uniform_real_distribution<double>(0., 200.)(rng);
+    const size_t nInput     = std::uniform_int_distribution<size_t>(0, 20000)(rng);
+    const size_t chunkSize  = std::uniform_int_distribution<size_t>(1, 3000)(rng);
+
+    // Bursts of dense data on top of a sparse background
+    std::vector<double> dataIn(nInput);
+    std::exponential_distribution<double> spacing(std::uniform_real_distribution<double>(0.01, 1.)(rng));
+    std::bernoulli_distribution burst(0.05);
+    double t = 0.;
+    for (auto& time : dataIn) {
+      t += burst(rng) ? 0.1 * spacing(rng) : spacing(rng);
+      time = t;
+    }
+
+    TimeClusterTrigger trigger(windowSize, nMinNumber, deadTime);
+    trigger.SetChunkSize(chunkSize);
+    auto [dataOut, monitor]          = trigger(dataIn);
+    auto [dataExpected, numExpected] = SerialTrigger(dataIn, windowSize, nMinNumber, deadTime);
+
+    ASSERT_EQ(dataOut, dataExpected) << "test " << iTest << ", chunk size " << chunkSize;
+    EXPECT_EQ(monitor.numInTrigger, numExpected);
+    EXPECT_EQ(monitor.nTriggers, dataExpected.size());
+    EXPECT_EQ(monitor.num, nInput);
+  }
+}
+
+TEST(_GTestTimeClusterTrigger, CheckUnsortedInputThrows)
+{
+  SCOPED_TRACE("CheckUnsortedInputThrows");
+
+  TimeClusterTrigger trigger(10., 2, 5.);
+  trigger.SetChunkSize(3);
+  std::vector<double> dataIn = {0., 1., 2., 3., 2.5, 4., 5.};
+  EXPECT_THROW(trigger(dataIn), std::runtime_error);
+}
+
+TEST(_GTestTimeClusterTrigger, CheckUnsortedFirstChunkThrows)
+{
+  SCOPED_TRACE("CheckUnsortedFirstChunkThrows");
+
+  // Disorder only in the first chunk, followed by many sorted chunks, which a thread may process after the first one
+  TimeClusterTrigger trigger(10., 2, 5.);
+  trigger.SetChunkSize(4);
+  std::vector<double> dataIn(4000);
+  for (size_t i = 0; i < dataIn.size(); i++) {
+    dataIn[i] = static_cast<double>(i);
+  }
+  std::swap(dataIn[1], dataIn[2]);
+  EXPECT_THROW(trigger(dataIn), std::runtime_error);
+}
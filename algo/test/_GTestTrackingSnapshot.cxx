@@ -0,0 +1,115 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CaInitManager.h"
+#include "TrackingSnapshot.h"
+#include "gtest/gtest.h"
+
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace cbm::algo;
+
+namespace
+{
+  constexpr u64 Key = 0x1234567890abcdefULL;
+
+  ca::Parameters<ca::fvec> MakeParameters()
+  {
+    ca::InitManager manager;
+    manager.SetMaxDoubletsPerSinglet(42);
+    manager.SetDefaultMass(0.5);
+    manager.SetRandomSeed(7);
+    return manager.TakeParameters();
+  }
+
+  /// \brief Serialized parameters, to compare two instances
+  std::string Serialize(const ca::Parameters<ca::fvec>& parameters)
+  {
+    std::stringstream stream;
+    {
+      boost::archive::binary_oarchive oa(stream);
+      parameters.SaveWithSetups(oa);
+    }
+    return stream.str();
+  }
+}  // namespace
+
+TEST(_GTestTrackingSnapshot, RoundTrip)
+{
+  const std::string path = "TrackingSnapshotRoundTrip.bin";
+  auto parameters        = MakeParameters();
+  TrackingSnapshot::Write(path, Key, parameters);
+
+  auto snapshot = TrackingSnapshot::Read(path, Key);
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_EQ(snapshot->GetMaxDoubletsPerSinglet(), 42u);
+  EXPECT_EQ(snapshot->GetDefaultMass(), 0.5f);
+  EXPECT_EQ(snapshot->GetRandomSeed(), 7);
+  EXPECT_EQ(Serialize(*snapshot), Serialize(parameters));
+
+  // A snapshot is replaced by the next write
+  TrackingSnapshot::Write(path, Key + 1, parameters);
+  EXPECT_FALSE(TrackingSnapshot::Read(path, Key).has_value());
+  EXPECT_TRUE(TrackingSnapshot::Read(path, Key + 1).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(_GTestTrackingSnapshot, KeyMismatch)
+{
+  const std::string path = "TrackingSnapshotKeyMismatch.bin";
+  TrackingSnapshot::Write(path, Key, MakeParameters());
+  EXPECT_FALSE(TrackingSnapshot::Read(path, Key ^ 1).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(_GTestTrackingSnapshot, CorruptChecksum)
+{
+  const std::string path = "TrackingSnapshotCorrupt.bin";
+  TrackingSnapshot::Write(path, Key, MakeParameters());
+  ASSERT_TRUE(TrackingSnapshot::Read(path, Key).has_value());
+
+  // Flip a byte of the archive
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(sizeof(TrackingSnapshot::Header) + 10);
+    char byte = file.get();
+    file.seekp(sizeof(TrackingSnapshot::Header) + 10);
+    file.put(static_cast<char>(byte ^ 0x5a));
+  }
+  EXPECT_FALSE(TrackingSnapshot::Read(path, Key).has_value());
+
+  // Truncated file
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write("CBMCASNP", 8);
+  }
+  EXPECT_FALSE(TrackingSnapshot::Read(path, Key).has_value());
+  std::remove(path.c_str());
+}
+
+TEST(_GTestTrackingSnapshot, MissingFile)
+{
+  EXPECT_FALSE(TrackingSnapshot::Read("TrackingSnapshotMissing.bin", Key).has_value());
+}
+
+TEST(_GTestTrackingSnapshot, KeyOfFiles)
+{
+  const std::string path = "TrackingSnapshotKeyOfFiles.yaml";
+  auto WriteFile         = [&](const char* content) { std::ofstream(path, std::ios::trunc) << content; };
+
+  WriteFile("a: 1\n");
+  const u64 key = TrackingSnapshot::MakeKey({path, ""});
+  EXPECT_EQ(TrackingSnapshot::MakeKey({path}), key);
+  EXPECT_EQ(TrackingSnapshot::LayoutFingerprint(), TrackingSnapshot::LayoutFingerprint());
+
+  WriteFile("a: 2\n");
+  EXPECT_NE(TrackingSnapshot::MakeKey({path}), key);
+  std::remove(path.c_str());
+  EXPECT_THROW(TrackingSnapshot::MakeKey({path}), std::runtime_error);
+}
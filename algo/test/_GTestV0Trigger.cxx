@@ -0,0 +1,166 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "V0Trigger.h"
+#include "compat/OpenMP.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace cbm::algo;
+using cbm::algo::evbuild::V0Trigger;
+using cbm::algo::evbuild::V0TriggerConfig;
+
+namespace
+{
+  V0TriggerConfig MakeConfig()
+  {
+    YAML::Node node;
+    node["track_start_z_min"]  = -10.;
+    node["track_start_z_max"]  = 100.;
+    node["track_end_z_min"]    = 50.;
+    node["track_impact_x_min"] = -0.5;
+    node["track_impact_x_max"] = 0.5;
+    node["track_impact_y_min"] = -0.5;
+    node["track_impact_y_max"] = 0.5;
+    node["pair_deltaT_max"]    = 4.;
+    node["pair_dist_max"]      = 0.5;
+    node["pair_z_min"]         = 5.;
+    node["pair_z_max"]         = 60.;
+    return V0TriggerConfig(node);
+  }
+
+  /// \brief Tracks from displaced two-track vertices, from the target and random, ordered in time with a few outliers
+  V0Trigger::TrackVector MakeTracks(std::mt19937& gen, size_t nVertices)
+  {
+    std::uniform_real_distribution<float> pos(-3.f, 3.f);
+    std::uniform_real_distribution<float> slope(-0.3f, 0.3f);
+    std::uniform_real_distribution<float> zVertex(0.f, 70.f);
+    std::uniform_real_distribution<float> jitter(0.f, 3.f);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    V0Trigger::TrackVector tracks;
+    tracks.reserve(2 * nVertices);
+    auto addTrack = [&](float x, float y, float z, float time) {
+      V0Trigger::Track track;
+      track.fParFirst.SetZ(20.f);
+      track.fParLast.SetZ(80.f);
+      auto& par      = track.fParPV;
+      const float tx = slope(gen);
+      const float ty = slope(gen);
+      par.SetZ(0.f);
+      par.SetX(x - tx * z);
+      par.SetY(y - ty * z);
+      par.SetTx(tx);
+      par.SetTy(ty);
+      par.SetTime(time);
+      tracks.push_back(track);
+    };
+
+    float time = 0.f;
+    for (size_t iVertex = 0; iVertex < nVertices; iVertex++) {
+      time += jitter(gen);
+      const int k = kind(gen);
+      if (k == 0) {  // Track from the target, rejected as primary
+        addTrack(0.f, 0.f, 0.f, time);
+      }
+      else if (k == 1) {  // Track earlier than its predecessor
+        addTrack(pos(gen), pos(gen), zVertex(gen), time - 5.f);
+      }
+      else {  // Two tracks from a displaced vertex
+        const float x = pos(gen);
+        const float y = pos(gen);
+        const float z = zVertex(gen);
+        addTrack(x, y, z, time);
+        addTrack(x, y, z, time + 0.5f * jitter(gen));
+      }
+    }
+    return tracks;
+  }
+
+  /// \brief The serial pair loop the trigger was originally implemented with
+  V0Trigger::Result SerialTrigger(const V0Trigger::TrackVector& tracks, const V0TriggerConfig& config)
+  {
+    auto isPrimary = [&](const V0Trigger::TrackParam& par) {
+      return par.X() >= config.TrackImpactX_min() && par.X() <= config.TrackImpactX_max()
+             && par.Y() >= config.TrackImpactY_min() && par.Y() <= config.TrackImpactY_max();
+    };
+    auto select = [&](const V0Trigger::Track& track) {
+      return track.fParFirst.Z() >= config.TrackStartZ_min() && track.fParFirst.Z() <= config.TrackStartZ_max()
+             && track.fParLast.Z() >= config.TrackEndZ_min() && !isPrimary(track.fParPV);
+    };
+
+    V0Trigger::Result result;
+    for (auto it1 = tracks.begin(); it1 != tracks.end(); it1++) {
+      if (!select(*it1)) continue;
+      for (auto it2 = std::next(it1); it2 != tracks.end(); it2++) {
+        if (!select(*it2)) continue;
+        const float time1 = it1->fParPV.GetTime();
+        const float time2 = it2->fParPV.GetTime();
+        if (time2 < time1) {
+          result.second.errTracksUnsorted++;
+          continue;
+        }
+        result.second.numTrackPairs++;
+        if (time2 - time1 > config.PairDeltaT_max()) break;
+        result.second.numTrackPairsAfterTimeCut++;
+
+        const auto& p1  = it1->fParPV;
+        const auto& p2  = it2->fParPV;
+        const double cx = (p1.GetX() - p1.GetTx() * p1.GetZ()) - (p2.GetX() - p2.GetTx() * p2.GetZ());
+        const double cy = (p1.GetY() - p1.GetTy() * p1.GetZ()) - (p2.GetY() - p2.GetTy() * p2.GetZ());
+        const double wx = p1.GetTx() - p2.GetTx();
+        const double wy = p1.GetTy() - p2.GetTy();
+        const double z  = -1. * (cx * wx + cy * wy) / (wx * wx + wy * wy);
+        const double dx = cx + z * wx;
+        const double dy = cy + z * wy;
+        if (sqrt(dx * dx + dy * dy) < config.PairDist_max()) {
+          result.second.numTrackPairsAfterDistCut++;
+          if (z >= config.PairZ_min() && z <= config.PairZ_max()) {
+            result.second.numTrackPairsAfterZCut++;
+            result.first.push_back(0.5 * (time1 + time2));
+          }
+        }
+      }
+    }
+    return result;
+  }
+}  // namespace
+
+TEST(_GTestV0Trigger, ParallelMatchesSerial)
+{
+  const V0TriggerConfig config = MakeConfig();
+  std::mt19937 gen(7);
+  const V0Trigger::TrackVector tracks = MakeTracks(gen, 3000);
+
+  V0Trigger::Result expected = SerialTrigger(tracks, config);
+  std::sort(expected.first.begin(), expected.first.end());
+  ASSERT_GT(expected.first.size(), 100);
+  ASSERT_GT(expected.second.errTracksUnsorted, 0);
+
+  V0Trigger trigger;
+  const int nThreads = openmp::GetMaxThreads();
+  for (int nThreadsTest : {1, 3, 8}) {
+    openmp::SetNumThreads(nThreadsTest);
+    SCOPED_TRACE(nThreadsTest);
+    const V0Trigger::Result result = trigger(tracks, config);
+
+    EXPECT_EQ(result.second.errTracksUnsorted, expected.second.errTracksUnsorted);
+    EXPECT_EQ(result.second.numTrackPairs, expected.second.numTrackPairs);
+    EXPECT_EQ(result.second.numTrackPairsAfterTimeCut, expected.second.numTrackPairsAfterTimeCut);
+    EXPECT_EQ(result.second.numTrackPairsAfterDistCut, expected.second.numTrackPairsAfterDistCut);
+    EXPECT_EQ(result.second.numTrackPairsAfterZCut, expected.second.numTrackPairsAfterZCut);
+
+    // Same trigger times, sorted in time
+    ASSERT_EQ(result.first.size(), expected.first.size());
+    for (size_t i = 0; i < result.first.size(); i++) {
+      EXPECT_DOUBLE_EQ(result.first[i], expected.first[i]) << "trigger " << i;
+    }
+  }
+  openmp::SetNumThreads(nThreads);
+}
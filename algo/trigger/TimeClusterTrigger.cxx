@@ -4,6 +4,8 @@
 
 #include "TimeClusterTrigger.h"
 
+#include "compat/OpenMP.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iterator>
@@ -21,9 +23,6 @@ namespace cbm::algo::evbuild
 
   TimeClusterTrigger::resultType TimeClusterTrigger::operator()(const vector<double>& dataVec) const
   {
-
-    if (!std::is_sorted(dataVec.begin(), dataVec.end())) throw std::runtime_error("TimeClusterTrigger: unsorted input");
-
     xpu::push_timer("TimeClusterTrigger");
     xpu::t_add_bytes(dataVec.size() * sizeof(double));
 
@@ -32,40 +31,100 @@ namespace cbm::algo::evbuild
     vector<double>& triggerVec             = result.first;
     TimeClusterTriggerMonitorData& monitor = result.second;
 
-    auto winStart = dataVec.begin();
-    auto current  = dataVec.begin();
+    const size_t nData   = dataVec.size();
+    const size_t nChunks = std::max<size_t>(1, (nData + fChunkSize - 1) / fChunkSize);
+    auto chunkStart      = [&](size_t iChunk) { return nData * iChunk / nChunks; };
+
+    // --- Search each chunk independently, starting with an empty window
+    vector<vector<Window>> chunkTriggers(nChunks);
+    vector<State> chunkEnd(nChunks);
+    bool sorted = true;
+    CBM_PARALLEL_FOR(schedule(dynamic) reduction(&& : sorted))
+    for (size_t iChunk = 0; iChunk < nChunks; iChunk++) {
+      const size_t begin = chunkStart(iChunk);
+      const size_t end   = chunkStart(iChunk + 1);
+      // The private copy of a thread covers several chunks, so it may only be cleared, never reset
+      if (!std::is_sorted(dataVec.begin() + (begin > 0 ? begin - 1 : 0), dataVec.begin() + end)) {
+        sorted = false;
+        continue;
+      }
+      chunkEnd[iChunk] = {begin, begin};
+      Search(dataVec, chunkEnd[iChunk], end, chunkTriggers[iChunk]);
+    }
+    if (!sorted) {
+      xpu::pop_timer();
+      throw std::runtime_error("TimeClusterTrigger: unsorted input");
+    }
+
+    // --- Stitch the chunks. The first chunk starts in the true state.
+    vector<Window> triggers = std::move(chunkTriggers[0]);
+    State state             = chunkEnd[0];
+    for (size_t iChunk = 1; iChunk < nChunks; iChunk++) {
+      const auto& chunk = chunkTriggers[iChunk];
+      size_t iSync      = Search(dataVec, state, chunkStart(iChunk + 1), triggers, &chunk);
+      if (iSync < chunk.size()) {
+        // Same trigger datum, so the search continues identically from here
+        triggers.insert(triggers.end(), chunk.begin() + iSync + 1, chunk.end());
+        state = chunkEnd[iChunk];
+      }
+    }
+
+    triggerVec.reserve(triggers.size());
+    for (const auto& window : triggers) {
+      triggerVec.push_back(0.5 * (dataVec[window.last] + dataVec[window.first]));
+      monitor.numInTrigger += window.last - window.first + 1;
+    }
+
+    // Store number of input data for monitoring
+    monitor.num += dataVec.size();
+    monitor.nTriggers = triggerVec.size();
 
-    while (current != dataVec.end()) {
+    monitor.time = xpu::pop_timer();
+
+    return result;
+  }
+
+
+  size_t TimeClusterTrigger::Search(const vector<double>& data, State& state, size_t end, vector<Window>& triggers,
+                                    const vector<Window>* sync) const
+  {
+    const size_t nSync = sync ? sync->size() : 0;
+    size_t iSync       = 0;
+    bool synced        = false;
+    size_t winStart    = state.winStart;
+    size_t current     = state.current;
+
+    while (current < end) {
 
       // If window size is exceeded, adjust window start
-      while (*current - *winStart > fWinSize)
+      while (data[current] - data[winStart] > fWinSize)
         winStart++;
 
       // Create trigger if threshold is reached
-      if (std::distance(winStart, current) >= fMinNumData - 1) {
-        triggerVec.push_back(0.5 * (*current + *winStart));
-
-        // Increment monitoring counter with number of digis used
-        monitor.numInTrigger += std::distance(winStart, current) + 1;
+      if (static_cast<std::ptrdiff_t>(current - winStart) >= fMinNumData - 1) {
+        triggers.push_back({winStart, current});
 
         // Start new window after dead time
-        winStart = current + 1;
-        while (winStart != dataVec.end() && *winStart - *current <= fDeadTime)
+        const size_t trigger = current;
+        winStart             = current + 1;
+        while (winStart != data.size() && data[winStart] - data[trigger] <= fDeadTime)
           winStart++;
         current = winStart;
+
+        // Stop if the other search found a trigger on the same datum
+        while (iSync < nSync && (*sync)[iSync].last < trigger)
+          iSync++;
+        synced = iSync < nSync && (*sync)[iSync].last == trigger;
+        if (synced) break;
       }
 
       // If threshold is not reached, check with next element
       else
         current++;
     }
-    // Store number of input data for monitoring
-    monitor.num += dataVec.size();
-    monitor.nTriggers = triggerVec.size();
 
-    monitor.time = xpu::pop_timer();
-
-    return result;
+    state = {winStart, current};
+    return synced ? iSync : nSync;
   }
 
 
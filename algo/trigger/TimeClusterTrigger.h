@@ -8,6 +8,7 @@
 #include "Definitions.h"
 #include "DigiTriggerConfig.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -39,6 +40,12 @@ namespace cbm::algo::evbuild
    ** can contribute to only one trigger. Consecutive triggers are separated by at least the dead time.
    **
    ** The input vector must be sorted, otherwise the behaviour is undefined.
+   **
+   ** The input is split into chunks which are searched in parallel, each one starting with an empty window.
+   ** The chunk results are stitched in order: Starting from the true state at the chunk start, the serial
+   ** search is repeated until it produces a trigger on the same datum as the chunk search. From there on,
+   ** both searches are identical, so the rest of the chunk result is taken over. The result is thus exactly
+   ** the one of a serial search over the full input.
    **/
   class TimeClusterTrigger {
 
@@ -63,14 +70,41 @@ namespace cbm::algo::evbuild
      **/
     resultType operator()(const std::vector<double>& dataVec) const;
 
+    /** @brief Set the number of time stamps per parallel chunk (default: 65536) **/
+    void SetChunkSize(size_t chunkSize) { fChunkSize = std::max<size_t>(chunkSize, 1); }
+
     /** @brief Info to string **/
     std::string ToString() const;
 
 
    private:
+    /** @brief Trigger window, given by the indices of its first and last datum **/
+    struct Window {
+      size_t first;
+      size_t last;
+    };
+
+    /** @brief State of the serial search **/
+    struct State {
+      size_t winStart;  ///< First datum in the window
+      size_t current;   ///< Datum to check next
+    };
+
+    /** @brief Serial search
+     ** @param data     Time stamps
+     ** @param state    State to start from, updated on return
+     ** @param end      Stop when reaching this datum
+     ** @param triggers Found triggers are appended here
+     ** @param sync     If given, stop after a trigger on one of these data (sorted)
+     ** @return Index in sync of the trigger that stopped the search, or sync.size()
+     **/
+    size_t Search(const std::vector<double>& data, State& state, size_t end, std::vector<Window>& triggers,
+                  const std::vector<Window>* sync = nullptr) const;
+
     double fWinSize     = 0.;
     int32_t fMinNumData = 0;
     double fDeadTime    = 0.;
+    size_t fChunkSize   = 1 << 16;
   };
 
 
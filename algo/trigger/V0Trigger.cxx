@@ -4,6 +4,9 @@
 
 #include "V0Trigger.h"
 
+#include "compat/OpenMP.h"
+
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 
@@ -22,47 +25,102 @@ namespace cbm::algo::evbuild
 
     Result result;
 
-    size_t numTracksUsed = 0;
-    for (auto trackIter1 = tracks.begin(); trackIter1 != tracks.end(); trackIter1++) {
-      if (!Select(*trackIter1, config)) continue;
-      numTracksUsed++;
-      for (auto trackIter2 = std::next(trackIter1); trackIter2 != tracks.end(); trackIter2++) {
-        if (!Select(*trackIter2, config)) continue;
+    // Apply the track cuts once
+    const TrackSoA soa         = SelectTracks(tracks, config);
+    const size_t numTracksUsed = soa.size();
+
+    // Trigger times per thread
+    std::vector<std::vector<double>> threadTriggers(openmp::GetMaxThreads());
+
+    size_t errTracksUnsorted         = 0;
+    size_t numTrackPairs             = 0;
+    size_t numTrackPairsAfterTimeCut = 0;
+    size_t numTrackPairsAfterDistCut = 0;
+    size_t numTrackPairsAfterZCut    = 0;
+
+    CBM_PARALLEL(reduction(+ : errTracksUnsorted, numTrackPairs, numTrackPairsAfterTimeCut, numTrackPairsAfterDistCut,
+                           numTrackPairsAfterZCut))
+    {
+      auto& triggers = threadTriggers[openmp::GetThreadNum()];
+      std::vector<double> zVertex;
+      std::vector<double> dist2;
+
+      qa::HistogramShards<qa::H1D>::Shard* phDeltaT  = nullptr;
+      qa::HistogramShards<qa::H1D>::Shard* phZVertex = nullptr;
+      qa::HistogramShards<qa::H1D>::Shard* phDca     = nullptr;
+      if (fpQa->IsActive()) {
+        phDeltaT  = &fpQa->fpPairDeltaTShards->Local();
+        phZVertex = &fpQa->fpPairZVertexShards->Local();
+        phDca     = &fpQa->fpPairDcaShards->Local();
+      }
 
-        // Check track time difference
-        float time1 = trackIter1->fParPV.GetTime();
-        float time2 = trackIter2->fParPV.GetTime();
+      CBM_OMP(for schedule(dynamic, 16))
+      for (size_t iTrack = 0; iTrack < soa.size(); iTrack++) {
+        const float time1 = soa.time[iTrack];
 
-        if (fpQa->IsActive()) {
-          fpQa->fphPairDeltaT->Fill(time2 - time1);
+        // Find the end of the time window
+        size_t jEnd = iTrack + 1;
+        for (; jEnd < soa.size(); jEnd++) {
+          const float time2 = soa.time[jEnd];
+          if (phDeltaT) {
+            phDeltaT->Count(time2 - time1);
+          }
+          if (time2 < time1) {
+            errTracksUnsorted++;
+            continue;
+          }
+          numTrackPairs++;
+          if (time2 - time1 > config.PairDeltaT_max()) break;
         }
 
-        if (time2 < time1) {
-          result.second.errTracksUnsorted++;
-          continue;
-        }
-        result.second.numTrackPairs++;
-        if (time2 - time1 > config.PairDeltaT_max()) break;
-        result.second.numTrackPairsAfterTimeCut++;
-
-        // Check PCA cuts
-        auto [zVertex, dist] = CalcPCA(trackIter1->fParPV, trackIter2->fParPV);
-        if (fpQa->IsActive()) {
-          fpQa->fphPairZVertex->Fill(zVertex);
-          fpQa->fphPairDca->Fill(dist);
-        }
+        // Check PCA cuts for all partners in the time window
+        const size_t jBegin = iTrack + 1;
+        zVertex.resize(jEnd - jBegin);
+        dist2.resize(jEnd - jBegin);
+        CalcPCA(soa, iTrack, jBegin, jEnd, zVertex.data(), dist2.data());
+
+        for (size_t jTrack = jBegin; jTrack < jEnd; jTrack++) {
+          const float time2 = soa.time[jTrack];
+          if (time2 < time1) continue;
+          numTrackPairsAfterTimeCut++;
+
+          const double z    = zVertex[jTrack - jBegin];
+          const double dist = sqrt(dist2[jTrack - jBegin]);
+          if (phZVertex) {
+            phZVertex->Count(z);
+            phDca->Count(dist);
+          }
 
-        if (dist < config.PairDist_max()) {
-          result.second.numTrackPairsAfterDistCut++;
-          if (zVertex >= config.PairZ_min() && zVertex <= config.PairZ_max()) {
-            result.second.numTrackPairsAfterZCut++;
-            double tVertex = 0.5 * (time1 + time2);
-            result.first.push_back(tVertex);
+          if (dist < config.PairDist_max()) {
+            numTrackPairsAfterDistCut++;
+            if (z >= config.PairZ_min() && z <= config.PairZ_max()) {
+              numTrackPairsAfterZCut++;
+              double tVertex = 0.5 * (time1 + time2);
+              triggers.push_back(tVertex);
+            }
           }
         }
       }
     }
 
+    // Merge the trigger times of the threads and sort them by time. The result does not depend on the distribution
+    // of the tracks over the threads, and the event builder gets time-ordered triggers.
+    size_t numTriggers = 0;
+    for (const auto& triggers : threadTriggers) {
+      numTriggers += triggers.size();
+    }
+    result.first.reserve(numTriggers);
+    for (const auto& triggers : threadTriggers) {
+      result.first.insert(result.first.end(), triggers.begin(), triggers.end());
+    }
+    std::sort(result.first.begin(), result.first.end());
+
+    result.second.errTracksUnsorted         = errTracksUnsorted;
+    result.second.numTrackPairs             = numTrackPairs;
+    result.second.numTrackPairsAfterTimeCut = numTrackPairsAfterTimeCut;
+    result.second.numTrackPairsAfterDistCut = numTrackPairsAfterDistCut;
+    result.second.numTrackPairsAfterZCut    = numTrackPairsAfterZCut;
+
     result.second.time = xpu::pop_timer();
     L_(info) << "V0Trigger: tracks " << tracks.size() << ", unsorted " << result.second.errTracksUnsorted
              << ", used tracks " << numTracksUsed << ", track pairs " << result.second.numTrackPairs
@@ -72,36 +130,57 @@ namespace cbm::algo::evbuild
   };
 
 
-  std::pair<double, double> V0Trigger::CalcPCA(const TrackParam& track1, const TrackParam& track2) const
+  V0Trigger::TrackSoA V0Trigger::SelectTracks(const TrackVector& tracks, const V0TriggerConfig& config) const
   {
+    TrackSoA soa;
+    for (const auto& track : tracks) {
+      if (!Select(track, config)) continue;
+      const TrackParam& par = track.fParPV;
+
+      // Start point of the track at z = 0
+      const double x0 = par.GetX() - par.GetTx() * par.GetZ();
+      const double y0 = par.GetY() - par.GetTy() * par.GetZ();
+      soa.x0.push_back(x0);
+      soa.y0.push_back(y0);
+      soa.tx.push_back(par.GetTx());
+      soa.ty.push_back(par.GetTy());
+      soa.time.push_back(par.GetTime());
+    }
+    return soa;
+  }
+
 
+  void V0Trigger::CalcPCA(const TrackSoA& soa, size_t iTrack, size_t jBegin, size_t jEnd, double* z, double* dist2)
+  {
     // Start point and direction of first track at z = 0
-    const double ax = track1.GetX() - track1.GetTx() * track1.GetZ();
-    const double ay = track1.GetY() - track1.GetTy() * track1.GetZ();
-    const double ux = track1.GetTx();
-    const double uy = track1.GetTy();
-
-    // Start point and direction of second track at z = 0
-    const double bx = track2.GetX() - track2.GetTx() * track2.GetZ();
-    const double by = track2.GetY() - track2.GetTy() * track2.GetZ();
-    const double vx = track2.GetTx();
-    const double vy = track2.GetTy();
-
-    // Difference vectors
-    const double cx = ax - bx;
-    const double cy = ay - by;
-    const double wx = ux - vx;
-    const double wy = uy - vy;
-
-    // z coordinate at closest approach in the x-y plane
-    const double z = -1. * (cx * wx + cy * wy) / (wx * wx + wy * wy);
-
-    // Distance at closest approach in the x-y plane
-    const double dx   = cx + z * wx;
-    const double dy   = cy + z * wy;
-    const double dist = sqrt(dx * dx + dy * dy);
-
-    return std::make_pair(z, dist);
+    const double ax = soa.x0[iTrack];
+    const double ay = soa.y0[iTrack];
+    const double ux = soa.tx[iTrack];
+    const double uy = soa.ty[iTrack];
+
+    const double* bx = soa.x0.data() + jBegin;
+    const double* by = soa.y0.data() + jBegin;
+    const double* vx = soa.tx.data() + jBegin;
+    const double* vy = soa.ty.data() + jBegin;
+
+    const size_t n = jEnd - jBegin;
+    CBM_OMP(simd)
+    for (size_t j = 0; j < n; j++) {
+      // Difference vectors
+      const double cx = ax - bx[j];
+      const double cy = ay - by[j];
+      const double wx = ux - vx[j];
+      const double wy = uy - vy[j];
+
+      // z coordinate at closest approach in the x-y plane
+      const double zPca = -1. * (cx * wx + cy * wy) / (wx * wx + wy * wy);
+
+      // Squared distance at closest approach in the x-y plane
+      const double dx = cx + zPca * wx;
+      const double dy = cy + zPca * wy;
+      z[j]            = zPca;
+      dist2[j]        = dx * dx + dy * dy;
+    }
   }
 
 
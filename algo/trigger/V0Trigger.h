@@ -39,6 +39,7 @@ namespace cbm::algo::evbuild
   ** outside of the target area. Tracks are assumed to be straight lines, in the absence of a magnetic field as in mCBM.
   ** The class returns a list of trigger times corresponding to track pairs satisfying the selection criteria:
   ** Maximum time difference, minimum z of PCA, maximum distance at PCA.
+  ** The trigger times are sorted in time; one trigger time per accepted pair, at the mean time of the two tracks.
   **/
   class V0Trigger {
 
@@ -55,7 +56,7 @@ namespace cbm::algo::evbuild
     /** @brief Execution
      ** @param  tracks      Input track vector
      ** @param  config      Trigger configuration
-     ** @return Vector of trigger times and monitoring data
+     ** @return Vector of trigger times (sorted) and monitoring data
      **/
     Result operator()(const TrackVector& tracks, const V0TriggerConfig& config) const;
 
@@ -71,16 +72,42 @@ namespace cbm::algo::evbuild
 
 
    private:
-    /** @brief Calculation of closest approach of two tracks (straight lines)
-     ** @param track1  Parameters of first track
-     ** @param track2  Parameters of second track
-     ** @return (z position, distance)
-     ** 
+    /** @struct TrackSoA
+     ** @brief Parameters of the selected tracks at the primary vertex, as structure of arrays
+     **
+     ** Tracks are straight lines, stored by their position at z = 0 and their slopes.
+     **/
+    struct TrackSoA {
+      std::vector<double> x0;   ///< x at z = 0
+      std::vector<double> y0;   ///< y at z = 0
+      std::vector<double> tx;   ///< Slope dx/dz
+      std::vector<double> ty;   ///< Slope dy/dz
+      std::vector<float> time;  ///< Time at the primary vertex
+
+      size_t size() const { return time.size(); }
+    };
+
+    /** @brief Selection of the tracks used for the trigger
+     ** @param tracks  Input track vector
+     ** @param config  Trigger configuration
+     ** @return Parameters of the selected tracks, in the order of the input
+     **/
+    TrackSoA SelectTracks(const TrackVector& tracks, const V0TriggerConfig& config) const;
+
+    /** @brief Calculation of closest approach of a track with a block of partner tracks (straight lines)
+     ** @param soa     Selected tracks
+     ** @param iTrack  Index of the track
+     ** @param jBegin  Index of the first partner track
+     ** @param jEnd    Index after the last partner track
+     ** @param z       Output: z position of closest approach [jEnd - jBegin]
+     ** @param dist2   Output: squared distance at closest approach [jEnd - jBegin]
+     **
      ** The closest approach is defined at the z position where the transverse distance of the tracks (in the x-y plane) is minimal.
      ** This is not strictly the minimal distance in 3-d space, which is mathematically and computationally more involved.
      ** It should be a good criterion for the purpose of finding displaced vertices.
+     ** The block is processed as one SIMD loop over the partner tracks.
      **/
-    std::pair<double, double> CalcPCA(const TrackParam& track1, const TrackParam& track2) const;
+    static void CalcPCA(const TrackSoA& soa, size_t iTrack, size_t jBegin, size_t jEnd, double* z, double* dist2);
 
     /** @brief Check track cuts 
      ** @param track  Track
@@ -10,8 +10,12 @@
 #include "UnpackMSBase.h"
 #include "compat/Algorithm.h"
 #include "compat/OpenMP.h"
+#include "util/RecyclingBuffer.h"
 #include "util/StlUtils.h"
+#include "util/TaskGraph.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <gsl/span>
 #include <map>
@@ -33,8 +37,13 @@ namespace cbm::algo
       size_t sizeBytesOut     = 0;  // total size of unpacked digis
       size_t errInvalidSysVer = 0;
       size_t errInvalidEqId   = 0;
+      size_t numUnsortedMs    = 0;  // number of microslices with digis not ordered in time
+      double time             = 0;  // wall time of unpacking, incl. merging and sorting [ms]
 
       double ExpansionFactor() const { return sizeBytesIn > 0 ? static_cast<double>(sizeBytesOut) / sizeBytesIn : 0.0; }
+
+      // Unpack throughput in GB/s of microslice contents
+      double Throughput() const { return time > 0 ? sizeBytesIn / time * 1e-6 : 0.0; }
     };
 
     /**
@@ -52,6 +61,106 @@ namespace cbm::algo
       ~MSData() = default;
     };
 
+    /**
+     * @brief Number of elements of a within the first d elements of the stable merge of a and b (merge path co-rank)
+     */
+    template<class T, class Less>
+    size_t MergeCoRank(const T* a, size_t na, const T* b, size_t nb, size_t d, Less less)
+    {
+      size_t lo = d > nb ? d - nb : 0;
+      size_t hi = std::min(d, na);
+      while (lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        if (!less(b[d - i - 1], a[i])) {  // a[i] is merged before b[d - i - 1]
+          lo = i + 1;
+        }
+        else {
+          hi = i;
+        }
+      }
+      return lo;
+    }
+
+    /**
+     * @brief Merge runs of sorted elements into one sorted sequence
+     * @param data Elements, sorted within each run
+     * @param runs Start offsets of the runs, followed by data.size(). Empty runs are allowed.
+     * @param buffer Scratch space, resized to data.size(). It may be swapped with data.
+     * @param less Ordering of the elements
+     *
+     * Merges pairs of neighbouring runs until a single run is left. This takes O(n log k) for k runs instead of
+     * O(n log n) for a full sort. The merge is stable: equal elements keep the order of their runs.
+     *
+     * The number of pairs halves in every round, so the last rounds would merge one or two pairs over the whole
+     * array. Instead, each round is cut into slices of about equal output size. The input range of a slice is found
+     * with a binary search along the merge path (MergeCoRank), and all slices of a round are merged in parallel.
+     */
+    template<class T, class Less>
+    void MergeRuns(PODVector<T>& data, gsl::span<const size_t> runs, PODVector<T>& buffer, Less less)
+    {
+      constexpr size_t MinSliceSize = 1 << 14;  // Elements, keeps the binary searches negligible
+
+      // Drop empty runs and runs that continue the previous run
+      std::vector<size_t> bounds;
+      bounds.reserve(runs.size());
+      for (size_t i = 0; i + 1 < runs.size(); i++) {
+        if (runs[i] == runs[i + 1]) continue;
+        if (!bounds.empty() && !less(data[runs[i]], data[runs[i] - 1])) continue;
+        bounds.push_back(runs[i]);
+      }
+      bounds.push_back(data.size());
+      if (bounds.size() <= 2) return;
+
+      const size_t nSlicesMax = 4 * openmp::GetMaxThreads();
+      const size_t sliceSize  = std::max(MinSliceSize, (data.size() + nSlicesMax - 1) / nSlicesMax);
+
+      // Output range [first, last) of the merge of [begin, mid) and [mid, end)
+      struct Slice {
+        size_t begin, mid, end, first, last;
+      };
+      std::vector<Slice> slices;
+
+      buffer.resize(data.size());
+      T* src = data.data();
+      T* dst = buffer.data();
+      while (bounds.size() > 2) {
+        const size_t nRuns  = bounds.size() - 1;
+        const size_t nPairs = (nRuns + 1) / 2;
+        slices.clear();
+        for (size_t p = 0; p < nPairs; p++) {
+          const size_t begin = bounds[2 * p];
+          const size_t mid   = bounds[std::min(2 * p + 1, nRuns)];
+          const size_t end   = bounds[std::min(2 * p + 2, nRuns)];
+          for (size_t first = 0; first < end - begin; first += sliceSize) {
+            slices.push_back({begin, mid, end, first, std::min(first + sliceSize, end - begin)});
+          }
+        }
+
+        CBM_PARALLEL_FOR(schedule(dynamic))
+        for (size_t iSlice = 0; iSlice < slices.size(); iSlice++) {
+          const auto& s   = slices[iSlice];
+          const T* a      = src + s.begin;
+          const T* b      = src + s.mid;
+          const size_t na = s.mid - s.begin;
+          const size_t nb = s.end - s.mid;
+          const size_t i0 = MergeCoRank(a, na, b, nb, s.first, less);
+          const size_t i1 = MergeCoRank(a, na, b, nb, s.last, less);
+          std::merge(a + i0, a + i1, b + (s.first - i0), b + (s.last - i1), dst + s.begin + s.first, less);
+        }
+
+        std::vector<size_t> merged;
+        merged.reserve(nPairs + 1);
+        for (size_t p = 0; p < nPairs; p++) {
+          merged.push_back(bounds[2 * p]);
+        }
+        merged.push_back(bounds.back());
+        bounds = std::move(merged);
+        std::swap(src, dst);
+      }
+
+      if (src != data.data()) data.swap(buffer);
+    }
+
   }  // namespace detail
 
   template<class MSMonitor>
@@ -79,6 +188,12 @@ namespace cbm::algo
 
   template<class Digi, class MSMonitor, class MSAux>
   class CommonUnpacker {
+   public:
+    /**
+     * @brief Return the digis of a previous timeslice, their memory is reused as output of the next one
+    **/
+    void Recycle(PODVector<Digi>&& digis) { fOutputBuffer.Give(std::move(digis)); }
+
    protected:
     using Monitor_t = UnpackMonitor<MSMonitor>;
     using Aux_t     = UnpackAux<MSAux>;
@@ -89,7 +204,8 @@ namespace cbm::algo
 
     Result_t DoUnpack(const fles::Subsystem subsystem, const fles::Timeslice& ts) const
     {
-      xpu::scoped_timer t_(fles::to_string(subsystem));
+      TaskTimer t_(fles::to_string(subsystem));
+      auto start      = std::chrono::steady_clock::now();
       auto legalEqIds = GetEqIds();
 
       detail::MSData msData{ts, subsystem, gsl::make_span(legalEqIds)};
@@ -99,6 +215,7 @@ namespace cbm::algo
       auto& digisOut   = std::get<0>(out);
       auto& monitorOut = std::get<1>(out);
       auto& auxOut     = std::get<2>(out);
+      digisOut         = fOutputBuffer.Take();
 
       static_cast<detail::UnpackMonitorBase&>(monitorOut) = msData.monitor;
 
@@ -106,10 +223,10 @@ namespace cbm::algo
       monitorOut.msMonitor.resize(numMs);             // monitoring data per microslice
       auxOut.msAux.resize(numMs);                     // auxiliary data per microslice
 
-      xpu::t_add_bytes(msData.monitor.sizeBytesIn);
+      TaskTimer::AddBytes(msData.monitor.sizeBytesIn);
 
-      xpu::push_timer("Unpack");
-      xpu::t_add_bytes(msData.monitor.sizeBytesIn);
+      TaskTimer::Push("Unpack");
+      TaskTimer::AddBytes(msData.monitor.sizeBytesIn);
       CBM_PARALLEL_FOR(schedule(dynamic))
       for (size_t i = 0; i < numMs; i++) {
         auto& msDesc = msData.msDesc[i];
@@ -134,40 +251,66 @@ namespace cbm::algo
         monitorOut.msMonitor[i] = std::move(std::get<1>(result));
         auxOut.msAux[i]         = std::move(std::get<2>(result));
       }
-      xpu::pop_timer();
+      TaskTimer::Pop();
 
-      xpu::push_timer("Resize");
-      size_t nDigisTotal = 0;
-      for (const auto& digis : msDigis) {
-        nDigisTotal += digis.size();
+      TaskTimer::Push("Resize");
+      // Output offset of each microslice
+      std::vector<size_t> msOffsets(numMs + 1, 0);
+      for (size_t i = 0; i < numMs; i++) {
+        msOffsets[i + 1] = msOffsets[i] + msDigis[i].size();
       }
+      const size_t nDigisTotal = msOffsets[numMs];
       digisOut.resize(nDigisTotal);
       monitorOut.sizeBytesOut = nDigisTotal * sizeof(Digi);
-      xpu::pop_timer();
-
-      xpu::push_timer("Merge");
-      xpu::t_add_bytes(monitorOut.sizeBytesOut);
-      CBM_PARALLEL_FOR(schedule(dynamic))
+      TaskTimer::Pop();
+
+      // Digis within a microslice are nearly always ordered in time. Sort only the few that aren't, so the merge step
+      // below can work on sorted runs.
+      TaskTimer::Push("Merge");
+      TaskTimer::AddBytes(monitorOut.sizeBytesOut);
+      size_t numUnsortedMs = 0;
+      CBM_PARALLEL_FOR(schedule(dynamic) reduction(+ : numUnsortedMs))
       for (size_t i = 0; i < numMs; i++) {
-        size_t offset = 0;
-        for (size_t x = 0; x < i; x++)
-          offset += msDigis[x].size();
-        std::copy(msDigis[i].begin(), msDigis[i].end(), digisOut.begin() + offset);
+        auto first = digisOut.begin() + msOffsets[i];
+        auto last  = digisOut.begin() + msOffsets[i + 1];
+        std::copy(msDigis[i].begin(), msDigis[i].end(), first);
+        std::vector<Digi>().swap(msDigis[i]);
+        if (!std::is_sorted(first, last, TimeLess)) {
+          std::sort(first, last, TimeLess);
+          numUnsortedMs++;
+        }
       }
-      xpu::pop_timer();
+      monitorOut.numUnsortedMs = numUnsortedMs;
+      TaskTimer::Pop();
+
+      TaskTimer::Push("Sort");
+      TaskTimer::AddBytes(monitorOut.sizeBytesOut);
+      DoMerge(digisOut, msOffsets);
+      TaskTimer::Pop();
 
-      xpu::push_timer("Sort");
-      xpu::t_add_bytes(monitorOut.sizeBytesOut);
-      DoSort(digisOut);
-      xpu::pop_timer();
+      monitorOut.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      L_(debug) << "Unpacked " << ToString(subsystem) << ": " << monitorOut.Throughput() << " GB/s";
 
       return out;
     }
 
    private:
-    void DoSort(gsl::span<Digi> digis) const
+    // Memory kept between timeslices. Unpackers are called by one thread at a time, so no locking is needed.
+    mutable RecyclingBuffer<Digi> fOutputBuffer;  //< Output digis, returned via Recycle()
+    mutable RecyclingBuffer<Digi> fMergeBuffer;   //< Scratch space of DoMerge
+
+    static bool TimeLess(const Digi& a, const Digi& b) { return a.GetTime() < b.GetTime(); }
+
+    /**
+     * @brief Sort digis by time, given runs of digis that are already sorted
+     * @param runs Start offsets of the sorted runs, followed by digis.size()
+     */
+    void DoMerge(PODVector<Digi>& digis, gsl::span<const size_t> runs) const
     {
-      Sort(digis.begin(), digis.end(), [](const Digi& a, const Digi& b) { return a.GetTime() < b.GetTime(); });
+      PODVector<Digi> buffer = fMergeBuffer.Take();
+      // Lambda instead of a function pointer, so the comparison is inlined into the merge
+      detail::MergeRuns(digis, runs, buffer, [](const Digi& a, const Digi& b) { return TimeLess(a, b); });
+      fMergeBuffer.Give(std::move(buffer));
     }
 
     std::vector<u16> GetEqIds() const
@@ -0,0 +1,259 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+/** @file CbmCalendarQueue.h
+ ** @date 18.10.2025
+ **/
+
+#ifndef CBMCALENDARQUEUE_H
+#define CBMCALENDARQUEUE_H 1
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+/** @class CbmCalendarQueue
+ ** @brief Time-ordered buffer of data, sorted into time bins (calendar queue)
+ ** @date 18 October 2025
+ **
+ ** Data are inserted with their time into the bin (bucket) the time falls
+ ** into, without sorting (amortised constant time). Only when the data are
+ ** read out, the content of a bucket is sorted. Data with equal time are
+ ** read out in the order of insertion, as for a std::multimap.
+ **
+ ** The buckets form a ring, which covers the time range from the first to
+ ** the last datum in the queue. The ring grows (doubling the number of
+ ** buckets) if data outside of this range are inserted. The buckets keep
+ ** their memory after being read out, such that in a long run, the queue
+ ** does not allocate memory per datum.
+ **
+ ** The bin width should be of the order of the average time between
+ ** subsequent data, such that the buckets are small. The bins are counted
+ ** from the time of the first datum inserted into the empty queue. If the
+ ** data in the queue span more than kMaxNofBins bins, the bin width is
+ ** doubled (the data are re-sorted into the wider bins), such that the
+ ** memory of the ring stays bounded. The initial bin width is restored
+ ** when the queue runs empty.
+ **
+ ** Times which are not finite (NaN, infinity) cannot be sorted and are
+ ** rejected with std::invalid_argument.
+ **/
+template<class Data>
+class CbmCalendarQueue {
+
+ public:
+  /** @brief Datum with its time **/
+  typedef std::pair<double, Data> Entry;
+
+
+  /** @brief Constructor
+     ** @param binWidth  Width of the time bins [ns]
+     **/
+  CbmCalendarQueue(double binWidth = 100.) : fBinWidthInit(binWidth), fBinWidth(binWidth), fBuckets(1)
+  {
+    assert(binWidth > 0.);
+  }
+
+
+  /** @brief Check whether the queue is empty **/
+  bool Empty() const { return fSize == 0; }
+
+
+  /** @brief Number of data in the queue **/
+  size_t Size() const { return fSize; }
+
+
+  // --------------------------------------------------------------------------
+  /** @brief Time of the earliest datum in the queue
+     ** @value Time of the earliest datum; -1 if the queue is empty
+     **/
+  double GetTimeFirst() const
+  {
+    if (fSize == 0) return -1.;
+    for (int64_t bin = fFirstBin; bin <= fLastBin; bin++) {
+      const Bucket& bucket = GetBucket(bin);
+      if (bucket.fBegin == bucket.fEntries.size()) continue;
+      auto first = std::min_element(bucket.fEntries.begin() + bucket.fBegin, bucket.fEntries.end(), Before);
+      return first->first;
+    }
+    return -1.;  // Not reached for a consistent queue
+  }
+  // --------------------------------------------------------------------------
+
+
+  /** @brief Time of the latest datum in the queue
+     ** @value Time of the latest datum; -1 if the queue is empty
+     **/
+  double GetTimeLast() const { return fSize == 0 ? -1. : fTimeLast; }
+
+
+  // --------------------------------------------------------------------------
+  /** @brief Insert a datum into the queue
+     ** @param time  Time of the datum [ns]
+     ** @param data  Datum
+     ** @throw std::invalid_argument if the time is not finite or its distance to the data in the queue is not
+     **/
+  void Insert(double time, Data&& data)
+  {
+    if (!std::isfinite(time) || (fSize > 0 && !std::isfinite(time - fTimeOrigin)))
+      throw std::invalid_argument("CbmCalendarQueue::Insert: time is not finite");
+
+    if (fSize == 0) {
+      fBinWidth   = fBinWidthInit;
+      fTimeOrigin = time;
+      fFirstBin   = 0;
+      fLastBin    = 0;
+      fTimeLast   = time;
+    }
+    else {
+      while (!Fits(time))
+        Rebin();
+      int64_t bin = GetBin(time);
+      if (bin < fFirstBin || bin > fLastBin) Cover(std::min(bin, fFirstBin), std::max(bin, fLastBin));
+      fTimeLast = std::max(fTimeLast, time);
+    }
+
+    Bucket& bucket = GetBucket(GetBin(time));
+    if (bucket.fBegin < bucket.fEntries.size() && time < bucket.fEntries.back().first) bucket.fSorted = false;
+    bucket.fEntries.emplace_back(time, std::move(data));
+    fSize++;
+  }
+  // --------------------------------------------------------------------------
+
+
+  // --------------------------------------------------------------------------
+  /** @brief Remove the earliest data from the queue
+     ** @param checkLimit  If false, all data are removed
+     ** @param maxTime     Data with time before maxTime are removed [ns]
+     ** @param func        Called as func(time, data) for each removed datum, in time order
+     ** @value Number of removed data
+     **/
+  template<class Func>
+  size_t Drain(bool checkLimit, double maxTime, Func&& func)
+  {
+    size_t nData = 0;
+    while (fSize > 0) {
+      Bucket& bucket = GetBucket(fFirstBin);
+      if (!bucket.fSorted) {
+        std::stable_sort(bucket.fEntries.begin() + bucket.fBegin, bucket.fEntries.end(), Before);
+        bucket.fSorted = true;
+      }
+      while (bucket.fBegin < bucket.fEntries.size()) {
+        Entry& entry = bucket.fEntries[bucket.fBegin];
+        if (checkLimit && !(entry.first < maxTime)) return nData;
+        func(entry.first, entry.second);
+        bucket.fBegin++;
+        fSize--;
+        nData++;
+      }
+      bucket.fEntries.clear();  // Keeps the capacity
+      bucket.fBegin = 0;
+      if (fSize > 0) fFirstBin++;
+    }
+    return nData;
+  }
+  // --------------------------------------------------------------------------
+
+
+ private:
+  /** @brief Data in one time bin **/
+  struct Bucket {
+    std::vector<Entry> fEntries {};  ///< Data, sorted by time if fSorted
+    size_t fBegin = 0;               ///< Number of data already removed
+    bool fSorted  = true;            ///< Data after fBegin are sorted by time
+  };
+
+  /** @brief Maximal number of bins covered by the ring **/
+  static constexpr int64_t kMaxNofBins = int64_t(1) << 16;
+
+  double fBinWidthInit;          ///< Initial width of the time bins [ns]
+  double fBinWidth;              ///< Width of the time bins [ns]
+  std::vector<Bucket> fBuckets;  ///< Ring of buckets, size is a power of 2
+  double fTimeOrigin = 0.;       ///< Time of the lower edge of bin 0 [ns]
+  int64_t fFirstBin  = 0;        ///< First bin which may contain data
+  int64_t fLastBin   = 0;        ///< Last bin which may contain data
+  double fTimeLast   = 0.;       ///< Time of the latest datum [ns]
+  size_t fSize       = 0;        ///< Number of data
+
+
+  /** @brief Comparison of data by time **/
+  static bool Before(const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; }
+
+
+  /** @brief Check whether the ring can cover a given time within kMaxNofBins bins **/
+  bool Fits(double time) const
+  {
+    double bin = std::floor((time - fTimeOrigin) / fBinWidth);
+    return std::max(bin, double(fLastBin)) - std::min(bin, double(fFirstBin)) < double(kMaxNofBins);
+  }
+
+
+  /** @brief Time bin of a given time, which must fit into the ring **/
+  int64_t GetBin(double time) const { return static_cast<int64_t>(std::floor((time - fTimeOrigin) / fBinWidth)); }
+
+
+  /** @brief Bin of doubled width containing a given bin **/
+  static int64_t HalfBin(int64_t bin) { return bin >= 0 ? bin / 2 : -((1 - bin) / 2); }
+
+
+  /** @brief Bucket of a given time bin **/
+  Bucket& GetBucket(int64_t bin) { return fBuckets[bin & (fBuckets.size() - 1)]; }
+  const Bucket& GetBucket(int64_t bin) const { return fBuckets[bin & (fBuckets.size() - 1)]; }
+
+
+  // --------------------------------------------------------------------------
+  /** @brief Extend the ring such that it covers the given range of bins
+     ** @param firstBin  First bin to be covered
+     ** @param lastBin   Last bin to be covered
+     **/
+  void Cover(int64_t firstBin, int64_t lastBin)
+  {
+    size_t nBins = fBuckets.size();
+    while (static_cast<int64_t>(nBins) <= lastBin - firstBin)
+      nBins *= 2;
+    if (nBins != fBuckets.size()) {
+      std::vector<Bucket> buckets(nBins);
+      for (int64_t bin = fFirstBin; bin <= fLastBin; bin++)
+        buckets[bin & (nBins - 1)] = std::move(GetBucket(bin));
+      fBuckets.swap(buckets);
+    }
+    fFirstBin = firstBin;
+    fLastBin  = lastBin;
+  }
+  // --------------------------------------------------------------------------
+
+
+  // --------------------------------------------------------------------------
+  /** @brief Double the bin width
+     **
+     ** Two neighbouring bins are merged into one. The data of the lower bin
+     ** are all earlier than those of the upper one, so the merged bucket is
+     ** sorted if both were sorted.
+     **/
+  void Rebin()
+  {
+    const size_t nBins = fBuckets.size();
+    std::vector<Bucket> buckets(nBins);
+    for (int64_t bin = fFirstBin; bin <= fLastBin; bin++) {
+      Bucket& source = GetBucket(bin);
+      Bucket& target = buckets[HalfBin(bin) & (nBins - 1)];
+      target.fEntries.insert(target.fEntries.end(), std::make_move_iterator(source.fEntries.begin() + source.fBegin),
+                             std::make_move_iterator(source.fEntries.end()));
+      target.fSorted = target.fSorted && source.fSorted;
+    }
+    fBuckets.swap(buckets);
+    fBinWidth *= 2.;
+    fFirstBin = HalfBin(fFirstBin);
+    fLastBin  = HalfBin(fLastBin);
+  }
+  // --------------------------------------------------------------------------
+};
+
+#endif /* CBMCALENDARQUEUE_H */
@@ -10,6 +10,7 @@
 #ifndef CBMDIGITIZE_H
 #define CBMDIGITIZE_H 1
 
+#include "CbmCalendarQueue.h"
 #include "CbmDaq.h"
 #include "CbmDigitizeBase.h"
 #include "CbmMatch.h"
@@ -137,7 +138,7 @@ class CbmDigitize : public CbmDigitizeBase {
   /** @brief Size of DAQ buffer
      ** @value Number of data in the DAQ buffer
      **/
-  ULong64_t GetDaqBufferSize() const { return fDaqBuffer.size(); }
+  ULong64_t GetDaqBufferSize() const { return fDaqBuffer.Size(); }
   // --------------------------------------------------------------------------
 
 
@@ -159,11 +160,7 @@ class CbmDigitize : public CbmDigitizeBase {
   /** @brief Time stamp of first data in the DAQ buffer
      ** @value Time stamp of first data in the DAQ buffer
      **/
-  Double_t GetDaqBufferTimeFirst() const
-  {
-    if (fDaqBuffer.empty()) return -1.;
-    return fDaqBuffer.begin()->first;
-  }
+  Double_t GetDaqBufferTimeFirst() const { return fDaqBuffer.GetTimeFirst(); }
   // --------------------------------------------------------------------------
 
 
@@ -171,11 +168,7 @@ class CbmDigitize : public CbmDigitizeBase {
   /** @brief Time stamp of last data in the DAQ buffer
      ** @value Time stamp of last data in the DAQ buffer
      **/
-  Double_t GetDaqBufferTimeLast() const
-  {
-    if (fDaqBuffer.empty()) return -1.;
-    return (--fDaqBuffer.end())->first;
-  }
+  Double_t GetDaqBufferTimeLast() const { return fDaqBuffer.GetTimeLast(); }
   // --------------------------------------------------------------------------
 
 
@@ -239,7 +232,7 @@ class CbmDigitize : public CbmDigitizeBase {
     if (IsChannelActive(*digi)) {
       std::unique_ptr<Digi> tmpDigi(digi);
       std::unique_ptr<CbmMatch> tmpMatch(match);
-      fDaqBuffer.insert(make_pair(time, std::make_pair(std::move(tmpDigi), std::move(tmpMatch))));
+      fDaqBuffer.Insert(time, std::make_pair(std::move(tmpDigi), std::move(tmpMatch)));
     }
   }
   // --------------------------------------------------------------------------
@@ -253,8 +246,8 @@ class CbmDigitize : public CbmDigitizeBase {
  private:
   /** DAQ buffer. Here, the digis and matches are buffered until they are
       ** filled into the time slice output (ROOT branch).
-      ** The map key is the digi time. **/
-  std::multimap<double, Data> fDaqBuffer;  //!
+      ** The data are sorted into bins of the digi time. **/
+  CbmCalendarQueue<Data> fDaqBuffer;  //!
 
 
   // --------------------------------------------------------------------------
@@ -292,50 +285,39 @@ class CbmDigitize : public CbmDigitizeBase {
       LOG(fatal) << GetName() << ": Unknown time-slice type!";
     }
 
-    // This implementation makes use of the fact that the data in the
-    // DAQ buffer are time-sorted.
-    auto it = fDaqBuffer.begin();
-    while (it != fDaqBuffer.end() && ((!checkMaxTime) || it->first < tMax)) {
+    // The DAQ buffer delivers the data time-sorted and removes them.
+    fDaqBuffer.Drain(checkMaxTime, tMax, [&](Double_t globalTime, Data& data) {
 
       // For regular time-slices, discard digis with negative times.
       // The first time slice starts at t = 0. All data before are just
       // not recorded.
-      if (timeSlice->IsRegular() && it->first < 0.) {
-        it++;
-        continue;
-      }
+      if (timeSlice->IsRegular() && globalTime < 0.) return;
 
       // Digi times before the start of the current time slice
       // should not happen.
-      assert((!checkMinTime) || it->first >= tMin);
+      assert((!checkMinTime) || globalTime >= tMin);
 
-      // TODO: This implementation uses the implicit copy constructor and
-      // manual removal from the source vector. There might be a more
-      // elegant way.
+      // TODO: This implementation uses the implicit copy constructor.
+      // There might be a more elegant way.
       assert(fDigis);
-      Double_t globalTime      = it->first;
-      std::unique_ptr<Digi>& d = it->second.first;
+      std::unique_ptr<Digi>& d = data.first;
       assert(d);
       d->SetTime(globalTime - tMin);
       fDigis->push_back(*d);
       if (fCreateMatches) {
         assert(fMatches);
-        assert(it->second.second);
-        fMatches->push_back(*(it->second.second));
+        assert(data.second);
+        fMatches->push_back(*(data.second));
       }
 
       // Register datum to the time slice header
       if (fCreateMatches)
-        timeSlice->RegisterData(GetSystemId(), it->first, fMatches->at(fMatches->size() - 1));
+        timeSlice->RegisterData(GetSystemId(), globalTime, fMatches->at(fMatches->size() - 1));
       else
-        timeSlice->RegisterData(GetSystemId(), it->first);
+        timeSlice->RegisterData(GetSystemId(), globalTime);
 
       nData++;
-      it++;
-    }
-
-    // Remove the corresponding elements from the buffer
-    fDaqBuffer.erase(fDaqBuffer.begin(), it);
+    });
 
     return nData;
   }
@@ -0,0 +1,135 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CbmCalendarQueue.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+  using Readout = std::vector<std::pair<double, int>>;
+
+  /** Remove data before maxTime from the reference, in the order of a std::multimap **/
+  Readout DrainReference(std::multimap<double, int>& reference, bool checkLimit, double maxTime)
+  {
+    auto last = checkLimit ? reference.lower_bound(maxTime) : reference.end();
+    Readout result(reference.begin(), last);
+    reference.erase(reference.begin(), last);
+    return result;
+  }
+
+  Readout DrainQueue(CbmCalendarQueue<int>& queue, bool checkLimit, double maxTime)
+  {
+    Readout result;
+    size_t nData = queue.Drain(checkLimit, maxTime, [&](double time, int data) { result.emplace_back(time, data); });
+    EXPECT_EQ(nData, result.size());
+    return result;
+  }
+
+  void ExpectSameState(const CbmCalendarQueue<int>& queue, const std::multimap<double, int>& reference)
+  {
+    ASSERT_EQ(queue.Size(), reference.size());
+    EXPECT_EQ(queue.Empty(), reference.empty());
+    if (reference.empty()) return;
+    EXPECT_EQ(queue.GetTimeFirst(), reference.begin()->first);
+    EXPECT_EQ(queue.GetTimeLast(), reference.rbegin()->first);
+  }
+
+  /** Random insertions and partial read-outs, compared to a std::multimap
+   ** @param jump  Probability of a datum far away from the current time
+   **/
+  void CompareToMultimap(unsigned seed, double binWidth, double jump)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> jitter(-500., 2000.);
+    std::uniform_real_distribution<double> far(-1.e9, 1.e12);
+    std::bernoulli_distribution isFar(jump);
+    std::bernoulli_distribution isRepeated(0.05);
+    std::uniform_int_distribution<int> nInsert(0, 200);
+    std::bernoulli_distribution isFull(0.05);
+
+    CbmCalendarQueue<int> queue(binWidth);
+    std::multimap<double, int> reference;
+    double now  = -1.e4;
+    double last = now;
+    int index   = 0;
+    for (int iStep = 0; iStep < 500; iStep++) {
+      for (int i = nInsert(gen); i > 0; i--) {
+        double time = isFar(gen) ? far(gen) : (isRepeated(gen) ? last : now + jitter(gen));
+        queue.Insert(time, int(index));
+        reference.emplace(time, index);
+        last = time;
+        index++;
+      }
+      ExpectSameState(queue, reference);
+
+      now += 1000.;
+      bool checkLimit = !isFull(gen);
+      ASSERT_EQ(DrainQueue(queue, checkLimit, now), DrainReference(reference, checkLimit, now))
+        << "seed " << seed << ", step " << iStep;
+      ExpectSameState(queue, reference);
+    }
+    EXPECT_EQ(DrainQueue(queue, false, 0.), DrainReference(reference, false, 0.));
+    EXPECT_TRUE(queue.Empty());
+  }
+}  // namespace
+
+
+TEST(_GTestCbmCalendarQueue, EqualsMultimap)
+{
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    CompareToMultimap(seed, 10., 0.);
+  }
+}
+
+
+TEST(_GTestCbmCalendarQueue, EqualsMultimapWithLargeGaps)
+{
+  // Data far away from the others force a coarser binning
+  for (unsigned seed = 1; seed <= 2; seed++) {
+    CompareToMultimap(seed, 10., 0.01);
+    CompareToMultimap(seed, 1.e-3, 0.01);
+  }
+}
+
+
+TEST(_GTestCbmCalendarQueue, EqualTimesInInsertionOrder)
+{
+  CbmCalendarQueue<int> queue(10.);
+  for (int i = 0; i < 100; i++) {
+    queue.Insert(i % 2 ? 5. : 1.e15, int(i));
+  }
+  Readout readout = DrainQueue(queue, false, 0.);
+  ASSERT_EQ(readout.size(), 100u);
+  for (int i = 0; i < 50; i++) {
+    EXPECT_EQ(readout[i], std::make_pair(5., 2 * i + 1));
+    EXPECT_EQ(readout[50 + i], std::make_pair(1.e15, 2 * i));
+  }
+}
+
+
+TEST(_GTestCbmCalendarQueue, NonFiniteTimeThrows)
+{
+  constexpr double Inf = std::numeric_limits<double>::infinity();
+  constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  CbmCalendarQueue<int> queue(10.);
+  EXPECT_THROW(queue.Insert(NaN, 0), std::invalid_argument);
+  EXPECT_THROW(queue.Insert(Inf, 0), std::invalid_argument);
+  EXPECT_TRUE(queue.Empty());
+
+  queue.Insert(-1.e308, 1);
+  EXPECT_THROW(queue.Insert(-Inf, 2), std::invalid_argument);
+  EXPECT_THROW(queue.Insert(1.e308, 3), std::invalid_argument);  // Distance to the first datum overflows
+  queue.Insert(-1.e307, 4);
+  EXPECT_EQ(queue.Size(), 2u);
+  EXPECT_EQ(DrainQueue(queue, false, 0.), (Readout {{-1.e308, 1}, {-1.e307, 4}}));
+}
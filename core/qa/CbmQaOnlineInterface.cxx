@@ -22,6 +22,44 @@ using cbm::algo::qa::Prof2D;
 using cbm::qa::OnlineInterface;
 using cbm::qa::RootHistogramAccessor;
 
+namespace
+{
+  /// \brief Adds a qa histogram to a ROOT histogram, if the type and the binning of the ROOT histogram match
+  template<class RootHistogram, class QaHistogram>
+  bool AddToRootHistogram(const QaHistogram& src, TH1* dst)
+  {
+    if (dst == nullptr || dst->IsA() != RootHistogram::Class()) {
+      return false;
+    }
+    if (dst->GetNbinsX() != static_cast<int>(src.GetNbinsX())) {
+      return false;
+    }
+    if constexpr (std::is_base_of_v<TH2D, RootHistogram>) {
+      if (dst->GetNbinsY() != static_cast<int>(src.GetNbinsY())) {
+        return false;
+      }
+    }
+    static_cast<RootHistogramAccessor<RootHistogram>*>(dst)->template AddFromQaHistogram<QaHistogram>(src);
+    return true;
+  }
+}  // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+bool OnlineInterface::AddHistogram(const H1D& src, TH1* dst) { return AddToRootHistogram<TH1D>(src, dst); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+bool OnlineInterface::AddHistogram(const H2D& src, TH1* dst) { return AddToRootHistogram<TH2D>(src, dst); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+bool OnlineInterface::AddHistogram(const Prof1D& src, TH1* dst) { return AddToRootHistogram<TProfile>(src, dst); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+bool OnlineInterface::AddHistogram(const Prof2D& src, TH1* dst) { return AddToRootHistogram<TProfile2D>(src, dst); }
+
 // ---------------------------------------------------------------------------------------------------------------------
 //
 void OnlineInterface::AddSlice(const H1D& src, double value, TH2D* dst)
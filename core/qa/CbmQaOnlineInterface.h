@@ -53,6 +53,11 @@ namespace cbm::qa
     template<class SourceQaHistogram>
     void AddSliceFromQaHistogram(const SourceQaHistogram& histo, double val);
 
+    /// \brief Adds the content of a qa histogram with the same binning
+    /// \param histo  Source histogram
+    template<class QaHistogram>
+    void AddFromQaHistogram(const QaHistogram& histo);
+
     /// \brief Sets fields from qa histogram
     /// \param histo  Source histogram
     template<class QaHistogram>
@@ -76,6 +81,23 @@ namespace cbm::qa
     /// \param dst   Destination 2D-profile
     static void AddSlice(const Prof1D& src, double value, TProfile2D* dst);
 
+    /// \brief Adds a histogram to a ROOT histogram of the same type and binning
+    /// \param src  Source histogram
+    /// \param dst  Destination ROOT histogram
+    /// \return false, if the destination histogram has an incompatible type or binning
+    ///
+    /// The content is added in place, so merging an update does not need a temporary ROOT histogram.
+    static bool AddHistogram(const H1D& src, TH1* dst);
+
+    /// \brief Adds a histogram to a ROOT histogram of the same type and binning
+    static bool AddHistogram(const H2D& src, TH1* dst);
+
+    /// \brief Adds a profile to a ROOT profile of the same type and binning
+    static bool AddHistogram(const Prof1D& src, TH1* dst);
+
+    /// \brief Adds a profile to a ROOT profile of the same type and binning
+    static bool AddHistogram(const Prof2D& src, TH1* dst);
+
     /// \brief Converts histogram H1D to ROOT histogram TH1D
     /// \param hist  1D-histogram
     /// \note  Allocates memory on heap for the ROOT histogram
@@ -141,6 +163,82 @@ namespace cbm::qa
     this->SetEntries(this->GetEntries() + src.GetEntries());
   }
 
+  // -------------------------------------------------------------------------------------------------------------------
+  //
+  template<class RootHistogram>
+  template<class QaHistogram>
+  void RootHistogramAccessor<RootHistogram>::AddFromQaHistogram(const QaHistogram& hist)
+  {
+    if constexpr (std::is_same_v<RootHistogram, TProfile> || std::is_same_v<RootHistogram, TProfile2D>) {
+      auto AddBin = [&](int iBinRoot, const auto& binQa) {
+        if (binQa.GetSumW() == 0.) {
+          return;
+        }
+        this->fArray[iBinRoot] += binQa.GetSumWV();
+        this->fBinEntries.fArray[iBinRoot] += binQa.GetSumW();
+        this->fSumw2.fArray[iBinRoot] += binQa.GetSumWV2();
+        this->fBinSumw2.fArray[iBinRoot] += binQa.GetSumW2();
+        if constexpr (std::is_same_v<RootHistogram, TProfile>) {
+          this->fTsumwy += binQa.GetSumWV();
+          this->fTsumwy2 += binQa.GetSumWV2();
+        }
+        else {
+          this->fTsumwz += binQa.GetSumWV();
+          this->fTsumwz2 += binQa.GetSumWV2();
+        }
+      };
+      if constexpr (std::is_same_v<RootHistogram, TProfile>) {
+        for (int iBinX = 0; iBinX <= this->GetNbinsX() + 1; ++iBinX) {
+          AddBin(this->GetBin(iBinX), hist.GetBinAccumulator(iBinX));
+        }
+      }
+      else {
+        for (int iBinX = 0; iBinX <= this->GetNbinsX() + 1; ++iBinX) {
+          for (int iBinY = 0; iBinY <= this->GetNbinsY() + 1; ++iBinY) {
+            AddBin(this->GetBin(iBinX, iBinY), hist.GetBinAccumulator(iBinX, iBinY));
+          }
+        }
+      }
+    }
+    else if constexpr (std::is_same_v<RootHistogram, TH1D> || std::is_same_v<RootHistogram, TH2D>) {
+      if (hist.GetTotSumW() != hist.GetTotSumW2()) {  // some of weights were not equal to 1.
+        if (!this->fSumw2.fN) {
+          this->Sumw2();
+        }
+      }
+      auto AddBin = [&](int iBinRoot, const auto& binQa) {
+        this->fArray[iBinRoot] += binQa.value();
+        if (this->fSumw2.fN) {
+          this->fSumw2.fArray[iBinRoot] += binQa.variance();
+        }
+      };
+      if constexpr (std::is_same_v<RootHistogram, TH1D>) {
+        for (int iBinX = 0; iBinX <= this->GetNbinsX() + 1; ++iBinX) {
+          AddBin(this->GetBin(iBinX), hist.GetBinAccumulator(iBinX));
+        }
+      }
+      else {
+        for (int iBinX = 0; iBinX <= this->GetNbinsX() + 1; ++iBinX) {
+          for (int iBinY = 0; iBinY <= this->GetNbinsY() + 1; ++iBinY) {
+            AddBin(this->GetBin(iBinX, iBinY), hist.GetBinAccumulator(iBinX, iBinY));
+          }
+        }
+      }
+    }
+
+    // Add total sums
+    if constexpr (std::is_base_of_v<TH2D, RootHistogram>) {
+      this->fTsumwy += hist.GetTotSumWY();
+      this->fTsumwy2 += hist.GetTotSumWY2();
+      this->fTsumwxy += hist.GetTotSumWXY();
+    }
+    this->fTsumw += hist.GetTotSumW();
+    this->fTsumw2 += hist.GetTotSumW2();
+    this->fTsumwx += hist.GetTotSumWX();
+    this->fTsumwx2 += hist.GetTotSumWX2();
+    this->SetEntries(this->GetEntries() + hist.GetEntries());
+  }
+
   // -------------------------------------------------------------------------------------------------------------------
   //
   template<class RootHistogram>
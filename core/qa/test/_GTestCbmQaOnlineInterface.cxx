@@ -0,0 +1,163 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CbmQaOnlineInterface.h"
+#include "Histogram.h"
+#include "TH1.h"
+#include "gtest/gtest.h"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+using cbm::algo::qa::H1D;
+using cbm::algo::qa::H2D;
+using cbm::algo::qa::Prof1D;
+using cbm::qa::OnlineInterface;
+
+namespace
+{
+  /// \brief Sends a histogram through the boost archive used on the wire, and resets it as qa::Data does
+  template<class Histo>
+  Histo Send(Histo& hist)
+  {
+    std::stringstream buffer;
+    {
+      boost::archive::binary_oarchive oarch(buffer);
+      oarch << hist;
+    }
+    hist.Reset();
+    Histo received;
+    boost::archive::binary_iarchive iarch(buffer);
+    iarch >> received;
+    return received;
+  }
+
+  /// \brief Receives an update as histserv's Application::ReadHistogram: the first one creates the ROOT histogram,
+  ///        later ones are merged into it in place
+  template<class Histo>
+  void Receive(const Histo& update, std::unique_ptr<TH1>& server)
+  {
+    if (!server) {
+      server.reset(OnlineInterface::ROOTHistogram(update));
+    }
+    else {
+      ASSERT_TRUE(OnlineInterface::AddHistogram(update, server.get()));
+    }
+  }
+
+  /// \brief Compares bin contents and errors of all bins (including under- and overflow), entries and total sums
+  void ExpectEqualHistograms(const TH1& merged, const TH1& expected)
+  {
+    ASSERT_EQ(merged.GetNcells(), expected.GetNcells());
+    for (int iBin = 0; iBin < expected.GetNcells(); ++iBin) {
+      EXPECT_DOUBLE_EQ(merged.GetBinContent(iBin), expected.GetBinContent(iBin)) << "bin " << iBin;
+      EXPECT_DOUBLE_EQ(merged.GetBinError(iBin), expected.GetBinError(iBin)) << "bin " << iBin;
+    }
+    EXPECT_DOUBLE_EQ(merged.GetEntries(), expected.GetEntries());
+
+    std::array<double, TH1::kNstat> statsMerged{};
+    std::array<double, TH1::kNstat> statsExpected{};
+    merged.GetStats(statsMerged.data());
+    expected.GetStats(statsExpected.data());
+    for (int iStat = 0; iStat < TH1::kNstat; ++iStat) {
+      EXPECT_DOUBLE_EQ(statsMerged[iStat], statsExpected[iStat]) << "stat " << iStat;
+    }
+  }
+}  // namespace
+
+TEST(_GTestCbmQaOnlineInterface, MergeH1DUpdates)
+{
+  TH1::AddDirectory(false);
+  H1D sent("h", "h", 10, 0., 10.);
+  H1D total("h", "h", 10, 0., 10.);
+  std::unique_ptr<TH1> server;
+
+  // First update with unit weights, second one with weights and under- and overflow
+  for (double x : {0.5, 0.5, 3.5, 9.5}) {
+    sent.Fill(x);
+    total.Fill(x);
+  }
+  Receive(Send(sent), server);
+  const std::pair<double, double> weighted[] = {{0.5, 2.}, {4.5, 0.5}, {-1., 3.}, {12., 1.5}};
+  for (auto [x, w] : weighted) {
+    sent.Fill(x, w);
+    total.Fill(x, w);
+  }
+  Receive(Send(sent), server);
+
+  std::unique_ptr<TH1> expected(OnlineInterface::ROOTHistogram(total));
+  ExpectEqualHistograms(*server, *expected);
+  EXPECT_DOUBLE_EQ(server->GetBinContent(1), 4.);
+  EXPECT_DOUBLE_EQ(server->GetBinError(1), std::sqrt(6.));  // 1 + 1 + 2^2
+}
+
+TEST(_GTestCbmQaOnlineInterface, MergeH2DUpdates)
+{
+  TH1::AddDirectory(false);
+  H2D sent("h2", "h2", 4, 0., 4., 3, 0., 3.);
+  H2D total("h2", "h2", 4, 0., 4., 3, 0., 3.);
+  std::unique_ptr<TH1> server;
+
+  for (int iUpdate = 0; iUpdate < 2; ++iUpdate) {
+    for (int x = -1; x <= 4; ++x) {
+      for (int y = -1; y <= 3; ++y) {
+        const double w = iUpdate == 0 ? 1. : 0.5 * (x + y + 3);
+        sent.Fill(x + 0.5, y + 0.5, w);
+        total.Fill(x + 0.5, y + 0.5, w);
+      }
+    }
+    Receive(Send(sent), server);
+  }
+
+  std::unique_ptr<TH1> expected(OnlineInterface::ROOTHistogram(total));
+  ExpectEqualHistograms(*server, *expected);
+}
+
+TEST(_GTestCbmQaOnlineInterface, MergeProf1DUpdates)
+{
+  TH1::AddDirectory(false);
+  Prof1D sent("p", "p", 5, 0., 5.);
+  Prof1D total("p", "p", 5, 0., 5.);
+  std::unique_ptr<TH1> server;
+
+  const std::pair<double, double> first[] = {{0.5, 1.}, {0.5, 3.}, {2.5, -1.}};
+  for (auto [x, y] : first) {
+    sent.Fill(x, y);
+    total.Fill(x, y);
+  }
+  Receive(Send(sent), server);
+  const std::pair<double, double> second[] = {{0.5, 5.}, {2.5, 2.}, {4.5, 7.}};
+  for (auto [x, y] : second) {
+    sent.Fill(x, y, 2.);
+    total.Fill(x, y, 2.);
+  }
+  Receive(Send(sent), server);
+
+  std::unique_ptr<TH1> expected(OnlineInterface::ROOTHistogram(total));
+  ExpectEqualHistograms(*server, *expected);
+  auto* profile = dynamic_cast<TProfile*>(server.get());
+  ASSERT_NE(profile, nullptr);
+  EXPECT_DOUBLE_EQ(profile->GetBinContent(1), (1. + 3. + 2. * 5.) / 4.);
+  EXPECT_DOUBLE_EQ(profile->GetBinEntries(1), 4.);
+}
+
+TEST(_GTestCbmQaOnlineInterface, RejectIncompatibleUpdates)
+{
+  TH1::AddDirectory(false);
+  H1D h1("h", "h", 10, 0., 10.);
+  H1D h1Rebinned("h", "h", 20, 0., 10.);
+  Prof1D p1("p", "p", 10, 0., 10.);
+  std::unique_ptr<TH1> server(OnlineInterface::ROOTHistogram(h1));
+
+  EXPECT_FALSE(OnlineInterface::AddHistogram(h1Rebinned, server.get()));
+  EXPECT_FALSE(OnlineInterface::AddHistogram(p1, server.get()));
+  EXPECT_FALSE(OnlineInterface::AddHistogram(h1, nullptr));
+  EXPECT_TRUE(OnlineInterface::AddHistogram(h1, server.get()));
+}
@@ -51,7 +51,9 @@ namespace cbm::ca
       //       But, if the kf-setup will not be a part of the ca::Parameters, it would not be needed;
       ca::InitManager manager;
       manager.ReadParametersObject(fsInputName.c_str());
-      manager.SetGeometrySetup(TrackingSetupBuilder::Instance()->MakeSetup<ca::fvec>(EFieldMode::Orig));
+      // NOTE: The parameters are serialized, and the CA track fit relies on the interpolated field. The cached field
+      //       (TrackingSetupBuilder::SetGeoSetupFieldMode) is therefore only applied to the geometry setup.
+      manager.SetGeometrySetup(TrackingSetupBuilder::Instance()->MakeSetup<ca::fvec>(EFieldMode::Intrpl));
       fpParameters = std::make_shared<ca::Parameters<float>>(ca::Parameters<float>(manager.TakeParameters()));
     }
 
@@ -6,19 +6,27 @@
 #include "Exceptions.h"
 #include "Options.h"
 #include "Reco.h"
+#include "RecoResultsColumnarArchive.h"
 #include "RecoResultsInputArchive.h"
 #include "RecoResultsOutputArchive.h"
 #include "System.h"
 #include "compat/Algorithm.h"
 #include "compat/OpenMP.h"
 #include "gpu/DeviceImage.h"
+#include "util/BoundedQueue.h"
 #include "util/MemoryLogger.h"
+#include "util/TsUtils.h"
 
 #include <StorableTimeslice.hpp>
 #include <TimesliceAutoSource.hpp>
 
+#include <atomic>
+#include <exception>
+#include <future>
 #include <log.hpp>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include <xpu/host.h>
 
@@ -56,6 +64,29 @@ std::shared_ptr<StorableRecoResults> makeStorableRecoResults(const fles::Timesli
   return storable;
 }
 
+/**
+ * @brief Dump a columnar archive. Only the sections that are printed are loaded.
+ */
+void dumpColumnarArchive(const std::string& path, size_t dumpTracksPerTS)
+{
+  RecoResultsColumnarReader archive(path);
+  L_(info) << "Columnar archive with " << archive.NTimeslices() << " timeslices";
+
+  for (size_t ts = 0; ts < archive.NTimeslices(); ts++) {
+    L_(info) << "TS " << archive.TsIndex(ts) << " start: " << archive.TsStartTime(ts)
+             << ", stsHits: " << archive.Count<sts::Hit>(ts, RecoColumn::StsHits)
+             << ", tofHits: " << archive.Count<tof::Hit>(ts, RecoColumn::TofHits)
+             << ", tracks: " << archive.Count<ca::Track>(ts, RecoColumn::Tracks);
+
+    auto tracks = archive.ReadTracks(ts);
+    for (size_t t = 0; t < std::min(tracks.size(), dumpTracksPerTS); t++) {
+      const auto& track = tracks[t];
+      L_(info) << " - Track " << t << " nHits: " << track.fNofHits << ", chi2: " << track.fParPV.ChiSq()
+               << ", X: " << track.fParPV.X() << ", Y: " << track.fParPV.Y() << ", Z: " << track.fParPV.Z();
+    }
+  }
+}
+
 bool dumpArchive(const Options& opts)
 {
   // Limit the number of events per timeslice to dump to avoid spamming the log
@@ -67,6 +98,11 @@ bool dumpArchive(const Options& opts)
 
   L_(info) << "Dumping archive: " << opts.InputLocator();
 
+  if (RecoResultsColumnarReader::IsColumnarArchive(opts.InputLocator())) {
+    dumpColumnarArchive(opts.InputLocator(), DumpTracksPerTS);
+    return true;
+  }
+
   RecoResultsInputArchive archive(opts.InputLocator());
 
   auto desc = archive.descriptor();
@@ -130,6 +166,212 @@ bool dumpArchive(const Options& opts)
   return true;
 }
 
+void logStageOccupancy(const std::string& stage, double busy, double total, const QueueOccupancy& input)
+{
+  L_(info) << "Pipeline stage " << stage << ": busy " << busy << " ms (" << 100. * busy / total << " %), waited "
+           << input.timePopWait << " ms for input; input queue mean " << input.MeanItems() << " / max "
+           << input.maxItems << " items, max " << input.maxBytes / (1024. * 1024.) << " MB";
+}
+
+/**
+ * @brief Process timeslices with fetching, reconstruction and archive writing (incl. compression) on separate threads
+ *
+ * The stages are connected by bounded queues of depth Options::PipelineDepth. Both queues are also limited by
+ * Options::PipelineMemoryMB. Reconstruction runs on the calling thread.
+ *
+ * The columnar archive is written on the reconstruction thread: it serializes directly from the result buffers, which
+ * are reused by the next timeslice.
+ *
+ * If the reconstruction or the writer fails, the pipeline stops and the error is rethrown. The fetcher cannot be
+ * interrupted while it waits in fles::TimesliceAutoSource::get(). It is joined if it finishes within
+ * FetcherStopTimeout, otherwise it is detached, so that a live source which delivers no more timeslices does not block
+ * the error. The fetcher keeps its own queue alive through a shared state in that case.
+ */
+void processPipelined(const Options& opts, Reco& reco, fles::TimesliceAutoSource& source,
+                      std::optional<RecoResultsOutputArchive>& archive,
+                      std::optional<RecoResultsColumnarWriter>& columnarArchive, MemoryLogger& memoryLogger)
+{
+  using msec = chron::duration<double, std::milli>;
+
+  constexpr auto FetcherStopTimeout = chron::seconds(10);
+
+  // State of the fetcher, shared with the thread in case it has to be detached
+  struct FetchState {
+    FetchState(size_t depth, size_t maxBytes) : queue(depth, maxBytes) {}
+    BoundedQueue<std::unique_ptr<fles::Timeslice>> queue;
+    std::atomic<bool> stop{false};
+    double timeBusy = 0.;  // [ms]
+    std::exception_ptr error;
+    std::promise<void> done;
+  };
+
+  const size_t depth    = opts.PipelineDepth();
+  const size_t maxBytes = opts.PipelineMemoryMB() * 1024 * 1024;
+  auto fetchState       = std::make_shared<FetchState>(depth, maxBytes);
+  auto fetchDone        = fetchState->done.get_future();
+  auto& fetchQueue      = fetchState->queue;
+  BoundedQueue<std::shared_ptr<StorableRecoResults>> writeQueue(depth, maxBytes);
+  L_(info) << "Pipelined processing: queue depth " << depth << ", memory limit per queue "
+           << (maxBytes > 0 ? std::to_string(opts.PipelineMemoryMB()) + " MB" : std::string("none"));
+
+  double timeReco  = 0.;  // busy time of the stages [ms]
+  double timeWrite = 0.;
+  std::exception_ptr writeError;
+
+  // Last write, reported with the monitor metrics of the next reconstructed timeslice
+  std::mutex writeMutex;
+  double lastWriteTime  = 0.;
+  size_t lastWriteBytes = 0;
+
+  auto startPipeline = chron::high_resolution_clock::now();
+
+  std::thread fetcher([&opts, &source, state = fetchState] {
+    try {
+      int tsIdx  = 0;
+      int num_ts = opts.NumTimeslices();
+      if (num_ts > 0) num_ts += opts.SkipTimeslices();
+      auto startFetchTS = chron::high_resolution_clock::now();
+      while (!state->stop) {
+        auto timeslice = source.get();
+        if (!timeslice) break;
+        if (tsIdx < opts.SkipTimeslices()) {
+          tsIdx++;
+          continue;
+        }
+
+        std::unique_ptr<fles::Timeslice> ts;
+        if (opts.ReleaseMode()) {
+          ts = std::make_unique<fles::StorableTimeslice>(*timeslice);
+          timeslice.reset();
+        }
+        else {
+          ts = std::move(timeslice);
+        }
+        state->timeBusy += msec(chron::high_resolution_clock::now() - startFetchTS).count();
+
+        const size_t bytes = ts_utils::SizeBytes(*ts);
+        if (!state->queue.Push(std::move(ts), bytes)) break;
+
+        tsIdx++;
+        if (num_ts > 0 && tsIdx >= num_ts) break;
+        startFetchTS = chron::high_resolution_clock::now();
+      }
+    }
+    catch (...) {
+      state->error = std::current_exception();
+    }
+    state->queue.Close();
+    state->done.set_value();
+  });
+
+  std::thread writer([&] {
+    try {
+      while (auto storable = writeQueue.Pop()) {
+        auto startWrite    = chron::high_resolution_clock::now();
+        const size_t bytes = (*storable)->SizeBytes();
+        archive->put(*storable);
+        storable->reset();
+        const double duration = msec(chron::high_resolution_clock::now() - startWrite).count();
+        timeWrite += duration;
+
+        std::lock_guard lock{writeMutex};
+        lastWriteTime  = duration;
+        lastWriteBytes = bytes;
+      }
+    }
+    catch (...) {
+      writeError = std::current_exception();
+      writeQueue.Close();
+    }
+  });
+
+  ProcessingExtraMonitor extraMonitor;
+  std::exception_ptr recoError;
+  int tsIdx         = opts.SkipTimeslices();
+  auto startFetchTS = chron::high_resolution_clock::now();
+  try {
+    while (auto ts = fetchQueue.Pop()) {
+      extraMonitor.timeIdle          = msec(chron::high_resolution_clock::now() - startFetchTS).count();
+      extraMonitor.nQueuedTimeslices = fetchQueue.Size();
+
+      auto startReco = chron::high_resolution_clock::now();
+      try {
+        RecoResults result = reco.Run(**ts);
+        if (archive) {
+          auto storable      = makeStorableRecoResults(**ts, result);
+          const size_t bytes = storable->SizeBytes();
+          if (!writeQueue.Push(std::move(storable), bytes)) {
+            break;  // The writer failed and closed its queue, its error is rethrown below
+          }
+        }
+        if (columnarArchive) {
+          auto startWrite           = chron::high_resolution_clock::now();
+          extraMonitor.bytesWritten = columnarArchive->Put((*ts)->index(), (*ts)->start_time(), result);
+          extraMonitor.timeWriter   = msec(chron::high_resolution_clock::now() - startWrite).count();
+          timeWrite += extraMonitor.timeWriter;
+        }
+        reco.Recycle(std::move(result));
+      }
+      catch (const ProcessingError& e) {
+        // TODO: Add flag if we want to abort on exception or continue with next timeslice
+        L_(error) << "Caught ProcessingError while processing timeslice " << tsIdx << ": " << e.what();
+      }
+      timeReco += msec(chron::high_resolution_clock::now() - startReco).count();
+
+      extraMonitor.nQueuedResults = writeQueue.Size();
+      if (archive) {
+        std::lock_guard lock{writeMutex};
+        extraMonitor.timeWriter   = lastWriteTime;
+        extraMonitor.bytesWritten = lastWriteBytes;
+      }
+      reco.QueueProcessingExtraMetrics(extraMonitor);
+
+      // Release memory after each timeslice and log memory usage
+      // This is useful to detect memory leaks as the memory usage should be constant between timeslices
+      ts->reset();
+      memoryLogger.Log();
+
+      tsIdx++;
+      startFetchTS = chron::high_resolution_clock::now();
+    }
+  }
+  catch (...) {
+    // Stop the other stages before leaving, otherwise the threads are destroyed while still joinable
+    recoError = std::current_exception();
+  }
+
+  fetchState->stop = true;
+  fetchQueue.Close();
+  writeQueue.Close();
+  writer.join();
+  const bool fetcherStopped = fetchDone.wait_for(FetcherStopTimeout) == std::future_status::ready;
+  if (fetcherStopped) {
+    fetcher.join();
+  }
+  else {
+    // Only reached after an error: the loop above ends regularly only once the fetcher has closed its queue
+    L_(error) << "Timeslice fetcher did not stop within " << FetcherStopTimeout.count()
+              << " s, detaching it from the failed pipeline";
+    fetcher.detach();
+  }
+
+  const double total = msec(chron::high_resolution_clock::now() - startPipeline).count();
+  if (fetcherStopped) {
+    L_(info) << "Pipeline stage fetch: busy " << fetchState->timeBusy << " ms (" << 100. * fetchState->timeBusy / total
+             << " %), waited " << fetchQueue.Stats().timePushWait << " ms for free queue space";
+  }
+  logStageOccupancy("reco", timeReco, total, fetchQueue.Stats());
+  if (archive) logStageOccupancy("write", timeWrite, total, writeQueue.Stats());
+  if (columnarArchive) {
+    L_(info) << "Columnar archive: wrote " << timeWrite << " ms on the reco thread (" << 100. * timeWrite / total
+             << " %)";
+  }
+
+  if (recoError) std::rethrow_exception(recoError);
+  if (writeError) std::rethrow_exception(writeError);
+  if (fetcherStopped && fetchState->error) std::rethrow_exception(fetchState->error);
+}
+
 int main(int argc, char** argv)
 {
   Options opts(argc, argv);
@@ -178,7 +420,12 @@ int main(int argc, char** argv)
   ProcessingExtraMonitor extraMonitor;
 
   std::optional<RecoResultsOutputArchive> archive;
-  if (!opts.OutputFile().empty()) {
+  std::optional<RecoResultsColumnarWriter> columnarArchive;
+  if (!opts.OutputFile().empty() && opts.ColumnarArchive()) {
+    L_(info) << "Writing results to columnar archive: " << opts.OutputFile();
+    columnarArchive.emplace(opts.OutputFile().string(), opts.CompressArchive());
+  }
+  else if (!opts.OutputFile().empty()) {
     L_(info) << "Writing results to file: " << opts.OutputFile();
     fles::ArchiveCompression compression = fles::ArchiveCompression::None;
     if (opts.CompressArchive()) {
@@ -187,6 +434,18 @@ int main(int argc, char** argv)
     archive.emplace(opts.OutputFile().string(), compression);
   }
 
+  if (opts.PipelineDepth() > 0) {
+    processPipelined(opts, reco, source, archive, columnarArchive, memoryLogger);
+    if (archive) archive->end_stream();
+    if (columnarArchive) columnarArchive->Close();
+
+    reco.Finalize();
+    auto endProcessing = chron::high_resolution_clock::now();
+    auto duration      = chron::duration_cast<chron::milliseconds>(endProcessing - startProcessing);
+    L_(info) << "Total Processing time (Wall): " << duration.count() << " ms";
+    return 0;
+  }
+
   int tsIdx  = 0;
   int num_ts = opts.NumTimeslices();
   if (num_ts > 0) num_ts += opts.SkipTimeslices();
@@ -221,6 +480,12 @@ int main(int argc, char** argv)
         xpu::t_add_bytes(extraMonitor.bytesWritten);
         archive->put(storable);
       }
+      if (columnarArchive) {
+        xpu::scoped_timer t_{"Write Archive", &extraMonitor.timeWriteArchive};
+        extraMonitor.bytesWritten = columnarArchive->Put(ts->index(), ts->start_time(), result);
+        xpu::t_add_bytes(extraMonitor.bytesWritten);
+      }
+      reco.Recycle(std::move(result));
     }
     catch (const ProcessingError& e) {
       // TODO: Add flag if we want to abort on exception or continue with next timeslice
@@ -241,6 +506,7 @@ int main(int argc, char** argv)
   }
 
   if (archive) archive->end_stream();
+  if (columnarArchive) columnarArchive->Close();
 
   reco.Finalize();
   auto endProcessing = chron::high_resolution_clock::now();
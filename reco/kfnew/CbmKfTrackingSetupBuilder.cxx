@@ -63,10 +63,9 @@ void TrackingSetupBuilder::CheckDetectorPresence()
 //
 std::shared_ptr<const cbm::algo::kf::Setup<double>> TrackingSetupBuilder::GetSharedGeoSetup()
 {
-  using cbm::algo::kf::EFieldMode;
   using cbm::algo::kf::Setup;
   if (!fpGeoSetup.get()) {
-    fpGeoSetup = std::make_shared<Setup<double>>(this->MakeSetup<double>(EFieldMode::Orig));
+    fpGeoSetup = std::make_shared<Setup<double>>(this->MakeSetup<double>(fGeoSetupFieldMode));
   }
   return fpGeoSetup;
 }
@@ -81,6 +80,7 @@ try {
   CheckDetectorPresence();
 
   fBuilder.Reset();
+  fBuilder.SetFieldCache(fFieldCacheStep, fFieldCacheMaxDeviation);
   // Magnetic field initialization
   if (auto* pField = FairRunAna::Instance()->GetField()) {
     LOG(info) << fabs(pField->GetBx(0., 0., 0.)) << ", " << fabs(pField->GetBy(0., 0., 0.)) << ", "
@@ -48,6 +48,26 @@ namespace cbm::kf
     /// \brief  Checks, if a tracking detector has hits
     bool HasHits(cbm::algo::ca::EDetectorID detID) const { return fvbDetHasHits[detID]; }
 
+    /// \brief Sets parameters of the cached field (EFieldMode::Cached)
+    /// \param step          Initial distance between the grid nodes [cm]
+    /// \param maxDeviation  Maximal deviation of the cached field from the field function [kG]
+    void SetFieldCache(double step, double maxDeviation)
+    {
+      fFieldCacheStep         = step;
+      fFieldCacheMaxDeviation = maxDeviation;
+      fbInitialized           = false;
+      fpGeoSetup              = nullptr;
+    }
+
+    /// \brief Sets the field mode of the geometry setup (GetSharedGeoSetup)
+    /// \param fldMode  Field mode: EFieldMode::Cached samples the field function on a grid, other modes provide the
+    ///                 interpolated field
+    void SetGeoSetupFieldMode(cbm::algo::kf::EFieldMode fldMode)
+    {
+      fGeoSetupFieldMode = fldMode;
+      fpGeoSetup         = nullptr;
+    }
+
     /// \brief  Sets hits ignoring (DEBUG FLAG)
     void SetIgnoreHitPresence(bool ok = true)
     {
@@ -116,6 +136,10 @@ namespace cbm::kf
     /// \note  Use-cases: precise fit in physical analyses and QA.
     std::shared_ptr<cbm::algo::kf::Setup<double>> fpGeoSetup{nullptr};
 
+    cbm::algo::kf::EFieldMode fGeoSetupFieldMode{cbm::algo::kf::EFieldMode::Orig};  ///< Field mode of the geo setup
+    double fFieldCacheStep{2.};            ///< Initial distance between the nodes of the field cache [cm]
+    double fFieldCacheMaxDeviation{0.01};  ///< Maximal deviation of the field cache from the field function [kG]
+
     /// \brief Checks, if the setup was already initialized
     /// \note  Each call of the setup initializer resets the setup builder, so the initialization is called
     ///        in the next MakeSetup call
@@ -550,14 +550,13 @@ bool Application::ReceiveConfigAndData(std::vector<zmq::message_t>& vMsg)
 template<class HistoDst, class HistoSrc>
 bool Application::ReadHistogram(const HistoSrc& rHist)
 {
-  HistoDst* pHist = cbm::qa::OnlineInterface::ROOTHistogram(rHist);
-  int index1 = FindHistogram(pHist->GetName());
+  int index1 = FindHistogram(rHist.GetName());
   if (-1 == index1) {
     // ----- Creating new histogram
-    HistoDst* histogram_new = static_cast<HistoDst*>(pHist->Clone());
+    HistoDst* histogram_new = cbm::qa::OnlineInterface::ROOTHistogram(rHist);
     fArrayHisto.Add(histogram_new);
 
-    LOG(info) << "Received new histo " << pHist->GetName();
+    LOG(info) << "Received new histo " << rHist.GetName();
 
     /// If new histo received, try to register it if configuration available
     if (!fbAllHistosRegistered) {
@@ -592,19 +591,15 @@ bool Application::ReadHistogram(const HistoSrc& rHist)
     }      // if( !fbAllCanvasReady )
   }        // if (-1 == index1)
   else {
-    // ----- Update histogram
-    LOG(debug) << "Received update for: " << pHist->GetName();
+    // ----- Update histogram: the message contains the content since the previous update, merge it in place
+    LOG(debug) << "Received update for: " << rHist.GetName();
     HistoDst* histogram_existing = dynamic_cast<HistoDst*>(fArrayHisto.At(index1));
-    if (nullptr == histogram_existing) {
+    if (nullptr == histogram_existing || !cbm::qa::OnlineInterface::AddHistogram(rHist, histogram_existing)) {
       LOG(error) << "CbmMqHistoServer::ReadHistogram => "
-                 << "Incompatible type found during update for histo " << pHist->GetName();
-      delete pHist;
+                 << "Incompatible type found during update for histo " << rHist.GetName();
       return false;
     }  // if( nullptr == histogram_existing )
-
-    histogram_existing->Add(pHist);
   }  // else of if (-1 == index1)
-  delete pHist;
   return true;
 }
 
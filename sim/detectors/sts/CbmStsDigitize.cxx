@@ -16,8 +16,14 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <tuple>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Includes from ROOT
 #include "TClonesArray.h"
@@ -404,10 +410,13 @@ UInt_t CbmStsDigitize::InitModules()
     CbmStsSimModule* module = new CbmStsSimModule(geoModule, &modulePar, this);
     auto result             = fModules.insert({address, module});
     assert(result.second);  // If false, module was already in map
+    module->InitAnalogBuffer();
     nModules++;
   }  //# modules in setup
 
   assert(nModules == fModules.size());
+  fModulePoints.clear();
+  fModulePoints.resize(nModules);
   return nModules;
 }
 // -------------------------------------------------------------------------
@@ -528,6 +537,7 @@ UInt_t CbmStsDigitize::InitSensors()
 
   UInt_t nSensors = 0;
   fSensors.clear();
+  fSensorModuleIndex.clear();
 
   fSensorFactory = new CbmStsSimSensorFactory();
   for (Int_t iSensor = 0; iSensor < fSetup->GetNofSensors(); iSensor++) {
@@ -553,6 +563,7 @@ UInt_t CbmStsDigitize::InitSensors()
     assert(result.second);  // If false, sensor was already in map
     auto& sensor = result.first->second;
     assert(sensor);  // Valid sensor pointer
+    fSensorModuleIndex[sensAddress] = std::distance(fModules.begin(), moduIt);
 
     // Assign setup element and module
     sensor->SetElement(geoSensor);
@@ -639,7 +650,7 @@ void CbmStsDigitize::ProcessAnalogBuffers(Double_t readoutTime)
 void CbmStsDigitize::ProcessMCEvent()
 {
 
-  // --- Loop over all StsPoints and execute the ProcessPoint method
+  // --- Loop over all StsPoints and prepare them for the response calculation
   assert(fPoints);
   for (Int_t iPoint = 0; iPoint < fPoints->GetEntriesFast(); iPoint++) {
     const CbmStsPoint* point = (const CbmStsPoint*) fPoints->At(iPoint);
@@ -667,29 +678,38 @@ void CbmStsDigitize::ProcessMCEvent()
       continue;
     }
 
-    // --- Process the StsPoint
+    // --- Get the sensor the point is in
+    UInt_t address = static_cast<UInt_t>(point->GetDetectorID());
+    assert(fSensors.count(address));
+    auto& sensor = fSensors.find(address)->second;
+    assert(sensor);
+
+    // --- Prepare the StsPoint; this uses the field and gRandom, so it stays sequential
     CbmLink link(1., iPoint, fCurrentMCEntry, fCurrentInput);
-    ProcessPoint(point, fCurrentEventTime, link);
+    PreparedPoint entry;
+    entry.fSensor = sensor.get();
+    entry.fPoint  = sensor->PreparePoint(point, fCurrentEventTime);
+    entry.fLink   = link;
+    fModulePoints[fSensorModuleIndex[address]].push_back(std::move(entry));
     fNofPointsProc++;
   }  //# StsPoints
-}
-// -------------------------------------------------------------------------
-
 
-// -----  Process a StsPoint   ---------------------------------------------
-void CbmStsDigitize::ProcessPoint(const CbmStsPoint* point, Double_t eventTime, const CbmLink& link)
-{
-
-  // --- Get the sensor the point is in
-  UInt_t address = static_cast<UInt_t>(point->GetDetectorID());
-  assert(fSensors.count(address));
-  auto& sensor = fSensors.find(address)->second;
-  assert(sensor);
-  Int_t status = sensor->ProcessPoint(point, eventTime, link);
-
-  // --- Statistics
-  Int_t nSignalsF = status / 1000;
-  Int_t nSignalsB = status - 1000 * nSignalsF;
+  // --- Calculate the response; modules are independent of each other
+  Int_t nSignalsF = 0;
+  Int_t nSignalsB = 0;
+  Int_t nModules  = fModulePoints.size();
+#ifdef _OPENMP
+  Int_t nThreads = fNofThreads > 0 ? fNofThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic) reduction(+ : nSignalsF, nSignalsB) num_threads(nThreads)
+#endif
+  for (Int_t iModule = 0; iModule < nModules; iModule++) {
+    for (auto& entry : fModulePoints[iModule]) {
+      Int_t status = entry.fSensor->ProcessPoint(entry.fPoint.get(), entry.fLink);
+      nSignalsF += status / 1000;
+      nSignalsB += status % 1000;
+    }  //# points in module
+    fModulePoints[iModule].clear();
+  }  //# modules
   LOG(debug2) << GetName() << ": Produced signals: " << nSignalsF + nSignalsB << " ( " << nSignalsF << " / "
               << nSignalsB << " )";
   fNofSignalsF += nSignalsF;
@@ -16,12 +16,16 @@
 #include "CbmStsDefs.h"
 #include "CbmStsDigi.h"
 #include "CbmStsPhysics.h"
+#include "CbmStsSensorPoint.h"
 #include "CbmStsSimModule.h"
 #include "CbmStsSimSensor.h"
 
 #include "TStopwatch.h"
 
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 class TClonesArray;
 class CbmStsPoint;
@@ -173,6 +177,15 @@ public:
   void SetModuleParameterFile(const char* fileName);
 
 
+  /** @brief Set the number of threads for the response calculation
+   ** @param nThreads  Number of threads; 0 (default) uses the OpenMP default
+   **
+   ** The analogue response of the modules is calculated in parallel, if
+   ** OpenMP is available. The digis do not depend on the number of threads.
+   **/
+  void SetNofThreads(Int_t nThreads) { fNofThreads = nThreads; }
+
+
   /** Set physics processes
    ** @param eLossModel       Energy loss model
    ** @param useLorentzShift  If kTRUE, activate Lorentz shift
@@ -247,6 +260,22 @@ private:
   /** Map of sensors. Key is the address. **/
   std::map<UInt_t, std::unique_ptr<CbmStsSimSensor>> fSensors {};
 
+  /** @brief MC point prepared for the response calculation **/
+  struct PreparedPoint {
+    CbmStsSimSensor* fSensor = nullptr;          ///< Sensor the point is in
+    std::unique_ptr<CbmStsSensorPoint> fPoint;  ///< Point in sensor c.s.
+    CbmLink fLink;                               ///< Link to the MC point
+  };
+
+  /** Prepared points per module, in the order of fModules **/
+  std::vector<std::vector<PreparedPoint>> fModulePoints {};  //!
+
+  /** Index of the module in fModules. Key is the sensor address. **/
+  std::unordered_map<UInt_t, UInt_t> fSensorModuleIndex {};  //!
+
+  /** Number of threads for the response calculation, 0 for the OpenMP default **/
+  Int_t fNofThreads = 0;  //!
+
   // --- Global user-defined parameter settings
   CbmStsParSim* fUserParSim         = nullptr;  ///< Settings for simulation
   CbmStsParAsic* fUserParAsic       = nullptr;  ///< User defined, global
@@ -357,15 +386,15 @@ private:
   void ProcessAnalogBuffers(Double_t readoutTime);
 
 
-  /** Process StsPoints from MCEvent **/
-  void ProcessMCEvent();
-
-
-  /** Process one MCPoint
-   ** @param point  Pointer to CbmStsPoint to be processed
-   ** @param link   Link to MCPoint
+  /** @brief Process StsPoints from MCEvent
+   **
+   ** The points are prepared sequentially, in input order, since the
+   ** magnetic field and the random generator are not thread-safe.
+   ** The analogue response is then calculated in parallel for the
+   ** modules (with OpenMP), each module processing its points in input
+   ** order. Thus, the result does not depend on the number of threads.
    **/
-  void ProcessPoint(const CbmStsPoint* point, Double_t eventTime, const CbmLink& link);
+  void ProcessMCEvent();
 
 
   /** @brief Read the list of inactive channels from file
@@ -13,6 +13,8 @@
 #include "Rtypes.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 /** @class CbmStsSensorPoint
  ** @brief Container class for a local point in a STS sensor
@@ -62,6 +64,18 @@ public:
   Int_t GetPid() const { return fPid; }         ///< Particle ID [PDG]
 
 
+  /** Charges created in the steps along the trajectory
+     ** @return Charge per step [e], empty if not sampled
+     **/
+  const std::vector<Double_t>& GetStepCharges() const { return fStepCharges; }
+
+
+  /** Set the charges created in the steps along the trajectory
+     ** @param charges  Charge per step [e]
+     **/
+  void SetStepCharges(std::vector<Double_t>&& charges) { fStepCharges = std::move(charges); }
+
+
   /** String output **/
   std::string ToString() const;
 
@@ -81,6 +95,8 @@ private:
   Double_t fBz;     ///< Magnetic field z component at midpoint [T]
   Int_t fPid;       ///< Particle Type [PDG code]
 
+  std::vector<Double_t> fStepCharges {};  //! Charge per trajectory step [e]
+
 
   ClassDef(CbmStsSensorPoint, 2);
 };
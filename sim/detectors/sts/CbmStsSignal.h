@@ -58,6 +58,23 @@ public:
   }
 
 
+  /** Re-initialise with a single link
+     ** @param time    Signal time [ns]
+     ** @param charge  Analog charge [e]
+     ** @param index   Index of CbmStsPoint
+     ** @param entry   Entry in input TTree
+     ** @param file    Number of input file
+     **
+     ** Same state as a newly constructed signal, but the link storage is reused.
+     **/
+  void Reset(Double_t time, Double_t charge, Int_t index, Int_t entry = -1, Int_t file = -1)
+  {
+    fTime = time;
+    fMatch.ClearLinks();
+    fMatch.AddLink(charge, index, entry, file);
+  }
+
+
   /** Charge
 		 ** @return Signal analog charge [e]
 		 **/
@@ -12,6 +12,8 @@
 #include "CbmStsDigitize.h"
 #include "CbmStsElement.h"
 
+#include <cassert>
+
 
 using namespace std;
 
@@ -29,16 +31,7 @@ ClassImp(CbmStsSimModule)
 
 
 // --- Destructor   --------------------------------------------------------
-CbmStsSimModule::~CbmStsSimModule()
-{
-
-  // --- Clean analog buffer
-  for (auto chanIt = fAnalogBuffer.begin(); chanIt != fAnalogBuffer.end(); chanIt++) {
-    for (auto sigIt = (chanIt->second).begin(); sigIt != (chanIt->second).end(); sigIt++) {
-      delete (*sigIt);
-    }
-  }
-}
+CbmStsSimModule::~CbmStsSimModule() {}
 // -------------------------------------------------------------------------
 
 
@@ -52,44 +45,55 @@ void CbmStsSimModule::AddSignal(UShort_t channel, Double_t time, Double_t charge
   // --- Discard charge if the channel is dead
   if (!fParams->IsChannelActive(channel)) return;
 
-  // --- If the channel is not yet active: create a new set and insert
-  // --- new signal into it.
-  if (fAnalogBuffer.find(channel) == fAnalogBuffer.end()) {
-    CbmStsSignal* signal = new CbmStsSignal(time, charge, index, entry, file);
-    fAnalogBuffer[channel].insert(signal);
-    return;
-  }  //? Channel not yet active
+  if (fBufferSize.empty()) InitAnalogBuffer();
 
-  // --- The channel is active: there are already signals in.
-  // --- Loop over all signals in the channels and compare their time.
-  //TODO: Loop over all signals is not needed, since they are time-ordered.
-  Bool_t isMerged = kFALSE;
-  sigset::iterator it;
+  // --- Loop over the signals in the channel in time order and compare
+  // --- their time. Merging can only happen with signals up to the first
+  // --- one later than the new signal; before that one, the new signal
+  // --- has to be inserted to keep the time order.
+  UInt_t nSignals   = fBufferSize[channel];
+  UInt_t position   = nSignals;
   Double_t deadTime = fParams->GetParAsic(channel).GetDeadTime();
-  for (it = fAnalogBuffer[channel].begin(); it != fAnalogBuffer[channel].end(); it++) {
+  for (UInt_t iSignal = 0; iSignal < nSignals; iSignal++) {
+    CbmStsSignal& signal = BufferSignal(channel, iSignal);
 
     // Time between new and old signal smaller than dead time: merge signals
-    if (TMath::Abs((*it)->GetTime() - time) < deadTime) {
+    if (TMath::Abs(signal.GetTime() - time) < deadTime) {
 
       // Current implementation of merging signals:
       // Add charges, keep first signal time
       // TODO: Check with STS electronics people on more realistic behaviour.
-      (*it)->SetTime(TMath::Min((*it)->GetTime(), time));
-      (*it)->AddLink(charge, index, entry, file);
-      isMerged = kTRUE;  // mark new signal as merged
-      break;             // Merging should be necessary only for one buffer signal
+      signal.SetTime(TMath::Min(signal.GetTime(), time));
+      signal.AddLink(charge, index, entry, file);
+      return;  // Merging should be necessary only for one buffer signal
 
     }  //? Time difference smaller than dead time
 
-  }  // Loop over signals in buffer for this channel
+    if (signal.GetTime() > time) {
+      position = iSignal;
+      break;
+    }
 
-  // --- If signal was merged: no further action
-  if (isMerged) return;
+  }  // Loop over signals in buffer for this channel
 
   // --- Arriving here, the signal did not interfere with existing ones.
   // --- So, it is added to the analog buffer.
-  CbmStsSignal* signal = new CbmStsSignal(time, charge, index, entry, file);
-  fAnalogBuffer[channel].insert(signal);
+  if (nSignals == fBufferCapacity[channel]) GrowAnalogBuffer(channel);
+  UInt_t iPool = 0;
+  if (fSignalFree.empty()) {
+    iPool = fSignalPool.size();
+    fSignalPool.emplace_back(time, charge, index, entry, file);
+  }
+  else {
+    iPool = fSignalFree.back();
+    fSignalFree.pop_back();
+    fSignalPool[iPool].Reset(time, charge, index, entry, file);
+  }
+  for (UInt_t iSignal = nSignals; iSignal > position; iSignal--) {
+    fBufferRing[BufferSlot(channel, iSignal)] = fBufferRing[BufferSlot(channel, iSignal - 1)];
+  }
+  fBufferRing[BufferSlot(channel, position)] = iPool;
+  fBufferSize[channel]++;
 }
 // -------------------------------------------------------------------------
 
@@ -104,13 +108,13 @@ void CbmStsSimModule::BufferStatus(Int_t& nofSignals, Double_t& timeFirst, Doubl
   Double_t tLast   = -1.;
   Double_t tSignal = -1.;
 
-  // --- Loop over active channels
-  for (auto chanIt = fAnalogBuffer.begin(); chanIt != fAnalogBuffer.end(); chanIt++) {
+  // --- Loop over channels
+  for (UShort_t channel = 0; channel < fBufferSize.size(); channel++) {
 
     // --- Loop over signals in channel
-    for (auto sigIt = (chanIt->second).begin(); sigIt != (chanIt->second).end(); sigIt++) {
+    for (UInt_t iSignal = 0; iSignal < fBufferSize[channel]; iSignal++) {
 
-      tSignal = (*sigIt)->GetTime();
+      tSignal = BufferSignal(channel, iSignal).GetTime();
       nSignals++;
       tFirst = tFirst < 0. ? tSignal : TMath::Min(tFirst, tSignal);
       tLast  = TMath::Max(tLast, tSignal);
@@ -223,13 +227,67 @@ Int_t CbmStsSimModule::GetAddressFromName(TString name)
 
 
 // -----  Initialise the analogue buffer   ---------------------------------
-void CbmStsSimModule::InitAnalogBuffer()
+void CbmStsSimModule::InitAnalogBuffer(UInt_t capacity)
 {
 
-  for (UShort_t channel = 0; channel < fParams->GetNofChannels(); channel++) {
-    multiset<CbmStsSignal*, CbmStsSignal::Before> mset;
-    fAnalogBuffer[channel] = mset;
+  assert(fBufferSize.empty());  // The buffer must not contain signals
+  UInt_t channelCapacity = 1;
+  while (channelCapacity < capacity)
+    channelCapacity *= 2;
+
+  UShort_t nChannels = fParams->GetNofChannels();
+  fBufferRing.assign(size_t(nChannels) * channelCapacity, 0);
+  fBufferOffset.resize(nChannels);
+  for (UShort_t channel = 0; channel < nChannels; channel++)
+    fBufferOffset[channel] = size_t(channel) * channelCapacity;
+  fBufferCapacity.assign(nChannels, channelCapacity);
+  fBufferHead.assign(nChannels, 0);
+  fBufferSize.assign(nChannels, 0);
+  fBufferUnused = 0;
+}
+// -------------------------------------------------------------------------
+
+
+// -----  Compact the analogue buffer   ------------------------------------
+void CbmStsSimModule::CompactAnalogBuffer()
+{
+
+  // --- The rings are unrolled into the new array, in channel order
+  std::vector<UInt_t> ring(fBufferRing.size() - fBufferUnused);
+  size_t offset = 0;
+  for (UShort_t channel = 0; channel < fBufferSize.size(); channel++) {
+    for (UInt_t iSignal = 0; iSignal < fBufferSize[channel]; iSignal++)
+      ring[offset + iSignal] = fBufferRing[BufferSlot(channel, iSignal)];
+    fBufferOffset[channel] = offset;
+    fBufferHead[channel]   = 0;
+    offset += fBufferCapacity[channel];
   }  //# channels
+
+  fBufferRing.swap(ring);
+  fBufferUnused = 0;
+}
+// -------------------------------------------------------------------------
+
+
+// -----  Double the capacity of one channel   -----------------------------
+void CbmStsSimModule::GrowAnalogBuffer(UShort_t channel)
+{
+
+  // --- The ring is unrolled to the end of the array, starting at slot 0
+  UInt_t capacity = 2 * fBufferCapacity[channel];
+  size_t offset   = fBufferRing.size();
+  fBufferRing.resize(offset + capacity);
+  for (UInt_t iSignal = 0; iSignal < fBufferSize[channel]; iSignal++)
+    fBufferRing[offset + iSignal] = fBufferRing[BufferSlot(channel, iSignal)];
+
+  fBufferUnused += fBufferCapacity[channel];
+
+  fBufferOffset[channel]   = offset;
+  fBufferCapacity[channel] = capacity;
+  fBufferHead[channel]     = 0;
+
+  // --- Reclaim the slots of grown rings, if they dominate the array
+  if (2 * fBufferUnused > fBufferRing.size()) CompactAnalogBuffer();
 }
 // -------------------------------------------------------------------------
 
@@ -241,18 +299,12 @@ Int_t CbmStsSimModule::ProcessAnalogBuffer(Double_t readoutTime)
   // --- Counter
   Int_t nDigis = 0;
 
-  // Create iterators needed for inner loop
-  sigset::iterator sigIt;
-  ;
-  sigset::iterator oldIt;
-  sigset::iterator endIt;
-
-  // --- Iterate over active channels
-  for (auto& chanIt : fAnalogBuffer) {
+  // --- Iterate over channels
+  for (UShort_t channel = 0; channel < fBufferSize.size(); channel++) {
 
     // Only do something if there are signals for the channel
-    if (!(chanIt.second).empty()) {
-      auto& asic = fParams->GetParAsic(chanIt.first);
+    if (fBufferSize[channel]) {
+      auto& asic = fParams->GetParAsic(channel);
 
       // --- Time limit up to which signals are digitised and sent to DAQ.
       // --- Up to that limit, it is guaranteed that future signals do not
@@ -265,26 +317,22 @@ Int_t CbmStsSimModule::ProcessAnalogBuffer(Double_t readoutTime)
       Double_t timeLimit = readoutTime - 5. * asic.GetTimeResol() - asic.GetDeadTime();
 
       // --- Digitise all signals up to the specified time limit
-      sigIt = (chanIt.second).begin();
-      oldIt = sigIt;
-      endIt = (chanIt.second).end();
-      while (sigIt != endIt) {
+      while (fBufferSize[channel]) {
+        UInt_t iPool         = fBufferRing[BufferSlot(channel, 0)];
+        CbmStsSignal& signal = fSignalPool[iPool];
 
         // --- Exit loop if signal time is larger than time limit
         // --- N.b.: Readout time < 0 means digitise everything
-        if (readoutTime >= 0. && (*sigIt)->GetTime() > timeLimit) break;
+        if (readoutTime >= 0. && signal.GetTime() > timeLimit) break;
 
         // --- Digitise signal
-        Digitize(chanIt.first, (*sigIt));
+        Digitize(channel, &signal);
         nDigis++;
 
-        // --- Increment iterator before it becomes invalid
-        oldIt = sigIt;
-        sigIt++;
-
-        // --- Delete digitised signal
-        delete (*oldIt);
-        (chanIt.second).erase(oldIt);
+        // --- Remove digitised signal from the front of the ring
+        fSignalFree.push_back(iPool);
+        fBufferHead[channel] = (fBufferHead[channel] + 1) & (fBufferCapacity[channel] - 1);
+        fBufferSize[channel]--;
       }  // Iterate over signals in channel
     }    // if there are signals
   }      // Iterate over channels
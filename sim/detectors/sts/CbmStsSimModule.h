@@ -19,8 +19,6 @@
 #include "TF1.h"
 #include "TRandom.h"
 
-#include <map>
-#include <set>
 #include <vector>
 
 class TClonesArray;
@@ -114,6 +112,24 @@ public:
   CbmStsDigitize* GetDigitizer() const { return fDigitizer; }
 
 
+  /** @brief Number of signals in the analogue buffer of a channel
+     ** @param channel  Channel number
+     ** @value Number of buffered signals
+     **/
+  UInt_t GetNofSignals(UShort_t channel) const { return fBufferSize.empty() ? 0 : fBufferSize[channel]; }
+
+
+  /** @brief Signal in the analogue buffer
+     ** @param channel  Channel number
+     ** @param i        Position in the channel, in time order (less than GetNofSignals)
+     ** @value Signal object
+     **/
+  const CbmStsSignal& GetSignal(UShort_t channel, UInt_t i) const
+  {
+    return fSignalPool[fBufferRing[BufferSlot(channel, i)]];
+  }
+
+
   /** @brief Number of electronic channels
      ** @value Number of ADC channels
      **/
@@ -121,18 +137,14 @@ public:
 
 
   /** Initialise the analogue buffer
-     ** The analogue buffer contains a std::multiset for each channel, to be
-     ** filled with CbmStsSignal objects. Without this method, a channel
-     ** multiset would be instantiated at run time when the first signal
-     ** for this channel arrives. Depending on the occupancy of this channel,
-     ** this may happen only after several hundreds of events. Consequently,
-     ** the memory consumption will increase for the first events until
-     ** each channel was activated at least once. This behaviour mimics a
-     ** memory leak and makes it harder to detect a real one in other parts
-     ** of the code. This is avoided by instantiating each channel multiset
-     ** at initialisation time.
+     ** @param capacity  Initial number of signals per channel (rounded up to a power of 2)
+     **
+     ** The analogue buffer holds a time-ordered ring of signals for each
+     ** channel. The rings are allocated here for all channels at once, so
+     ** the memory consumption does not grow during the first events. If not
+     ** called, the buffer is initialised when the first signal arrives.
      **/
-  void InitAnalogBuffer();
+  void InitAnalogBuffer(UInt_t capacity = 4);
 
 
   /** Check whether module parameters are set
@@ -199,15 +211,57 @@ private:
   CbmStsDigitize* fDigitizer     = nullptr;  //! Digitizer
   const CbmStsParModule* fParams = nullptr;  //! Module parameters
 
-  /** Buffer for analog signals, key is channel number.
-     ** Because signals do not, in general, arrive time-sorted,
-     ** the buffer must hold a (multi)set of signals for each channel
-     ** (multiset allowing for different signals at the same time).
-     ** Sorting in the multiset is with the less operator of CbmStsSignal,
-     ** which compares the time of the signals.
+  /** Buffer for analog signals
+     ** Because signals do not, in general, arrive time-sorted, each channel
+     ** has a ring of signals sorted by time (signals at the same time in
+     ** order of arrival). The rings of all channels are stored in one flat
+     ** array and hold indices into a pool of signal objects. Digitised
+     ** signals are removed from the front of the ring and their objects are
+     ** reused for new signals, so no allocation is needed per signal.
+     ** A full ring is moved to the end of the flat array with twice its
+     ** capacity; the slots it leaves behind are reclaimed by compacting the
+     ** array when they make up more than half of it.
+     **/
+  std::vector<UInt_t> fBufferRing;        //! Pool indices, rings of all channels
+  std::vector<size_t> fBufferOffset;      //! Start of the ring in fBufferRing per channel
+  std::vector<UInt_t> fBufferCapacity;    //! Slots of the ring per channel, power of 2
+  std::vector<UInt_t> fBufferHead;        //! Ring position of the earliest signal per channel
+  std::vector<UInt_t> fBufferSize;        //! Number of signals per channel
+  size_t fBufferUnused = 0;               //! Slots in fBufferRing left behind by grown rings
+  std::vector<CbmStsSignal> fSignalPool;  //! Signal objects
+  std::vector<UInt_t> fSignalFree;        //! Indices of unused signal objects
+
+
+  /** Signal in the analogue buffer
+     ** @param channel  Channel number
+     ** @param i        Position in the channel, in time order
+     ** @return Signal object
+     **/
+  CbmStsSignal& BufferSignal(UShort_t channel, UInt_t i)
+  {
+    return fSignalPool[fBufferRing[BufferSlot(channel, i)]];
+  }
+
+
+  /** Slot in the flat ring array
+     ** @param channel  Channel number
+     ** @param i        Position in the channel, in time order
+     ** @return Index in fBufferRing
+     **/
+  size_t BufferSlot(UShort_t channel, UInt_t i) const
+  {
+    return fBufferOffset[channel] + ((fBufferHead[channel] + i) & (fBufferCapacity[channel] - 1));
+  }
+
+
+  /** Remove the slots left behind by grown rings from the flat ring array **/
+  void CompactAnalogBuffer();
+
+
+  /** Double the number of slots of one channel
+     ** @param channel  Channel number
      **/
-  typedef std::multiset<CbmStsSignal*, CbmStsSignal::Before> sigset;
-  std::map<UShort_t, sigset> fAnalogBuffer;
+  void GrowAnalogBuffer(UShort_t channel);
 
 
   /** Digitise an analogue charge signal
@@ -217,7 +271,7 @@ private:
   void Digitize(UShort_t channel, CbmStsSignal* signal);
 
 
-  ClassDef(CbmStsSimModule, 1);
+  ClassDef(CbmStsSimModule, 2);
 };
 
 #endif /* CBMSTSSIMMODULE_H */
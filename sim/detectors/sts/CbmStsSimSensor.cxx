@@ -60,14 +60,33 @@ Int_t CbmStsSimSensor::GetSensorId() const
 // -----   Process a CbmStsPoint  ------------------------------------------
 Int_t CbmStsSimSensor::ProcessPoint(const CbmStsPoint* point, Double_t eventTime, const CbmLink& link)
 {
+  auto sPoint = PreparePoint(point, eventTime);
+  return ProcessPoint(sPoint.get(), link);
+}
+// -------------------------------------------------------------------------
 
-  // --- Physical node
-  assert(fElement);
-  TGeoPhysicalNode* node = fElement->GetPnode();
+
+// -----   Calculate the response to a prepared point   --------------------
+Int_t CbmStsSimSensor::ProcessPoint(CbmStsSensorPoint* point, const CbmLink& link)
+{
 
   // --- Set current link
   fCurrentLink = link;
 
+  // --- Calculate the detector response
+  return CalculateResponse(point);
+}
+// -------------------------------------------------------------------------
+
+
+// -----   Prepare a MC point for the response calculation   ---------------
+std::unique_ptr<CbmStsSensorPoint> CbmStsSimSensor::PreparePoint(const CbmStsPoint* point, Double_t eventTime) const
+{
+
+  // --- Physical node
+  assert(fElement);
+  TGeoPhysicalNode* node = fElement->GetPnode();
+
   // --- Transform start coordinates into local C.S.
   Double_t global[3];
   Double_t local[3];
@@ -206,13 +225,12 @@ Int_t CbmStsSimSensor::ProcessPoint(const CbmStsPoint* point, Double_t eventTime
 
   // --- Create SensorPoint
   // Note: there is a conversion from kG to T in the field values.
-  CbmStsSensorPoint* sPoint = new CbmStsSensorPoint(x1, y1, z1, x2, y2, z2, p, point->GetEnergyLoss(), pTime,
+  auto sPoint = std::make_unique<CbmStsSensorPoint>(x1, y1, z1, x2, y2, z2, p, point->GetEnergyLoss(), pTime,
                                                     bField[0] / 10., bField[1] / 10., bField[2] / 10., point->GetPid());
 
-  // --- Calculate the detector response
-  Int_t result = CalculateResponse(sPoint);
-  delete sPoint;
+  // --- Random numbers for the detector response
+  SampleResponse(sPoint.get());
 
-  return result;
+  return sPoint;
 }
 // -------------------------------------------------------------------------
@@ -16,6 +16,8 @@
 #include <TObject.h>
 #include <TString.h>
 
+#include <memory>
+
 class CbmLink;
 class CbmStsElement;
 class CbmStsParSensorCond;
@@ -112,6 +114,31 @@ public:
   Int_t ProcessPoint(const CbmStsPoint* point, Double_t eventTime, const CbmLink& link);
 
 
+  /** @brief Prepare one MC Point for the response calculation
+     ** @param point      Pointer to CbmStsPoint object
+     ** @param eventTime  Event start time [ns]
+     ** @return Point in the internal coordinate system
+     **
+     ** First part of ProcessPoint: converts the coordinates, gets the
+     ** magnetic field and samples the random numbers of the response
+     ** (SampleResponse). Neither the field nor gRandom are thread-safe, so
+     ** this must be called sequentially, in the order of the input points,
+     ** to obtain a reproducible random sequence.
+     **/
+  std::unique_ptr<CbmStsSensorPoint> PreparePoint(const CbmStsPoint* point, Double_t eventTime) const;
+
+
+  /** @brief Calculate the response to a prepared point
+     ** @param point  Point returned by PreparePoint
+     ** @param link   Link to the MC point
+     ** @return  Status variable, depends on sensor type
+     **
+     ** Second part of ProcessPoint. Only modifies this sensor and its module,
+     ** so points in different modules can be processed concurrently.
+     **/
+  Int_t ProcessPoint(CbmStsSensorPoint* point, const CbmLink& link);
+
+
   /** Set the sensor conditions
      ** @param conditions    Pointer to conditions parameters
      **/
@@ -188,6 +215,16 @@ protected:
   virtual Int_t CalculateResponse(CbmStsSensorPoint* point) = 0;
 
 
+  /** Sample the random numbers needed for the response to one MC Point
+     ** @param point   Pointer to CbmStsSensorPoint with relevant parameters
+     **
+     ** Called by PreparePoint. Concrete classes store the random numbers
+     ** in the sensor point, such that CalculateResponse does not use
+     ** gRandom. By default, no random numbers are needed.
+     **/
+  virtual void SampleResponse(CbmStsSensorPoint* /*point*/) const {}
+
+
   ClassDef(CbmStsSimSensor, 1);
 };
 
@@ -17,7 +17,10 @@
 #include "CbmStsSetup.h"
 #include "CbmStsSimModule.h"
 
+#include <cassert>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 
 using std::string;
@@ -203,22 +206,14 @@ void CbmStsSimSensorDssd::ProduceCharge(CbmStsSensorPoint* point)
     return;
   }
 
-  // Kinetic energy
-  Double_t mass = CbmStsPhysics::ParticleMass(point->GetPid());
-  Double_t eKin = TMath::Sqrt(point->GetP() * point->GetP() + mass * mass) - mass;
-
   // Length of trajectory inside sensor and its projections
-  Double_t trajLx     = point->GetX2() - point->GetX1();
-  Double_t trajLy     = point->GetY2() - point->GetY1();
-  Double_t trajLz     = point->GetZ2() - point->GetZ1();
-  Double_t trajLength = TMath::Sqrt(trajLx * trajLx + trajLy * trajLy + trajLz * trajLz);
+  Double_t trajLx = point->GetX2() - point->GetX1();
+  Double_t trajLy = point->GetY2() - point->GetY1();
+  Double_t trajLz = point->GetZ2() - point->GetZ1();
 
   // The trajectory is sub-divided into equidistant steps, with a step size
   // close to 3 micrometer.
-  Double_t stepSizeTarget = 3.e-4;  // targeted step size is 3 micrometer
-  Int_t nSteps            = TMath::Nint(trajLength / stepSizeTarget);
-  if (nSteps == 0) nSteps = 1;  // assure at least one step
-  Double_t stepSize  = trajLength / nSteps;
+  Int_t nSteps       = GetNofSteps(point);
   Double_t stepSizeX = trajLx / nSteps;
   Double_t stepSizeY = trajLy / nSteps;
   Double_t stepSizeZ = trajLz / nSteps;
@@ -226,10 +221,9 @@ void CbmStsSimSensorDssd::ProduceCharge(CbmStsSensorPoint* point)
   // Average charge per step, used for uniform distribution
   Double_t chargePerStep = chargeTotal / nSteps;
 
-  // Stopping power, needed for energy loss fluctuations
-  Double_t dedx = 0.;
-
-  if (eLossModel == CbmStsELoss::kUrban) dedx = CbmStsPhysics::Instance()->StoppingPower(eKin, point->GetPid());
+  // Energy loss fluctuations: charges per step are sampled beforehand
+  if (eLossModel == CbmStsELoss::kUrban && point->GetStepCharges().empty()) SampleResponse(point);
+  assert(eLossModel != CbmStsELoss::kUrban || Int_t(point->GetStepCharges().size()) == nSteps);
 
   // Stepping over the trajectory
   Double_t chargeSum = 0.;
@@ -244,8 +238,7 @@ void CbmStsSimSensorDssd::ProduceCharge(CbmStsSensorPoint* point)
     // Charge for this step
     Double_t chargeInStep = chargePerStep;  // uniform energy loss
     if (eLossModel == CbmStsELoss::kUrban)  // energy loss fluctuations
-      chargeInStep =
-        CbmStsPhysics::Instance()->EnergyLoss(stepSize, mass, eKin, dedx) / CbmStsPhysics::PairCreationEnergy();
+      chargeInStep = point->GetStepCharges()[iStep];
     chargeSum += chargeInStep;
 
     // Propagate charge to strips
@@ -269,6 +262,54 @@ void CbmStsSimSensorDssd::ProduceCharge(CbmStsSensorPoint* point)
 // -------------------------------------------------------------------------
 
 
+// -----   Number of steps along the trajectory   ---------------------------
+Int_t CbmStsSimSensorDssd::GetNofSteps(const CbmStsSensorPoint* point)
+{
+  Double_t trajLx     = point->GetX2() - point->GetX1();
+  Double_t trajLy     = point->GetY2() - point->GetY1();
+  Double_t trajLz     = point->GetZ2() - point->GetZ1();
+  Double_t trajLength = TMath::Sqrt(trajLx * trajLx + trajLy * trajLy + trajLz * trajLz);
+
+  Double_t stepSizeTarget = 3.e-4;  // targeted step size is 3 micrometer
+  Int_t nSteps            = TMath::Nint(trajLength / stepSizeTarget);
+  if (nSteps == 0) nSteps = 1;  // assure at least one step
+  return nSteps;
+}
+// -------------------------------------------------------------------------
+
+
+// -----   Sample the energy loss fluctuations   ---------------------------
+void CbmStsSimSensorDssd::SampleResponse(CbmStsSensorPoint* point) const
+{
+
+  // Only the Urban model has fluctuations
+  if (fSettings->ELossModel() != CbmStsELoss::kUrban) return;
+
+  // Kinetic energy
+  Double_t mass = CbmStsPhysics::ParticleMass(point->GetPid());
+  Double_t eKin = TMath::Sqrt(point->GetP() * point->GetP() + mass * mass) - mass;
+
+  // Step size along the trajectory
+  Double_t trajLx     = point->GetX2() - point->GetX1();
+  Double_t trajLy     = point->GetY2() - point->GetY1();
+  Double_t trajLz     = point->GetZ2() - point->GetZ1();
+  Double_t trajLength = TMath::Sqrt(trajLx * trajLx + trajLy * trajLy + trajLz * trajLz);
+  Int_t nSteps        = GetNofSteps(point);
+  Double_t stepSize   = trajLength / nSteps;
+
+  // Stopping power, needed for energy loss fluctuations
+  Double_t dedx = CbmStsPhysics::Instance()->StoppingPower(eKin, point->GetPid());
+
+  // Charge for each step
+  std::vector<Double_t> charges(nSteps);
+  for (Int_t iStep = 0; iStep < nSteps; iStep++)
+    charges[iStep] =
+      CbmStsPhysics::Instance()->EnergyLoss(stepSize, mass, eKin, dedx) / CbmStsPhysics::PairCreationEnergy();
+  point->SetStepCharges(std::move(charges));
+}
+// -------------------------------------------------------------------------
+
+
 // -----   Register charge to the module  ----------------------------------
 void CbmStsSimSensorDssd::RegisterCharge(Int_t side, Int_t strip, Double_t charge, Double_t time) const
 {
@@ -197,6 +197,23 @@ protected:
   void RegisterCharge(Int_t side, Int_t strip, Double_t charge, Double_t time) const;
 
 
+  /** @brief Sample the energy loss fluctuations
+     ** @param point  Pointer to sensor point object
+     **
+     ** For the Urban energy loss model, the charge created in each step
+     ** along the trajectory is sampled and stored in the sensor point.
+     ** ProduceCharge uses these charges instead of sampling them itself.
+     **/
+  virtual void SampleResponse(CbmStsSensorPoint* point) const;
+
+
+  /** @brief Number of steps along the trajectory
+     ** @param point  Pointer to sensor point object
+     ** @return Number of steps with a step size close to 3 micrometer
+     **/
+  static Int_t GetNofSteps(const CbmStsSensorPoint* point);
+
+
   ClassDef(CbmStsSimSensorDssd, 1);
 };
 
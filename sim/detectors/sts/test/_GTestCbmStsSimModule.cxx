@@ -0,0 +1,146 @@
+/* Copyright (C) 2025 GSI Helmholtzzentrum fuer Schwerionenforschung, Darmstadt
+   SPDX-License-Identifier: GPL-3.0-only
+   Authors: agent [committer] */
+
+#include "CbmStsParAsic.h"
+#include "CbmStsParModule.h"
+#include "CbmStsSignal.h"
+#include "CbmStsSimModule.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+  constexpr UShort_t NofChannels = 128;
+  constexpr UShort_t HotChannel  = 7;
+
+  /** Analogue signal as produced by the response calculation **/
+  struct Signal {
+    UShort_t channel;
+    Double_t time;
+    Double_t charge;
+    Int_t index;
+  };
+
+  /** Random signals of one module in input order. One channel gets a large
+   ** fraction of the signals, such that its ring has to grow. The charges
+   ** are below threshold, so digitisation does not need the setup.
+   **/
+  std::vector<Signal> MakeSignals(unsigned seed, Int_t nSignals)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> channel(0, NofChannels - 1);
+    std::uniform_real_distribution<double> jitter(0., 2000.);
+    std::uniform_real_distribution<double> charge(100., 2000.);
+    std::bernoulli_distribution hot(0.2);
+
+    std::vector<Signal> signals;
+    for (Int_t index = 0; index < nSignals; index++) {
+      UShort_t ch = hot(gen) ? HotChannel : channel(gen);
+      signals.push_back({ch, 10. * index + jitter(gen), charge(gen), index});
+    }
+    return signals;
+  }
+
+  std::unique_ptr<CbmStsParModule> MakeParModule(Double_t deadTime)
+  {
+    auto par = std::make_unique<CbmStsParModule>(NofChannels, NofChannels);
+    par->SetAllAsics(CbmStsParAsic(NofChannels, 31, 75000., 3000., 5., deadTime, 1000., 0.));
+    return par;
+  }
+
+  void ExpectSameBuffers(const CbmStsSimModule& lhs, const CbmStsSimModule& rhs)
+  {
+    for (UShort_t channel = 0; channel < NofChannels; channel++) {
+      ASSERT_EQ(lhs.GetNofSignals(channel), rhs.GetNofSignals(channel)) << "channel " << channel;
+      for (UInt_t i = 0; i < lhs.GetNofSignals(channel); i++) {
+        const CbmStsSignal& l = lhs.GetSignal(channel, i);
+        const CbmStsSignal& r = rhs.GetSignal(channel, i);
+        EXPECT_EQ(l.GetTime(), r.GetTime()) << "channel " << channel << ", signal " << i;
+        EXPECT_EQ(l.GetCharge(), r.GetCharge()) << "channel " << channel << ", signal " << i;
+        ASSERT_EQ(l.GetMatch().GetNofLinks(), r.GetMatch().GetNofLinks()) << "channel " << channel;
+        for (Int_t iLink = 0; iLink < l.GetMatch().GetNofLinks(); iLink++) {
+          EXPECT_EQ(l.GetMatch().GetLink(iLink).GetIndex(), r.GetMatch().GetLink(iLink).GetIndex());
+        }
+      }
+    }
+  }
+}  // namespace
+
+
+TEST(_GTestCbmStsSimModule, BufferIsTimeOrdered)
+{
+  // Without dead time, signals are never merged
+  auto par = MakeParModule(0.);
+  CbmStsSimModule module(nullptr, par.get());
+
+  // Reference: signals with equal time in order of arrival, as in a multimap
+  std::vector<std::multimap<Double_t, Int_t>> expected(NofChannels);
+  Double_t readoutTime = 0.;
+  for (const auto& signal : MakeSignals(1, 20000)) {
+    module.AddSignal(signal.channel, signal.time, signal.charge, signal.index);
+    expected[signal.channel].emplace(signal.time, signal.index);
+
+    // Read out the earlier signals from time to time
+    if (signal.index % 1000 == 999) {
+      readoutTime = signal.time - 5000.;
+      module.ProcessAnalogBuffer(readoutTime);
+      Double_t timeLimit = readoutTime - 5. * par->GetParAsic(0).GetTimeResol();
+      for (auto& channelSignals : expected) {
+        channelSignals.erase(channelSignals.begin(), channelSignals.upper_bound(timeLimit));
+      }
+    }
+  }
+
+  EXPECT_GT(module.GetNofSignals(HotChannel), 4u);  // The ring of the hot channel has grown
+  for (UShort_t channel = 0; channel < NofChannels; channel++) {
+    ASSERT_EQ(module.GetNofSignals(channel), expected[channel].size()) << "channel " << channel;
+    UInt_t i = 0;
+    for (const auto& [time, index] : expected[channel]) {
+      const CbmStsSignal& signal = module.GetSignal(channel, i++);
+      EXPECT_EQ(signal.GetTime(), time) << "channel " << channel;
+      EXPECT_EQ(signal.GetMatch().GetLink(0).GetIndex(), index) << "channel " << channel;
+    }
+  }
+}
+
+
+TEST(_GTestCbmStsSimModule, ParallelEqualsSerial)
+{
+  // With dead time, signals are merged, which depends on the order of arrival
+  constexpr Int_t NofModules = 16;
+  auto par                   = MakeParModule(800.);
+
+  std::vector<std::vector<Signal>> signals;
+  std::vector<std::unique_ptr<CbmStsSimModule>> serial;
+  std::vector<std::unique_ptr<CbmStsSimModule>> parallel;
+  for (Int_t iModule = 0; iModule < NofModules; iModule++) {
+    signals.push_back(MakeSignals(100 + iModule, 5000));
+    serial.push_back(std::make_unique<CbmStsSimModule>(nullptr, par.get()));
+    parallel.push_back(std::make_unique<CbmStsSimModule>(nullptr, par.get()));
+  }
+
+  // Same scheme as CbmStsDigitize::ProcessMCEvent: modules in parallel, each in input order
+  for (Int_t iModule = 0; iModule < NofModules; iModule++) {
+    for (const auto& signal : signals[iModule]) {
+      serial[iModule]->AddSignal(signal.channel, signal.time, signal.charge, signal.index);
+    }
+  }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(4)
+#endif
+  for (Int_t iModule = 0; iModule < NofModules; iModule++) {
+    for (const auto& signal : signals[iModule]) {
+      parallel[iModule]->AddSignal(signal.channel, signal.time, signal.charge, signal.index);
+    }
+  }
+
+  for (Int_t iModule = 0; iModule < NofModules; iModule++) {
+    ExpectSameBuffers(*serial[iModule], *parallel[iModule]);
+  }
+}